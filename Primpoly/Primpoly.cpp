@@ -58,6 +58,20 @@
 #include <algorithm>    // Iterators.
 #include <stdexcept>    // Exceptions.
 #include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <functional>   // function
+#include <iterator>     // input_iterator_tag
+#include <cstddef>      // ptrdiff_t
+#include <thread>       // Worker threads.
+#include <mutex>        // mutex, lock_guard, unique_lock
+#include <condition_variable>  // Wake up idle workers.
+#include <future>       // packaged_task, future
+#include <queue>        // Task queue.
+#include <list>         // LRU order.
+#include <map>          // LRU index.
+#include <atomic>       // Stop flag.
+#include <chrono>       // steady_clock
+#include <csignal>      // Stop the daemon on SIGINT and SIGTERM.
 
 using namespace std ;   // I don't want to use the std:: prefix everywhere.
 
@@ -75,11 +89,32 @@ using namespace std ;   // I don't want to use the std:: prefix everywhere.
 #include "ppOperationCount.h" // OperationCount collection for factoring and poly finding.
 #include "ppFactor.h"         // Prime factorization and Euler Phi.
 #include "ppPolynomial.h"     // Polynomial operations and mod polynomial operations.
+#include "ppSearch.h"         // Primitive polynomial search and test API.
 #include "ppParser.h"         // Parsing of polynomials and I/O services.
+#include "ppOutput.h"         // Fast output of polynomials.
+#include "ppBatch.h"          // Batch testing of polynomials.
+#include "ppArchive.h"        // Polynomial archives.
+#include "ppAggregate.h"      // Streaming statistics of polynomials.
+#include "ppMonitor.h"        // Statistics export.
+#include "ppEstimate.h"       // Cost model.
+#include "ppPerfCounters.h"   // Hardware performance counters.
+#include "ppDaemon.h"         // Query daemon.
+#include "ppTrace.h"          // Timeline tracing.
 #include "ppUnitTest.h"       // Complete unit test.
 
 
 
+// The running daemon, for the signal handler.
+static PolyDaemon * runningDaemon = nullptr ;
+
+static void stopDaemon( int )
+{
+    if (runningDaemon != nullptr)
+        runningDaemon->stop() ;
+}
+
+
+
 /*=============================================================================
 |
 | NAME
@@ -111,21 +146,29 @@ int main( int argc, const char * argv[] )
 {
     try
     {
+        // Read the parameters p and n from the command line.  Throw a parsing exception if there is a problem.
+        PolyParser<PolySymbol, PolyValue> parser ;
+        parser.parseCommandLine( argc, argv ) ;
+
+        // In batch mode, or when listing polynomials for another program, the standard output is for the results only.
+        ostream & console = parser.batchTest_ || parser.outputFormat_ != OutputFormat::Human ? cerr : cout ;
+
         //  Show the legal notice first.
-        cout << legalNotice ;
+        console << legalNotice ;
 
         #ifdef SELF_CHECK
-        //  Do a self check first, always.
-        bool unitTestStatus = unitTest() ;
+        //  Do a quick self check first, always.  Run the complete unit test the first time
+        //  we run this build, or if the user asks for it.
+        bool unitTestStatus = selfCheck( parser.fullUnitTest_ ) ;
         if (!unitTestStatus)
             throw PrimpolyError( "Self-check failed!" ) ;
         else
-            cout << "Self-check passes..." << endl ;
+            console << "Self-check passes..." << endl ;
         #endif
 
-        // Read the parameters p and n from the command line.  Throw a parsing exception if there is a problem.
-        PolyParser<PolySymbol, PolyValue> parser ;
-        parser.parseCommandLine( argc, argv ) ;
+        // Did user ask for the unit test only?
+        if (parser.unitTestOnly_)
+            return static_cast<int>( ReturnStatus::Success ) ;
 
         // Did user ask for help?
         if (parser.printHelp_)
@@ -134,31 +177,209 @@ int main( int argc, const char * argv[] )
             return static_cast<int>( ReturnStatus::AskForHelp ) ;
         }
 
+        // With the statistics, count hardware events in each stage of testing, if we can.
+        if (parser.printOperationCount_ && !parser.estimate_ && !PerfCounters::enable())
+            console << "No hardware counters:  " << PerfCounters::unavailableReason() << endl ;
+
+        // Print the statistics at the end of the run, as a table or as JSON.
+        chrono::steady_clock::time_point startTime = chrono::steady_clock::now() ;
+        auto printStatistics = [&parser, startTime]( ostream & out, const OperationCount & statistics )
+        {
+            if (parser.statisticsJson_)
+                writeStatisticsJson( out, statistics,
+                                     chrono::duration< double >( chrono::steady_clock::now() - startTime ).count(), true ) ;
+            else
+                out << statistics << endl ;
+        } ;
+
+        // Snapshots of the statistics every few seconds while we search.
+        unique_ptr< StatisticsMonitor > monitor ;
+        if (!parser.monitorFile_.empty())
+            monitor.reset( new StatisticsMonitor( parser.monitorFile_ ) ) ;
+
+        // A timeline of what each thread does, for chrome://tracing or ui.perfetto.dev.
+        // We write it when we're done, or when an error unwinds us.
+        unique_ptr< TraceSession > trace ;
+        if (!parser.traceFile_.empty())
+            trace.reset( new TraceSession( parser.traceFile_ ) ) ;
+        PP_TRACE_THREAD_NAME( "main", -1 ) ;
+
+        // Answer queries on a socket until we're interrupted.
+        if (parser.daemon_)
+        {
+            PolyDaemon daemon( parser.daemonSocket_ ) ;
+            runningDaemon = &daemon ;
+            signal( SIGINT,  stopDaemon ) ;
+            signal( SIGTERM, stopDaemon ) ;
+
+            cout << "Listening on " << parser.daemonSocket_ << endl ;
+            daemon.run() ;
+            runningDaemon = nullptr ;
+        }
+        // Test a batch of polynomials, one per line, writing one result per line.
+        else if (parser.batchTest_)
+        {
+            ThreadPool     pool ;
+            PolyOrderCache cache ;
+
+            if (parser.batchFile_.empty())
+                testPolynomials( cin, cout, pool, cache ) ;
+            else
+                testPolynomialFile( parser.batchFile_, cout, pool, cache ) ;
+        }
+        // How long the search would take, without doing it.
+        else if (parser.estimate_)
+        {
+            JobEstimate estimate = estimateJob( parser.p, parser.n ) ;
+
+            if (parser.statisticsJson_)
+                writeEstimateJson( cout, estimate ) ;
+            else
+                cout << estimate << endl ;
+        }
+        // Statistics of all the primitive polynomials, searching shards in parallel.
+        else if (parser.aggregate_)
+        {
+            ThreadPool     pool ;
+            PolyOrderCache cache ;
+            OperationCount statistics ;
+            unique_ptr< AggregatorList > aggregators = AggregatorList::standard() ;
+
+            ppuint numPrimitivePoly = aggregate( parser.p, parser.n, *aggregators, pool, cache, &statistics ) ;
+
+            cout << "\n\nStatistics of the " << numPrimitivePoly << " primitive polynomials modulo " << parser.p
+                 << " of degree " << parser.n << "\n\n" << *aggregators << endl ;
+
+            if (monitor)
+                monitor->finish( statistics ) ;
+
+            if (parser.printOperationCount_)
+                printStatistics( cout, statistics ) ;
+        }
+        // Write all the primitive polynomials to an archive.
+        else if (parser.writeArchive_)
+        {
+            SearchOptions options ;
+            options.monitor = monitor.get() ;
+            PrimitivePolynomialSearch search( parser.p, parser.n, options ) ;
+            PolynomialArchiveWriter archive( parser.archiveFile_, parser.p, parser.n ) ;
+
+            search.enumerate( [&archive]( const Polynomial & f ) { archive.write( f ) ; return true ; } ) ;
+            archive.finish() ;
+
+            console << "Wrote " << archive.size() << " primitive polynomials modulo " << parser.p << " of degree " << parser.n
+                    << " to " << parser.archiveFile_ << endl ;
+
+            if (monitor)
+                monitor->finish( search.statistics() ) ;
+
+            if (parser.printOperationCount_)
+                printStatistics( console, search.statistics() ) ;
+        }
+        // List the polynomials in an archive, or check it.
+        else if (parser.readArchive_ || parser.verifyArchive_)
+        {
+            MappedFile file( parser.archiveFile_, parser.verifyArchive_ ) ;
+            if (!file.isMapped())
+                throw ArchiveError( "Error:  can't read archive file " + parser.archiveFile_ ) ;
+
+            PolynomialArchive archive( file.begin(), file.end() ) ;
+            console << parser.archiveFile_ << " has " << archive.size() << " polynomials modulo " << archive.modulus()
+                    << " of degree " << archive.degree() << " written by Primpoly Version "
+                    << archive.generatorVersion() / 100 << "." << archive.generatorVersion() % 100 / 10 << endl ;
+
+            if (parser.verifyArchive_)
+            {
+                ThreadPool pool ;
+                archive.verify( pool ) ;
+                console << "All " << archive.size() << " polynomials are in order and primitive." << endl ;
+            }
+            else
+            {
+                if (parser.outputFormat_ == OutputFormat::HexMask && archive.modulus() != 2)
+                    throw ParserError( "Error.  Hex tap masks are only for p = 2" ) ;
+
+                PolynomialWriter writer( cout, parser.outputFormat_ ) ;
+                ppuint numLeft = parser.archiveCount_ ;
+                archive.scan( parser.archiveFirst_, [&writer, &numLeft]( const Polynomial & f )
+                {
+                    if (numLeft == 0)
+                        return false ;
+
+                    writer.write( f ) ;
+                    --numLeft ;
+                    return true ;
+                } ) ;
+            }
+        }
         // The user input a polynomial.  Test it for primitivity.
-        if (parser.testPolynomialForPrimitivity_)
+        else if (parser.testPolynomialForPrimitivity_)
         {
             // Test for primitivity with the quick test.
             Polynomial f( parser.testPolynomial_ ) ;
-            PolyOrder order( f ) ;
-            cout << f << " is " << (order.isPrimitive() ? "" : "NOT") << " primitive!" << endl ;
+            OperationCount statistics ;
+            cout << f << " is " << (isPrimitive( f, &statistics ) ? "" : "NOT") << " primitive!" << endl ;
 
             if (parser.printOperationCount_)
-                cout << order.statistics_ << endl ;
+                printStatistics( cout, statistics ) ;
 
             // Do a very slow maximal order test for primitivity, if asked to do so.
             if (parser.slowConfirm_)
             {
                 cout << confirmWarning ;
-                cout << " confirmed " << (order.maximal_order() ? "" : "NOT") << " primitive!" << endl ;
+                cout << " confirmed " << (confirmPrimitive( f ) ? "" : "NOT") << " primitive!" << endl ;
             }
         }
         else
         {
-            //  Find a primitive polynomial.
-            Polynomial f = findPrimitivePolynomial( parser.p, parser.n,
-                                                    parser.printOperationCount_, parser.listAllPrimitivePolynomials_, parser.slowConfirm_ ) ;
+            //  Find a primitive polynomial, or all of them.  The search confirms each one
+            //  with the slow test, if asked to, and throws if the two tests disagree.
+            SearchOptions options ;
+            options.slowConfirm = parser.slowConfirm_ ;
+            options.monitor     = monitor.get() ;
+            PrimitivePolynomialSearch search( parser.p, parser.n, options ) ;
+
+            // Format the polynomials by hand into a big buffer, written out on another thread.
+            PolynomialWriter writer( cout, parser.outputFormat_ ) ;
+            bool human = parser.outputFormat_ == OutputFormat::Human ;
+
+            if (parser.listAllPrimitivePolynomials_ && human)
+            {
+                ostringstream os ;
+                os << "\n\nThere are " << search.getNumPrimPoly() << " primitive polynomials modulo " << parser.p << " of degree " << parser.n << "\n\n" ;
+                writer.write( os.str() ) ;
+            }
+
+            auto print = [ &parser, &writer, human ]( const Polynomial & f )
+            {
+                writer.write( f ) ;
+
+                if (parser.slowConfirm_ && human)
+                {
+                    writer.write( confirmWarning ) ;
+                    writer.write( static_cast<string>( f ) + " confirmed primitive!\n" ) ;
+                }
+
+                return true ;
+            } ;
+
+            if (parser.listAllPrimitivePolynomials_)
+                search.enumerate( print ) ;
+            else
+                print( search.findFirst() ) ;
+
+            writer.flush() ;
+
+            if (monitor)
+                monitor->finish( search.statistics() ) ;
+
+            if (parser.printOperationCount_)
+                printStatistics( console, search.statistics() ) ;
         }
 
+        if (trace)
+            trace->finish() ;
+
         return static_cast<int>( ReturnStatus::Success ) ;
     }
     // Catch all exceptions and report what happened to the user.
@@ -208,6 +429,16 @@ int main( int argc, const char * argv[] )
         cerr << "Internal math error in multiple precision arithmetic:  " << e.what() << endl << writeToAuthorMessage ;
         return static_cast<int>( ReturnStatus::InternalError ) ;
     }
+    catch ( DaemonError & e )
+    {
+        cerr << "Daemon error:  " << e.what() << endl ;
+        return static_cast<int>( ReturnStatus::InternalError ) ;
+    }
+    catch ( ArchiveError & e )
+    {
+        cerr << "Archive error:  " << e.what() << endl ;
+        return static_cast<int>( ReturnStatus::InternalError ) ;
+    }
     catch ( ArithModPException & e )
     {
         cerr << "Internal modulo p arithmetic error:  " << e.what() << endl << writeToAuthorMessage ;
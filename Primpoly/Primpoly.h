@@ -73,6 +73,9 @@
 // Modulo p arithmetic debugging:
 //     #define DEBUG_PP_ARITH
 //
+// Compile out the timeline trace points used by -T.  Same as cmake -DPP_TRACE=OFF.
+//     #define PP_NO_TRACE
+//
 // Forces one or more unit tests to fail and generate test error messages.
 // Default is to leave undefined.
 //
@@ -115,6 +118,18 @@
 static_assert( 8 * sizeof( ppuint ) >= 64 || 8 * sizeof( ppsint ) >= 64,
                "Error:  basic integer types ppuint and ppsint must be at least 64-bits.  Sorry, you'll have to run on a computer with a 64-bit CPU." ) ;
 
+// Double length unsigned integer type for multiple precision digit products, carries and
+// two digit by one digit divisions.  A ppuint digit times a ppuint digit plus two more ppuint
+// digits always fits.  GCC and Clang compile these to single mul, adc and div instructions.
+#if defined( __SIZEOF_INT128__ )
+    typedef unsigned __int128 ppuint2 ;
+#else
+    #error "Error:  BigInt needs the double length unsigned __int128 type.  Please compile with GCC or Clang."
+#endif
+
+static_assert( sizeof( ppuint2 ) == 2 * sizeof( ppuint ),
+               "Error:  double length integer type ppuint2 must be twice the length of ppuint." ) ;
+
 
 /*=============================================================================
  |
@@ -181,6 +196,9 @@ class PrimpolyError : public runtime_error
  |
  +============================================================================*/
 
+// The version in the legal notice times 100, e.g. for file headers.
+static const ppuint primpolyVersion = 1300 ;
+
 static const string legalNotice
 (
     "\n"
@@ -202,12 +220,69 @@ static const string helpText
      "\n"
      "        Primpoly -t ""<Polynomial to test>, p""\n"
      "          If you leave off the ,p we default to p = 2\n"
+     "          Modulo 2 you can also give a hex tap mask 0x13 or bit string 0b10011\n"
+     "          for x^4 + x + 1, and for any p a list of exponents with optional\n"
+     "          coefficients, (5 1:2 0), 3 for x^5 + 2 x + 1, 3\n"
      "\n"
      "        Primpoly -a p n\n"
      "          Same, but list all primitive polynomials of degree n mod p\n"
      "\n"
+     "        Primpoly -a -l p n,  Primpoly -a -j p n,  Primpoly -a -x 2 n\n"
+     "          Same, but one per line, as JSON Lines, or as hex tap masks 0x13 (p = 2 only),\n"
+     "          with everything else going to the standard error.  Without -a, just the first one.\n"
+     "\n"
      "        Primpoly -s p n\n"
-     "          Same, but print search statistics too.\n"
+     "          Same, but print search statistics too, with the latency of each stage of testing,\n"
+     "          and where the hardware allows, its cycles, instructions per cycle and cache and\n"
+     "          branch misses.\n"
+     "\n"
+     "        Primpoly -S p n\n"
+     "          Same, but print the statistics as one line of JSON, with the rate and progress.\n"
+     "\n"
+     "        Primpoly -a -m <Statistics file> p n\n"
+     "          Rewrite the statistics file every 10 seconds during the search, as Prometheus\n"
+     "          text, or as JSON if the name ends in .json.  Works with -w too;  with -g we\n"
+     "          write just the final statistics.\n"
+     "\n"
+     "        Primpoly -g -T <Trace file> p n\n"
+     "          Write a timeline of what each thread did, with each stage of testing, each shard\n"
+     "          and the time workers waited, as a Chrome trace for chrome://tracing or\n"
+     "          ui.perfetto.dev.  Works with the other options too.\n"
+     "\n"
+     "        Primpoly -b <File of polynomials to test>\n"
+     "          Test each polynomial in the file, one per line in any of the -t formats,\n"
+     "          and print one result per line.  Leave off the file to read the standard\n"
+     "          input.  The file can also hold packed binary polynomials, see ppBatch.h\n"
+     "\n"
+     "        Primpoly -g p n\n"
+     "          Count all primitive polynomials of degree n mod p by weight and by tap, and find\n"
+     "          the minimum weight ones, without listing them.  Uses every hardware thread.\n"
+     "\n"
+     "        Primpoly -e p n,  Primpoly --estimate p n\n"
+     "          Estimate the time to find the first and all primitive polynomials of degree n mod p,\n"
+     "          and the memory, searching in one thread, in parallel or to an archive, without\n"
+     "          searching.  Takes a few tenths of a second up to n = 1000 or so, and a few seconds\n"
+     "          for n in the thousands, including up to a second factoring p^n - 1 if there is no\n"
+     "          factor table for p.  With -S, print it as one line of JSON.\n"
+     "\n"
+     "        Primpoly -w <Archive file> p n\n"
+     "          Write all primitive polynomials of degree n mod p to a compact indexed archive.\n"
+     "\n"
+     "        Primpoly -r <Archive file> [<first> [<count>]]\n"
+     "          List the polynomials in an archive, from number first on, numbered from 0.\n"
+     "          -l, -j and -x work here too.\n"
+     "\n"
+     "        Primpoly -v <Archive file>\n"
+     "          Check that an archive is intact and all its polynomials are primitive.\n"
+     "\n"
+     "        Primpoly -d <Socket path>\n"
+     "          Answer queries on a Unix domain socket until interrupted.  Each query is\n"
+     "          one line:  <id> <deadline ms> test <polynomial> | first p n | count p n |\n"
+     "          enumerate p n <first> <count>\n"
+     "\n"
+     "        Primpoly -u\n"
+     "          Run the complete unit test, logging to unitTest.log.  Otherwise we run a quick\n"
+     "          smoke test every time, and the complete unit test once for each build.\n"
      "\n"
      "        Primpoly -h\n"
      "          Print this help message.\n"
@@ -0,0 +1,454 @@
+/*==============================================================================
+| 
+|  NAME
+|
+|     ppAggregate.cpp
+|
+|  DESCRIPTION
+|
+|     Streaming statistics of primitive polynomials:  histograms of weights
+|     and taps and the minimum weight polynomials, merged across shards.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|     
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+
+
+/*------------------------------------------------------------------------------
+|                                Includes                                      |
+------------------------------------------------------------------------------*/
+
+#include <cstdlib>      // abort()
+#include <iostream>     // Basic stream I/O.
+#include <iomanip>      // setw()
+#include <new>          // set_new_handler()
+#include <cmath>        // Basic math functions e.g. sqrt()
+#include <limits>       // Numeric limits.
+#include <complex>      // Complex data type and operations.
+#include <fstream>      // File stream I/O.
+#include <sstream>      // String stream I/O.
+#include <vector>       // STL vector class.
+#include <string>       // STL string class.
+#include <algorithm>    // Iterators.
+#include <stdexcept>    // Exceptions.
+#include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <functional>   // function
+#include <iterator>     // input_iterator_tag
+#include <cstddef>      // ptrdiff_t
+#include <thread>       // Worker threads.
+#include <mutex>        // mutex, lock_guard, unique_lock
+#include <condition_variable>  // Wake up idle workers.
+#include <future>       // packaged_task, future
+#include <queue>        // Task queue.
+#include <list>         // LRU order.
+#include <map>          // LRU index.
+#include <atomic>       // Trace enabled flag.
+
+using namespace std ;   // So we don't need to say std::vector everywhere.
+
+
+
+/*------------------------------------------------------------------------------
+|                                PP Include Files                              |
+------------------------------------------------------------------------------*/
+
+#include "Primpoly.h"       // Global functions.
+#include "ppArith.h"        // Basic arithmetic functions.
+#include "ppBigInt.h"       // Arbitrary precision integer arithmetic.
+#include "ppOperationCount.h"   // OperationCount collection for factoring and poly finding.
+#include "ppFactor.h"       // Prime factorization and Euler Phi.
+#include "ppPolynomial.h"   // Polynomial operations and mod polynomial operations.
+#include "ppSearch.h"       // Primitive polynomial search and test API.
+#include "ppParser.h"       // Parsing of polynomials and I/O services.
+#include "ppBatch.h"        // Thread pool and PolyOrder cache.
+#include "ppAggregate.h"    // Streaming statistics of polynomials.
+#include "ppTrace.h"        // Timeline tracing.
+
+
+// Number of nonzero coefficients of f.
+static int polynomialWeight( const Polynomial & f )
+{
+    int w = 0 ;
+    for (int i = 0 ;  i <= f.deg() ;  ++i)
+        if (f[ i ] != 0)
+            ++w ;
+
+    return w ;
+}
+
+// Does f come before g in search order?  Compare coefficients from the highest power of x down.
+static bool comesBefore( const Polynomial & f, const Polynomial & g )
+{
+    for (int i = f.deg() ;  i >= 0 ;  --i)
+        if (f[ i ] != g[ i ])
+            return f[ i ] < g[ i ] ;
+
+    return false ;
+}
+
+// Add the counts of b into a, growing a if need be.
+static void addCounts( vector< ppuint > & a, const vector< ppuint > & b )
+{
+    if (a.size() < b.size())
+        a.resize( b.size(), 0 ) ;
+
+    for (size_t i = 0 ;  i < b.size() ;  ++i)
+        a[ i ] += b[ i ] ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     operator << for PolynomialAggregator
+ |
+ | DESCRIPTION
+ |
+ |     Print the results of an aggregator in a box.
+ |
+ +============================================================================*/
+
+ostream & operator<<( ostream & out, const PolynomialAggregator & aggregator )
+{
+    out << "+--------- Statistics ------------------------------------\n" ;
+    aggregator.report( out ) ;
+    out << "|\n" ;
+    out << "+-----------------------------------------------------\n" ;
+
+    return out ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     WeightHistogram
+ |
+ | DESCRIPTION
+ |
+ |     Count polynomials by weight.
+ |
+ +============================================================================*/
+
+void WeightHistogram::add( const Polynomial & f )
+{
+    int w = polynomialWeight( f ) ;
+    if (count_.size() <= static_cast<size_t>( w ))
+        count_.resize( w + 1, 0 ) ;
+
+    ++count_[ w ] ;
+}
+
+void WeightHistogram::merge( const PolynomialAggregator & aggregator )
+{
+    addCounts( count_, dynamic_cast< const WeightHistogram & >( aggregator ).count_ ) ;
+}
+
+unique_ptr< PolynomialAggregator > WeightHistogram::emptyCopy() const
+{
+    return unique_ptr< PolynomialAggregator >( new WeightHistogram ) ;
+}
+
+ppuint WeightHistogram::count( int w ) const
+{
+    return w >= 0 && static_cast<size_t>( w ) < count_.size() ? count_[ w ] : 0 ;
+}
+
+void WeightHistogram::report( ostream & out ) const
+{
+    ppuint total = 0 ;
+    for (ppuint c : count_)
+        total += c ;
+
+    out << "|\n" ;
+    out << "| Number of polynomials :               " << total << endl ;
+    out << "| Trinomials :                          " << count( 3 ) << endl ;
+    out << "| Pentanomials :                        " << count( 5 ) << endl ;
+    out << "|\n" ;
+    out << "| Weight (nonzero coefficients) :       Number of polynomials\n" ;
+
+    for (size_t w = 0 ;  w < count_.size() ;  ++w)
+        if (count_[ w ] != 0)
+            out << "|     " << setw( 8 ) << w << "                          " << count_[ w ] << endl ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     TapHistogram
+ |
+ | DESCRIPTION
+ |
+ |     Count the nonzero coefficients of each power of x.
+ |
+ +============================================================================*/
+
+void TapHistogram::add( const Polynomial & f )
+{
+    if (count_.size() <= static_cast<size_t>( f.deg() ))
+        count_.resize( f.deg() + 1, 0 ) ;
+
+    for (int k = 0 ;  k <= f.deg() ;  ++k)
+        if (f[ k ] != 0)
+            ++count_[ k ] ;
+}
+
+void TapHistogram::merge( const PolynomialAggregator & aggregator )
+{
+    addCounts( count_, dynamic_cast< const TapHistogram & >( aggregator ).count_ ) ;
+}
+
+unique_ptr< PolynomialAggregator > TapHistogram::emptyCopy() const
+{
+    return unique_ptr< PolynomialAggregator >( new TapHistogram ) ;
+}
+
+ppuint TapHistogram::count( int k ) const
+{
+    return k >= 0 && static_cast<size_t>( k ) < count_.size() ? count_[ k ] : 0 ;
+}
+
+void TapHistogram::report( ostream & out ) const
+{
+    out << "|\n" ;
+    out << "| Power of x :                          Number with a nonzero coefficient\n" ;
+
+    for (size_t k = count_.size() ;  k-- > 0 ; )
+        out << "|     " << setw( 8 ) << k << "                          " << count_[ k ] << endl ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     MinimumWeight
+ |
+ | DESCRIPTION
+ |
+ |     Keep the least weight, its count and its first members.  Each search
+ |     adds polynomials in search order, so its members stay sorted;  merging
+ |     keeps the first ones of both.
+ |
+ +============================================================================*/
+
+void MinimumWeight::add( const Polynomial & f )
+{
+    int w = polynomialWeight( f ) ;
+
+    if (numMembers_ == 0 || w < weight_)
+    {
+        weight_     = w ;
+        numMembers_ = 0 ;
+        members_.clear() ;
+    }
+
+    if (w == weight_)
+    {
+        ++numMembers_ ;
+        if (members_.size() < maxMembers_)
+            members_.push_back( f ) ;
+    }
+}
+
+void MinimumWeight::merge( const PolynomialAggregator & aggregator )
+{
+    const MinimumWeight & other = dynamic_cast< const MinimumWeight & >( aggregator ) ;
+
+    if (other.numMembers_ == 0 || (numMembers_ != 0 && weight_ < other.weight_))
+        return ;
+
+    if (numMembers_ == 0 || other.weight_ < weight_)
+    {
+        weight_     = other.weight_ ;
+        numMembers_ = other.numMembers_ ;
+        members_.assign( other.members_.begin(), other.members_.begin() + min( maxMembers_, other.members_.size() ) ) ;
+        return ;
+    }
+
+    vector< Polynomial > members ;
+    std::merge( members_.begin(), members_.end(), other.members_.begin(), other.members_.end(),
+                back_inserter( members ), comesBefore ) ;
+
+    if (members.size() > maxMembers_)
+        members.resize( maxMembers_ ) ;
+
+    members_.swap( members ) ;
+    numMembers_ += other.numMembers_ ;
+}
+
+unique_ptr< PolynomialAggregator > MinimumWeight::emptyCopy() const
+{
+    return unique_ptr< PolynomialAggregator >( new MinimumWeight( maxMembers_ ) ) ;
+}
+
+void MinimumWeight::report( ostream & out ) const
+{
+    out << "|\n" ;
+    out << "| Minimum weight :                      " << weight_ << endl ;
+    out << "| Number of minimum weight :            " << numMembers_ << endl ;
+
+    if (!members_.empty())
+        out << "| First " << members_.size() << " of them :\n" ;
+
+    for (const Polynomial & f : members_)
+        out << "|     " << f << endl ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     AggregatorList
+ |
+ | DESCRIPTION
+ |
+ |     Pass each call on to every aggregator in the list.
+ |
+ +============================================================================*/
+
+void AggregatorList::push_back( unique_ptr< PolynomialAggregator > aggregator )
+{
+    aggregators_.push_back( std::move( aggregator ) ) ;
+}
+
+unique_ptr< AggregatorList > AggregatorList::standard()
+{
+    unique_ptr< AggregatorList > list( new AggregatorList ) ;
+    list->push_back( unique_ptr< PolynomialAggregator >( new WeightHistogram ) ) ;
+    list->push_back( unique_ptr< PolynomialAggregator >( new MinimumWeight ) ) ;
+    list->push_back( unique_ptr< PolynomialAggregator >( new TapHistogram ) ) ;
+
+    return list ;
+}
+
+void AggregatorList::add( const Polynomial & f )
+{
+    for (auto & aggregator : aggregators_)
+        aggregator->add( f ) ;
+}
+
+void AggregatorList::merge( const PolynomialAggregator & aggregator )
+{
+    const AggregatorList & other = dynamic_cast< const AggregatorList & >( aggregator ) ;
+
+    for (size_t i = 0 ;  i < aggregators_.size() && i < other.aggregators_.size() ;  ++i)
+        aggregators_[ i ]->merge( *other.aggregators_[ i ] ) ;
+}
+
+unique_ptr< PolynomialAggregator > AggregatorList::emptyCopy() const
+{
+    unique_ptr< AggregatorList > list( new AggregatorList ) ;
+    for (auto & aggregator : aggregators_)
+        list->push_back( aggregator->emptyCopy() ) ;
+
+    return unique_ptr< PolynomialAggregator >( list.release() ) ;
+}
+
+void AggregatorList::report( ostream & out ) const
+{
+    for (auto & aggregator : aggregators_)
+        aggregator->report( out ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     aggregate
+ |
+ | DESCRIPTION
+ |
+ |     Search the shards in parallel, starting each from the cached context,
+ |     then merge their aggregators and operation counts in shard order.
+ |
+ +============================================================================*/
+
+ppuint aggregate( ppuint p, int n, PolynomialAggregator & aggregator, ThreadPool & pool, PolyOrderCache & cache,
+                  OperationCount * statistics )
+{
+    shared_ptr< const PolyOrder > context = cache.context( p, n ) ;
+
+    int numShards = static_cast<int>( pool.size() ) ;
+    vector< unique_ptr< PolynomialAggregator > > shardAggregator ;
+    vector< OperationCount > shardStatistics( numShards ) ;
+    vector< ppuint > numFound( numShards, 0 ) ;
+    vector< future<void> > done ;
+
+    for (int shard = 0 ;  shard < numShards ;  ++shard)
+    {
+        shardAggregator.push_back( aggregator.emptyCopy() ) ;
+
+        SearchOptions options ;
+        options.shard      = shard ;
+        options.numShards  = numShards ;
+        options.aggregator = shardAggregator.back().get() ;
+
+        done.push_back( pool.submit( [=, &context, &shardStatistics, &numFound]()
+        {
+            PP_TRACE_SCOPE_ARG( "shard", "work", shard ) ;
+            PrimitivePolynomialSearch search( p, n, *context, options ) ;
+
+            Polynomial f ;
+            while (search.next( f ))
+                ++numFound[ shard ] ;
+
+            shardStatistics[ shard ] = search.statistics() ;
+        } ) ) ;
+    }
+
+    // Wait for all the shards before we rethrow the first error, since they use our locals.
+    for (auto & shard : done)
+        shard.wait() ;
+
+    for (auto & shard : done)
+        shard.get() ;
+
+    ppuint numPrimitivePoly = 0 ;
+    for (int shard = 0 ;  shard < numShards ;  ++shard)
+    {
+        aggregator.merge( *shardAggregator[ shard ] ) ;
+        numPrimitivePoly += numFound[ shard ] ;
+
+        if (statistics != nullptr)
+            *statistics += shardStatistics[ shard ] ;
+    }
+
+    return numPrimitivePoly ;
+}
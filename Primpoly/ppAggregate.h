@@ -0,0 +1,247 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppAggregate.h
+|
+|  DESCRIPTION
+|
+|     Header file for streaming statistics of primitive polynomials, gathered
+|     as the search finds them instead of from a listing.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with the !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+// Wrap this header file to prevent duplication if it is included
+// accidentally more than once.
+#ifndef __PP_AGGREGATE_H__
+#define __PP_AGGREGATE_H__
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PolynomialAggregator
+|
+| DESCRIPTION
+|
+|     Base class for statistics of a stream of polynomials which take O( n )
+|     space no matter how many polynomials there are.  Give one to a search
+|     in its SearchOptions and the search adds each primitive polynomial as
+|     soon as it finds it.
+|
+|     Searches in different threads or shards each get their own empty copy,
+|     and we merge the copies at the end.  Merging gives the same result in
+|     any order.
+|
+| EXAMPLE
+|
+|     WeightHistogram weights ;
+|     SearchOptions options ;
+|     options.aggregator = &weights ;
+|     enumerate( 2, 16, []( const Polynomial & ) { return true ; }, options ) ;
+|     cout << weights ;
+|
++============================================================================*/
+
+class PolynomialAggregator
+{
+    public:
+        virtual ~PolynomialAggregator() {} ;
+
+        // Count one more polynomial.
+        virtual void add( const Polynomial & f ) = 0 ;
+
+        // Fold in the counts of another aggregator of the same kind.
+        virtual void merge( const PolynomialAggregator & aggregator ) = 0 ;
+
+        // A new aggregator of the same kind with nothing in it.
+        virtual unique_ptr< PolynomialAggregator > emptyCopy() const = 0 ;
+
+        // Write the results as lines starting with "| ", like the OperationCount report.
+        virtual void report( ostream & out ) const = 0 ;
+
+        friend ostream & operator<<( ostream & out, const PolynomialAggregator & aggregator ) ;
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     WeightHistogram
+|
+| DESCRIPTION
+|
+|     Number of polynomials by weight, the number of nonzero coefficients.
+|     Weight 3 are the trinomials and weight 5 the pentanomials.
+|
++============================================================================*/
+
+class WeightHistogram : public PolynomialAggregator
+{
+    public:
+        WeightHistogram() : count_() {} ;
+
+        void add( const Polynomial & f ) ;
+        void merge( const PolynomialAggregator & aggregator ) ;
+        unique_ptr< PolynomialAggregator > emptyCopy() const ;
+        void report( ostream & out ) const ;
+
+        // Number of polynomials of weight w.
+        ppuint count( int w ) const ;
+
+    private:
+        vector< ppuint > count_ ;   // Indexed by weight.
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     TapHistogram
+|
+| DESCRIPTION
+|
+|                                                                 k
+|     For each k, the number of polynomials with a nonzero x  term, the
+|     taps of the corresponding linear feedback shift register.
+|
++============================================================================*/
+
+class TapHistogram : public PolynomialAggregator
+{
+    public:
+        TapHistogram() : count_() {} ;
+
+        void add( const Polynomial & f ) ;
+        void merge( const PolynomialAggregator & aggregator ) ;
+        unique_ptr< PolynomialAggregator > emptyCopy() const ;
+        void report( ostream & out ) const ;
+
+        // Number of polynomials with a nonzero coefficient of x ^ k.
+        ppuint count( int k ) const ;
+
+    private:
+        vector< ppuint > count_ ;   // Indexed by power of x.
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     MinimumWeight
+|
+| DESCRIPTION
+|
+|     The least weight of any polynomial, how many have it, and the first
+|     maxMembers of them in search order.
+|
++============================================================================*/
+
+class MinimumWeight : public PolynomialAggregator
+{
+    public:
+        explicit MinimumWeight( size_t maxMembers = 10 )
+            : maxMembers_( maxMembers )
+            , weight_( 0 )
+            , numMembers_( 0 )
+            , members_()
+        {
+        } ;
+
+        void add( const Polynomial & f ) ;
+        void merge( const PolynomialAggregator & aggregator ) ;
+        unique_ptr< PolynomialAggregator > emptyCopy() const ;
+        void report( ostream & out ) const ;
+
+        // Zero if we haven't seen any polynomials.
+        inline int weight() const { return weight_ ; } ;
+        inline ppuint numMembers() const { return numMembers_ ; } ;
+        inline const vector< Polynomial > & members() const { return members_ ; } ;
+
+    private:
+        size_t               maxMembers_ ;
+        int                  weight_ ;
+        ppuint               numMembers_ ;
+        vector< Polynomial > members_ ;     // In search order.
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     AggregatorList
+|
+| DESCRIPTION
+|
+|     Several aggregators fed the same polynomials, reported in order inside
+|     one box.
+|
+| EXAMPLE
+|
+|     AggregatorList statistics ;
+|     statistics.push_back( unique_ptr< PolynomialAggregator >( new WeightHistogram ) ) ;
+|     statistics.push_back( unique_ptr< PolynomialAggregator >( new MinimumWeight ) ) ;
+|
++============================================================================*/
+
+class AggregatorList : public PolynomialAggregator
+{
+    public:
+        AggregatorList() : aggregators_() {} ;
+
+        void push_back( unique_ptr< PolynomialAggregator > aggregator ) ;
+
+        // The weight, tap and minimum weight statistics.
+        static unique_ptr< AggregatorList > standard() ;
+
+        void add( const Polynomial & f ) ;
+        void merge( const PolynomialAggregator & aggregator ) ;
+        unique_ptr< PolynomialAggregator > emptyCopy() const ;
+        void report( ostream & out ) const ;
+
+    private:
+        vector< unique_ptr< PolynomialAggregator > > aggregators_ ;
+} ;
+
+
+// Add all the primitive polynomials of degree n modulo p to aggregator, searching one shard
+// on each thread of the pool, each with an empty copy of aggregator, then merging them.
+// Return the number of primitive polynomials.  If statistics is not null, return the operation
+// counts of all the shards there.
+ppuint aggregate( ppuint p, int n, PolynomialAggregator & aggregator, ThreadPool & pool, PolyOrderCache & cache,
+                  OperationCount * statistics = nullptr ) ;
+
+#endif // __PP_AGGREGATE_H__ -- End of wrapper for header file.
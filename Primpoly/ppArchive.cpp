@@ -0,0 +1,809 @@
+/*==============================================================================
+| 
+|  NAME
+|
+|     ppArchive.cpp
+|
+|  DESCRIPTION
+|
+|     Write, read and verify compact indexed archives of primitive polynomials.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|     
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+
+
+/*------------------------------------------------------------------------------
+|                                Includes                                      |
+------------------------------------------------------------------------------*/
+
+#include <cstdlib>      // abort()
+#include <iostream>     // Basic stream I/O.
+#include <new>          // set_new_handler()
+#include <cmath>        // Basic math functions e.g. sqrt()
+#include <limits>       // Numeric limits.
+#include <complex>      // Complex data type and operations.
+#include <fstream>      // File stream I/O.
+#include <sstream>      // String stream I/O.
+#include <vector>       // STL vector class.
+#include <string>       // STL string class.
+#include <algorithm>    // Iterators.
+#include <stdexcept>    // Exceptions.
+#include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <functional>   // function
+#include <iterator>     // input_iterator_tag
+#include <cstddef>      // ptrdiff_t
+#include <thread>       // Worker threads.
+#include <mutex>        // mutex, lock_guard, unique_lock
+#include <condition_variable>  // Wake up idle workers.
+#include <future>       // packaged_task, future
+#include <queue>        // Task queue.
+#include <list>         // LRU order.
+#include <map>          // LRU index.
+#include <atomic>       // Trace enabled flag.
+#include <cstring>      // memcmp()
+
+using namespace std ;   // So we don't need to say std::vector everywhere.
+
+
+
+/*------------------------------------------------------------------------------
+|                                PP Include Files                              |
+------------------------------------------------------------------------------*/
+
+#include "Primpoly.h"       // Global functions.
+#include "ppArith.h"        // Basic arithmetic functions.
+#include "ppBigInt.h"       // Arbitrary precision integer arithmetic.
+#include "ppOperationCount.h"   // OperationCount collection for factoring and poly finding.
+#include "ppFactor.h"       // Prime factorization and Euler Phi.
+#include "ppPolynomial.h"   // Polynomial operations and mod polynomial operations.
+#include "ppParser.h"       // Parsing of polynomials and I/O services.
+#include "ppBatch.h"        // Thread pool and memory mapped files.
+#include "ppArchive.h"      // Polynomial archives.
+#include "ppTrace.h"        // Timeline tracing.
+
+
+/*------------------------------------------------------------------------------
+|                                Encoding                                      |
+------------------------------------------------------------------------------*/
+
+static const char   archiveSignature[] = "PPA1" ;
+static const size_t archiveHeaderSize  = 40 ;
+
+// Least b with p <= 2 ^ b, so b bits hold any coefficient 0 ... p-1.
+static int bitsPerCoefficient( ppuint p )
+{
+    int b = 1 ;
+    while ((static_cast<ppuint>( 1u ) << b) < p)
+        ++b ;
+
+    return b ;
+}
+
+// Little endian unsigned integer of numBytes bytes.
+static ppuint readLittleEndian( const unsigned char * bytes, int numBytes )
+{
+    ppuint value = 0 ;
+    for (int i = numBytes - 1 ;  i >= 0 ;  --i)
+        value = (value << 8) | bytes[ i ] ;
+
+    return value ;
+}
+
+static void writeLittleEndian( ostream & out, ppuint value, int numBytes )
+{
+    for (int i = 0 ;  i < numBytes ;  ++i, value >>= 8)
+        out.put( static_cast<char>( value & 0xFF ) ) ;
+}
+
+// Compare coefficients a    ... a  of two polynomials lexicographically:  -1, 0 or 1 for a < b, a == b, a > b.
+//                       n-1      0
+static int compareCoefficients( const vector< ppuint > & a, const vector< ppuint > & b )
+{
+    for (size_t i = a.size() ;  i-- > 0 ; )
+        if (a[ i ] != b[ i ])
+            return a[ i ] < b[ i ] ? -1 : 1 ;
+
+    return 0 ;
+}
+
+// Difference b - a of coefficients as base p numbers, for b > a.  Return false if it doesn't fit in a ppuint.
+static bool difference( const vector< ppuint > & b, const vector< ppuint > & a, ppuint p, ppuint & delta )
+{
+    vector< ppuint > digit( b.size() ) ;
+    ppuint borrow = 0 ;
+    for (size_t i = 0 ;  i < b.size() ;  ++i)
+    {
+        ppuint subtrahend = a[ i ] + borrow ;
+        borrow   = b[ i ] < subtrahend ? 1 : 0 ;
+        digit[ i ] = b[ i ] + borrow * p - subtrahend ;
+    }
+
+    delta = 0 ;
+    for (size_t i = digit.size() ;  i-- > 0 ; )
+    {
+        ppuint2 next = static_cast<ppuint2>( delta ) * p + digit[ i ] ;
+        if (next > numeric_limits< ppuint >::max())
+            return false ;
+
+        delta = static_cast<ppuint>( next ) ;
+    }
+
+    return true ;
+}
+
+// Add delta to coefficients as a base p number.  Return false if the sum has more than n digits.
+static bool add( vector< ppuint > & coeff, ppuint delta, ppuint p )
+{
+    ppuint2 carry = delta ;
+    for (size_t i = 0 ;  i < coeff.size() && carry != 0 ;  ++i)
+    {
+        ppuint2 sum = coeff[ i ] + carry ;
+        coeff[ i ] = static_cast<ppuint>( sum % p ) ;
+        carry      = sum / p ;
+    }
+
+    return carry == 0 ;
+}
+
+// Pack the coefficients into bitsPerCoeff bits each, lowest bit first.
+static void writeRecord( ostream & out, const vector< ppuint > & coeff, int bitsPerCoeff, size_t recordSize )
+{
+    vector<char> record( recordSize, 0 ) ;
+    size_t bit = 0 ;
+    for (ppuint c : coeff)
+        for (int k = 0 ;  k < bitsPerCoeff ;  ++k, ++bit)
+            if ((c >> k) & 1)
+                record[ bit >> 3 ] |= static_cast<char>( 1 << (bit & 7) ) ;
+
+    out.write( record.data(), record.size() ) ;
+}
+
+// Write 7 bits a byte, lowest first, with the high bit set on all but the last byte.
+static size_t writeVarint( ostream & out, ppuint value )
+{
+    size_t numBytes = 1 ;
+    for ( ;  value >= 0x80 ;  value >>= 7, ++numBytes)
+        out.put( static_cast<char>( (value & 0x7F) | 0x80 ) ) ;
+
+    out.put( static_cast<char>( value ) ) ;
+
+    return numBytes ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialArchiveWriter
+ |
+ | DESCRIPTION
+ |
+ |     Create the file and leave room for the header.
+ |
+ +============================================================================*/
+
+PolynomialArchiveWriter::PolynomialArchiveWriter( const string & fileName, ppuint p, int n, ppuint blockSize )
+    : fileName_( fileName )
+    , out_()
+    , p_( p )
+    , n_( n )
+    , blockSize_( blockSize )
+    , count_( 0 )
+    , offset_( archiveHeaderSize )
+    , blockOffset_()
+    , last_( n > 0 ? n : 0 )
+    , finished_( false )
+{
+    if (p < minModulus || p >= maxModulus || n < 1 || blockSize < 1 || blockSize > 0xFFFFFFFFu)
+    {
+        ostringstream os ;
+        os << "Error:  can't archive polynomials of degree " << n << " modulo " << p << " in blocks of " << blockSize
+           << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw ArchiveError( os.str() ) ;
+    }
+
+    out_.open( fileName_, ios::binary | ios::trunc ) ;
+    if (!out_)
+    {
+        ostringstream os ;
+        os << "Error:  can't create archive file " << fileName_ << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw ArchiveError( os.str() ) ;
+    }
+
+    // Placeholder for the header.
+    out_.write( string( archiveHeaderSize, '\0' ).data(), archiveHeaderSize ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     ~PolynomialArchiveWriter
+ |
+ | DESCRIPTION
+ |
+ |     Finish the archive if the caller didn't.  We can't throw from here, so
+ |     call finish() to find out about errors.
+ |
+ +============================================================================*/
+
+PolynomialArchiveWriter::~PolynomialArchiveWriter()
+{
+    try
+    {
+        finish() ;
+    }
+    catch( ... )
+    {
+    }
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialArchiveWriter::write
+ |
+ | DESCRIPTION
+ |
+ |     Append f as a record if it starts a block, otherwise as its difference
+ |     from the last polynomial.
+ |
+ +============================================================================*/
+
+void PolynomialArchiveWriter::write( const Polynomial & f )
+{
+    if (finished_ || f.deg() != n_ || f.modulus() != p_ || f[ n_ ] != 1)
+    {
+        ostringstream os ;
+        os << "Error:  can't archive " << f << " with monic polynomials of degree " << n_ << " modulo " << p_
+           << (finished_ ? " after finishing the archive" : "")
+           << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw ArchiveError( os.str() ) ;
+    }
+
+    vector< ppuint > coeff( n_ ) ;
+    for (int i = 0 ;  i < n_ ;  ++i)
+        coeff[ i ] = f[ i ] ;
+
+    if (count_ > 0 && compareCoefficients( coeff, last_ ) <= 0)
+    {
+        ostringstream os ;
+        os << "Error:  can't archive " << f << " because it doesn't come after the last polynomial"
+           << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw ArchiveError( os.str() ) ;
+    }
+
+    int    bitsPerCoeff = bitsPerCoefficient( p_ ) ;
+    size_t recordSize   = (static_cast<size_t>( n_ ) * bitsPerCoeff + 7) / 8 ;
+
+    ppuint delta = 0 ;
+    if (count_ % blockSize_ == 0)
+    {
+        blockOffset_.push_back( offset_ ) ;
+        writeRecord( out_, coeff, bitsPerCoeff, recordSize ) ;
+        offset_ += recordSize ;
+    }
+    else if (difference( coeff, last_, p_, delta ))
+        offset_ += writeVarint( out_, delta ) ;
+    else
+    {
+        // Too far apart:  escape, then the record.
+        out_.put( 0 ) ;
+        writeRecord( out_, coeff, bitsPerCoeff, recordSize ) ;
+        offset_ += 1 + recordSize ;
+    }
+
+    last_ = coeff ;
+    ++count_ ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialArchiveWriter::finish
+ |
+ | DESCRIPTION
+ |
+ |     Append the block index, then go back and fill in the header.
+ |
+ +============================================================================*/
+
+void PolynomialArchiveWriter::finish()
+{
+    if (finished_)
+        return ;
+
+    finished_ = true ;
+
+    for (ppuint offset : blockOffset_)
+        writeLittleEndian( out_, offset, 8 ) ;
+
+    out_.seekp( 0 ) ;
+    out_.write( archiveSignature, 4 ) ;
+    writeLittleEndian( out_, primpolyVersion, 4 ) ;
+    writeLittleEndian( out_, p_, 8 ) ;
+    writeLittleEndian( out_, static_cast<ppuint>( n_ ), 4 ) ;
+    writeLittleEndian( out_, blockSize_, 4 ) ;
+    writeLittleEndian( out_, count_, 8 ) ;
+    writeLittleEndian( out_, offset_, 8 ) ;
+
+    out_.close() ;
+    if (!out_)
+    {
+        ostringstream os ;
+        os << "Error:  can't write archive file " << fileName_ << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw ArchiveError( os.str() ) ;
+    }
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialArchive
+ |
+ | DESCRIPTION
+ |
+ |     Read and check the header, and find the index.
+ |
+ +============================================================================*/
+
+PolynomialArchive::PolynomialArchive( const char * first, const char * last )
+    : first_( reinterpret_cast<const unsigned char *>( first ) )
+    , index_( nullptr )
+    , p_( 0 )
+    , n_( 0 )
+    , blockSize_( 0 )
+    , count_( 0 )
+    , numBlocks_( 0 )
+    , version_( 0 )
+    , bitsPerCoeff_( 0 )
+    , recordSize_( 0 )
+{
+    if (!isArchive( first, last ) || static_cast<size_t>( last - first ) < archiveHeaderSize)
+        throw ArchiveError( "Error:  archive doesn't start with the PPA1 header" ) ;
+
+    ppuint n           = readLittleEndian( first_ + 16, 4 ) ;
+    ppuint indexOffset = readLittleEndian( first_ + 32, 8 ) ;
+    version_   = readLittleEndian( first_ + 4,  4 ) ;
+    p_         = readLittleEndian( first_ + 8,  8 ) ;
+    blockSize_ = readLittleEndian( first_ + 20, 4 ) ;
+    count_     = readLittleEndian( first_ + 24, 8 ) ;
+
+    if (p_ < minModulus || p_ >= maxModulus || n < 1 || n > static_cast<ppuint>( numeric_limits<int>::max() - 1 ) ||
+        blockSize_ < 1)
+    {
+        ostringstream os ;
+        os << "Error:  archive has p = " << p_ << ", n = " << n << " and " << blockSize_ << " polynomials per block"
+           << " but needs 2 <= p < " << maxModulus << ", n >= 1 and at least 1" ;
+        throw ArchiveError( os.str() ) ;
+    }
+
+    n_            = static_cast<int>( n ) ;
+    bitsPerCoeff_ = bitsPerCoefficient( p_ ) ;
+    recordSize_   = (static_cast<size_t>( n_ ) * bitsPerCoeff_ + 7) / 8 ;
+    numBlocks_    = count_ / blockSize_ + (count_ % blockSize_ != 0 ? 1 : 0) ;
+
+    size_t size = static_cast<size_t>( last - first ) ;
+    if (indexOffset < archiveHeaderSize || indexOffset > size || (size - indexOffset) / 8 != numBlocks_ ||
+        (size - indexOffset) % 8 != 0)
+    {
+        ostringstream os ;
+        os << "Error:  archive of " << count_ << " polynomials in " << numBlocks_ << " blocks has its index at offset "
+           << indexOffset << " but is " << size << " bytes long" ;
+        throw ArchiveError( os.str() ) ;
+    }
+
+    index_ = first_ + indexOffset ;
+}
+
+
+bool PolynomialArchive::isArchive( const char * first, const char * last )
+{
+    return last - first >= 4 && memcmp( first, archiveSignature, 4 ) == 0 ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialArchive::blockBegin, blockEnd, blockLength
+ |
+ | DESCRIPTION
+ |
+ |     Find block i from the index.  Blocks must lie in order between the
+ |     header and the index.
+ |
+ +============================================================================*/
+
+const unsigned char * PolynomialArchive::blockBegin( ppuint i ) const
+{
+    ppuint offset = readLittleEndian( index_ + 8 * i, 8 ) ;
+    ppuint limit  = i + 1 < numBlocks_ ? readLittleEndian( index_ + 8 * (i + 1), 8 )
+                                       : static_cast<ppuint>( index_ - first_ ) ;
+
+    if (offset < archiveHeaderSize || offset >= limit)
+    {
+        ostringstream os ;
+        os << "Error:  archive block " << i << " is at offset " << offset << " but should be between "
+           << archiveHeaderSize << " and " << limit ;
+        throw ArchiveError( os.str() ) ;
+    }
+
+    return first_ + offset ;
+}
+
+const unsigned char * PolynomialArchive::blockEnd( ppuint i ) const
+{
+    return i + 1 < numBlocks_ ? blockBegin( i + 1 ) : index_ ;
+}
+
+ppuint PolynomialArchive::blockLength( ppuint i ) const
+{
+    return i + 1 < numBlocks_ ? blockSize_ : count_ - i * blockSize_ ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialArchive::decode
+ |
+ | DESCRIPTION
+ |
+ |     Decode one polynomial:  a record, a difference, or an escape and a record.
+ |
+ +============================================================================*/
+
+const unsigned char * PolynomialArchive::decode( const unsigned char * pos, const unsigned char * end,
+                                                 bool startOfBlock, vector< ppuint > & coeff ) const
+{
+    ppuint delta = 0 ;
+    if (!startOfBlock)
+    {
+        // Gather the difference 7 bits at a time.
+        int shift = 0 ;
+        for (bool more = true ;  more ;  shift += 7)
+        {
+            if (pos == end || shift > 63 || (shift == 63 && (*pos & 0x7E) != 0))
+                throw ArchiveError( "Error:  archive has a difference which is too long or runs past the end of its block" ) ;
+
+            delta |= static_cast<ppuint>( *pos & 0x7F ) << shift ;
+            more   = (*pos++ & 0x80) != 0 ;
+        }
+
+        // A zero difference is the escape before a record.
+        if (delta != 0)
+        {
+            if (!add( coeff, delta, p_ ))
+                throw ArchiveError( "Error:  archive has a difference which takes a polynomial past the last one of degree n" ) ;
+
+            return pos ;
+        }
+    }
+
+    if (static_cast<size_t>( end - pos ) < recordSize_)
+        throw ArchiveError( "Error:  archive has a record which runs past the end of its block" ) ;
+
+    size_t bit = 0 ;
+    for (int j = 0 ;  j < n_ ;  ++j)
+    {
+        // Gather the coefficient's bits a byte at a time.
+        ppuint c = 0 ;
+        for (int k = 0 ;  k < bitsPerCoeff_ ; )
+        {
+            int shift = static_cast<int>( bit & 7 ) ;
+            int take  = min( 8 - shift, bitsPerCoeff_ - k ) ;
+            c |= static_cast<ppuint>( (pos[ bit >> 3 ] >> shift) & ((1u << take) - 1) ) << k ;
+            k   += take ;
+            bit += take ;
+        }
+
+        if (c >= p_)
+        {
+            ostringstream os ;
+            os << "Error:  archive has coefficient " << c << " of x ^ " << j << " which isn't less than p = " << p_ ;
+            throw ArchiveError( os.str() ) ;
+        }
+
+        coeff[ j ] = c ;
+    }
+
+    return pos + recordSize_ ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialArchive::polynomial
+ |
+ | DESCRIPTION
+ |
+ |     The monic polynomial with coefficients a    ... a .
+ |                                              n-1      0
+ |
+ +============================================================================*/
+
+Polynomial PolynomialArchive::polynomial( const vector< ppuint > & coeff ) const
+{
+    vector< ppuint > c( coeff ) ;
+    c.push_back( 1 ) ;
+
+    Polynomial f( c ) ;
+    f.setModulus( p_ ) ;
+
+    return f ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialArchive::select
+ |
+ | DESCRIPTION
+ |
+ |     Decode from the start of the block up to polynomial k.
+ |
+ +============================================================================*/
+
+Polynomial PolynomialArchive::select( ppuint k ) const
+{
+    if (k >= count_)
+    {
+        ostringstream os ;
+        os << "Error:  no polynomial of rank " << k << " in an archive of " << count_ ;
+        throw ArchiveError( os.str() ) ;
+    }
+
+    ppuint i = k / blockSize_ ;
+    const unsigned char * pos = blockBegin( i ) ;
+    const unsigned char * end = blockEnd( i ) ;
+
+    vector< ppuint > coeff( n_ ) ;
+    pos = decode( pos, end, true, coeff ) ;
+    for (ppuint j = 0 ;  j < k % blockSize_ ;  ++j)
+        pos = decode( pos, end, false, coeff ) ;
+
+    return polynomial( coeff ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialArchive::rank
+ |
+ | DESCRIPTION
+ |
+ |     Binary search the first polynomials of the blocks for the last block
+ |     which starts at or before f, then count within that block.
+ |
+ +============================================================================*/
+
+ppuint PolynomialArchive::rank( const Polynomial & f ) const
+{
+    if (f.deg() != n_ || f.modulus() != p_)
+    {
+        ostringstream os ;
+        os << "Error:  can't look up " << f << " in an archive of polynomials of degree " << n_ << " modulo " << p_ ;
+        throw ArchiveError( os.str() ) ;
+    }
+
+    vector< ppuint > target( n_ ), coeff( n_ ) ;
+    for (int i = 0 ;  i < n_ ;  ++i)
+        target[ i ] = f[ i ] ;
+
+    // Blocks [0, low) start at or before f and blocks [high, numBlocks) start after it.
+    ppuint low = 0, high = numBlocks_ ;
+    while (low < high)
+    {
+        ppuint mid = low + (high - low) / 2 ;
+        decode( blockBegin( mid ), blockEnd( mid ), true, coeff ) ;
+
+        if (compareCoefficients( coeff, target ) <= 0)
+            low = mid + 1 ;
+        else
+            high = mid ;
+    }
+
+    if (low == 0)
+        return 0 ;
+
+    ppuint i = low - 1 ;
+    const unsigned char * pos = blockBegin( i ) ;
+    const unsigned char * end = blockEnd( i ) ;
+
+    ppuint j = 0 ;
+    for ( ;  j < blockLength( i ) ;  ++j)
+    {
+        pos = decode( pos, end, j == 0, coeff ) ;
+        if (compareCoefficients( coeff, target ) >= 0)
+            break ;
+    }
+
+    return i * blockSize_ + j ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialArchive::scan
+ |
+ | DESCRIPTION
+ |
+ |     Decode from polynomial k on, block by block.
+ |
+ +============================================================================*/
+
+void PolynomialArchive::scan( ppuint k, const function< bool( const Polynomial & ) > & found ) const
+{
+    vector< ppuint > coeff( n_ ) ;
+
+    for (ppuint i = k / blockSize_ ;  i < numBlocks_ ;  ++i)
+    {
+        const unsigned char * pos = blockBegin( i ) ;
+        const unsigned char * end = blockEnd( i ) ;
+
+        for (ppuint j = 0 ;  j < blockLength( i ) ;  ++j)
+        {
+            pos = decode( pos, end, j == 0, coeff ) ;
+            if (i * blockSize_ + j >= k && !found( polynomial( coeff ) ))
+                return ;
+        }
+    }
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialArchive::verify
+ |
+ | DESCRIPTION
+ |
+ |     Each thread checks a slice of the blocks:  every block decodes to
+ |     exactly its length, ends where the next one begins, and its
+ |     polynomials are in increasing order, including the first one against
+ |     the last one of the block before.  All threads test primitivity from
+ |     a copy of the same PolyOrder context, so we factor r only once.
+ |
+ +============================================================================*/
+
+void PolynomialArchive::verify( ThreadPool & pool, bool testPrimitivity ) const
+{
+    if (numBlocks_ == 0)
+        return ;
+
+    unique_ptr< PolyOrder > context ;
+    if (testPrimitivity)
+        context = unique_ptr< PolyOrder >( new PolyOrder( select( 0 ) ) ) ;
+
+    ppuint numSlices = min( static_cast<ppuint>( pool.size() ), numBlocks_ ) ;
+    vector< future<void> > done ;
+
+    for (ppuint slice = 0 ;  slice < numSlices ;  ++slice)
+    {
+        ppuint firstBlock = numBlocks_ * slice       / numSlices ;
+        ppuint lastBlock  = numBlocks_ * (slice + 1) / numSlices ;
+
+        done.push_back( pool.submit( [this, firstBlock, lastBlock, &context]()
+        {
+            PP_TRACE_SCOPE_ARG( "verify blocks", "work", firstBlock ) ;
+            unique_ptr< PolyOrder > order ;
+            if (context)
+                order = unique_ptr< PolyOrder >( new PolyOrder( *context ) ) ;
+
+            // Start from the last polynomial of the block before ours.
+            vector< ppuint > coeff( n_ ), previous( n_ ) ;
+            if (firstBlock > 0)
+            {
+                Polynomial last = select( firstBlock * blockSize_ - 1 ) ;
+                for (int j = 0 ;  j < n_ ;  ++j)
+                    previous[ j ] = last[ j ] ;
+            }
+
+            for (ppuint i = firstBlock ;  i < lastBlock ;  ++i)
+            {
+                const unsigned char * pos = blockBegin( i ) ;
+                const unsigned char * end = blockEnd( i ) ;
+
+                for (ppuint j = 0 ;  j < blockLength( i ) ;  ++j)
+                {
+                    pos = decode( pos, end, j == 0, coeff ) ;
+
+                    ppuint k = i * blockSize_ + j ;
+                    if (k > 0 && compareCoefficients( coeff, previous ) <= 0)
+                    {
+                        ostringstream os ;
+                        os << "Error:  archive polynomial " << polynomial( coeff ) << " of rank " << k
+                           << " doesn't come after the one before it" ;
+                        throw ArchiveError( os.str() ) ;
+                    }
+
+                    if (order)
+                    {
+                        order->newPolynomial( polynomial( coeff ) ) ;
+                        if (!order->isPrimitive())
+                        {
+                            ostringstream os ;
+                            os << "Error:  archive polynomial " << polynomial( coeff ) << " of rank " << k
+                               << " isn't primitive" ;
+                            throw ArchiveError( os.str() ) ;
+                        }
+                    }
+
+                    previous = coeff ;
+                }
+
+                if (pos != end)
+                {
+                    ostringstream os ;
+                    os << "Error:  archive block " << i << " has " << (end - pos) << " bytes left over after its "
+                       << blockLength( i ) << " polynomials" ;
+                    throw ArchiveError( os.str() ) ;
+                }
+            }
+        } ) ) ;
+    }
+
+    // Wait for all the slices before we rethrow the first problem, since they use our context.
+    for (auto & slice : done)
+        slice.wait() ;
+
+    for (auto & slice : done)
+        slice.get() ;
+}
@@ -0,0 +1,256 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppArchive.h
+|
+|  DESCRIPTION
+|
+|     Header file for compact indexed archives of primitive polynomial lists.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with the !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+// Wrap this header file to prevent duplication if it is included
+// accidentally more than once.
+#ifndef __PP_ARCHIVE_H__
+#define __PP_ARCHIVE_H__
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     ArchiveError
+|
+| DESCRIPTION
+|
+|     Exception class for archives which can't be written, read, or which fail
+|     verification, derived from the STL exception class runtime_error.
+|
++============================================================================*/
+
+class ArchiveError : public runtime_error
+{
+    public:
+        // Throw with an error message.
+        ArchiveError( const string & description )
+            : runtime_error( description )
+        {
+        } ;
+
+        // Throw with default error message.
+        ArchiveError()
+            : runtime_error( "Archive error:  " )
+        {
+        } ;
+
+} ; // end class ArchiveError
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     Polynomial archive format
+|
+| DESCRIPTION
+|
+|     A list of distinct monic polynomials of degree n modulo p, e.g. all the
+|     primitive ones, in lexicographic order of their coefficients
+|     a    ... a , which is the order PrimitivePolynomialSearch finds them.
+|      n-1      0
+|     The rank of f is the number of polynomials in the list before it.
+|     All numbers are little endian.
+|
+|         Header, 40 bytes:
+|
+|             bytes 0-3     PPA1
+|             bytes 4-7     Version of Primpoly which wrote the archive, times 100.
+|             bytes 8-15    p
+|             bytes 16-19   n
+|             bytes 20-23   Number of polynomials per block, B.
+|             bytes 24-31   Number of polynomials.
+|             bytes 32-39   Offset of the block index.
+|
+|         Blocks of B polynomials, the last one maybe shorter.  The first
+|         polynomial of a block is a record of the coefficients a0 ... a
+|                                                                      n-1
+|         in b bits each, where b is the least with p <= 2 ^ b, lowest bit
+|         first, padded with zero bits to a whole number of bytes.  Each of
+|         the rest is the difference between it and the one before, taking
+|         the coefficients as the digits of a base p number, written 7 bits a
+|         byte, lowest first, with the high bit set on all but the last byte.
+|         A difference of 2 ^ 64 or more is written as a zero byte followed by
+|         the record.
+|
+|         Block index:  one 8 byte file offset for each block.
+|
+|     Differences between primitive polynomials are small, so a polynomial
+|     takes about 2 bytes no matter what its degree.  To find polynomial k,
+|     look up its block in the index and decode at most B - 1 differences.
+|
++============================================================================*/
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PolynomialArchiveWriter
+|
+| DESCRIPTION
+|
+|     Write an archive file, one polynomial at a time.  We write the header
+|     last, once we know the count, so the file must be seekable.
+|
+| EXAMPLE
+|
+|     PolynomialArchiveWriter archive( "degree32.ppa", 2, 32 ) ;
+|     enumerate( 2, 32, [&]( const Polynomial & f ) { archive.write( f ) ; return true ; } ) ;
+|     archive.finish() ;
+|
++============================================================================*/
+
+class PolynomialArchiveWriter
+{
+    public:
+        // Throws ArchiveError if we can't create the file.
+        PolynomialArchiveWriter( const string & fileName, ppuint p, int n, ppuint blockSize = 256 ) ;
+
+        // Finish the archive, if finish() wasn't called.
+        ~PolynomialArchiveWriter() ;
+
+        // Append f, which must be of degree n modulo p and come after the last one.
+        // Throws ArchiveError if it doesn't.
+        void write( const Polynomial & f ) ;
+
+        // Write the index and the header, and close the file.
+        // Throws ArchiveError if the file can't be written.
+        void finish() ;
+
+        inline ppuint size() const { return count_ ; } ;
+
+    private:
+        PolynomialArchiveWriter( const PolynomialArchiveWriter & ) = delete ;
+        PolynomialArchiveWriter & operator=( const PolynomialArchiveWriter & ) = delete ;
+
+        string           fileName_ ;
+        ofstream         out_ ;
+        ppuint           p_ ;
+        int              n_ ;
+        ppuint           blockSize_ ;
+        ppuint           count_ ;
+        ppuint           offset_ ;        // Of the next byte we write.
+        vector< ppuint > blockOffset_ ;
+        vector< ppuint > last_ ;          // Coefficients a0 ... a(n-1) of the last polynomial.
+        bool             finished_ ;
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PolynomialArchive
+|
+| DESCRIPTION
+|
+|     Read an archive in place from memory, e.g. a MappedFile, with random
+|     access by rank.
+|
+| EXAMPLE
+|
+|     MappedFile file( "degree32.ppa" ) ;
+|     PolynomialArchive archive( file.begin(), file.end() ) ;
+|     Polynomial f = archive.select( archive.size() / 2 ) ;
+|     // archive.rank( f ) == archive.size() / 2
+|
++============================================================================*/
+
+class PolynomialArchive
+{
+    public:
+        // View the archive in [first, last).  Throws ArchiveError if the header or index is wrong.
+        PolynomialArchive( const char * first, const char * last ) ;
+
+        // Does [first, last) start with the PPA1 signature?
+        static bool isArchive( const char * first, const char * last ) ;
+
+        inline ppuint modulus()          const { return p_ ; } ;
+        inline int    degree()           const { return n_ ; } ;
+        inline ppuint size()             const { return count_ ; } ;
+        inline ppuint blockSize()        const { return blockSize_ ; } ;
+        inline ppuint generatorVersion() const { return version_ ; } ;
+
+        // The polynomial of rank k, numbered from 0.  Throws ArchiveError if k >= size().
+        Polynomial select( ppuint k ) const ;
+
+        // The number of polynomials in the archive which come before f, which must be of
+        // degree n modulo p.  f is in the archive if rank( f ) < size() and select( rank( f ) ) == f.
+        ppuint rank( const Polynomial & f ) const ;
+
+        // Call found( f ) for the polynomials of rank k, k + 1, ... until found() returns false
+        // or there are no more.
+        void scan( ppuint k, const function< bool( const Polynomial & ) > & found ) const ;
+
+        // Decode every block, checking the polynomials are in order, the index and the count.
+        // With testPrimitivity, check that every polynomial is primitive too, a slice of the
+        // blocks per thread of the pool.  Throws ArchiveError describing the first problem found.
+        void verify( ThreadPool & pool, bool testPrimitivity = true ) const ;
+
+    private:
+        // Decode the polynomial at pos into coeff, given the one before it, and return the
+        // position after it.  At the start of a block, read the record.  Throws ArchiveError
+        // if the polynomial runs past end or is out of range.
+        const unsigned char * decode( const unsigned char * pos, const unsigned char * end,
+                                      bool startOfBlock, vector< ppuint > & coeff ) const ;
+
+        // Start and end of block i.
+        const unsigned char * blockBegin( ppuint i ) const ;
+        const unsigned char * blockEnd( ppuint i ) const ;
+
+        // Number of polynomials in block i.
+        ppuint blockLength( ppuint i ) const ;
+
+        Polynomial polynomial( const vector< ppuint > & coeff ) const ;
+
+        const unsigned char * first_ ;
+        const unsigned char * index_ ;
+        ppuint                p_ ;
+        int                   n_ ;
+        ppuint                blockSize_ ;
+        ppuint                count_ ;
+        ppuint                numBlocks_ ;
+        ppuint                version_ ;
+        int                   bitsPerCoeff_ ;
+        size_t                recordSize_ ;   // In bytes.
+} ;
+
+#endif // __PP_ARCHIVE_H__ -- End of wrapper for header file.
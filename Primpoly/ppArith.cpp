@@ -50,6 +50,7 @@
 #include <algorithm>    // Iterators.
 #include <stdexcept>    // Exceptions.
 #include <cassert>      // assert()
+#include <memory>       // shared_ptr
 
 using namespace std ;
 
@@ -162,25 +163,27 @@ inline UIntType ModP<UIntType,SIntType>::operator()( SIntType n )
 |
 | METHOD
 |
-|     Multiplication by repeated squaring.
+|     Multiplication by repeated squaring.  For BigInt with an odd modulus
+|     we multiply in Montgomery form instead, which avoids the division after
+|     each product.  See class Montgomery in ppBigInt.cpp.
 |
 +============================================================================*/
 
-// Generic.
+// Repeated squaring with a division for every product.
 template <typename IntType>
-IntType PowerMod<IntType>::operator()( const IntType & a, const IntType & n )
+static IntType powerModBySquaring( const IntType & a, const IntType & n, const IntType & p )
 {
     IntType a1 = a ;
 
     //  Out of range conditions.
     if (a  <  static_cast<IntType>( 0u ) || 
         n  <  static_cast<IntType>( 0u ) || 
-        p_ <= static_cast<IntType>( 1u ) || 
+        p  <= static_cast<IntType>( 1u ) || 
        (a  == static_cast<IntType>( 0u ) && n == static_cast<IntType>( 0u )))
     {
         ostringstream os ;
         os << "PowerMod::operator() "
-           << "out of range a = " << a << " n = " << n  << " p_ = " << p_
+           << "out of range a = " << a << " n = " << n  << " p = " << p
            << " at " << __FILE__ << ": line " << __LINE__ ;
         throw ArithModPException( os.str() ) ;
     }
@@ -193,7 +196,7 @@ IntType PowerMod<IntType>::operator()( const IntType & a, const IntType & n )
         return static_cast<IntType>( 1u ) ;
 
     if (n == static_cast<IntType>( 1u ))
-        return a % static_cast<IntType>( p_ ) ;
+        return a % static_cast<IntType>( p ) ;
 
     int bitNum = n.maxBitNumber() ; // Index to highest bit.
 
@@ -227,10 +230,10 @@ IntType PowerMod<IntType>::operator()( const IntType & a, const IntType & n )
     //  every 1 bit.
     while ( --bitNum >= 0 )
     {
-        a1 = (a1 * a1) % static_cast<IntType>( p_ ) ; // Square mod p.
+        a1 = (a1 * a1) % static_cast<IntType>( p ) ; // Square mod p.
 
         if (n.testBit( bitNum ))
-            a1 = (a1 * a) % static_cast<IntType>( p_ ) ; // Times a mod p.
+            a1 = (a1 * a) % static_cast<IntType>( p ) ; // Times a mod p.
 
         #ifdef DEBUG_PP_ARITH
         cout << "S " ;
@@ -247,6 +250,32 @@ IntType PowerMod<IntType>::operator()( const IntType & a, const IntType & n )
     return a1 ;
 }
 
+// Generic.
+template <typename IntType>
+IntType PowerMod<IntType>::operator()( const IntType & a, const IntType & n )
+{
+    return powerModBySquaring( a, n, p_ ) ;
+}
+
+// BigInt with a Montgomery context for odd moduli.  Falls back to
+// repeated squaring with division for even moduli, a small unit test
+// base and the error cases.
+PowerMod<BigInt>::PowerMod( const BigInt & p )
+    : p_( p )
+    , montgomery_( p )
+{
+}
+
+BigInt PowerMod<BigInt>::operator()( const BigInt & a, const BigInt & n )
+{
+    if (montgomery_.isEnabled() && BigInt::getBase() == 0 &&
+        !(a == static_cast<ppuint>( 0u ) && n == static_cast<ppuint>( 0u )))
+        return montgomery_.power( a, n ) ;
+
+    return powerModBySquaring( a, n, p_ ) ;
+}
+
+
 
 
 /*=============================================================================
@@ -570,21 +599,16 @@ ppuint PowerMod<ppuint>::operator()( const ppuint & a, const ppuint & n )
         // Expose the next bit.
         n1 <<= 1 ;
 
-        // Out of range conditions. 
-        if (product > BigInt::getBase() || a > BigInt::getBase())
+        // Products of operands of more than half a word would overflow a ppuint:
+        // do them in double length.
+        if ((product | a) >> (4 * sizeof( ppuint )))
         {
             // Square modulo p.
-            product = multiplyMod( product, product, p_ ) ;
+            product = static_cast<ppuint>( (static_cast<ppuint2>( product ) * product) % p_ ) ;
 
             //  Leading bit is 1: multiply by a modulo p.
             if (n1 & mask)
-                product = multiplyMod( a, product, p_ ) ;
-
-            // ostringstream os ;
-            // os << "PowerMod<ppuint>::operator() "
-            //    << "product before squaring " << product << " or a = " << a << " is > base = " << BigInt::getBase()
-            //    << " at " << __FILE__ << ": line " << __LINE__ ;
-            // throw ArithModPException( os.str() ) ;
+                product = static_cast<ppuint>( (static_cast<ppuint2>( a ) * product) % p_ ) ;
         }
         else
         {
@@ -1045,7 +1069,7 @@ template ppuint multiplyMod( const ppuint a, const ppuint b, const ppuint n ) ;
 
 // We already specialized this function for ppuint in the source code implementation above, so we can omit
 // the template instantiation:   template ppuint PowerMod<ppuint>::operator()( const ppuint & a, const ppuint & n ) ;
-template BigInt  PowerMod<BigInt>::operator()( const BigInt & a, const BigInt & n ) ;
+// PowerMod<BigInt> is a class specialization declared in ppBigInt.h.
 
 template ModP<ppuint,ppsint>::ModP( ppuint p ) ;
 template ModP<ppuint,ppsint>::ModP( const ModP & ) ;
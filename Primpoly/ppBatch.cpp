@@ -0,0 +1,849 @@
+/*==============================================================================
+| 
+|  NAME
+|
+|     ppBatch.cpp
+|
+|  DESCRIPTION
+|
+|     Test batches of polynomials for primitivity on a thread pool, sharing
+|     the factorization of r between all polynomials of the same p and n.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|     
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+
+
+/*------------------------------------------------------------------------------
+|                                Includes                                      |
+------------------------------------------------------------------------------*/
+
+#include <cstdlib>      // abort()
+#include <iostream>     // Basic stream I/O.
+#include <new>          // set_new_handler()
+#include <cmath>        // Basic math functions e.g. sqrt()
+#include <limits>       // Numeric limits.
+#include <complex>      // Complex data type and operations.
+#include <fstream>      // File stream I/O.
+#include <sstream>      // String stream I/O.
+#include <vector>       // STL vector class.
+#include <string>       // STL string class.
+#include <algorithm>    // Iterators.
+#include <stdexcept>    // Exceptions.
+#include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <functional>   // function
+#include <iterator>     // input_iterator_tag
+#include <cstddef>      // ptrdiff_t
+#include <thread>       // Worker threads.
+#include <mutex>        // mutex, lock_guard, unique_lock
+#include <condition_variable>  // Wake up idle workers.
+#include <future>       // packaged_task, future
+#include <queue>        // Task queue.
+#include <list>         // LRU order.
+#include <map>          // LRU index.
+#include <atomic>       // Trace enabled flag, cache hit counts.
+#include <cstring>      // memchr(), memcmp()
+
+#include <sys/mman.h>   // Memory mapped files.
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>     // close()
+
+using namespace std ;   // So we don't need to say std::vector everywhere.
+
+
+
+/*------------------------------------------------------------------------------
+|                                PP Include Files                              |
+------------------------------------------------------------------------------*/
+
+#include "Primpoly.h"       // Global functions.
+#include "ppArith.h"        // Basic arithmetic functions.
+#include "ppBigInt.h"       // Arbitrary precision integer arithmetic.
+#include "ppOperationCount.h"   // OperationCount collection for factoring and poly finding.
+#include "ppFactor.h"       // Prime factorization and Euler Phi.
+#include "ppPolynomial.h"   // Polynomial operations and mod polynomial operations.
+#include "ppSearch.h"       // Primitive polynomial search and test API.
+#include "ppParser.h"       // Parsing of polynomials and I/O services.
+#include "ppBatch.h"        // Batch testing of polynomials.
+#include "ppTrace.h"        // Timeline tracing.
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     ThreadPool
+ |
+ | DESCRIPTION
+ |
+ |     Start the worker threads.
+ |
+ +============================================================================*/
+
+ThreadPool::ThreadPool( unsigned int numThreads )
+    : threads_()
+    , tasks_()
+    , mutex_()
+    , ready_()
+    , stop_( false )
+{
+    if (numThreads == 0)
+        numThreads = max( thread::hardware_concurrency(), 1u ) ;
+
+    for (unsigned int i = 0 ;  i < numThreads ;  ++i)
+        threads_.push_back( thread( &ThreadPool::worker, this, static_cast<int>( i ) ) ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     ~ThreadPool
+ |
+ | DESCRIPTION
+ |
+ |     Let the workers drain the queue, then wait for them to exit.
+ |
+ +============================================================================*/
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard< mutex > lock( mutex_ ) ;
+        stop_ = true ;
+    }
+    ready_.notify_all() ;
+
+    for (auto & worker : threads_)
+        worker.join() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     ThreadPool::submit
+ |
+ | DESCRIPTION
+ |
+ |     Queue a task.  The future is ready when the task is done, and get()
+ |     rethrows whatever the task threw.
+ |
+ +============================================================================*/
+
+future<void> ThreadPool::submit( function< void() > task )
+{
+    packaged_task< void() > packagedTask( std::move( task ) ) ;
+    future<void> done = packagedTask.get_future() ;
+
+    {
+        lock_guard< mutex > lock( mutex_ ) ;
+        tasks_.push( std::move( packagedTask ) ) ;
+        PP_TRACE_COUNTER( "queued tasks", tasks_.size() ) ;
+    }
+    ready_.notify_one() ;
+
+    return done ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     ThreadPool::worker
+ |
+ | DESCRIPTION
+ |
+ |     Run tasks until we're told to stop and the queue is empty.  On the
+ |     trace timeline, each worker alternates between waiting and running a
+ |     task, so idle workers and a backed up queue are easy to see.
+ |
+ +============================================================================*/
+
+void ThreadPool::worker( int number )
+{
+    PP_TRACE_THREAD_NAME( "worker", number ) ;
+
+    for (;;)
+    {
+        packaged_task< void() > task ;
+        {
+            PP_TRACE_SCOPE( "wait for task", "pool" ) ;
+            unique_lock< mutex > lock( mutex_ ) ;
+            ready_.wait( lock, [this]() { return stop_ || !tasks_.empty() ; } ) ;
+
+            if (tasks_.empty())
+                return ;
+
+            task = std::move( tasks_.front() ) ;
+            tasks_.pop() ;
+            PP_TRACE_COUNTER( "queued tasks", tasks_.size() ) ;
+        }
+
+        PP_TRACE_SCOPE( "task", "pool" ) ;
+        task() ;
+    }
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyOrderCache
+ |
+ | DESCRIPTION
+ |
+ |     Empty cache holding up to capacity contexts.
+ |
+ +============================================================================*/
+
+PolyOrderCache::PolyOrderCache( size_t capacity )
+    : capacity_( max( capacity, static_cast<size_t>( 1u ) ) )
+    , lru_()
+    , index_()
+    , mutex_()
+    , numHits_( 0u )
+    , numMisses_( 0u )
+{
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyOrderCache::context
+ |
+ | DESCRIPTION
+ |
+ |     Look up the context for degree n modulo p and move it to the front.
+ |     On a miss, factor r outside the lock so other threads aren't held up,
+ |     then insert it, evicting the least recently used context if full.
+ |
+ +============================================================================*/
+
+shared_ptr< const PolyOrder > PolyOrderCache::context( ppuint p, int n )
+{
+    const Key key( p, n ) ;
+
+    {
+        lock_guard< mutex > lock( mutex_ ) ;
+        auto found = index_.find( key ) ;
+        if (found != index_.end())
+        {
+            ++numHits_ ;
+            lru_.splice( lru_.begin(), lru_, found->second ) ;
+            return found->second->second ;
+        }
+        ++numMisses_ ;
+    }
+
+    Polynomial f ;
+    f.initial_trial_poly( n, p ) ;
+    shared_ptr< const PolyOrder > order = make_shared< const PolyOrder >( f ) ;
+
+    lock_guard< mutex > lock( mutex_ ) ;
+
+    // Another thread may have beaten us to it.
+    auto found = index_.find( key ) ;
+    if (found != index_.end())
+        return found->second->second ;
+
+    lru_.push_front( make_pair( key, order ) ) ;
+    index_[ key ] = lru_.begin() ;
+
+    if (lru_.size() > capacity_)
+    {
+        index_.erase( lru_.back().first ) ;
+        lru_.pop_back() ;
+    }
+
+    return order ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     BatchContext
+ |
+ | DESCRIPTION
+ |
+ |     One task's working copy of a cached context, reused for as long as
+ |     the lines it tests have the same p and n.
+ |
+ +============================================================================*/
+
+struct BatchContext
+{
+    BatchContext()
+        : p( 0u )
+        , n( 0 )
+        , order()
+    {
+    }
+
+    ppuint                  p ;
+    int                     n ;
+    unique_ptr< PolyOrder > order ;
+} ;
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     testPolynomial
+ |
+ | DESCRIPTION
+ |
+ |     Test one polynomial, range checking it like the command line parser
+ |     does for -t.  We call it name in any error message.
+ |
+ +============================================================================*/
+
+static string testPolynomial( const Polynomial & f, const string & name, PolyOrderCache & cache, BatchContext & context )
+{
+    ostringstream os ;
+    ppuint p = f.modulus() ;
+    int    n = f.deg() ;
+
+    if (n < static_cast<int>( minDegree ) || p < minModulus || p >= maxModulus || !isAlmostSurelyPrime( p ))
+    {
+        os << name << " error: p must be a prime < " << maxModulus << " and n must be >= " << minDegree ;
+        return os.str() ;
+    }
+
+    if (!context.order || context.p != p || context.n != n)
+    {
+        context.order = unique_ptr< PolyOrder >( new PolyOrder( *cache.context( p, n ) ) ) ;
+        context.p     = p ;
+        context.n     = n ;
+    }
+
+    context.order->newPolynomial( f ) ;
+    os << f << " is " << (context.order->isPrimitive() ? "" : "NOT ") << "primitive!" ;
+
+    return os.str() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     errorLine
+ |
+ | DESCRIPTION
+ |
+ |     The result line for an exception, flattened onto one line.
+ |
+ +============================================================================*/
+
+static string errorLine( const string & name, const exception & e )
+{
+    string what( e.what() ) ;
+    replace( what.begin(), what.end(), '\n', ' ' ) ;
+
+    return name + " error: " + what ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     testPolynomialLine
+ |
+ | DESCRIPTION
+ |
+ |     Test one line of input, in any of the formats readPolynomial knows.
+ |     An error becomes the result line.  A blank line gives a blank result.
+ |
+ +============================================================================*/
+
+static string testPolynomialLine( const string & line, PolyOrderCache & cache, BatchContext & context )
+{
+    if (line.find_first_not_of( " \t\r" ) == string::npos)
+        return "" ;
+
+    try
+    {
+        return testPolynomial( Polynomial( line ), line, cache, context ) ;
+    }
+    catch( exception & e )
+    {
+        return errorLine( line, e ) ;
+    }
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     testBlock
+ |
+ | DESCRIPTION
+ |
+ |     Split numItems into one contiguous slice per thread, get the result
+ |     line for each item with test() on the pool, then write the results in
+ |     input order.  Each slice has its own BatchContext.
+ |
+ +============================================================================*/
+
+static void testBlock( size_t numItems, const function< string( size_t, BatchContext & ) > & test,
+                       ostream & out, ThreadPool & pool )
+{
+    vector<string> results( numItems ) ;
+
+    size_t numSlices = min( static_cast<size_t>( pool.size() ), numItems ) ;
+    vector< future<void> > done ;
+    for (size_t slice = 0 ;  slice < numSlices ;  ++slice)
+    {
+        size_t begin = slice       * numItems / numSlices ;
+        size_t end   = (slice + 1) * numItems / numSlices ;
+
+        done.push_back( pool.submit( [slice, begin, end, &test, &results]()
+        {
+            PP_TRACE_SCOPE_ARG( "batch slice", "work", slice ) ;
+            BatchContext context ;
+            for (size_t i = begin ;  i < end ;  ++i)
+                results[ i ] = test( i, context ) ;
+        } ) ) ;
+    }
+
+    {
+        PP_TRACE_SCOPE( "wait for slices", "work" ) ;
+        for (auto & slice : done)
+            slice.get() ;
+    }
+
+    for (const string & result : results)
+        out << result << '\n' ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     testPolynomials
+ |
+ | DESCRIPTION
+ |
+ |     Read a block of lines, test them on the pool, then write the results
+ |     before reading the next block.
+ |
+ +============================================================================*/
+
+void testPolynomials( istream & in, ostream & out, ThreadPool & pool, PolyOrderCache & cache, size_t blockSize )
+{
+    blockSize = max( blockSize, static_cast<size_t>( 1u ) ) ;
+
+    vector<string> lines ;
+    string line ;
+
+    while (in)
+    {
+        lines.clear() ;
+        while (lines.size() < blockSize && getline( in, line ))
+            lines.push_back( line ) ;
+
+        if (lines.empty())
+            break ;
+
+        testBlock( lines.size(), [&lines, &cache]( size_t i, BatchContext & context )
+                   {
+                       return testPolynomialLine( lines[ i ], cache, context ) ;
+                   }, out, pool ) ;
+    }
+
+    out.flush() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     testPolynomials
+ |
+ | DESCRIPTION
+ |
+ |     Same, for lines of text in memory.  We split a block of lines in place
+ |     and only copy each one as its thread tests it.
+ |
+ +============================================================================*/
+
+void testPolynomials( const char * first, const char * last, ostream & out, ThreadPool & pool,
+                      PolyOrderCache & cache, size_t blockSize )
+{
+    blockSize = max( blockSize, static_cast<size_t>( 1u ) ) ;
+
+    vector< pair< const char *, const char * > > lines ;
+    const char * pos = first ;
+
+    while (pos != last)
+    {
+        lines.clear() ;
+        while (lines.size() < blockSize && pos != last)
+        {
+            const char * newline = static_cast<const char *>( memchr( pos, '\n', last - pos ) ) ;
+            const char * end     = newline ? newline : last ;
+
+            lines.push_back( make_pair( pos, end ) ) ;
+            pos = newline ? newline + 1 : last ;
+        }
+
+        testBlock( lines.size(), [&lines, &cache]( size_t i, BatchContext & context )
+                   {
+                       return testPolynomialLine( string( lines[ i ].first, lines[ i ].second ), cache, context ) ;
+                   }, out, pool ) ;
+    }
+
+    out.flush() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     testPolynomials
+ |
+ | DESCRIPTION
+ |
+ |     Same, for packed polynomials.  A record with a bad coefficient gets
+ |     an error line naming its record number.
+ |
+ +============================================================================*/
+
+void testPolynomials( const PackedPolynomials & packed, ostream & out, ThreadPool & pool,
+                      PolyOrderCache & cache, size_t blockSize )
+{
+    blockSize = max( blockSize, static_cast<size_t>( 1u ) ) ;
+
+    for (size_t first = 0 ;  first < packed.size() ;  first += blockSize)
+    {
+        testBlock( min( blockSize, packed.size() - first ), [first, &packed, &cache]( size_t i, BatchContext & context )
+                   {
+                       ostringstream name ;
+                       name << "record " << first + i ;
+                       try
+                       {
+                           return testPolynomial( packed[ first + i ], name.str(), cache, context ) ;
+                       }
+                       catch( exception & e )
+                       {
+                           return errorLine( name.str(), e ) ;
+                       }
+                   }, out, pool ) ;
+    }
+
+    out.flush() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     testPolynomialFile
+ |
+ | DESCRIPTION
+ |
+ |     Test the polynomials in a file, text or packed.  We memory map the
+ |     file if we can, and fall back to reading it as a stream of text.
+ |
+ +============================================================================*/
+
+void testPolynomialFile( const string & fileName, ostream & out, ThreadPool & pool, PolyOrderCache & cache )
+{
+    MappedFile file( fileName ) ;
+    if (file.isMapped())
+    {
+        if (PackedPolynomials::isPacked( file.begin(), file.end() ))
+            testPolynomials( PackedPolynomials( file.begin(), file.end() ), out, pool, cache ) ;
+        else
+            testPolynomials( file.begin(), file.end(), out, pool, cache ) ;
+        return ;
+    }
+
+    ifstream fin( fileName ) ;
+    if (!fin)
+        throw ParserError( "Cannot open the file of polynomials " + fileName ) ;
+
+    testPolynomials( fin, out, pool, cache ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     MappedFile
+ |
+ | DESCRIPTION
+ |
+ |     Map a regular file read only.  Leave it unmapped if we can't.
+ |
+ +============================================================================*/
+
+MappedFile::MappedFile( const string & fileName, bool sequential )
+    : data_( nullptr )
+    , size_( 0 )
+{
+    int fd = open( fileName.c_str(), O_RDONLY ) ;
+    if (fd < 0)
+        return ;
+
+    struct stat status ;
+    if (fstat( fd, &status ) == 0 && S_ISREG( status.st_mode ) && status.st_size > 0)
+    {
+        size_t size = static_cast<size_t>( status.st_size ) ;
+        void * data = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 ) ;
+        if (data != MAP_FAILED)
+        {
+            madvise( data, size, sequential ? MADV_SEQUENTIAL : MADV_RANDOM ) ;
+            data_ = static_cast<const char *>( data ) ;
+            size_ = size ;
+        }
+    }
+
+    close( fd ) ;
+}
+
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+        munmap( const_cast<char *>( data_ ), size_ ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PackedPolynomials
+ |
+ | DESCRIPTION
+ |
+ |     Read and check the header, and find the records.
+ |
+ +============================================================================*/
+
+static const char   packedSignature[] = "PPK1" ;
+static const size_t packedHeaderSize  = 16 ;
+
+// Least b with p <= 2 ^ b, so b bits hold any coefficient 0 ... p-1.
+static int bitsPerCoefficient( ppuint p )
+{
+    int b = 1 ;
+    while ((static_cast<ppuint>( 1u ) << b) < p)
+        ++b ;
+
+    return b ;
+}
+
+// Little endian unsigned integer of numBytes bytes.
+static ppuint readLittleEndian( const char * bytes, int numBytes )
+{
+    ppuint value = 0 ;
+    for (int i = numBytes - 1 ;  i >= 0 ;  --i)
+        value = (value << 8) | static_cast<unsigned char>( bytes[ i ] ) ;
+
+    return value ;
+}
+
+static void writeLittleEndian( ostream & out, ppuint value, int numBytes )
+{
+    for (int i = 0 ;  i < numBytes ;  ++i, value >>= 8)
+        out.put( static_cast<char>( value & 0xFF ) ) ;
+}
+
+PackedPolynomials::PackedPolynomials( const char * first, const char * last )
+    : records_( nullptr )
+    , p_( 0 )
+    , n_( 0 )
+    , bitsPerCoeff_( 0 )
+    , recordSize_( 0 )
+    , numRecords_( 0 )
+{
+    if (!isPacked( first, last ) || static_cast<size_t>( last - first ) < packedHeaderSize)
+        throw ParserError( "Error:  packed polynomials don't start with the PPK1 header" ) ;
+
+    ppuint p = readLittleEndian( first + 4, 8 ) ;
+    ppuint n = readLittleEndian( first + 12, 4 ) ;
+    if (p < minModulus || p >= maxModulus || n < 1 || n > static_cast<ppuint>( numeric_limits<int>::max() - 1 ))
+    {
+        ostringstream os ;
+        os << "Error:  packed polynomials have p = " << p << " and n = " << n
+           << " but need 2 <= p < " << maxModulus << " and n >= 1" ;
+        throw ParserError( os.str() ) ;
+    }
+
+    records_      = first + packedHeaderSize ;
+    p_            = p ;
+    n_            = static_cast<int>( n ) ;
+    bitsPerCoeff_ = bitsPerCoefficient( p_ ) ;
+    recordSize_   = ((static_cast<size_t>( n_ ) + 1) * bitsPerCoeff_ + 7) / 8 ;
+
+    size_t numBytes = static_cast<size_t>( last - records_ ) ;
+    if (numBytes % recordSize_ != 0)
+    {
+        ostringstream os ;
+        os << "Error:  packed polynomials of degree " << n_ << " modulo " << p_ << " take " << recordSize_
+           << " bytes each, but there are " << numBytes << " bytes after the header" ;
+        throw ParserError( os.str() ) ;
+    }
+
+    numRecords_ = numBytes / recordSize_ ;
+}
+
+
+bool PackedPolynomials::isPacked( const char * first, const char * last )
+{
+    return last - first >= 4 && memcmp( first, packedSignature, 4 ) == 0 ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PackedPolynomials::operator[]
+ |
+ | DESCRIPTION
+ |
+ |     Unpack record i.
+ |
+ +============================================================================*/
+
+Polynomial PackedPolynomials::operator[]( size_t i ) const
+{
+    const unsigned char * record = reinterpret_cast<const unsigned char *>( records_ + i * recordSize_ ) ;
+
+    vector<ppuint> coeff( n_ + 1 ) ;
+    size_t bit = 0 ;
+    for (int j = 0 ;  j <= n_ ;  ++j)
+    {
+        // Gather the coefficient's bits a byte at a time.
+        ppuint c = 0 ;
+        for (int k = 0 ;  k < bitsPerCoeff_ ; )
+        {
+            int shift = static_cast<int>( bit & 7 ) ;
+            int take  = min( 8 - shift, bitsPerCoeff_ - k ) ;
+            c |= static_cast<ppuint>( (record[ bit >> 3 ] >> shift) & ((1u << take) - 1) ) << k ;
+            k   += take ;
+            bit += take ;
+        }
+
+        if (c >= p_)
+        {
+            ostringstream os ;
+            os << "Error:  packed coefficient " << c << " of x ^ " << j << " isn't less than p = " << p_ ;
+            throw ParserError( os.str() ) ;
+        }
+
+        coeff[ j ] = c ;
+    }
+
+    Polynomial f( coeff ) ;
+    f.setModulus( p_ ) ;
+
+    return f ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PackedPolynomials::write
+ |
+ | DESCRIPTION
+ |
+ |     Write the header and pack the polynomials.
+ |
+ +============================================================================*/
+
+void PackedPolynomials::write( ostream & out, ppuint p, int n, const vector< Polynomial > & f )
+{
+    out.write( packedSignature, 4 ) ;
+    writeLittleEndian( out, p, 8 ) ;
+    writeLittleEndian( out, static_cast<ppuint>( n ), 4 ) ;
+
+    int bitsPerCoeff = bitsPerCoefficient( p ) ;
+    vector<char> record( ((static_cast<size_t>( n ) + 1) * bitsPerCoeff + 7) / 8 ) ;
+
+    for (const Polynomial & g : f)
+    {
+        if (g.deg() != n || g.modulus() != p)
+        {
+            ostringstream os ;
+            os << "Error:  can't pack " << g << " with polynomials of degree " << n << " modulo " << p ;
+            throw ParserError( os.str() ) ;
+        }
+
+        fill( record.begin(), record.end(), 0 ) ;
+        size_t bit = 0 ;
+        for (int j = 0 ;  j <= n ;  ++j)
+        {
+            for (int k = 0 ;  k < bitsPerCoeff ;  ++k, ++bit)
+                if ((g[ j ] >> k) & 1)
+                    record[ bit >> 3 ] |= static_cast<char>( 1 << (bit & 7) ) ;
+        }
+
+        out.write( record.data(), record.size() ) ;
+    }
+}
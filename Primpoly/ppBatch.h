@@ -0,0 +1,251 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppBatch.h
+|
+|  DESCRIPTION
+|
+|     Header file for testing batches of polynomials for primitivity:
+|     a thread pool, a cache of PolyOrder contexts and the batch tester.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with the !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+// Wrap this header file to prevent duplication if it is included
+// accidentally more than once.
+#ifndef __PP_BATCH_H__
+#define __PP_BATCH_H__
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     ThreadPool
+|
+| DESCRIPTION
+|
+|     A fixed set of worker threads which run tasks in the order submitted.
+|     The destructor finishes the queued tasks, then joins the threads.
+|
+| EXAMPLE
+|
+|     ThreadPool pool ;
+|     future<void> done = pool.submit( []() { ... } ) ;
+|     done.get() ;  // Wait, and rethrow any exception from the task.
+|
++============================================================================*/
+
+class ThreadPool
+{
+    public:
+        // Zero threads means one per hardware thread.
+        explicit ThreadPool( unsigned int numThreads = 0 ) ;
+
+        ~ThreadPool() ;
+
+        future<void> submit( function< void() > task ) ;
+
+        inline unsigned int size() const { return static_cast<unsigned int>( threads_.size() ) ; } ;
+
+    private:
+        ThreadPool( const ThreadPool & ) = delete ;
+        ThreadPool & operator=( const ThreadPool & ) = delete ;
+
+        void worker( int number ) ;
+
+        vector<thread>                  threads_ ;
+        queue< packaged_task<void()> >  tasks_ ;
+        mutex                           mutex_ ;
+        condition_variable              ready_ ;
+        bool                            stop_ ;
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PolyOrderCache
+|
+| DESCRIPTION
+|
+|     Least recently used cache of PolyOrder contexts, one per (p, n).
+|     A context holds everything the PolyOrder constructor computes for
+|     polynomials of degree n modulo p:  the factorization of r, the
+|     exponents for the order tests and the number of primitive polynomials.
+|     Testing a polynomial starts from a copy of its context instead of
+|     factoring r again.
+|
+|     Safe to use from many threads at once.
+|
++============================================================================*/
+
+class PolyOrderCache
+{
+    public:
+        explicit PolyOrderCache( size_t capacity = 16 ) ;
+
+        // The context for degree n modulo p, computed on a miss.
+        shared_ptr< const PolyOrder > context( ppuint p, int n ) ;
+
+        inline ppuint numHits()   const { return numHits_ ; } ;
+        inline ppuint numMisses() const { return numMisses_ ; } ;
+
+    private:
+        typedef pair< ppuint, int > Key ;
+        typedef list< pair< Key, shared_ptr< const PolyOrder > > > LRUList ;
+
+        size_t                          capacity_ ;
+        LRUList                         lru_ ;      // Most recently used first.
+        map< Key, LRUList::iterator >   index_ ;
+        mutex                           mutex_ ;
+        atomic< ppuint >                numHits_ ;     // Counted under mutex_, but read without it.
+        atomic< ppuint >                numMisses_ ;
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     MappedFile
+|
+| DESCRIPTION
+|
+|     Read only memory map of a whole file, so we can scan multi-gigabyte
+|     inputs without copying them through a stream.  Pipes, terminals and
+|     empty files can't be mapped;  isMapped() is false and the caller
+|     should read them as a stream instead.  Ask for random access if we'll
+|     jump around the file, so the kernel doesn't read ahead for nothing.
+|
++============================================================================*/
+
+class MappedFile
+{
+    public:
+        explicit MappedFile( const string & fileName, bool sequential = true ) ;
+
+        ~MappedFile() ;
+
+        inline bool         isMapped() const { return data_ != nullptr ; } ;
+        inline const char * begin()    const { return data_ ; } ;
+        inline const char * end()      const { return data_ + size_ ; } ;
+
+    private:
+        MappedFile( const MappedFile & ) = delete ;
+        MappedFile & operator=( const MappedFile & ) = delete ;
+
+        const char * data_ ;
+        size_t       size_ ;
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PackedPolynomials
+|
+| DESCRIPTION
+|
+|     Polynomials of one degree n modulo p, packed in binary.  All numbers
+|     are little endian.
+|
+|         bytes 0-3     PPK1
+|         bytes 4-11    p
+|         bytes 12-15   n
+|         bytes 16-     One record per polynomial:  the coefficients
+|                       a0, a1, ..., an, each in b bits where b is the least
+|                       with p <= 2 ^ b, lowest bit first.  Each record is
+|                       padded with zero bits to a whole number of bytes.
+|
+|     So a polynomial of degree 32 modulo 2 takes 5 bytes instead of a line
+|     of text.  We read the records in place from memory, e.g. a MappedFile.
+|
+| EXAMPLE
+|
+|     ostringstream os ;
+|     PackedPolynomials::write( os, 2, 4, { Polynomial( "x^4 + x + 1, 2" ) } ) ;
+|     string s = os.str() ;
+|     PackedPolynomials packed( s.data(), s.data() + s.size() ) ;
+|     // packed.size() == 1, packed[ 0 ] == x^4 + x + 1
+|
++============================================================================*/
+
+class PackedPolynomials
+{
+    public:
+        // View the packed polynomials in [first, last), header included.
+        // Throws ParserError if the header or the length is wrong.
+        PackedPolynomials( const char * first, const char * last ) ;
+
+        // Does [first, last) start with the PPK1 signature?
+        static bool isPacked( const char * first, const char * last ) ;
+
+        // Write the header and the polynomials, which must all be of degree n modulo p.
+        static void write( ostream & out, ppuint p, int n, const vector< Polynomial > & f ) ;
+
+        inline ppuint modulus() const { return p_ ; } ;
+        inline int    degree()  const { return n_ ; } ;
+        inline size_t size()    const { return numRecords_ ; } ;
+
+        // Polynomial number i.  Throws ParserError if a coefficient isn't less than p.
+        Polynomial operator[]( size_t i ) const ;
+
+    private:
+        const char * records_ ;
+        ppuint       p_ ;
+        int          n_ ;
+        int          bitsPerCoeff_ ;
+        size_t       recordSize_ ;   // In bytes.
+        size_t       numRecords_ ;
+} ;
+
+
+// Test each line of in for primitivity, the way Primpoly -t does, and write one line
+// of result to out for each, in input order.  A line which doesn't parse gets an error
+// line instead.  We test blocks of blockSize lines at a time on the thread pool.
+void testPolynomials( istream & in, ostream & out, ThreadPool & pool, PolyOrderCache & cache,
+                      size_t blockSize = 4096 ) ;
+
+// Same, for the lines of text in [first, last).
+void testPolynomials( const char * first, const char * last, ostream & out, ThreadPool & pool,
+                      PolyOrderCache & cache, size_t blockSize = 4096 ) ;
+
+// Same, for packed polynomials, one result line per record.
+void testPolynomials( const PackedPolynomials & packed, ostream & out, ThreadPool & pool,
+                      PolyOrderCache & cache, size_t blockSize = 4096 ) ;
+
+// Test the polynomials in a file of text lines or packed polynomials, which we memory map if we can.
+// Throws ParserError if we can't read the file.
+void testPolynomialFile( const string & fileName, ostream & out, ThreadPool & pool, PolyOrderCache & cache ) ;
+
+#endif // __PP_BATCH_H__ -- End of wrapper for header file.
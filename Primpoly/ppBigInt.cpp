@@ -72,11 +72,14 @@
 #include <complex>      // Complex data type and operations.
 #include <fstream>      // File stream I/O.
 #include <sstream>      // String stream I/O.
+#include <iomanip>      // setw() and setfill()
 #include <vector>       // STL vector class.
+#include <deque>        // STL deque class.
 #include <string>       // STL string class.
 #include <algorithm>    // Iterators.
 #include <stdexcept>    // Exceptions.
 #include <cassert>      // assert()
+#include <memory>       // shared_ptr
 
 using namespace std ;   // So we don't need to say std::vector everywhere.
 
@@ -97,12 +100,132 @@ using namespace std ;   // So we don't need to say std::vector everywhere.
 
 
 
-/*------------------------------------------------------------------------------
-|                     Initialize Class Variables                               |
-------------------------------------------------------------------------------*/
+/*=============================================================================
+|
+| NAME
+|
+|     BigIntDigits::grow
+|
+| DESCRIPTION
+|
+|     Move the digits into new heap storage with room for n digits.
+|     Throws bad_alloc if we run out of memory and length_error if n is
+|     larger than we could ever allocate, as vector does.
+|
++============================================================================*/
+
+// Count of heap allocations for BigInt digits, one per thread so a test in one thread
+// doesn't see the allocations of tests running in other threads.
+static thread_local ppuint numBigIntHeapAllocations = 0 ;
+
+void BigIntDigits::grow( size_t n )
+{
+    if (n > numeric_limits<size_t>::max() / sizeof( ppuint ))
+        throw length_error( "BigIntDigits::grow" ) ;
+
+    ppuint * newDigit = new ppuint[ n ] ;
+    ++numBigIntHeapAllocations ;
+
+    for (size_t i = 0 ;  i < size_ ;  ++i)
+        newDigit[ i ] = digit_[ i ] ;
+
+    if (digit_ != inline_)
+        delete [] digit_ ;
+
+    digit_    = newDigit ;
+    capacity_ = n ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     BigIntDigits::numHeapAllocations
+|
+| DESCRIPTION
+|
+|     Number of heap allocations for BigInt digits so far in this thread.
+|     Used for testing and benchmarking.
+|
++============================================================================*/
+
+ppuint BigIntDigits::numHeapAllocations()
+{
+    return numBigIntHeapAllocations ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     Digit helper functions
+|
+| DESCRIPTION
+|
+|     Split a double length number t = c b + d into its base b digit d and
+|     carry c, and divide a double length number by a digit.
+|
+|     A base of b = 0 stands for the full word base b = 2^N where N is the
+|     number of bits in a ppuint.  Then the split is just the low and high
+|     halves of t, which the compiler reduces to register moves.  Any other
+|     base is a small base used only for unit testing, where t always fits
+|     into a single ppuint.
+|
++============================================================================*/
+
+static const int bitsPerWord = 8 * sizeof( ppuint ) ;
+
+static inline ppuint2 fullBase( const ppuint b )
+{
+    return (b == 0) ? (static_cast<ppuint2>( 1u ) << bitsPerWord) : static_cast<ppuint2>( b ) ;
+}
+
+static inline ppuint digitOf( const ppuint2 t, const ppuint b )
+{
+    return (b == 0) ? static_cast<ppuint>( t ) : static_cast<ppuint>( t ) % b ;
+}
+
+static inline ppuint carryOf( const ppuint2 t, const ppuint b )
+{
+    return (b == 0) ? static_cast<ppuint>( t >> bitsPerWord ) : static_cast<ppuint>( t ) / b ;
+}
+
+//  Return q = | t / d | and r = t mod d.  The quotient must fit into a digit, i.e. the high half of t is < d.
+//             --     --
+static inline ppuint divideDigit( const ppuint2 t, const ppuint d, ppuint & r )
+{
+    #if defined( __x86_64__ ) && defined( __GNUC__ )
+    // One divq instruction instead of a call to the general 128-bit library divide.
+    ppuint q ;
+    ppuint hi = static_cast<ppuint>( t >> bitsPerWord ) ;
+    ppuint lo = static_cast<ppuint>( t ) ;
+    __asm__( "divq %4" : "=a"( q ), "=d"( r ) : "a"( lo ), "d"( hi ), "rm"( d ) ) ;
+    return q ;
+    #else
+    r = static_cast<ppuint>( t % d ) ;
+    return static_cast<ppuint>( t / d ) ;
+    #endif
+}
+
+//                                                     k
+//  Return the largest number k of decimal numerals 10  <= b which fit into one digit.
+static int decimalChunk( const ppuint b, ppuint & tenToTheK )
+{
+    int k = 1 ;
+    tenToTheK = 10 ;
+
+    while (static_cast<ppuint2>( tenToTheK ) * 10 <= fullBase( b ))
+    {
+        tenToTheK *= 10 ;
+        ++k ;
+    }
 
-// Pointer to number system base.  Used for unit testing only.
-ppuint * BigInt::pbase = 0 ;
+    return k ;
+}
 
 
 
@@ -125,7 +248,7 @@ ppuint * BigInt::pbase = 0 ;
 +============================================================================*/
 
 BigInt::BigInt()
-       : digit_( 0 )                // Construct a vector with zero length.
+       : digit_( 0 )                // Construct with zero length.
 {
     // Force us to generate a base by using it.
     //ppuint b = base_() ; b ;
@@ -158,7 +281,7 @@ BigInt::BigInt()
 
 BigInt::~BigInt()
 {
-    // Digits are in a vector which frees itself when it goes out of scope.
+    // Digits free themselves when they go out of scope.
     // Other class variables are primitives.
 
     // try
@@ -224,26 +347,28 @@ BigInt::~BigInt()
 |       So the algorithm for extracting the BigInt digits is
 |   
 |       do until d == 0:
-|   
+|
 |           U = d mod b
-|   
+|
 |           u = |  d / b |
 |               --      --
 |
+|       For the full word base b, any d is a single digit.
+|
 +============================================================================*/
 
 BigInt::BigInt( const ppuint d )
-       : digit_( 0 )                // Construct a vector with zero length.
+       : digit_( 0 )                // Construct with zero length.
 {
     ppuint b  = base_() ;
     ppuint d2 = d ;
 
     try
     {
-        // Early return if d = 0;  d will never be negative.
-        if (d2 == 0)
+        // Early return if d = 0 or d fits into a full word digit;  d will never be negative.
+        if (d2 == 0 || b == 0)
         {
-            digit_.push_back( 0 ) ;
+            digit_.push_back( d2 ) ;
         }
         else
             while (d2 != 0)
@@ -291,12 +416,67 @@ BigInt::BigInt( const ppuint d )
 +============================================================================*/
 
 BigInt::BigInt( const string & s )
-       : digit_( 0 )                  // Construct a vector with zero length.
+       : digit_( 0 )                  // Construct with zero length.
 {
-    // Construct temporary big integer w = 0 or else throw exception upwards.
+    // Construct temporary big integer w or else throw exception upwards.
     // If this fails, memory for w is automatically released during stack unwind,
     // this BigInt object isn't constructed.
-    BigInt w( 0 ) ;
+    BigInt w = fromDecimal( s, 0, s.size() ) ;
+
+    // Swap the digits of w into this number.
+    swap( w.digit_, digit_ ) ;
+
+    // As we go out of scope, w's destructor will be called.
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     BigInt::fromDecimal
+|
+| DESCRIPTION
+|
+|     Convert the decimal numerals s[ begin ] ... s[ end - 1 ] to a BigInt.
+|
+| METHOD
+|
+|     Short strings use Horner's rule, which is quadratic in the length.
+|     Longer strings split into a high and low part with the low part
+|     having exactly L = k 2^i numerals and recurse,
+|
+|                            L
+|         w = high  *  ( 10 )  +  low
+|
+|     using the cached power of 10 and fast multiplication.
+|
++============================================================================*/
+
+BigInt BigInt::fromDecimal( const string & s, size_t begin, size_t end )
+{
+    ppuint tenToTheK = 0 ;
+    int    k         = decimalChunk( base_(), tenToTheK ) ;
+    size_t len       = end - begin ;
+
+    if (len > static_cast<size_t>( k ) * radixThreshold)
+    {
+        // Low part gets between 1/4 and 1/2 of the numerals.
+        int level = 0 ;
+        while ((static_cast<size_t>( k ) << (level + 1)) <= len / 2)
+            ++level ;
+
+        size_t lowLen = static_cast<size_t>( k ) << level ;
+
+        BigInt w = fromDecimal( s, begin, end - lowLen ) ;
+        w *= decimalPower( level ) ;
+        w += fromDecimal( s, end - lowLen, end ) ;
+
+        return w ;
+    }
+
+    BigInt w( static_cast<ppuint>( 0u ) ) ;
 
     #ifdef DEBUG_PP_BIGINT
     cout << "BigInt( string ) digits " ;
@@ -304,43 +484,52 @@ BigInt::BigInt( const string & s )
 
     //  Use Horner's rule on base 10 numerals to convert decimal string
     //  of digits to base b.  e.g. 123 = 10 * (10 * ((10 * 0) + 1) + 2) + 3
-    for (auto & c : s)
+    //
+    //                                     k
+    //  Speed up by taking k numerals at once in base 10  <= b, i.e. 19 numerals for a
+    //  full 64-bit word digit, so we do only one multiprecision multiply and add per chunk.
+    //  The leading chunk holds the leftover numerals.
+    int chunkSize = static_cast<int>( len ) % k ;
+    if (chunkSize == 0)
+        chunkSize = k ;
+
+    for (size_t i = begin ;  i < end ;  i += chunkSize, chunkSize = k)
     {
-        w *= static_cast<ppuint>( 10u ) ;
+        ppuint chunk      = 0 ;
+        ppuint tenToChunk = 1 ;
 
-        // This only works for ASCII characters.
-        int digit = 0 ;
-        if (isdigit( c ))
-        {
-            char asciiDigit[ 2 ] ;
-            asciiDigit[ 0 ] = c ;
-            asciiDigit[ 1 ] = '\0' ;
-            digit = atoi( asciiDigit ) ;
-        }
-        else
+        for (size_t j = i ;  j < i + chunkSize ;  ++j)
         {
-            ostringstream os ;
-            os << "BigInt::BigInt( string )"
-               << "range error from character = " << c
-               << " at " << __FILE__ << ": line " << __LINE__ ;
-            throw BigIntRangeError( os.str() ) ;
-        }
+            // This only works for ASCII characters.
+            char c = s[ j ] ;
+            if (!isdigit( c ))
+            {
+                ostringstream os ;
+                os << "BigInt::BigInt( string )"
+                   << "range error from character = " << c
+                   << " at " << __FILE__ << ": line " << __LINE__ ;
+                throw BigIntRangeError( os.str() ) ;
+            }
 
-        #ifdef DEBUG_PP_BIGINT
-        cout << digit << " " ;
-        #endif
+            ppuint digit = static_cast<ppuint>( c - '0' ) ;
+
+            #ifdef DEBUG_PP_BIGINT
+            cout << digit << " " ;
+            #endif
 
-        w += static_cast<ppuint>( digit ) ;
+            chunk       = 10 * chunk + digit ;
+            tenToChunk *= 10 ;
+        }
+
+        w *= tenToChunk ;
+        w += chunk ;
     }
     
     #ifdef DEBUG_PP_BIGINT
     cout << endl ;
     #endif
 
-    // Swap the digits of w into this number.
-    swap( w.digit_, digit_ ) ;
-
-    // As we go out of scope, w's destructor will be called.
+    return w ;
 }
 
 
@@ -370,6 +559,29 @@ BigInt::BigInt( const BigInt & u )
 
 
 
+/*=============================================================================
+|
+| NAME
+|
+|     BigInt::BigInt( BigInt && )
+|
+| DESCRIPTION
+|
+|     Move constructor.  Takes over the heap digits of u if it has any, leaving u empty.
+|
+| EXAMPLE
+|
+|    BigInt v( u * w ) ;
+|
++============================================================================*/
+
+BigInt::BigInt( BigInt && u ) noexcept
+       : digit_( std::move( u.digit_ ) )
+{
+}
+
+
+
 /*=============================================================================
 |
 | NAME
@@ -394,7 +606,7 @@ BigInt & BigInt::operator=( const BigInt & n )
 
     try
     {
-        vector<ppuint> tempDigits( n.digit_ ) ;
+        BigIntDigits tempDigits( n.digit_ ) ;
     
         // Move the old values into the temporary, and the new values into the object.
         // The temporary containing the old values will be destroyed when we leave scope.
@@ -411,6 +623,31 @@ BigInt & BigInt::operator=( const BigInt & n )
 
 
 
+/*=============================================================================
+|
+| NAME
+|
+|     BigInt::operator=( BigInt && )
+|
+| DESCRIPTION
+|
+|    Move assignment operator.  Can't fail, so needs no temporary.
+|
+| EXAMPLE
+|
+|    BigInt m ;  m = n * n ;
+|
++============================================================================*/
+
+BigInt & BigInt::operator=( BigInt && n ) noexcept
+{
+    digit_ = std::move( n.digit_ ) ;
+
+    return *this ;
+}
+
+
+
 /*=============================================================================
 |
 | NAME
@@ -431,27 +668,27 @@ BigInt & BigInt::operator=( const BigInt & n )
 
 BigInt::operator ppuint() const
 {
-    ppuint result = 0 ;
-    ppuint b = base_() ;
+    ppuint2 result = 0 ;
+    ppuint2 b = fullBase( base_() ) ;
 
-    for (int i = static_cast<unsigned int>( digit_.size()) - 1 ;  i >= 0 ;  --i)
+    for (int i = static_cast<int>( digit_.size()) - 1 ;  i >= 0 ;  --i)
     {
-        // Check for overflow before it happens:  Will
-        // result * base + digit > (maximum unsigned integer)?
-        if (result > (numeric_limits<ppuint>::max() - digit_[ i ]) / b )
+        // Will result * base + digit > (maximum unsigned integer)?
+        // Since result fits into a ppuint, the double length number can't overflow.
+        result = result * b + digit_[ i ] ;
+
+        if (result > numeric_limits<ppuint>::max())
         {
             ostringstream os ;
             os << "BigInt::operator ppuint "
-               << "About to overflow, result = " << result
+               << "About to overflow, result "
                << "from digit = " << digit_[ i ]
                << " at " << __FILE__ << ": line " << __LINE__ ;
             throw BigIntOverflow( os.str() ) ;
         }
-        else
-            result = result * b + digit_[ i ] ;
     }
 
-    return result ;
+    return static_cast<ppuint>( result ) ;
 }
 
 
@@ -484,64 +721,173 @@ BigInt::operator ppuint() const
 
 string BigInt::to_string() const
 {
-   // ppuint b = base_() ; b ;
-    const ppuint decimalBase = static_cast<ppuint>( 10u ) ;
+    string s ;
+    toDecimal( *this, 0, s ) ;
 
-    // Output stream to hold the digits.
-    ostringstream os ;
-    string s = "" ;
+    return s ;
+}
 
-    // Pull out the decimal digits in reverse:
-    //
-    //    do until u == 0:
-    //        U = u mod 10
-    //        u = |  u / 10 |
-    //            --       --
-    BigInt u( *this ) ;
-
-    // Special cases.
-    if (u == BigInt( static_cast<ppuint>( 0u ) ))
-        return "0" ;
-    else if (u == BigInt( static_cast<ppuint>( 1u ) ))
-        return "1" ;
 
-    #ifdef DEBUG_PP_BIGINT
-    cout << "to_string digits = "  ;
-    #endif
 
-    while (u != BigInt( static_cast<ppuint>( 0u ) ))
+/*=============================================================================
+|
+| NAME
+|
+|     BigInt::toDecimal
+|
+| DESCRIPTION
+|
+|     Append the decimal numerals of u to the string s, zero filled on the
+|     left to numDecimals numerals.  numDecimals = 0 means no zero fill.
+|
+| METHOD
+|
+|     Small numbers divide out k numerals at a time, which is quadratic
+|     in the length.  Larger numbers divide by a cached power of 10 with
+|     about a quarter to a half as many digits,
+|
+|                      L                    L
+|     u = |  u / ( 10 )   |,  v = u mod ( 10 )
+|         --             --
+|
+|     and recurse on the quotient and on the remainder zero filled to L numerals.
+|     With fast division this is subquadratic.
+|
++============================================================================*/
+
+void BigInt::toDecimal( const BigInt & u, int numDecimals, string & s )
+{
+    int n = static_cast<int>( u.digit_.size() ) ;
+
+    ppuint tenToTheK = 0 ;
+    int    k         = decimalChunk( base_(), tenToTheK ) ;
+
+    if (n >= radixThreshold)
     {
-        ppuint digit = u % decimalBase ;
+        // Largest cached power with at most half the digits of u.
+        int level = 0 ;
+        while (2 * static_cast<int>( decimalPower( level ).digit_.size() ) <= (n + 1) / 2)
+            ++level ;
+
+        BigInt q, r ;
+        divMod( u, decimalPower( level ), q, r ) ;
+
+        int lowDecimals = k << level ;
+        toDecimal( q, numDecimals > 0 ? numDecimals - lowDecimals : 0, s ) ;
+        toDecimal( r, lowDecimals, s ) ;
+        return ;
+    }
+
+    // Pull out the decimal digits in reverse, k numerals at a time:
+    //
+    //    do until w == 0:
+    //                   k
+    //        U = w mod 10
+    //                     k
+    //        w = |  w / 10  |
+    //            --        --
+    BigInt w( u ) ;
+    BigInt q ;
+
+    ostringstream os ;
 
+    // Special case.
+    if (w == static_cast<ppuint>( 0u ))
+        os << "0" ;
+    else
+    {
         #ifdef DEBUG_PP_BIGINT
-        // This line was recursing in and out of BigInt::to_string and BigInt::printNumber, ending in a memory violation.
-        // cout << "to_string:  number to convert u = " ; printNumber( u, cout ) ;
-        cout << digit << " "  ;
+        cout << "to_string chunks = "  ;
         #endif
 
-        if (!(os << digit))
+        vector<ppuint> chunk ;
+        while (w != static_cast<ppuint>( 0u ))
         {
-            ostringstream os ;
-            os << "BigInt::to_string can't convert digit = " << digit
-               << " at " << __FILE__ << ": line " << __LINE__ ;
-                throw BigIntRangeError( os.str() ) ;
+            ppuint r ;
+            divMod( w, tenToTheK, q, r ) ;
+            swap( w.digit_, q.digit_ ) ;
+
+            #ifdef DEBUG_PP_BIGINT
+            // This line was recursing in and out of BigInt::to_string and BigInt::printNumber, ending in a memory violation.
+            // cout << "to_string:  number to convert u = " ; printNumber( u, cout ) ;
+            cout << r << " "  ;
+            #endif
+
+            chunk.push_back( r ) ;
         }
 
-        u /= decimalBase ;
+        #ifdef DEBUG_PP_BIGINT
+        cout << endl ;
+        #endif
+
+        // Leading chunk without leading zeros, then all others zero filled to k numerals.
+        os << chunk.back() ;
+        for (int i = static_cast<int>( chunk.size() ) - 2 ;  i >= 0 ;  --i)
+            os << setw( k ) << setfill( '0' ) << chunk[ i ] ;
+    }
+
+    if (!os)
+    {
+        ostringstream os ;
+        os << "BigInt::to_string can't convert digits "
+           << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw BigIntRangeError( os.str() ) ;
     }
-    
-    #ifdef DEBUG_PP_BIGINT
-    cout << endl ;
-    #endif
 
-    s = os.str() ;
-    reverse( s.begin(), s.end() ) ;
+    // Zero fill on the left.
+    string numerals = os.str() ;
+    if (static_cast<int>( numerals.size() ) < numDecimals)
+        s.append( numDecimals - numerals.size(), '0' ) ;
 
-    return s ;
+    s += numerals ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     BigInt::decimalPower
+|
+| DESCRIPTION
+|
+|                           k 2^i
+|     Return the power  10        for radix conversion where k numerals fit
+|     into one digit.  We compute each power once by squaring the one before
+|     and keep it until the base changes.
+|
++============================================================================*/
+
+const BigInt & BigInt::decimalPower( int i )
+{
+    // A deque doesn't move its elements as it grows, so references we hand out stay valid.
+    // Like the base, the table is per thread, so concurrent conversions don't race to fill it.
+    static thread_local deque<BigInt> power ;
+    static thread_local ppuint        powerBase = 1 ; // Not a valid base, so we fill the table on the first call.
+
+    if (powerBase != base_())
+    {
+        power.clear() ;
+        powerBase = base_() ;
+    }
+
+    if (power.empty())
+    {
+        ppuint tenToTheK = 0 ;
+        decimalChunk( base_(), tenToTheK ) ;
+        power.push_back( BigInt( tenToTheK ) ) ;
+    }
+
+    while (static_cast<int>( power.size() ) <= i)
+        power.push_back( power.back() * power.back() ) ;
+
+    return power[ i ] ;
 }
 
 
 
+
 /*=============================================================================
 |
 | NAME
@@ -651,13 +997,12 @@ istream & operator>>( istream & in, BigInt & u )
 |
 +============================================================================*/
 
-const BigInt operator+( const BigInt & u, const BigInt & v )
+BigInt operator+( BigInt u, const BigInt & v )
 {
     // Do + in terms of += to maintain consistency.
-    // Copy construct temporary copy and add to it.
-    // Return value optimization compiles away the copy constructor.
-    // const on return type disallows doing (u+v) = w ;
-    return BigInt( u ) += v ;
+    // u is our own copy, or the moved in temporary, so we can change it and return it.
+    u += v ;
+    return u ;
 }
 
 
@@ -690,12 +1035,12 @@ const BigInt operator+( const BigInt & u, const BigInt & v )
 |
 +============================================================================*/
 
-const BigInt operator+( const BigInt & u, ppuint d )
+BigInt operator+( BigInt u, ppuint d )
 {
     // Do + in terms of += to maintain consistency.
-    // Return value optimization compiles away the copy constructor.
-    // const on return type disallows doing (u+v) = w ;
-    return BigInt( u ) += d ;
+    // u is our own copy, or the moved in temporary, so we can change it and return it.
+    u += d ;
+    return u ;
 }
 
 
@@ -744,35 +1089,36 @@ BigInt & BigInt::operator+=( const BigInt & v )
 
     // Allocate temporary space for the sum.
     BigInt w ;
+    w.digit_.reserve( (m < n ? n : m) + 1 ) ;
 
-    ppuint carry = 0 ;  // Always < 2b
-    ppuint sum   = 0 ;  // Always in [0, 2b)
+    ppuint  carry = 0 ;  // Always 0 or 1
+    ppuint2 sum   = 0 ;  // Always in [0, 2b)
 
     //  Add and carry, starting with the least significant
     //  digits in each number.
     for (int i = 0 ;  i < (m < n ? m : n) ;  ++i)
     {
-        sum         = digit_[ i ] + v.digit_[ i ] + carry ;
+        sum         = static_cast<ppuint2>( digit_[ i ] ) + v.digit_[ i ] + carry ;
         // Can throw from argument operator=().
-        w.digit_.push_back( sum % b ) ;
-        carry       = sum / b ;
+        w.digit_.push_back( digitOf( sum, b ) ) ;
+        carry       = carryOf( sum, b ) ;
     }
 
     if (n < m)
         for (int i = n ;  i < m ;  ++i)
         {
-            sum         = 0 + v.digit_[ i ] + carry ;
+            sum         = static_cast<ppuint2>( v.digit_[ i ] ) + carry ;
             // Can throw from argument operator=().
-            w.digit_.push_back( sum % b ) ;
-            carry       = sum / b ;
+            w.digit_.push_back( digitOf( sum, b ) ) ;
+            carry       = carryOf( sum, b ) ;
         }
     else if (m < n)
         for (int i = m ;  i < n ;  ++i)
         {
-            sum         = digit_[ i ] + 0 + carry ;
+            sum         = static_cast<ppuint2>( digit_[ i ] ) + carry ;
             // Can throw from argument operator=().
-            w.digit_.push_back( sum % b ) ;
-            carry       = sum / b ;
+            w.digit_.push_back( digitOf( sum, b ) ) ;
+            carry       = carryOf( sum, b ) ;
         }
 
 
@@ -826,7 +1172,8 @@ BigInt & BigInt::operator+=( const ppuint d )
     int  n = static_cast<int>( digit_.size() ) ;
     ppuint b = base_() ;
 
-    if (d >= b)
+    // Any d is a single digit in the full word base.
+    if (b != 0 && d >= b)
     {
         // TODO:   We should do BigInt + here instead of aborting.
         ostringstream os ;
@@ -838,20 +1185,21 @@ BigInt & BigInt::operator+=( const ppuint d )
 
     // Allocate temporary space for the sum.
     BigInt w ;
+    w.digit_.reserve( n + 1 ) ;
 
     // Add the first digit.
-    ppuint sum   = digit_[ 0 ] + d ; // Always in [0, 2b)
-    w.digit_.push_back( sum % b ) ;
+    ppuint2 sum   = static_cast<ppuint2>( digit_[ 0 ] ) + d ; // Always in [0, 2b)
+    w.digit_.push_back( digitOf( sum, b ) ) ;
 
-    ppuint carry = sum / b ; // Always < 2b
+    ppuint carry = carryOf( sum, b ) ; // Always 0 or 1
 
     //  Add and carry in the other digits if needed.
     for (int i = 1 ;  i < n ;  ++i)
     {
-        sum         = digit_[ i ] + carry ;
+        sum         = static_cast<ppuint2>( digit_[ i ] ) + carry ;
         // Can throw from argument operator=().
-        w.digit_.push_back( sum % b ) ;
-        carry       = sum / b ;
+        w.digit_.push_back( digitOf( sum, b ) ) ;
+        carry       = carryOf( sum, b ) ;
     }
 
     // Add the carry digit as the most significant digit.
@@ -918,17 +1266,14 @@ BigInt & BigInt::operator++()
 |
 +============================================================================*/
 
-const BigInt BigInt::operator++( int ) // Dummy argument to distinguish postfix form.
+BigInt BigInt::operator++( int ) // Dummy argument to distinguish postfix form.
 {
     BigInt save = *this ;
 
     // Add 1 using prefix operator.
     ++(*this) ;
 
-    // Return const copy of original
-    // to prevent doing i++++ which is the same as i.operator++(0).operator++(0)
-    // which does i += 1, returns i, then does i += 1 which would increment
-    // by 1;  not what we wanted.
+    // Return the original value, moved out rather than copied.
     return save ;
 }
 
@@ -952,12 +1297,12 @@ const BigInt BigInt::operator++( int ) // Dummy argument to distinguish postfix
 |
 +============================================================================*/
 
-const BigInt operator-( const BigInt & u, const BigInt & v )
+BigInt operator-( BigInt u, const BigInt & v )
 {
     // Do - in terms of -= to maintain consistency.
-    // Return value optimization compiles away the copy constructor.
-    // const on return type disallows doing (u-v) = w ;
-    return BigInt( u ) -= v ;
+    // u is our own copy, or the moved in temporary, so we can change it and return it.
+    u -= v ;
+    return u ;
 }
 
 
@@ -980,12 +1325,12 @@ const BigInt operator-( const BigInt & u, const BigInt & v )
 |
 +============================================================================*/
 
-const BigInt operator-( const BigInt & u, const ppuint d )
+BigInt operator-( BigInt u, const ppuint d )
 {
     // Do - in terms of -= to maintain consistency.
-    // Return value optimization compiles away the copy constructor.
-    // const on return type disallows doing (u-v) = w ;
-    return BigInt( u ) -= d ;
+    // u is our own copy, or the moved in temporary, so we can change it and return it.
+    u -= d ;
+    return u ;
 }
 
 
@@ -1003,6 +1348,14 @@ const BigInt operator-( const BigInt & u, const ppuint d )
 |    Subtract u - v = (u1 ... un) - (v1 ... vm) = (w1 ... wn) = w.
 |    Assume u >= v.  If u < v, the carry is negative, and we abort.
 |
+|    Each digit difference is offset by b so it stays nonnegative,
+|
+|        t = b + u  - v  - borrow  in [0, 2b)
+|                 i    i
+|
+|    then w  = t mod b, and we borrow 1 from the next digit when t < b.
+|          i
+|
 +============================================================================*/
 
 BigInt & BigInt::operator-=( const BigInt & v )
@@ -1024,21 +1377,24 @@ BigInt & BigInt::operator-=( const BigInt & v )
     // Allocate temporary space for the difference.
     BigInt w ;
 
+    ppuint2 bb = fullBase( b ) ;
+    w.digit_.reserve( n ) ;
+
     // Subtract u - v starting with nth digits assuming n >= m.
     ppuint borrow = 0 ;
     for (int i = 0 ;  i < n ;  ++i)
     {
-        // t in [-b, b)
-        ppsint t = digit_[ i ] - (i >= m ? 0 : v.digit_[ i ]) + borrow ;
+        // t in [0, 2b)
+        ppuint2 t = bb + digit_[ i ] - (i >= m ? 0 : v.digit_[ i ]) - borrow ;
 
         // Subtract, allowing for where u < v and we must borrow.
         // Can throw from argument operator=().
-        w.digit_.push_back( (t > 0) ? t % b : (t + b) % b ) ;
+        w.digit_.push_back( digitOf( t, b ) ) ;
 
-        borrow = (t < 0) ? -1 : 0 ; // -1 if u - v + borrow < 0, else 0
+        borrow = (t < bb) ? 1 : 0 ; // 1 if u - v - borrow < 0, else 0
     }
 
-    if (borrow == -1)
+    if (borrow != 0)
     {
         ostringstream os ;
         os << "BigInt::operator-= " << " negative result for u - v = "
@@ -1077,8 +1433,10 @@ BigInt & BigInt::operator-=( const ppuint u )
     // Get the base and number of digits.
     ppuint b = base_() ;
     int  n = static_cast<int>( digit_.size()) ;
+    ppuint2 bb = fullBase( b ) ;
 
-    if (u >= b)
+    // Any u is a single digit in the full word base.
+    if (b != 0 && u >= b)
     {
         // TODO:   We should do BigInt - here instead of aborting.
         ostringstream os ;
@@ -1088,24 +1446,24 @@ BigInt & BigInt::operator-=( const ppuint u )
         throw BigIntUnderflow( os.str() ) ;
     }
 
-    // Subtract 1 from the least significant digit.
-    ppsint t = digit_[ 0 ] - u ;
+    // Subtract u from the least significant digit.
+    ppuint2 t = bb + digit_[ 0 ] - u ;
 
     // Subtract and allow for borrow.
-    digit_[ 0 ] = (t > 0) ? t % b : (t + b) % b ;
-    ppsint borrow  = (t < 0) ? -1 : 0 ; // -1 if u - 1 + borrow < 0, else 0
+    digit_[ 0 ] = digitOf( t, b ) ;
+    ppuint borrow = (t < bb) ? 1 : 0 ; // 1 if u - d < 0, else 0
 
     // Propagate the subtraction up to the (n-1)st digit.
-    for (int i = 1 ;  i < n ;  ++i)
+    for (int i = 1 ;  i < n && borrow != 0 ;  ++i)
     {
-        t = digit_[ i ] + borrow ;
+        t = bb + digit_[ i ] - borrow ;
 
         // Subtract and allow for borrow.
-        digit_[ i ] = (t > 0) ? t % b : (t + b) % b ;
-        borrow      = (t < 0) ? -1 : 0 ; // -1 if u - 1 + borrow < 0, else 0
+        digit_[ i ] = digitOf( t, b ) ;
+        borrow      = (t < bb) ? 1 : 0 ; // 1 if u - borrow < 0, else 0
     }
 
-    if (borrow == -1)
+    if (borrow != 0)
     {
         ostringstream os ;
         os << "BigInt::operator-= " << " underflow, borrow = -1 "
@@ -1147,26 +1505,27 @@ BigInt & BigInt::operator-=( const ppuint u )
 
 BigInt & BigInt::operator--()
 {
-    ppuint b = base_() ;
+    ppuint  b  = base_() ;
+    ppuint2 bb = fullBase( b ) ;
 
     // Subtract 1 from the least significant digit.
-    ppsint t = digit_[ 0 ] - 1 ;
+    ppuint2 t = bb + digit_[ 0 ] - 1 ;
 
     // Subtract and allow for borrow.
-    digit_[ 0 ] = (t > 0) ? t % b : (t + b) % b ;
-    ppsint borrow        = (t < 0) ? -1 : 0 ; // -1 if u - 1 + borrow < 0, else 0
+    digit_[ 0 ] = digitOf( t, b ) ;
+    ppuint borrow = (t < bb) ? 1 : 0 ; // 1 if u - 1 < 0, else 0
 
     // Subtract u - 1 starting with nth digits.
-    for (unsigned int i = 1 ;  i < digit_.size() ;  ++i)
+    for (unsigned int i = 1 ;  i < digit_.size() && borrow != 0 ;  ++i)
     {
-        t = digit_[ i ] + borrow ;
+        t = bb + digit_[ i ] - borrow ;
 
         // Subtract and allow for borrow.
-        digit_[ i ] = (t > 0) ? t % b : (t + b) % b ;
-        borrow        = (t < 0) ? -1 : 0 ; // -1 if u - 1 + borrow < 0, else 0
+        digit_[ i ] = digitOf( t, b ) ;
+        borrow      = (t < bb) ? 1 : 0 ; // 1 if u - borrow < 0, else 0
     }
 
-    if (borrow == -1)
+    if (borrow != 0)
     {
         ostringstream os ;
         os << "BigInt::operator-- " << " underflow, borrow = -1 "
@@ -1174,6 +1533,10 @@ BigInt & BigInt::operator--()
         throw BigIntUnderflow( os.str() ) ;
     }
 
+    // Trim a leading zero, but stop if u = 0.
+    while (digit_.size() > 1 && digit_.back() == 0)
+        digit_.pop_back() ;
+
     return *this ;
 }
 
@@ -1215,12 +1578,12 @@ BigInt BigInt::operator--( int )
 //  Multiply (u1 ... un) * digit = (w1 ... wn).
 //  Numbers are right justified, so that un and wn are in array
 //  location n.
-const BigInt operator*( const BigInt & u, const BigInt & v )
+BigInt operator*( BigInt u, const BigInt & v )
 {
     // Do * in terms of *= to maintain consistency.
-    // Return value optimization compiles away the copy constructor.
-    // const on return type disallows doing (u*v) = w ;
-    return BigInt( u ) *= v ;
+    // u is our own copy, or the moved in temporary, so we can change it and return it.
+    u *= v ;
+    return u ;
 }
 
 
@@ -1239,12 +1602,12 @@ const BigInt operator*( const BigInt & u, const BigInt & v )
 //  Multiply (u1 ... un) * digit = (w1 ... wn).
 //  Numbers are right justified, so that un and wn are in array
 //  location n.
-const BigInt operator*( const BigInt & u, const ppuint digit )
+BigInt operator*( BigInt u, const ppuint digit )
 {
     // Do * in terms of *= to maintain consistency.
-    // Return value optimization compiles away the copy constructor.
-    // const on return type disallows doing (u*v) = w ;
-    return BigInt( u ) *= digit ;
+    // u is our own copy, or the moved in temporary, so we can change it and return it.
+    u *= digit ;
+    return u ;
 }
 
 
@@ -1276,12 +1639,10 @@ const BigInt operator*( const BigInt & u, const ppuint digit )
 
 BigInt & BigInt::operator*=( const BigInt & v )
 {
-    // Pull out the number of digits and base.
+    // Pull out the number of digits.
     int m = static_cast<int>( digit_.size() ) ;
     int n = static_cast<int>( v.digit_.size() ) ;
 
-    ppuint b = base_() ;
-
     if (m  == 0 || n == 0)
     {
         ostringstream os ;
@@ -1291,8 +1652,124 @@ BigInt & BigInt::operator*=( const BigInt & v )
         throw BigIntMathError( os.str() ) ;
     }
 
-    // Allocate temporary space for the product.
+    // Squaring u * u needs only about half the digit products.
+    bool squaring = (this == &v) ;
+    if (!squaring && m == n)
+    {
+        squaring = true ;
+        for (int i = 0 ;  i < n && squaring ;  ++i)
+            squaring = (digit_[ i ] == v.digit_[ i ]) ;
+    }
+
+    // Compute the product into temporary space.
     BigInt w ;
+    multiply( *this, v, w, squaring ) ;
+
+    // Swap the digits of w into this number.
+    swap( w.digit_, digit_ ) ;
+
+    // Return (reference to) the product.
+    return *this ;
+
+    // As we go out of scope, w's destructor will be called.
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     multiply
+|
+| DESCRIPTION
+|
+|     w = u v for BigInts with no leading zero digits.
+|
+| METHOD
+|
+|     Pick the algorithm by the length n of the shorter number,
+|
+|     n < karatsubaThreshold     schoolbook O( n^2 )
+|     n < toom3Threshold         Karatsuba  O( n^1.585 )
+|     otherwise                  Toom-3     O( n^1.465 )
+|
+|     Schoolbook squaring does half the digit products, so it stays faster
+|     than Karatsuba up to the larger karatsubaSquareThreshold.
+|
+|     If u is twice as long as v or more, we cut u into pieces the length
+|     of v, multiply each by v and add the shifted partial products.
+|
++============================================================================*/
+
+void BigInt::multiply( const BigInt & u, const BigInt & v, BigInt & w, bool squaring )
+{
+    // Let u be the longer number.
+    const BigInt & u1 = (u.digit_.size() >= v.digit_.size()) ? u : v ;
+    const BigInt & v1 = (u.digit_.size() >= v.digit_.size()) ? v : u ;
+
+    int m = static_cast<int>( u1.digit_.size() ) ;
+    int n = static_cast<int>( v1.digit_.size() ) ;
+
+    if (n < (squaring ? karatsubaSquareThreshold : karatsubaThreshold))
+    {
+        if (squaring)
+            squareSchoolbook( u1, w ) ;
+        else
+            multiplySchoolbook( u1, v1, w ) ;
+    }
+    else if (m >= 2 * n)
+    {
+        w = static_cast<ppuint>( 0u ) ;
+        for (int k = 0 ;  k < m ;  k += n)
+        {
+            BigInt t ;
+            multiply( digitRange( u1, k, k + n ), v1, t, false ) ;
+            addShifted( w, t, k ) ;
+        }
+    }
+    else if (n < toom3Threshold)
+        multiplyKaratsuba( u1, v1, w, squaring ) ;
+    else
+        multiplyToom3( u1, v1, w, squaring ) ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     multiplySchoolbook
+|
+| DESCRIPTION
+|
+|    Multiply
+|
+|    (u    ...  u  )
+|      m-1       0  b
+|
+|      x
+|
+|    (v    ...  v  )
+|      n-1       0  b
+|
+|     =
+|
+|    (w    ...  w  )
+|      m+n-1     0  b
+|
+|    one digit of v at a time.
+|
++============================================================================*/
+
+void BigInt::multiplySchoolbook( const BigInt & u, const BigInt & v, BigInt & w )
+{
+    int m = static_cast<int>( u.digit_.size() ) ;
+    int n = static_cast<int>( v.digit_.size() ) ;
+
+    ppuint b = base_() ;
+
     try
     {
         w.digit_.resize( m + n ) ;
@@ -1300,7 +1777,7 @@ BigInt & BigInt::operator*=( const BigInt & v )
     catch( length_error & e )
     {
         ostringstream os ;
-        os << "\nBigInt::operator*=() could not resize to " << m+n << "digits \n"
+        os << "\nBigInt::multiplySchoolbook() could not resize to " << m+n << "digits \n"
            << "in file " << __FILE__ << " at line " << __LINE__ ;
 
         throw BigIntOverflow( os.str() ) ;
@@ -1316,39 +1793,422 @@ BigInt & BigInt::operator*=( const BigInt & v )
     for (int j = 0 ;  j < n ;  ++j)
     {
         // Skip if digit of v is zero.
-        if (v.digit_[ j ] == 0)
+        ppuint vj = v.digit_[ j ] ;
+        if (vj == 0)
         {
             w.digit_[ j + m ] = 0 ;
             continue ;
         }
 
-        // Multiply u by the jth digit of v.
+        // Multiply u by the jth digit of v.  t <= (b-1)^2 + 2 (b-1) < b^2 always fits into a double digit.
         carry = 0 ;
         for (int i = 0 ;  i < m ;  ++i)
         {
-            ppuint t = digit_[ i ] * v.digit_[ j ] + w.digit_[ i + j ] + carry ;
-            w.digit_[ i + j ] = t % b ;
-            carry             = t / b ;
+            ppuint2 t = static_cast<ppuint2>( u.digit_[ i ] ) * vj + w.digit_[ i + j ] + carry ;
+            w.digit_[ i + j ] = digitOf( t, b ) ;
+            carry             = carryOf( t, b ) ;
         }
 
         w.digit_[ j + m ] = carry ;
     }
 
-    // Trim a leading zero digit.
-    if (w.digit_[ m + n - 1 ] == 0)
+    // Trim leading zero digits, but stop if the product is 0.
+    while (w.digit_.size() > 1 && w.digit_.back() == 0)
+        w.digit_.pop_back() ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     squareSchoolbook
+|
+| DESCRIPTION
+|
+|          2
+|     w = u  for a BigInt u with n digits.
+|
+| METHOD
+|
+|      2                         2  2i              i+j
+|     u  =    sum   u  u  =  sum  u   b   + 2  sum  u  u  b
+|           0<=i,j<n i  j    i    i             i<j  i  j
+|
+|     so we form each cross product once, double the sum and add in the
+|     squares on the diagonal.  About n^2 / 2 digit products instead of n^2.
+|
++============================================================================*/
+
+void BigInt::squareSchoolbook( const BigInt & u, BigInt & w )
+{
+    int n = static_cast<int>( u.digit_.size() ) ;
+
+    ppuint b = base_() ;
+
+    try
+    {
+        w.digit_.assign( 2 * n, 0 ) ;
+    }
+    catch( length_error & e )
+    {
+        ostringstream os ;
+        os << "\nBigInt::squareSchoolbook() could not resize to " << 2*n << "digits \n"
+           << "in file " << __FILE__ << " at line " << __LINE__ ;
+
+        throw BigIntOverflow( os.str() ) ;
+    }
+
+    // Cross products u  u  for i < j.
+    //                  i  j
+    for (int i = 0 ;  i < n - 1 ;  ++i)
+    {
+        ppuint ui = u.digit_[ i ] ;
+        if (ui == 0)
+            continue ;
+
+        ppuint carry = 0 ;
+        for (int j = i + 1 ;  j < n ;  ++j)
+        {
+            ppuint2 t = static_cast<ppuint2>( ui ) * u.digit_[ j ] + w.digit_[ i + j ] + carry ;
+            w.digit_[ i + j ] = digitOf( t, b ) ;
+            carry             = carryOf( t, b ) ;
+        }
+
+        w.digit_[ i + n ] = carry ;
+    }
+
+    // Double the cross products.  The sum is < b^(2n-1) so the top digit can't overflow.
+    ppuint carry = 0 ;
+    for (int k = 0 ;  k < 2 * n ;  ++k)
     {
+        ppuint2 t = static_cast<ppuint2>( w.digit_[ k ] ) * 2 + carry ;
+        w.digit_[ k ] = digitOf( t, b ) ;
+        carry         = carryOf( t, b ) ;
+    }
+
+    //                  2
+    // Add the squares u  into digits 2i and 2i+1.
+    //                  i
+    carry = 0 ;
+    for (int i = 0 ;  i < n ;  ++i)
+    {
+        ppuint2 t = static_cast<ppuint2>( u.digit_[ i ] ) * u.digit_[ i ] + w.digit_[ 2 * i ] + carry ;
+        w.digit_[ 2 * i ] = digitOf( t, b ) ;
+        carry             = carryOf( t, b ) ;
+
+        t = static_cast<ppuint2>( w.digit_[ 2 * i + 1 ] ) + carry ;
+        w.digit_[ 2 * i + 1 ] = digitOf( t, b ) ;
+        carry                 = carryOf( t, b ) ;
+    }
+
+    // Trim leading zero digits, but stop if the product is 0.
+    while (w.digit_.size() > 1 && w.digit_.back() == 0)
         w.digit_.pop_back() ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     multiplyKaratsuba
+|
+| DESCRIPTION
+|
+|     w = u v where v has at least half as many digits as u.
+|
+| METHOD
+|
+|     Split at k = half the digits of u,
+|
+|                 k                     k
+|     u = u  b  + u      v = v  b  + v
+|          1       0          1       0
+|
+|     and recurse on three half length products,
+|
+|     z  = u  v      z  = u  v      z  = (u  + u ) (v  + v ) - z  - z
+|      0    0  0      2    1  1      1     0    1    0    1     0    2
+|
+|                 2k        k
+|     u v = z  b   + z  b  + z
+|            2         1      0
+|
++============================================================================*/
+
+void BigInt::multiplyKaratsuba( const BigInt & u, const BigInt & v, BigInt & w, bool squaring )
+{
+    int m = static_cast<int>( u.digit_.size() ) ;
+    int k = (m + 1) / 2 ;
+
+    BigInt u0 = digitRange( u, 0, k ) ;
+    BigInt u1 = digitRange( u, k, m ) ;
+
+    BigInt z0, z1, z2 ;
+
+    if (squaring)
+    {
+        multiply( u0, u0, z0, true ) ;
+        multiply( u1, u1, z2, true ) ;
+
+        BigInt s = u0 + u1 ;
+        multiply( s, s, z1, true ) ;
     }
+    else
+    {
+        int n = static_cast<int>( v.digit_.size() ) ;
 
-    // Swap the digits of w into this number.
-    swap( w.digit_, digit_ ) ;
+        BigInt v0 = digitRange( v, 0, k ) ;
+        BigInt v1 = digitRange( v, k, n ) ;
 
-    // Trim off leading zero digits.
+        multiply( u0, v0, z0, false ) ;
+        multiply( u1, v1, z2, false ) ;
+        multiply( u0 + u1, v0 + v1, z1, false ) ;
+    }
 
-    // Return (reference to) the sum.
-    return *this ;
+    z1 -= z0 ;
+    z1 -= z2 ;
 
-    // As we go out of scope, w's destructor will be called.
+    swap( w.digit_, z0.digit_ ) ;
+    addShifted( w, z1, k ) ;
+    addShifted( w, z2, 2 * k ) ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     multiplyToom3
+|
+| DESCRIPTION
+|
+|     w = u v where v has at least half as many digits as u.
+|
+| METHOD
+|
+|     Toom-Cook 3-way.  Split into thirds with x = b^k,
+|
+|                2                                2
+|     u(x) = u  x  + u  x + u         v(x) = v  x  + v  x + v
+|             2       1      0                2       1      0
+|
+|     Then r(x) = u(x) v(x) is a degree 4 polynomial.  Evaluate at the points
+|     0, 1, -1, -2 and infinity, do five one third length products and
+|     recover the coefficients by Bodrato's interpolation sequence,
+|
+|     r  = r(0)                r  = r(oo)
+|      0                        4
+|     r  = (r(-2) - r(1)) / 3
+|      3
+|     r  = (r(1) - r(-1)) / 2
+|      1
+|     r  = r(-1) - r(0)
+|      2
+|     r  = (r  - r ) / 2 + 2 r(oo)
+|      3     2    3
+|     r  = r  + r  - r
+|      2    2    1    4
+|     r  = r  - r
+|      1    1    3
+|
+|     The values at -1 and -2 can be negative, so we carry a sign along.
+|     All divisions are exact.
+|
++============================================================================*/
+
+// Signed magnitude for the Toom-3 evaluation and interpolation.
+struct SignedBigInt
+{
+    BigInt mag ;
+    bool   neg ;
+} ;
+
+//  x + y  or  x - y
+static SignedBigInt signedAdd( const SignedBigInt & x, const SignedBigInt & y, bool subtract = false )
+{
+    bool yneg = (y.neg != subtract) ;
+
+    if (x.neg == yneg)
+        return SignedBigInt{ x.mag + y.mag, x.neg } ;
+    else if (x.mag >= y.mag)
+    {
+        SignedBigInt z{ x.mag - y.mag, x.neg } ;
+        z.neg = z.neg && z.mag != static_cast<ppuint>( 0u ) ;
+        return z ;
+    }
+    else
+        return SignedBigInt{ y.mag - x.mag, yneg } ;
+}
+
+void BigInt::multiplyToom3( const BigInt & u, const BigInt & v, BigInt & w, bool squaring )
+{
+    int m = static_cast<int>( u.digit_.size() ) ;
+    int n = static_cast<int>( v.digit_.size() ) ;
+    int k = (m + 2) / 3 ;
+
+    // Evaluate at 0, 1, -1, -2 and infinity.
+    BigInt u0 = digitRange( u, 0, k ) ;
+    BigInt u1 = digitRange( u, k, 2 * k ) ;
+    BigInt u2 = digitRange( u, 2 * k, m ) ;
+
+    SignedBigInt s   { u0 + u2, false } ;
+    SignedBigInt up1 = signedAdd( s, SignedBigInt{ u1, false } ) ;
+    SignedBigInt um1 = signedAdd( s, SignedBigInt{ u1, false }, true ) ;
+    SignedBigInt um2 = signedAdd( um1, SignedBigInt{ u2, false } ) ;
+    um2.mag *= 2 ;
+    um2 = signedAdd( um2, SignedBigInt{ u0, false }, true ) ;
+
+    BigInt r0, r4 ;
+    SignedBigInt r1{ BigInt(), false }, rm1{ BigInt(), false }, rm2{ BigInt(), false } ;
+
+    if (squaring)
+    {
+        multiply( u0,      u0,      r0,      true ) ;
+        multiply( up1.mag, up1.mag, r1.mag,  true ) ;
+        multiply( um1.mag, um1.mag, rm1.mag, true ) ;
+        multiply( um2.mag, um2.mag, rm2.mag, true ) ;
+        multiply( u2,      u2,      r4,      true ) ;
+    }
+    else
+    {
+        BigInt v0 = digitRange( v, 0, k ) ;
+        BigInt v1 = digitRange( v, k, 2 * k ) ;
+        BigInt v2 = digitRange( v, 2 * k, n ) ;
+
+        SignedBigInt t   { v0 + v2, false } ;
+        SignedBigInt vp1 = signedAdd( t, SignedBigInt{ v1, false } ) ;
+        SignedBigInt vm1 = signedAdd( t, SignedBigInt{ v1, false }, true ) ;
+        SignedBigInt vm2 = signedAdd( vm1, SignedBigInt{ v2, false } ) ;
+        vm2.mag *= 2 ;
+        vm2 = signedAdd( vm2, SignedBigInt{ v0, false }, true ) ;
+
+        multiply( u0,      v0,      r0,      false ) ;
+        multiply( up1.mag, vp1.mag, r1.mag,  false ) ;
+        multiply( um1.mag, vm1.mag, rm1.mag, false ) ;
+        multiply( um2.mag, vm2.mag, rm2.mag, false ) ;
+        multiply( u2,      v2,      r4,      false ) ;
+
+        rm1.neg = (um1.neg != vm1.neg) && rm1.mag != static_cast<ppuint>( 0u ) ;
+        rm2.neg = (um2.neg != vm2.neg) && rm2.mag != static_cast<ppuint>( 0u ) ;
+    }
+
+    // Interpolate.
+    SignedBigInt r3 = signedAdd( rm2, r1, true ) ;
+    r3.mag /= static_cast<ppuint>( 3u ) ;
+
+    r1 = signedAdd( r1, rm1, true ) ;
+    r1.mag /= static_cast<ppuint>( 2u ) ;
+
+    SignedBigInt r2 = signedAdd( rm1, SignedBigInt{ r0, false }, true ) ;
+
+    r3 = signedAdd( r2, r3, true ) ;
+    r3.mag /= static_cast<ppuint>( 2u ) ;
+    r3 = signedAdd( r3, SignedBigInt{ r4 * static_cast<ppuint>( 2u ), false } ) ;
+
+    r2 = signedAdd( r2, r1 ) ;
+    r2 = signedAdd( r2, SignedBigInt{ r4, false }, true ) ;
+
+    r1 = signedAdd( r1, r3, true ) ;
+
+    // The coefficients of the product are nonnegative;  recombine them.
+    swap( w.digit_, r0.digit_ ) ;
+    addShifted( w, r1.mag, k ) ;
+    addShifted( w, r2.mag, 2 * k ) ;
+    addShifted( w, r3.mag, 3 * k ) ;
+    addShifted( w, r4,     4 * k ) ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     digitRange, shiftDigits, addShifted
+|
+| DESCRIPTION
+|
+|     Split and recombine numbers by whole digits for the subquadratic
+|     multiply and divide.  Results have no leading zero digits.
+|
++============================================================================*/
+
+BigInt BigInt::digitRange( const BigInt & u, int lo, int hi )
+{
+    int n = static_cast<int>( u.digit_.size() ) ;
+    if (hi > n)
+        hi = n ;
+
+    // Skip leading zero digits.
+    while (hi > lo && u.digit_[ hi - 1 ] == 0)
+        --hi ;
+
+    BigInt w ;
+    if (hi <= lo)
+        w.digit_.assign( 1, 0 ) ;
+    else
+    {
+        w.digit_.resize( hi - lo ) ;
+        for (int i = lo ;  i < hi ;  ++i)
+            w.digit_[ i - lo ] = u.digit_[ i ] ;
+    }
+
+    return w ;
+}
+
+BigInt BigInt::shiftDigits( const BigInt & u, int k )
+{
+    int n = static_cast<int>( u.digit_.size() ) ;
+
+    // Zero stays zero.
+    if (k == 0 || (n == 1 && u.digit_[ 0 ] == 0))
+        return u ;
+
+    BigInt w ;
+    w.digit_.assign( n + k, 0 ) ;
+    for (int i = 0 ;  i < n ;  ++i)
+        w.digit_[ i + k ] = u.digit_[ i ] ;
+
+    return w ;
+}
+
+void BigInt::addShifted( BigInt & w, const BigInt & u, int k )
+{
+    int n = static_cast<int>( u.digit_.size() ) ;
+
+    // Adding zero.
+    if (n == 1 && u.digit_[ 0 ] == 0)
+        return ;
+
+    ppuint b = base_() ;
+
+    if (static_cast<int>( w.digit_.size() ) < n + k)
+        w.digit_.resize( n + k ) ;
+
+    int    m     = static_cast<int>( w.digit_.size() ) ;
+    ppuint carry = 0 ;
+
+    for (int i = 0 ;  i < n ;  ++i)
+    {
+        ppuint2 t = static_cast<ppuint2>( w.digit_[ i + k ] ) + u.digit_[ i ] + carry ;
+        w.digit_[ i + k ] = digitOf( t, b ) ;
+        carry             = carryOf( t, b ) ;
+    }
+
+    for (int i = n + k ;  carry != 0 && i < m ;  ++i)
+    {
+        ppuint2 t = static_cast<ppuint2>( w.digit_[ i ] ) + carry ;
+        w.digit_[ i ] = digitOf( t, b ) ;
+        carry         = carryOf( t, b ) ;
+    }
+
+    if (carry != 0)
+        w.digit_.push_back( carry ) ;
 }
 
 
@@ -1380,8 +2240,10 @@ BigInt & BigInt::operator*=( ppuint d )
 
     // Allocate temporary space for the product.
     BigInt w ;
+    w.digit_.reserve( n + 1 ) ;
 
-    if (d > b)
+    // Any d is a single digit in the full word base.
+    if (b != 0 && d > b)
     {
         // TODO:   We should do BigInt * here instead of aborting.
         //      w *= static_cast<BigInt>( d ) ;
@@ -1393,7 +2255,7 @@ BigInt & BigInt::operator*=( ppuint d )
     }
     // In this special case, we just shift digits left and zero fill.
     // But do nothing if the number is zero.
-    else if (d == b && *this != static_cast<BigInt>( static_cast<ppuint>( 0u )))
+    else if (b != 0 && d == b && *this != static_cast<ppuint>( 0u ))
     {
         w.digit_.push_back( 0 ) ;
 
@@ -1407,17 +2269,17 @@ BigInt & BigInt::operator*=( ppuint d )
         // Multiply digits and carry.
         for (int i = 0 ;  i < n ;  ++i)
         {
-            ppuint t = digit_[ i ] * d + carry ;
-            ppuint r = t % b ;
+            ppuint2 t = static_cast<ppuint2>( digit_[ i ] ) * d + carry ;
+            ppuint  r = digitOf( t, b ) ;
 
             w.digit_.push_back( r ) ;
-            carry = t / b ;
+            carry = carryOf( t, b ) ;
 
             #ifdef DEBUG_PP_BIGINT
             cout << "BigInt::operator*=(ppuint)" << endl ;
             cout << "d        = " << d << endl ;
             cout << "digit[i] = " << digit_[ i ] << " i = " << i << endl ;
-            cout << "t        = " << t << endl ;
+            cout << "t        = " << static_cast<ppuint>( t ) << endl ;
             cout << "r        = " << r << endl ;
             cout << "carry    = " << carry << endl ;
             #endif
@@ -1426,6 +2288,10 @@ BigInt & BigInt::operator*=( ppuint d )
         // Additional carry beyond the nth digit.
         if (carry)
             w.digit_.push_back( carry ) ;
+
+        // Zero times d or u times zero.
+        while (w.digit_.size() > 1 && w.digit_.back() == 0)
+            w.digit_.pop_back() ;
     }
 
     // Swap the digits of w into this number.
@@ -1455,12 +2321,12 @@ BigInt & BigInt::operator*=( ppuint d )
 |
 +============================================================================*/
 
-const BigInt operator/( const BigInt & u, const BigInt & v )
+BigInt operator/( BigInt u, const BigInt & v )
 {
     // Do / in terms of /= to maintain consistency.
-    // Return value optimization compiles away the copy constructor.
-    // const on return type disallows doing (u/v) = w ;
-    return BigInt( u ) /= v ;
+    // u is our own copy, or the moved in temporary, so we can change it and return it.
+    u /= v ;
+    return u ;
 }
 
 
@@ -1492,12 +2358,12 @@ BigInt & BigInt::operator/=( const BigInt & v )
 |
 +============================================================================*/
 
-const BigInt operator/( const BigInt & u, ppuint d )
+BigInt operator/( BigInt u, ppuint d )
 {
     // Do / in terms of /= to maintain consistency.
-    // Return value optimization compiles away the copy constructor.
-    // const on return type disallows doing (u/v) = w ;
-    return BigInt( u ) /= d ;
+    // u is our own copy, or the moved in temporary, so we can change it and return it.
+    u /= d ;
+    return u ;
 }
 
 /*=============================================================================
@@ -1629,8 +2495,8 @@ void divMod( const BigInt & u,
     if (q.digit_.size() > 0)
         q.digit_.clear() ;
 
-    // Call multiprecision divide.
-    if (d > b)
+    // Call multiprecision divide.  Any d is a single digit in the full word base.
+    if (b != 0 && d > b)
     { 
         // TODO:   We should do BigInt divMod here instead of aborting.
         //    BigInt rr ;
@@ -1643,7 +2509,7 @@ void divMod( const BigInt & u,
         throw BigIntOverflow( os.str() ) ;
     }
     // In this special case, we just shift digits right.
-    else if (d == b)
+    else if (b != 0 && d == b)
     {
         r = 0 ;
         
@@ -1664,32 +2530,259 @@ void divMod( const BigInt & u,
             for (int j = 1 ; j <= n-1 ;  ++j)
                 q.digit_.push_back( u.digit_[ j ] ) ;
 
-            #ifdef DEBUG_PP_BIGINT
-            cout << "BigInt::divMod: the special case of divisor d = " << d << " equals " << " base b = " << b << endl ;
-            #endif
-        }
-    }
+            #ifdef DEBUG_PP_BIGINT
+            cout << "BigInt::divMod: the special case of divisor d = " << d << " equals " << " base b = " << b << endl ;
+            #endif
+        }
+    }
+    else
+    {
+        r = 0 ;
+        ppuint2 bb = fullBase( b ) ;
+        q.digit_.resize( n ) ;
+
+        // Long division from most to least significant digit.
+        // Since r < d, the quotient digit of t = r b + u  fits into a digit.
+        //                                               j
+        for (int j = n - 1 ; j >= 0 ;  --j)
+        {
+            ppuint2 t     = r * bb + u.digit_[ j ] ;
+            q.digit_[ j ] = divideDigit( t, d, r ) ;
+        }
+
+        // Trim leading zeros, if any, but stop if q = 0.
+        while (q.digit_.size() > 1 && q.digit_.back() == 0)
+            q.digit_.pop_back() ;
+    }
+
+    return ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     divMod
+|
+| DESCRIPTION
+|
+|     Compute u / v = q, r where all quantities are BigInts.
+|
+|     u = q v + r,  0 <= r < v
+|
+|     Throw BigIntZeroDivide if v = 0.
+|
+| METHOD
+|
+|     Knuth's Algorithm D takes O( m n ) digit operations for an m+n digit u
+|     and n digit v.  When both the divisor and the quotient are long, we
+|     divide recursively by the method of Burnikel and Ziegler instead, which
+|     is about twice the cost of a multiplication of the same size.
+|
++============================================================================*/
+
+void divMod( const BigInt & u, 
+             const BigInt & v,
+             BigInt &       q, 
+             BigInt &       r )
+{
+    int m_n = static_cast<int>( u.digit_.size()) ;
+    int n   = static_cast<int>( v.digit_.size()) ;
+
+    if (n >= BigInt::bzThreshold && m_n - n >= BigInt::bzThreshold)
+        BigInt::divModRecursive( u, v, q, r ) ;
+    else
+        BigInt::divModKnuth( u, v, q, r ) ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     divModRecursive
+|
+| DESCRIPTION
+|
+|     Compute u / v = q, r by recursive division.
+|
+| METHOD
+|
+|     C. Burnikel and J. Ziegler, "Fast Recursive Division",
+|     Max-Planck-Institut fuer Informatik Research Report MPI-I-98-1-022, 1998.
+|
+|     Normalize v so its leading digit is >= b/2 and pad it with low order
+|     zero digits to a length n = j 2^k which halves down to the Knuth
+|     threshold.  Cut u into t blocks of n digits, the leading block smaller
+|     than v.  Then divide two blocks by one block from left to right, each
+|     remainder becoming the top block of the next step.
+|
++============================================================================*/
+
+void BigInt::divModRecursive( const BigInt & u, const BigInt & v, BigInt & q, BigInt & r )
+{
+    ppuint2 bb = fullBase( base_() ) ;
+    int     s  = static_cast<int>( v.digit_.size() ) ;
+
+    // Block length nBlock = j m where m = 2^k and j < bzThreshold.
+    int m = 1 ;
+    while (m * bzThreshold <= s)
+        m *= 2 ;
+
+    int j      = (s + m - 1) / m ;
+    int nBlock = j * m ;
+    int sigma  = nBlock - s ;
+
+    // Normalize as in Knuth's Algorithm D.  The leading digit of v d will be >= b/2.
+    ppuint d = static_cast<ppuint>( bb / (static_cast<ppuint2>( v.digit_[ s - 1 ] ) + 1) ) ;
+
+    BigInt B = shiftDigits( d == 1 ? v : v * d, sigma ) ;
+    BigInt A = shiftDigits( d == 1 ? u : u * d, sigma ) ;
+
+    // Number of blocks of A, allowing one extra digit so the leading block is < B.
+    int t = (static_cast<int>( A.digit_.size() ) + 1 + nBlock - 1) / nBlock ;
+    if (t < 2)
+        t = 2 ;
+
+    BigInt Q( static_cast<ppuint>( 0u ) ) ;
+    BigInt R ;
+    BigInt Z = digitRange( A, (t - 2) * nBlock, t * nBlock ) ;
+
+    for (int i = t - 2 ;  i >= 0 ;  --i)
+    {
+        BigInt qi ;
+        divide2n1n( Z, B, nBlock, qi, R ) ;
+        addShifted( Q, qi, i * nBlock ) ;
+
+        //                 n
+        //  Next Z = R  b   + (next block of A)
+        if (i > 0)
+        {
+            Z = shiftDigits( R, nBlock ) ;
+            addShifted( Z, digitRange( A, (i - 1) * nBlock, i * nBlock ), 0 ) ;
+        }
+    }
+
+    // Undo the normalization of the remainder.  The sigma padding digits are zero.
+    R = digitRange( R, sigma, static_cast<int>( R.digit_.size() ) ) ;
+    if (d != 1)
+        R /= d ;
+
+    swap( q.digit_, Q.digit_ ) ;
+    swap( r.digit_, R.digit_ ) ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     divide2n1n
+|
+| DESCRIPTION
+|
+|                              n
+|     a / v = q, r where a < v b  and v is a normalized n digit number.
+|
+| METHOD
+|
+|     With h = n/2, split a into h digit blocks a1 a2 a3 a4 and do two
+|     3 by 2 block divisions (a1 a2 a3) / v = q1, r1  and  (r1 a4) / v = q2, r.
+|     Then q = (q1 q2).  Use Knuth's Algorithm D for odd or small n.
+|
++============================================================================*/
+
+void BigInt::divide2n1n( const BigInt & a, const BigInt & v, int n, BigInt & q, BigInt & r )
+{
+    if (n % 2 != 0 || n < bzThreshold)
+    {
+        divModKnuth( a, v, q, r ) ;
+        return ;
+    }
+
+    int h = n / 2 ;
+
+    BigInt q1, r1 ;
+    divide3n2n( digitRange( a, h, static_cast<int>( a.digit_.size() ) ), v, h, q1, r1 ) ;
+
+    BigInt a2 = shiftDigits( r1, h ) ;
+    addShifted( a2, digitRange( a, 0, h ), 0 ) ;
+
+    BigInt q2 ;
+    divide3n2n( a2, v, h, q2, r ) ;
+
+    q = shiftDigits( q1, h ) ;
+    addShifted( q, q2, 0 ) ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     divide3n2n
+|
+| DESCRIPTION
+|
+|                              h
+|     a / v = q, r where a < v b  and v is a normalized 2h digit number.
+|
+| METHOD
+|
+|     Split a into h digit blocks (a1 a2 a3) and v into (v1 v2).
+|
+|     Estimate q^ = (a1 a2) / v1 recursively, or q^ = b^h - 1 if a1 = v1.
+|     Then with
+|                             h                      ^
+|     remainder r1 = (a1 a2) - q^ v1,  x = r1 b  + a3,  d = q v2
+|
+|     the true remainder is x - d.  Because v is normalized, the estimate
+|     q^ is at most 2 too large and we correct it by adding back v.
+|
++============================================================================*/
+
+void BigInt::divide3n2n( const BigInt & a, const BigInt & v, int h, BigInt & q, BigInt & r )
+{
+    BigInt v1  = digitRange( v, h,     2 * h ) ;
+    BigInt v2  = digitRange( v, 0,     h ) ;
+    BigInt a1  = digitRange( a, 2 * h, 3 * h ) ;
+    BigInt a12 = digitRange( a, h,     3 * h ) ;
+
+    BigInt qhat, r1 ;
+    if (a1 < v1)
+        divide2n1n( a12, v1, h, qhat, r1 ) ;
     else
     {
-        r = 0 ;
+        //    ^    h                                    h
+        //    q = b  - 1 and r1 = (a1 a2) - (v1 b  - v1)
+        qhat.digit_.assign( h, static_cast<ppuint>( fullBase( base_() ) - 1 ) ) ;
 
-        // Long division from most to least significant digit.
-        for (int j = n - 1 ; j >= 0 ;  --j)
-        {
-            ppuint t         = r * b + u.digit_[ j ] ;
-            q.digit_.push_back( t / d ) ;
-            r             = t % d ;
-        }
+        r1 = a12 - shiftDigits( v1, h ) ;
+        r1 += v1 ;
+    }
 
-        // Put the digits into correct order.
-        reverse( q.digit_.begin(), q.digit_.end() ) ;
+    BigInt dhat ;
+    multiply( qhat, v2, dhat, false ) ;
 
-        // Trim leading zeros, if any, but stop if q = 0.
-        while (q.digit_.size() > 1 && q.digit_.back() == 0)
-            q.digit_.pop_back() ;
+    BigInt x = shiftDigits( r1, h ) ;
+    addShifted( x, digitRange( a, 0, h ), 0 ) ;
+
+    // Add back v until the remainder is nonnegative.
+    while (x < dhat)
+    {
+        x += v ;
+        --qhat ;
     }
 
-    return ;
+    x -= dhat ;
+
+    swap( q.digit_, qhat.digit_ ) ;
+    swap( r.digit_, x.digit_ ) ;
 }
 
 
@@ -1698,7 +2791,7 @@ void divMod( const BigInt & u,
 |
 | NAME
 |
-|     divMod
+|     divModKnuth
 |
 | DESCRIPTION
 |
@@ -1829,12 +2922,13 @@ void divMod( const BigInt & u,
 |
 +============================================================================*/
 
-void divMod( const BigInt & u, 
-             const BigInt & v,
-             BigInt &       q, 
-             BigInt &       r )
+void BigInt::divModKnuth( const BigInt & u, 
+                           const BigInt & v,
+                           BigInt &       q, 
+                           BigInt &       r )
 {
-    ppuint b   = u.base_() ;
+    ppuint  b   = u.base_() ;
+    ppuint2 bb  = fullBase( b ) ;
     int  m_n = static_cast<int>( u.digit_.size()) ;
     int  n   = static_cast<int>( v.digit_.size()) ;
     int  m   = m_n - n ; //  Compute m from the fact that u has m + n digits, and v has n digits.
@@ -1951,8 +3045,8 @@ void divMod( const BigInt & u,
         throw BigIntZeroDivide( os.str() ) ;
     }
 
-    //  Normalizer.
-    ppuint d = b / (v2.digit_[ n-1 ] + 1) ;
+    //  Normalizer.  Leading digit of v times d will be >= b/2.
+    ppuint d = static_cast<ppuint>( bb / (static_cast<ppuint2>( v2.digit_[ n-1 ] ) + 1) ) ;
 
 #ifdef DEBUG_PP_BIGINT
     cout << "\tnormalizer d = " << d << endl ;
@@ -1971,10 +3065,10 @@ void divMod( const BigInt & u,
         ppuint carry = 0 ;
         for (int j = 0 ;  j <= m + n - 1 ;  ++j)
         {
-            ppuint t = u2.digit_[ j ] * d + carry ;
+            ppuint2 t = static_cast<ppuint2>( u2.digit_[ j ] ) * d + carry ;
 
-            u2.digit_[ j ] = t % b ;
-            carry          = t / b ;
+            u2.digit_[ j ] = digitOf( t, b ) ;
+            carry          = carryOf( t, b ) ;
         }
         u2.digit_[ m+n ] = carry ;
 
@@ -1985,10 +3079,10 @@ void divMod( const BigInt & u,
         carry = 0 ;
         for (int j = 0 ;  j <= n-1 ;  ++j)
         {
-            ppuint t = v2.digit_[ j ] * d + carry ;
+            ppuint2 t = static_cast<ppuint2>( v2.digit_[ j ] ) * d + carry ;
 
-            v2.digit_[ j ] = t % b ;
-            carry          = t / b ;
+            v2.digit_[ j ] = digitOf( t, b ) ;
+            carry          = carryOf( t, b ) ;
         }
 
         // No carry can occur, so flag an error if it happens.
@@ -2026,29 +3120,42 @@ void divMod( const BigInt & u,
         //       |       n-1         |
         //       --                 --
         //
-        ppuint temp = u2.digit_[ j+n ] * b + u2.digit_[ j+n-1 ] ;
-        ppuint q2   = temp / v2.digit_[ n-1 ] ;
-        ppuint r2   = temp % v2.digit_[ n-1 ] ;
+        //  The top digits can be equal giving a trial quotient b, too big for the one instruction divide.
+        ppuint2 temp = u2.digit_[ j+n ] * bb + u2.digit_[ j+n-1 ] ;
+        ppuint2 q2 ;
+        ppuint2 r2 ;
+
+        if (u2.digit_[ j+n ] < v2.digit_[ n-1 ])
+        {
+            ppuint r2Digit ;
+            q2 = divideDigit( temp, v2.digit_[ n-1 ], r2Digit ) ;
+            r2 = r2Digit ;
+        }
+        else
+        {
+            q2 = temp / v2.digit_[ n-1 ] ;
+            r2 = temp % v2.digit_[ n-1 ] ;
+        }
 
 #ifdef DEBUG_PP_BIGINT
-        cout << "\ttrial quotient q2 = " << q2 << " r2 = " << r2 << endl ;
+        cout << "\ttrial quotient q2 = " << static_cast<ppuint>( q2 ) << " r2 = " << static_cast<ppuint>( r2 ) << endl ;
 #endif
 
-        // Correction if necessary.
-        if (q2 >= b || (q2 * v2.digit_[ n-2 ] > b * r2 + u2.digit_[ j+n-2 ]))
+        // Correction if necessary.  If q2 < b and r2 < b, none of the double digit products overflow.
+        if (q2 >= bb || (q2 * v2.digit_[ n-2 ] > bb * r2 + u2.digit_[ j+n-2 ]))
         {
             --q2 ;
             r2 += v2.digit_[ n-1 ] ;
         }
 
 #ifdef DEBUG_PP_BIGINT
-        cout << "\tcorrected trial quotient q2 = " << q2 << " r2 = " << r2 << endl ;
+        cout << "\tcorrected trial quotient q2 = " << static_cast<ppuint>( q2 ) << " r2 = " << static_cast<ppuint>( r2 ) << endl ;
 #endif
 
         // Low probability repeat correction if necessary.
-        if (r2 < b)
+        if (r2 < bb)
         {
-            if (q2 >= b || (q2 * v2.digit_[ n-2 ] > b * r2 + u2.digit_[ j+n-2 ]))
+            if (q2 >= bb || (q2 * v2.digit_[ n-2 ] > bb * r2 + u2.digit_[ j+n-2 ]))
             {
                 --q2 ;
                 // We don't use the remainder since this is the last correction.
@@ -2057,11 +3164,11 @@ void divMod( const BigInt & u,
         }
         
 #ifdef DEBUG_PP_BIGINT
-        cout << "\trepeat corrected trial quotient q2 = " << q2 << " r2 = " << r2 << endl ;
+        cout << "\trepeat corrected trial quotient q2 = " << static_cast<ppuint>( q2 ) << " r2 = " << static_cast<ppuint>( r2 ) << endl ;
 #endif
 
 #ifdef DEBUG_PP_BIGINT
-        cout << "\tfinal trial quotient q2 = " << q2 << " r2 = " << r2 << endl ;
+        cout << "\tfinal trial quotient q2 = " << static_cast<ppuint>( q2 ) << " r2 = " << static_cast<ppuint>( r2 ) << endl ;
 #endif
 
         // Multiply and subtract:
@@ -2076,35 +3183,23 @@ void divMod( const BigInt & u,
         //         (u    u      ... u  )
         //           j+n  j+n-1      j
 
-        ppsint borrow = 0 ;
+        //  Each digit of q2 v is split into a digit and a carry to the next product;  the
+        //  digit subtraction is offset by b to stay nonnegative as in operator-=.
+        ppuint carry  = 0 ;
+        ppuint borrow = 0 ;
         for (int i = 0 ;  i <= n ;  ++i)
         {
-            ppsint t2  = borrow + u2.digit_[ j + i ] - q2 * v2.digit_[ i ] ;
+            ppuint2 p  = q2 * v2.digit_[ i ] + carry ;
+            carry      = carryOf( p, b ) ;
 
-#ifdef DEBUG_PP_BIGINT
-            cout << "\t\ti = " << i << " j+i = " << j+i << " q2 = " << q2 << " borrow = " << borrow << endl ;
-            cout << "\t\tv2[ i ] = " << getDigit( v2, i ) << " u2[j+i] = " << getDigit( u2, j+i ) << " t2 = " << t2 << endl ;
-#endif
+            ppuint2 t2 = bb + u2.digit_[ j + i ] - digitOf( p, b ) - borrow ;
 
-            // Digit subtraction is positive:  don't need to borrow.
-            if (t2 >= 0)
-            {
-                u2.digit_[ j + i ] = t2 ;
-                borrow = 0 ;
-            }
-            //  If t2 is negative, we need to borrow.
-            else
-            {
-                    // e.g. t = -1 -> -10,
-                    // borrow = floor( (t+1)/b ) - 1 = 0/10 - 1 -> -9/10 - 1 => -1;
-                    //  -11 -> -20:  borrow -2
-                    borrow = -1 + (t2 + 1) / (ppsint) b ;
+            u2.digit_[ j + i ] = digitOf( t2, b ) ;
+            borrow             = (t2 < bb) ? 1 : 0 ;
 
-                    // Add the positive borrow to the digit to force it positive.
-                    u2.digit_[ j + i ] = -borrow * (ppsint) b + t2 ;
-            }
 #ifdef DEBUG_PP_BIGINT
-            cout << "\t\tcorrected borrow = " << borrow << "u2.[j+i] = "<< getDigit( u2,j+i ) << endl ;
+            cout << "\t\ti = " << i << " j+i = " << j+i << " q2 = " << static_cast<ppuint>( q2 ) << " borrow = " << borrow << endl ;
+            cout << "\t\tv2[ i ] = " << getDigit( v2, i ) << " u2[j+i] = " << getDigit( u2, j+i ) << endl ;
 #endif
         }
 
@@ -2117,7 +3212,7 @@ void divMod( const BigInt & u,
 #endif
 
         // Save the quotient.
-        q.digit_[ j ] = q2 ;
+        q.digit_[ j ] = static_cast<ppuint>( q2 ) ;
 
 
         // Decrease q2 and add back correction if q2 is too big.
@@ -2134,17 +3229,17 @@ void divMod( const BigInt & u,
         //
         // Ignore the carry to the left of u    since it cancels with the earlier borrow.
         //                                  n+j
-        if (borrow < 0)
+        if (borrow != 0)
         {
             --q.digit_[ j ] ;
 
-            ppuint carry = 0 ;
+            carry = 0 ;
             for (int i = 0 ;  i <= n ;  ++i)
             {
-               ppsint t = u2.digit_[ j + i ] + v2.digit_[ i ] + carry ;
+                ppuint2 t = static_cast<ppuint2>( u2.digit_[ j + i ] ) + v2.digit_[ i ] + carry ;
 
-                u2.digit_[ j + i ] = t % b ;
-                carry              = t / b ;
+                u2.digit_[ j + i ] = digitOf( t, b ) ;
+                carry              = carryOf( t, b ) ;
             }
         }
     } // end for j
@@ -2170,13 +3265,12 @@ void divMod( const BigInt & u,
         ppuint remainder = 0 ;
         for (int j = n-1 ;  j >= 0 ;  --j)
         {
-            ppuint t = u2.digit_[ j ] + remainder * b ;
+            ppuint2 t = u2.digit_[ j ] + remainder * bb ;
 
-            r.digit_[ j ] = t / d ;
-            remainder     = t % d ;
-    
-             #ifdef DEBUG_PP_BIGINT
-            cout << "\tRemainder normalization:  j = " << j << " t = " << t << endl ;
+            r.digit_[ j ] = divideDigit( t, d, remainder ) ;
+
+            #ifdef DEBUG_PP_BIGINT
+            cout << "\tRemainder normalization:  j = " << j << endl ;
             cout << "\tr[ j ] = " << r.digit_[ j ] << " remainder = " << remainder << endl ;
             #endif
         }
@@ -2204,6 +3298,384 @@ void divMod( const BigInt & u,
 
 
 
+/*=============================================================================
+|
+| NAME
+|
+|     Montgomery::Montgomery
+|
+| DESCRIPTION
+|
+|     Set up a Montgomery context for the modulus n with s digits, R = b^s.
+|
+| METHOD
+|
+|     n' = -1/n  (mod b) by Newton's iteration x <- x (2 - n  x) which
+|              0                                            0
+|     doubles the number of correct low order bits each step.  Any odd n
+|                                                                       0
+|     is its own inverse mod 8, so starting from 3 correct bits, 5 steps are
+|     enough for 64 bits and 6 for a 128 bit word.
+|
+|     R^2 (mod n) converts numbers into Montgomery form with one product.
+|
++============================================================================*/
+
+Montgomery::Montgomery( const BigInt & n )
+    : numDigits_( 0 )
+    , n_( n )
+    , nPrime_( 0 )
+    , rSquared_( 0 )
+{
+    // Need the full word base and gcd( n, b ) = 1, i.e. n odd.
+    if (BigInt::base_() != 0 || n.digit_.size() == 0 || (n.digit_[ 0 ] & 1) == 0 || n <= static_cast<ppuint>( 1u ))
+        return ;
+
+    int s = static_cast<int>( n.digit_.size() ) ;
+
+    ppuint n0  = n.digit_[ 0 ] ;
+    ppuint inv = n0 ;
+    for (int i = 0 ;  i < 6 ;  ++i)
+        inv *= 2 - n0 * inv ;
+
+    nPrime_ = static_cast<ppuint>( 0u ) - inv ;
+
+    BigInt r2 = BigInt::shiftDigits( BigInt( static_cast<ppuint>( 1u ) ), 2 * s ) % n ;
+
+    rSquared_.assign( s, 0 ) ;
+    for (size_t i = 0 ;  i < r2.digit_.size() ;  ++i)
+        rSquared_[ i ] = r2.digit_[ i ] ;
+
+    numDigits_ = s ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     Montgomery::multiply
+|
+| DESCRIPTION
+|
+|                  -1
+|     w = x y R      (mod n) for s digit numbers 0 <= x, y < n.
+|
+|     w may be the same array as x or y.  t is scratch space of at least s + 2 digits.
+|
+| METHOD
+|
+|     Coarsely integrated operand scanning (CIOS) from
+|
+|     C. K. Koc, T. Acar and B. S. Kaliski, "Analyzing and Comparing
+|     Montgomery Multiplication Algorithms", IEEE Micro, 16(3), 1996.
+|
+|     For each digit y  of y, add x y  to t, then add the multiple m n which
+|                     i             i
+|     makes the low digit of t zero, m = t  n' (mod b), and shift t right by
+|                                         0
+|     one digit.  Then t < 2n and one conditional subtract gives w.
+|
++============================================================================*/
+
+void Montgomery::multiply( const ppuint * x, const ppuint * y, ppuint * w, ppuint * t ) const
+{
+    int            s = numDigits_ ;
+    const ppuint * n = n_.digit_.begin() ;
+
+    for (int j = 0 ;  j < s + 2 ;  ++j)
+        t[ j ] = 0 ;
+
+    for (int i = 0 ;  i < s ;  ++i)
+    {
+        // t = t + x y
+        //            i
+        ppuint  yi    = y[ i ] ;
+        ppuint  carry = 0 ;
+        ppuint2 p ;
+        for (int j = 0 ;  j < s ;  ++j)
+        {
+            p       = static_cast<ppuint2>( x[ j ] ) * yi + t[ j ] + carry ;
+            t[ j ]  = static_cast<ppuint>( p ) ;
+            carry   = static_cast<ppuint>( p >> bitsPerWord ) ;
+        }
+        p          = static_cast<ppuint2>( t[ s ] ) + carry ;
+        t[ s ]     = static_cast<ppuint>( p ) ;
+        t[ s + 1 ] = static_cast<ppuint>( p >> bitsPerWord ) ;
+
+        // t = (t + m n) / b
+        ppuint m = t[ 0 ] * nPrime_ ;
+        p        = static_cast<ppuint2>( m ) * n[ 0 ] + t[ 0 ] ;
+        carry    = static_cast<ppuint>( p >> bitsPerWord ) ;
+        for (int j = 1 ;  j < s ;  ++j)
+        {
+            p          = static_cast<ppuint2>( m ) * n[ j ] + t[ j ] + carry ;
+            t[ j - 1 ] = static_cast<ppuint>( p ) ;
+            carry      = static_cast<ppuint>( p >> bitsPerWord ) ;
+        }
+        p          = static_cast<ppuint2>( t[ s ] ) + carry ;
+        t[ s - 1 ] = static_cast<ppuint>( p ) ;
+        t[ s ]     = t[ s + 1 ] + static_cast<ppuint>( p >> bitsPerWord ) ;
+    }
+
+    reduce( t, w ) ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     Montgomery::square
+|
+| DESCRIPTION
+|
+|          2  -1
+|     w = x  R    (mod n) for an s digit number 0 <= x < n.
+|
+|     w may be the same array as x.  t is scratch space of 2s + 2 digits.
+|
+| METHOD
+|
+|     Square x with each cross product computed once as in BigInt
+|     squareSchoolbook, then Montgomery reduce the 2s digit square,
+|     one digit at a time,
+|
+|     m = t  n' (mod b),   t = t + m n b^i
+|          i
+|
+|     which zeroes the low s digits.  About 3/4 of the digit products of
+|     the Montgomery multiply.
+|
++============================================================================*/
+
+void Montgomery::square( const ppuint * x, ppuint * w, ppuint * t ) const
+{
+    int            s = numDigits_ ;
+    const ppuint * n = n_.digit_.begin() ;
+
+    for (int j = 0 ;  j < 2 * s + 2 ;  ++j)
+        t[ j ] = 0 ;
+
+    // Cross products x  x  for i < j.
+    //                 i  j
+    ppuint2 p ;
+    for (int i = 0 ;  i < s - 1 ;  ++i)
+    {
+        ppuint xi    = x[ i ] ;
+        ppuint carry = 0 ;
+        for (int j = i + 1 ;  j < s ;  ++j)
+        {
+            p          = static_cast<ppuint2>( xi ) * x[ j ] + t[ i + j ] + carry ;
+            t[ i + j ] = static_cast<ppuint>( p ) ;
+            carry      = static_cast<ppuint>( p >> bitsPerWord ) ;
+        }
+        t[ i + s ] = carry ;
+    }
+
+    // Double them and add the squares on the diagonal.
+    ppuint carry = 0 ;
+    for (int k = 0 ;  k < 2 * s ;  ++k)
+    {
+        p      = static_cast<ppuint2>( t[ k ] ) * 2 + carry ;
+        t[ k ] = static_cast<ppuint>( p ) ;
+        carry  = static_cast<ppuint>( p >> bitsPerWord ) ;
+    }
+
+    carry = 0 ;
+    for (int i = 0 ;  i < s ;  ++i)
+    {
+        p              = static_cast<ppuint2>( x[ i ] ) * x[ i ] + t[ 2 * i ] + carry ;
+        t[ 2 * i ]     = static_cast<ppuint>( p ) ;
+        carry          = static_cast<ppuint>( p >> bitsPerWord ) ;
+
+        p              = static_cast<ppuint2>( t[ 2 * i + 1 ] ) + carry ;
+        t[ 2 * i + 1 ] = static_cast<ppuint>( p ) ;
+        carry          = static_cast<ppuint>( p >> bitsPerWord ) ;
+    }
+
+    // Reduce.  The result t / R < 2n lies in digits s ... 2s.
+    for (int i = 0 ;  i < s ;  ++i)
+    {
+        ppuint m = t[ i ] * nPrime_ ;
+        carry    = 0 ;
+        for (int j = 0 ;  j < s ;  ++j)
+        {
+            p          = static_cast<ppuint2>( m ) * n[ j ] + t[ i + j ] + carry ;
+            t[ i + j ] = static_cast<ppuint>( p ) ;
+            carry      = static_cast<ppuint>( p >> bitsPerWord ) ;
+        }
+
+        for (int k = i + s ;  carry != 0 ;  ++k)
+        {
+            p      = static_cast<ppuint2>( t[ k ] ) + carry ;
+            t[ k ] = static_cast<ppuint>( p ) ;
+            carry  = static_cast<ppuint>( p >> bitsPerWord ) ;
+        }
+    }
+
+    reduce( t + s, w ) ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     Montgomery::reduce
+|
+| DESCRIPTION
+|
+|     w = t - n if t >= n, else w = t, for an s + 1 digit number t < 2n.
+|
++============================================================================*/
+
+void Montgomery::reduce( const ppuint * t, ppuint * w ) const
+{
+    int            s = numDigits_ ;
+    const ppuint * n = n_.digit_.begin() ;
+
+    bool subtract = (t[ s ] != 0) ;
+    if (!subtract)
+    {
+        subtract = true ;
+        for (int j = s - 1 ;  j >= 0 ;  --j)
+        {
+            if (t[ j ] != n[ j ])
+            {
+                subtract = (t[ j ] > n[ j ]) ;
+                break ;
+            }
+        }
+    }
+
+    if (subtract)
+    {
+        ppuint borrow = 0 ;
+        for (int j = 0 ;  j < s ;  ++j)
+        {
+            ppuint2 d = static_cast<ppuint2>( t[ j ] ) - n[ j ] - borrow ;
+            w[ j ]    = static_cast<ppuint>( d ) ;
+            borrow    = (d >> bitsPerWord) != 0 ? 1 : 0 ;
+        }
+    }
+    else
+        for (int j = 0 ;  j < s ;  ++j)
+            w[ j ] = t[ j ] ;
+}
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     Montgomery::power
+|
+| DESCRIPTION
+|
+|      e
+|     a  (mod n) for a >= 0 and e >= 0 in a context which is enabled.
+|
+| METHOD
+|
+|     Fixed window exponentiation.  Precompute the Montgomery forms of
+|             k
+|     a^0 ... a^(2  - 1) where the window size k grows with the length of e.
+|     Then scan e from the top k bits at a time, squaring k times and
+|     multiplying by the table entry for each window.  Convert out of
+|     Montgomery form at the end.  This saves about a third of the
+|     multiplies of the binary method for long exponents.
+|
++============================================================================*/
+
+BigInt Montgomery::power( const BigInt & a, const BigInt & e ) const
+{
+    int s = numDigits_ ;
+
+    // Highest 1 bit of e.
+    int numBits = static_cast<int>( e.digit_.size() ) * bitsPerWord ;
+    while (numBits > 0 && ((e.digit_[ (numBits - 1) / bitsPerWord ] >> ((numBits - 1) % bitsPerWord)) & 1) == 0)
+        --numBits ;
+
+    //  0
+    // a  = 1
+    if (numBits == 0)
+        return BigInt( static_cast<ppuint>( 1u ) ) ;
+
+    int k = numBits > 671 ? 6 : numBits > 239 ? 5 : numBits > 79 ? 4 : numBits > 23 ? 3 : 1 ;
+
+    // Scratch space and the table of 2^k powers of a in Montgomery form.
+    vector<ppuint> t( 2 * s + 2 ) ;
+    vector<ppuint> table( static_cast<size_t>( s ) << k ) ;
+    vector<ppuint> w( s ) ;
+
+    BigInt a1 = a % n_ ;
+    for (size_t i = 0 ;  i < a1.digit_.size() ;  ++i)
+        w[ i ] = a1.digit_[ i ] ;
+
+    //                2                         2
+    // a R = (a)  (R )  R^-1 and R = (1)  (R )  R^-1  (mod n)
+    multiply( &w[ 0 ], rSquared_.begin(), &table[ s ], &t[ 0 ] ) ;
+
+    w.assign( s, 0 ) ;
+    w[ 0 ] = 1 ;
+    multiply( &w[ 0 ], rSquared_.begin(), &table[ 0 ], &t[ 0 ] ) ;
+
+    for (int i = 2 ;  i < (1 << k) ;  ++i)
+        multiply( &table[ (i - 1) * s ], &table[ s ], &table[ i * s ], &t[ 0 ] ) ;
+
+    //  Bits j k ... j k + k - 1 of e.
+    auto window = [&]( int j )
+    {
+        int value = 0 ;
+        for (int bit = j * k + k - 1 ;  bit >= j * k ;  --bit)
+        {
+            value <<= 1 ;
+            if (bit < numBits)
+                value |= static_cast<int>( (e.digit_[ bit / bitsPerWord ] >> (bit % bitsPerWord)) & 1 ) ;
+        }
+        return value ;
+    } ;
+
+    int numWindows = (numBits + k - 1) / k ;
+    int top        = window( numWindows - 1 ) ;
+    for (int i = 0 ;  i < s ;  ++i)
+        w[ i ] = table[ top * s + i ] ;
+
+    for (int j = numWindows - 2 ;  j >= 0 ;  --j)
+    {
+        for (int i = 0 ;  i < k ;  ++i)
+            square( &w[ 0 ], &w[ 0 ], &t[ 0 ] ) ;
+
+        int d = window( j ) ;
+        if (d != 0)
+            multiply( &w[ 0 ], &table[ d * s ], &w[ 0 ], &t[ 0 ] ) ;
+    }
+
+    //                  -1
+    // Convert back (w) R   (mod n) = (w) (1) R^-1.
+    vector<ppuint> one( s, 0 ) ;
+    one[ 0 ] = 1 ;
+    multiply( &w[ 0 ], &one[ 0 ], &w[ 0 ], &t[ 0 ] ) ;
+
+    BigInt result ;
+    result.digit_.resize( s ) ;
+    for (int i = 0 ;  i < s ;  ++i)
+        result.digit_[ i ] = w[ i ] ;
+
+    // Trim leading zeros, if any, but stop if the result is 0.
+    while (result.digit_.size() > 1 && result.digit_.back() == 0)
+        result.digit_.pop_back() ;
+
+    return result ;
+}
+
+
+
 /*=============================================================================
 |
 | NAME
@@ -2344,7 +3816,7 @@ int BigInt::ceilLg()
 {
     int bitNum ;
     
-    for (bitNum = maxBitNumber();  testBit( bitNum ) == false && bitNum >= 0 ;  --bitNum)
+    for (bitNum = maxBitNumber();  bitNum >= 0 && testBit( bitNum ) == false ;  --bitNum)
     #ifdef DEBUG_PP_BIGINT
     cout << "bitNum = " << bitNum << " testBit = " << testBit( bitNum ) << endl
     #endif // NDEBUG
@@ -2404,7 +3876,8 @@ bool operator==( const BigInt & u, const ppuint d )
     ppuint b = u.base_() ;
 
     // TODO:   We should do BigInt == here instead of aborting.
-    if (d > b)
+    // Any d is a single digit in the full word base.
+    if (b != 0 && d > b)
     {
         ostringstream os ;
         os << "BigInt::operator== " << " digit d = " << d << " > base b = " << u.base_()
@@ -2413,7 +3886,7 @@ bool operator==( const BigInt & u, const ppuint d )
         throw BigIntRangeError( os.str() ) ;
     }
     // Special case check to see if u = 10 in base b.
-    else if (d == b)
+    else if (b != 0 && d == b)
     {
         if (u.digit_.size() != 2 || u.digit_[ 0 ] != 0 || u.digit_[ 1 ] != 1)
             return false ;
@@ -2516,7 +3989,8 @@ bool operator>( const BigInt & u, const ppuint d )
 {
     ppuint b = u.base_() ;
 
-    if (d >= b)
+    // Any d is a single digit in the full word base.
+    if (b != 0 && d >= b)
     {
         ostringstream os ;
         os << "BigInt::operator> " << "d = " << d
@@ -2644,12 +4118,29 @@ bool operator<=( const BigInt & u, const ppuint d )
 |
 +============================================================================*/
 
-BigInt operator&( const BigInt & u, const BigInt & n )
+BigInt operator&( const BigInt & u, const BigInt & v )
 {
+    if (u.base_() != 0)
+    {
+        ostringstream os ;
+        os << "BigInt::operator& " << " bit masking needs the full word base, not b = " << u.base_()
+           << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw BigIntDomainError( os.str() ) ;
+    }
+
     // Allocate temporary space for the result which will
     // be destructed as this function goes out of scope.
     BigInt w ;
 
+    // And the digits which both numbers have;  the rest are masked to zero.
+    size_t n = min( u.digit_.size(), v.digit_.size() ) ;
+    for (size_t i = 0 ;  i < n ;  ++i)
+        w.digit_.push_back( u.digit_[ i ] & v.digit_[ i ] ) ;
+
+    // Trim leading zeros, but stop if w = 0.
+    while (w.digit_.size() > 1 && w.digit_.back() == 0)
+        w.digit_.pop_back() ;
+
     // Return a copy of the result.
     return w ;
 }
@@ -2664,16 +4155,59 @@ BigInt operator&( const BigInt & u, const BigInt & n )
 |
 | DESCRIPTION
 |
-|     Bit shift left.
+|     Bit shift left,
+|
+|              n
+|     w = u * 2
+|
+|     Shift whole digits for n / N, then the bits within digits for n mod N,
+|     where N is the number of bits per digit.
 |
 +============================================================================*/
 
 BigInt operator<<( const BigInt & u, ppuint n )
 {
+    if (u.base_() != 0)
+    {
+        ostringstream os ;
+        os << "BigInt::operator<< " << " bit shifting needs the full word base, not b = " << u.base_()
+           << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw BigIntDomainError( os.str() ) ;
+    }
+
     // Allocate temporary space for the result which will
     // be destructed as this function goes out of scope.
     BigInt w ;
 
+    // Shifting zero gives zero.
+    if (u == static_cast<ppuint>( 0u ))
+    {
+        w.digit_.push_back( 0 ) ;
+        return w ;
+    }
+
+    ppuint numDigitShifts = n / bitsPerWord ;
+    int    numBitShifts   = static_cast<int>( n % bitsPerWord ) ;
+
+    // Low order zero digits.
+    w.digit_.assign( numDigitShifts, 0 ) ;
+
+    // Shift the bits of each digit, carrying the high bits into the next digit.
+    ppuint carry = 0 ;
+    for (auto & d : u.digit_)
+    {
+        if (numBitShifts == 0)
+            w.digit_.push_back( d ) ;
+        else
+        {
+            w.digit_.push_back( (d << numBitShifts) | carry ) ;
+            carry = d >> (bitsPerWord - numBitShifts) ;
+        }
+    }
+
+    if (carry != 0)
+        w.digit_.push_back( carry ) ;
+
     // Return a copy of the result.
     return w ;
 }
@@ -2755,7 +4289,9 @@ int BigInt::maxBitNumber() const
 |
 | DESCRIPTION
 |
-|     Return the BigInt base.
+|     Return the BigInt base.  Returns 0 for the default full word base
+|              N
+|     b = 2  where N is the number of bits in a ppuint.
 |
 +============================================================================*/
 
@@ -2824,7 +4360,7 @@ const int getNumDigits(const BigInt & u )
 
 void setBase( const BigInt & u, const ppuint base )
 {
-   *u.pbase = base ;
+   u.base_() = base ;
 }
 
             
@@ -2841,10 +4377,10 @@ void setBase( const BigInt & u, const ppuint base )
 | EXAMPLE
 |
 |     For standard output to the console,
-|         BigInt w( "68719476735", cout ) ;
-|        printNumber(r)
+|         BigInt w( "36893488147419103231" ) ;
+|        printNumber( w, cout )
 |     gives
-|        68719476735 [digits = 31 2147483647 base b = 2147483648 number of digits = 2]
+|        36893488147419103231 [digits = 1 18446744073709551615  base b = 2^64 number of digits = 2)
 |
 +============================================================================*/
 
@@ -2856,7 +4392,12 @@ void printNumber( const BigInt & u, ostream & out = cout )
     for (int i = getNumDigits( u ) - 1 ;  i >= 0 ; --i)
         out << getDigit( u, i ) << " " ;
 
-    out << " base b = " << BigInt::getBase() << " number of digits = " << getNumDigits( u ) << ")" << endl ;
+    out << " base b = " ;
+    if (BigInt::getBase() == 0)
+        out << "2^" << u.numBitsPerDigit_() ;
+    else
+        out << BigInt::getBase() ;
+    out << " number of digits = " << getNumDigits( u ) << ")" << endl ;
 }
 
             
@@ -2874,7 +4415,7 @@ void printNumber( const BigInt & u, ostream & out = cout )
 | EXAMPLE
 |
 |    (lldb) expr printNumber(r)
-|    68719476735 [digits = 31 2147483647 base b = 2147483648 number of digits = 2]
+|    36893488147419103231 [digits = 1 18446744073709551615  base b = 2^64 number of digits = 2)
 |
 +============================================================================*/
 
@@ -2907,42 +4448,23 @@ void printNumber( const BigInt & u )
 ppuint & BigInt::base_()
 {
     // Base of the number system used for each digit.  If a digit has can hold N bits,
-    // the signed integer maximum is
-    //          N-1
-    //         2    - 1
-    //
-    // If we let the base be
-    //
-    //          N/2 - 1
+    // we let
+    //          N
     //     b = 2
     //
-    //       2    N-2
-    // then b  = 2    will not only fit into a signed integer but will also be a power
-    //
-    // of 2, making bit shifting and testing much easier.
+    // so each digit uses the whole computer word.  Digit products and carries up to
+    //  2
+    // b  - 1 fit into the double length type ppuint2, and b being a power of 2 makes
+    // bit shifting and testing easy.
     //
-    // e.g. for N = 8, the largest positive number = 01111111 = 127, base b = 8 whose
-    // square, 64 is less than the signed maximum.
+    // b itself doesn't fit into a digit, so we store it as b mod 2^N = 0.
+    // Unit tests can switch to a small base such as 10 to check the digit arithmetic by hand.
+    // Each thread has its own copy, which starts out as the full word base.
     //
-    static ppuint base = static_cast<ppuint>(1u) << numBitsPerDigit_() ;
-    
-    // Point to it for testing.  Use reference?
-    pbase = &base ;
-
-    // Detect if the base is way out of range, and build up an exception.
-    if (base <= 0)
-    {
-        ostringstream os ;
-        os << "Base for multiple precision number system is too small."
-           << "BigInt::base_() " << " base  = " << base << " <= 0 "
-           << " at " << __FILE__ << ": line " << __LINE__
-           << "Internal error." ;
-
-        throw BigIntRangeError( os.str() ) ;
-    }
+    static thread_local ppuint base = 0 ;
 
     return base ;
-} 
+}
 
 
 
@@ -2967,25 +4489,20 @@ ppuint & BigInt::base_()
 |
 +============================================================================*/
 
-int & BigInt::numBitsPerDigit_()
+int BigInt::numBitsPerDigit_()
 {
     // Base of the number system used for each digit.  If a digit has can hold N bits,
     // we let
-    //          N/2 - 1
+    //          N
     //     b = 2
     //
-    //          2
-    // so that b  fits into a digit and b is an integer number of bits in
-    // length, making bit shifting and testing easier.
-    //
-    // Use half the number of bits in an unsigned integer.
-    static int numBitsPerDigit = (sizeof( ppuint ) * 8) / 2 - 1 ;
+    // Use all the bits in an unsigned integer.  A per-process constant.
+    static const int numBitsPerDigit = sizeof( ppuint ) * 8 ;
 
     #ifdef DEBUG_PP_BIGINT
     cout << "numBitsPerDigit_():" << endl ;
     cout << "sizeof( ppuint ) = " << sizeof( ppuint ) << " bytes" << endl ;
     cout << "numBitsPerDigit = " << numBitsPerDigit << endl ;
-    cout << "base = 1 << numBitsPerDigit = " << (static_cast<ppuint>(1u) << numBitsPerDigit) << endl ;
     #endif
 
     if (numBitsPerDigit <= 0)
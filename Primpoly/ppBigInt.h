@@ -163,6 +163,197 @@ class BigIntZeroDivide : public BigIntMathError
 
 
 
+/*=============================================================================
+|
+| NAME
+|
+|     BigIntDigits
+|
+| DESCRIPTION
+|
+|     Digit storage for BigInt with room for a few digits inside the object
+|     itself, so numbers up to numInlineDigits digits (256 bits) don't touch
+|     the heap.  Longer numbers spill over into heap storage.  Supports the
+|     part of the vector<ppuint> interface which BigInt uses, and throws the
+|     same bad_alloc and length_error exceptions.
+|
+| NOTES
+|
+|     The heap functions are documented in detail ppBigInt.cpp
+|
++============================================================================*/
+
+class BigIntDigits
+{
+    public:
+        static const size_t numInlineDigits = 4 ;
+
+        BigIntDigits()
+            : size_( 0 )
+            , capacity_( numInlineDigits )
+            , digit_( inline_ )
+        {
+        }
+
+        // n zero digits.
+        explicit BigIntDigits( size_t n )
+            : BigIntDigits()
+        {
+            resize( n ) ;
+        }
+
+        BigIntDigits( const BigIntDigits & d )
+            : BigIntDigits()
+        {
+            assign( d ) ;
+        }
+
+        // Steal the heap storage of d if it has any.
+        BigIntDigits( BigIntDigits && d ) noexcept
+            : BigIntDigits()
+        {
+            take( d ) ;
+        }
+
+        ~BigIntDigits()
+        {
+            if (digit_ != inline_)
+                delete [] digit_ ;
+        }
+
+        BigIntDigits & operator=( const BigIntDigits & d )
+        {
+            if (this != &d)
+                assign( d ) ;
+            return *this ;
+        }
+
+        BigIntDigits & operator=( BigIntDigits && d ) noexcept
+        {
+            if (this != &d)
+            {
+                if (digit_ != inline_)
+                    delete [] digit_ ;
+                digit_    = inline_ ;
+                capacity_ = numInlineDigits ;
+                take( d ) ;
+            }
+            return *this ;
+        }
+
+        size_t size() const                      { return size_ ; }
+        ppuint &       operator[]( size_t i )       { return digit_[ i ] ; }
+        const ppuint & operator[]( size_t i ) const { return digit_[ i ] ; }
+        ppuint &       back()                       { return digit_[ size_ - 1 ] ; }
+        const ppuint & back() const                 { return digit_[ size_ - 1 ] ; }
+        ppuint *       begin()                      { return digit_ ; }
+        const ppuint * begin() const                { return digit_ ; }
+        ppuint *       end()                        { return digit_ + size_ ; }
+        const ppuint * end() const                  { return digit_ + size_ ; }
+
+        void push_back( const ppuint d )
+        {
+            if (size_ == capacity_)
+                grow( 2 * capacity_ ) ;
+            digit_[ size_++ ] = d ;
+        }
+
+        void pop_back()
+        {
+            --size_ ;
+        }
+
+        void clear()
+        {
+            size_ = 0 ;
+        }
+
+        void reserve( size_t n )
+        {
+            if (n > capacity_)
+                grow( n ) ;
+        }
+
+        // New digits are zero.
+        void resize( size_t n )
+        {
+            reserve( n ) ;
+            for (size_t i = size_ ;  i < n ;  ++i)
+                digit_[ i ] = 0 ;
+            size_ = n ;
+        }
+
+        void assign( size_t n, const ppuint d )
+        {
+            reserve( n ) ;
+            for (size_t i = 0 ;  i < n ;  ++i)
+                digit_[ i ] = d ;
+            size_ = n ;
+        }
+
+        void swap( BigIntDigits & d ) noexcept
+        {
+            // Both on the heap:  just trade pointers.
+            if (digit_ != inline_ && d.digit_ != d.inline_)
+            {
+                std::swap( digit_,    d.digit_ ) ;
+                std::swap( size_,     d.size_ ) ;
+                std::swap( capacity_, d.capacity_ ) ;
+            }
+            else if (this != &d)
+            {
+                BigIntDigits t( std::move( d ) ) ;
+                d     = std::move( *this ) ;
+                *this = std::move( t ) ;
+            }
+        }
+
+        // Number of times any BigInt in this thread went to the heap for digit storage.
+        static ppuint numHeapAllocations() ;
+
+    private:
+        void assign( const BigIntDigits & d )
+        {
+            reserve( d.size_ ) ;
+            for (size_t i = 0 ;  i < d.size_ ;  ++i)
+                digit_[ i ] = d.digit_[ i ] ;
+            size_ = d.size_ ;
+        }
+
+        // Move the digits of d into this object which has empty inline storage, leaving d empty.
+        void take( BigIntDigits & d ) noexcept
+        {
+            if (d.digit_ != d.inline_)
+            {
+                digit_    = d.digit_ ;
+                capacity_ = d.capacity_ ;
+                d.digit_    = d.inline_ ;
+                d.capacity_ = numInlineDigits ;
+            }
+            else
+                for (size_t i = 0 ;  i < d.size_ ;  ++i)
+                    inline_[ i ] = d.inline_[ i ] ;
+
+            size_   = d.size_ ;
+            d.size_ = 0 ;
+        }
+
+        // Move the digits to heap storage for n digits.
+        void grow( size_t n ) ;
+
+        size_t   size_ ;                      // Number of digits in use.
+        size_t   capacity_ ;                  // Number of digits we have storage for.
+        ppuint * digit_ ;                     // Points to inline_ or to heap storage.
+        ppuint   inline_[ numInlineDigits ] ; // Storage for small numbers.
+} ;
+
+inline void swap( BigIntDigits & d1, BigIntDigits & d2 ) noexcept
+{
+    d1.swap( d2 ) ;
+}
+
+
+
 /*=============================================================================
 |
 | NAME
@@ -213,10 +404,18 @@ class BigInt
         // e.g. BigInt u ;  BigInt v( u ) ; 
         BigInt( const BigInt & u ) ;
 
+        // Move constructor steals the digits of a temporary.
+        // e.g. BigInt v( u * w ) ;
+        BigInt( BigInt && u ) noexcept ;
+
         // Assignment.
         // e.g. BigInt u( "123" ) ;  BigInt v ;  v = u ;
         BigInt & operator=( const BigInt & n ) ;
 
+        // Move assignment.
+        // e.g. BigInt v ;  v = u * w ;
+        BigInt & operator=( BigInt && n ) noexcept ;
+
 		// Conversion to int.
         // e.g. BigInt( w ) = "123" ;  ppuint u = static_cast<int>( w ) ;
         operator ppuint() const ;
@@ -230,10 +429,11 @@ class BigInt
         // e.g. istringstream is ;  is >> u ;
         friend istream & operator>>( istream & in,        BigInt & u ) ;
 
-        // u + v and other additions.
-        friend const BigInt operator+( const BigInt & u, const BigInt & v ) ;
+        // u + v and other additions.  The binary operators take their left operand by value,
+        // so a temporary like the u + v in (u + v) * w is moved into the result, not copied.
+        friend BigInt operator+( BigInt u, const BigInt & v ) ;
 
-        friend const BigInt operator+( const BigInt & u, const ppuint d ) ;
+        friend BigInt operator+( BigInt u, const ppuint d ) ;
 
         BigInt & operator+=( const BigInt & u ) ;
 
@@ -242,12 +442,12 @@ class BigInt
         // ++u and other increments.
         BigInt & operator++() ;
 
-        const BigInt operator++( int ) ;
+        BigInt operator++( int ) ;
 
         // u - v and other subtractions.
-        friend const BigInt operator-( const BigInt & u, const BigInt & v ) ;
+        friend BigInt operator-( BigInt u, const BigInt & v ) ;
 
-        friend const BigInt operator-( const BigInt & u, const ppuint d ) ;
+        friend BigInt operator-( BigInt u, const ppuint d ) ;
 
         BigInt & operator-=( const BigInt & u ) ;
 
@@ -259,9 +459,9 @@ class BigInt
         BigInt operator--( int ) ;
 
         // u * v, and other multiplies.
-        friend const BigInt operator*( const BigInt & u, const BigInt & v ) ;
+        friend BigInt operator*( BigInt u, const BigInt & v ) ;
 
-        friend const BigInt operator*( const BigInt & u, const ppuint d ) ;
+        friend BigInt operator*( BigInt u, const ppuint d ) ;
 
         BigInt & operator*=( const BigInt & u ) ;
 
@@ -269,9 +469,9 @@ class BigInt
 
         // | u / v |, and other integer divides.
         // --     --
-        friend const BigInt operator/( const BigInt & u, const BigInt & v ) ;
+        friend BigInt operator/( BigInt u, const BigInt & v ) ;
 
-        friend const BigInt operator/( const BigInt & u, const ppuint d ) ;
+        friend BigInt operator/( BigInt u, const ppuint d ) ;
 
         BigInt & operator/=( const BigInt & u ) ;
 
@@ -325,8 +525,9 @@ class BigInt
         // Highest bit number in a BigInt, 0 is smallest bit.
         int maxBitNumber() const ;
 
-        // Used by the PolyParser and main for input range checking, so we use a class function
-        // not requiring us to instantiate a BigInt object.
+        // Base of the number system.  Returns 0 for the default full word base b = 2^N where
+        // N is the number of bits in a ppuint.  Any other value is a small base set for unit testing
+        // in the calling thread.
         static const ppuint getBase() ;
 
         //-----------------< Unit Test Functions >----------------------------
@@ -335,36 +536,90 @@ class BigInt
 
         friend const int getNumDigits( const BigInt & u ) ;
 
+        // Change the base for all BigInts in the calling thread only.
         friend void setBase( const BigInt & u, const ppuint base ) ;
 
         friend void printNumber( const BigInt & u, ostream & out ) ;
     
         friend void printNumber( const BigInt & u ) ;
 
+        // Montgomery modular arithmetic works directly on the digits.
+        friend class Montgomery ;
+
     // Class variables shared among all classes.
     // We use static functions instead of static variables to work 
     // around the C++ static member initialization order problem.
     private:
-        // Base of the number system (a power of 2) and
-        // corresponding number of bits per digit.
+        // Base of the number system and corresponding number of bits per digit.
+        // The full word base b = 2^N doesn't fit into a ppuint so we store it as b mod 2^N = 0.
+        // The base is thread local, so a unit test switching its base can't disturb BigInts in other threads.
         static ppuint & base_() ;
 
-        // Pointer to number system base.  Used for unit testing only.
-        static ppuint * pbase ;
+        static int numBitsPerDigit_() ;
+
+    // Subquadratic multiplication and division for large numbers.
+    private:
+        // Below these many digits the next simpler method is faster.  Tuned by timing on x86-64
+        // in the full word base.
+        static const int karatsubaThreshold       = 48 ;
+        static const int karatsubaSquareThreshold = 128 ;
+        static const int toom3Threshold           = 256 ;
+        static const int bzThreshold              = 96 ;
+
+        // w = u v, choosing schoolbook, Karatsuba or Toom-3 by size.  Use squaring when u and v are the same number.
+        static void multiply( const BigInt & u, const BigInt & v, BigInt & w, bool squaring ) ;
+
+        static void multiplySchoolbook( const BigInt & u, const BigInt & v, BigInt & w ) ;
+
+        static void squareSchoolbook( const BigInt & u, BigInt & w ) ;
 
-        static int & numBitsPerDigit_() ;
+        static void multiplyKaratsuba( const BigInt & u, const BigInt & v, BigInt & w, bool squaring ) ;
+
+        static void multiplyToom3( const BigInt & u, const BigInt & v, BigInt & w, bool squaring ) ;
+
+        // Knuth's Algorithm D and Burnikel-Ziegler recursive division.
+        static void divModKnuth( const BigInt & u, const BigInt & v, BigInt & q, BigInt & r ) ;
+
+        static void divModRecursive( const BigInt & u, const BigInt & v, BigInt & q, BigInt & r ) ;
+
+        static void divide2n1n( const BigInt & a, const BigInt & v, int n, BigInt & q, BigInt & r ) ;
+
+        static void divide3n2n( const BigInt & a, const BigInt & v, int h, BigInt & q, BigInt & r ) ;
+
+        //                                 lo
+        // Digits lo through hi-1 of u = | u / b   | mod b^(hi-lo), and u b^k.
+        //                               --       --
+        static BigInt digitRange( const BigInt & u, int lo, int hi ) ;
+
+        static BigInt shiftDigits( const BigInt & u, int k ) ;
+
+        //             k
+        // w = w + u b  in place.
+        static void addShifted( BigInt & w, const BigInt & u, int k ) ;
+
+    // Subquadratic conversion to and from decimal.
+    private:
+        // Numbers with fewer digits convert by the quadratic method.
+        static const int radixThreshold = 32 ;
+
+        static BigInt fromDecimal( const string & s, size_t begin, size_t end ) ;
+
+        static void toDecimal( const BigInt & u, int numDecimals, string & s ) ;
+
+        static const BigInt & decimalPower( int i ) ;
 
     // Private data for member functions only.
     private:
 		//  Numbers are n-place quantities with base b digits,
-        //         2
-        //  where b  is guaranteed to fit into a digit and
-        //  b is a power of 2.
+        //              N
+        //  where b = 2  and N is the number of bits in a ppuint, i.e. each
+        //  digit uses the whole computer word.  Digit products and carries
+        //  are computed in the double length type ppuint2.
         //
     	//         (u     . . . u )
 		//           n-1         0
 		//
-		//  For programming ease, digits are stored in a vector of
+		//  For programming ease, digits are stored in an array of
         //  length n with the least significant digit at digit[ 0 ],
 		//
 		//  +----+----+----+------+------+
@@ -372,7 +627,98 @@ class BigInt
 		//  |  0 |  1 |  2 | ...  |  n-1 |
 		//  +----+----+----+------+------+
 	   	//
-    	vector< ppuint > digit_ ;
+    	//  Up to BigIntDigits::numInlineDigits digits are stored inside
+    	//  the object itself without any heap allocation.
+    	BigIntDigits digit_ ;
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     Montgomery
+|
+| DESCRIPTION
+|
+|     Context for modular multiplication and exponentiation in Montgomery
+|     form for a fixed odd modulus n with s digits.  With R = b^s, numbers
+|     are kept as x R (mod n) so that each modular product needs only
+|     multiplies and shifts and no multiprecision division.
+|
+|     Montgomery mont( n ) ;
+|     if (mont.isEnabled())
+|         BigInt w = mont.power( a, e ) ;   // a ^ e (mod n)
+|
+| NOTES
+|
+|     Only for the full word base.  Even moduli and the small unit test bases
+|     leave the context disabled and the caller must use ordinary division.
+|     The member functions are documented in detail in ppBigInt.cpp
+|
++============================================================================*/
+
+class Montgomery
+{
+    public:
+        // Precompute n' = -1/n (mod b) and R^2 (mod n).
+        explicit Montgomery( const BigInt & n ) ;
+
+        // True if n is odd and we are in the full word base.
+        bool isEnabled() const { return numDigits_ > 0 ; }
+
+        //  e
+        // a  (mod n) for any a >= 0 and e >= 0.
+        BigInt power( const BigInt & a, const BigInt & e ) const ;
+
+        //                      -1
+        // Montgomery product  x y R  (mod n) of s digit numbers x, y < n.
+        // t is scratch space of at least s + 2 digits.
+        void multiply( const ppuint * x, const ppuint * y, ppuint * w, ppuint * t ) const ;
+
+        //                      2  -1
+        // Montgomery square  x  R  (mod n).  t is scratch space of 2s + 2 digits.
+        void square( const ppuint * x, ppuint * w, ppuint * t ) const ;
+
+    private:
+        // Subtract n from an s + 1 digit number t < 2n if t >= n.
+        void reduce( const ppuint * t, ppuint * w ) const ;
+
+    private:
+        int          numDigits_ ;  // Number of digits s of the modulus, 0 if disabled.
+        BigInt       n_ ;          // Modulus n.
+        ppuint       nPrime_ ;     // -1/n  (mod b)
+        BigIntDigits rSquared_ ;   // R^2 (mod n) padded to s digits.
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PowerMod<BigInt>
+|
+| DESCRIPTION
+|
+|     PowerMod specialized for BigInt.  Keeps a Montgomery context for the
+|     modulus so repeated calls, e.g. the squarings in the Miller-Rabin
+|     test, pay for the setup only once.
+|
++============================================================================*/
+
+template<>
+class PowerMod<BigInt>
+{
+    public:
+        PowerMod( const BigInt & p ) ;
+
+        BigInt operator()( const BigInt & a, const BigInt & n ) ;
+
+    protected:
+        BigInt     p_ ;           // Modulus for all arithmetic operations.
+        Montgomery montgomery_ ;  // Montgomery context for odd p_.
 } ;
 
 
@@ -0,0 +1,653 @@
+/*==============================================================================
+| 
+|  NAME
+|
+|     ppDaemon.cpp
+|
+|  DESCRIPTION
+|
+|     Primitive polynomial query daemon on a Unix domain socket, and a
+|     simple client for it.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|     
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+
+
+/*------------------------------------------------------------------------------
+|                                Includes                                      |
+------------------------------------------------------------------------------*/
+
+#include <cstdlib>      // abort()
+#include <iostream>     // Basic stream I/O.
+#include <new>          // set_new_handler()
+#include <cmath>        // Basic math functions e.g. sqrt()
+#include <limits>       // Numeric limits.
+#include <complex>      // Complex data type and operations.
+#include <fstream>      // File stream I/O.
+#include <sstream>      // String stream I/O.
+#include <vector>       // STL vector class.
+#include <string>       // STL string class.
+#include <algorithm>    // Iterators.
+#include <stdexcept>    // Exceptions.
+#include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <functional>   // function
+#include <iterator>     // input_iterator_tag
+#include <cstddef>      // ptrdiff_t
+#include <thread>       // Worker threads.
+#include <mutex>        // mutex, lock_guard, unique_lock
+#include <condition_variable>  // Wake up idle workers.
+#include <future>       // packaged_task, future
+#include <queue>        // Task queue.
+#include <list>         // Connection threads.
+#include <map>          // Result store for first.
+#include <atomic>       // Stop flag, connection count.
+#include <chrono>       // Deadlines.
+
+#include <sys/socket.h> // Unix domain sockets.
+#include <sys/un.h>
+#include <unistd.h>     // close(), unlink()
+#include <poll.h>       // Wait for input with a timeout.
+#include <cerrno>
+#include <cstring>      // strerror()
+
+using namespace std ;   // So we don't need to say std::vector everywhere.
+
+
+
+/*------------------------------------------------------------------------------
+|                                PP Include Files                              |
+------------------------------------------------------------------------------*/
+
+#include "Primpoly.h"       // Global functions.
+#include "ppArith.h"        // Basic arithmetic functions.
+#include "ppBigInt.h"       // Arbitrary precision integer arithmetic.
+#include "ppOperationCount.h"   // OperationCount collection for factoring and poly finding.
+#include "ppFactor.h"       // Prime factorization and Euler Phi.
+#include "ppPolynomial.h"   // Polynomial operations and mod polynomial operations.
+#include "ppSearch.h"       // Primitive polynomial search and test API.
+#include "ppParser.h"       // Parsing of polynomials and I/O services.
+#include "ppBatch.h"        // Batch testing of polynomials.
+#include "ppDaemon.h"       // Query daemon.
+#include "ppTrace.h"        // Timeline tracing.
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     socketError
+ |
+ | DESCRIPTION
+ |
+ |     Throw a DaemonError describing errno.
+ |
+ +============================================================================*/
+
+static void socketError( const string & what, const string & socketPath, const char * file, int line )
+{
+    ostringstream os ;
+    os << what << " " << socketPath << ": " << strerror( errno )
+       << " at " << file << ": line " << line ;
+    throw DaemonError( os.str() ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     socketAddress
+ |
+ | DESCRIPTION
+ |
+ |     Fill in the address of the Unix domain socket at socketPath.
+ |
+ +============================================================================*/
+
+static sockaddr_un socketAddress( const string & socketPath )
+{
+    sockaddr_un address ;
+    memset( &address, 0, sizeof( address ) ) ;
+    address.sun_family = AF_UNIX ;
+
+    if (socketPath.size() >= sizeof( address.sun_path ))
+    {
+        ostringstream os ;
+        os << "Socket path " << socketPath << " is too long"
+           << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw DaemonError( os.str() ) ;
+    }
+    strncpy( address.sun_path, socketPath.c_str(), sizeof( address.sun_path ) - 1 ) ;
+
+    return address ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     sendLine
+ |
+ | DESCRIPTION
+ |
+ |     Send a line, all of it.  Return false if the other end has gone away.
+ |
+ +============================================================================*/
+
+static bool sendLine( int fd, const string & line )
+{
+    string s = line + '\n' ;
+    size_t numSent = 0 ;
+
+    while (numSent < s.size())
+    {
+        ssize_t n = send( fd, s.data() + numSent, s.size() - numSent, MSG_NOSIGNAL ) ;
+        if (n < 0 && errno == EINTR)
+            continue ;
+        if (n <= 0)
+            return false ;
+        numSent += static_cast<size_t>( n ) ;
+    }
+
+    return true ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyDaemon
+ |
+ | DESCRIPTION
+ |
+ |     Start listening on the socket right away, so clients can connect
+ |     before run() is called.
+ |
+ +============================================================================*/
+
+PolyDaemon::PolyDaemon( const string & socketPath, unsigned int numThreads, size_t cacheSize, size_t maxConnections )
+    : socketPath_( socketPath )
+    , listenFd_( -1 )
+    , stop_( false )
+    , maxConnections_( maxConnections )
+    , numConnections_( 0u )
+    , pool_( numThreads )
+    , cache_( cacheSize )
+    , firstPrimitive_()
+    , firstPrimitiveMutex_()
+{
+    sockaddr_un address = socketAddress( socketPath_ ) ;
+
+    listenFd_ = socket( AF_UNIX, SOCK_STREAM, 0 ) ;
+    if (listenFd_ < 0)
+        socketError( "Cannot create socket", socketPath_, __FILE__, __LINE__ ) ;
+
+    // Remove the socket left over from a daemon which didn't shut down cleanly.
+    unlink( socketPath_.c_str() ) ;
+
+    if (bind( listenFd_, reinterpret_cast<sockaddr *>( &address ), sizeof( address ) ) < 0 ||
+        listen( listenFd_, SOMAXCONN ) < 0)
+    {
+        int error = errno ;
+        close( listenFd_ ) ;
+        errno = error ;
+        socketError( "Cannot listen on socket", socketPath_, __FILE__, __LINE__ ) ;
+    }
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     ~PolyDaemon
+ |
+ | DESCRIPTION
+ |
+ |     Stop listening and remove the socket.
+ |
+ +============================================================================*/
+
+PolyDaemon::~PolyDaemon()
+{
+    close( listenFd_ ) ;
+    unlink( socketPath_.c_str() ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyDaemon::run
+ |
+ | DESCRIPTION
+ |
+ |     Accept connections, each served by its own thread which reads
+ |     requests and hands them to the pool.  Poll so we notice stop().
+ |     Join the threads of connections which have closed as we go, so a
+ |     daemon running for weeks doesn't pile them up.
+ |
+ +============================================================================*/
+
+void PolyDaemon::run()
+{
+    // In a list, so done stays put while the thread sets it.
+    struct Connection
+    {
+        atomic<bool> done ;
+        thread       server ;
+    } ;
+    list< Connection > connections ;
+
+    auto reap = [&connections]()
+    {
+        for (auto connection = connections.begin() ;  connection != connections.end() ; )
+        {
+            if (connection->done)
+            {
+                connection->server.join() ;
+                connection = connections.erase( connection ) ;
+            }
+            else
+                ++connection ;
+        }
+    } ;
+
+    while (!stop_)
+    {
+        reap() ;
+        numConnections_ = connections.size() ;
+
+        pollfd listening = { listenFd_, POLLIN, 0 } ;
+        if (poll( &listening, 1, 100 ) <= 0)
+            continue ;
+
+        int fd = accept( listenFd_, nullptr, nullptr ) ;
+        if (fd < 0)
+            continue ;
+
+        // Too many clients already:  turn this one away rather than start yet another thread.
+        if (connections.size() >= maxConnections_)
+        {
+            close( fd ) ;
+            continue ;
+        }
+
+        connections.emplace_back() ;
+        Connection & connection = connections.back() ;
+        connection.done = false ;
+        connection.server = thread( [this, fd, &connection]()
+                                    {
+                                        serveConnection( fd ) ;
+                                        connection.done = true ;
+                                    } ) ;
+        numConnections_ = connections.size() ;
+    }
+
+    for (auto & connection : connections)
+        connection.server.join() ;
+    numConnections_ = 0u ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyDaemon::stop
+ |
+ | DESCRIPTION
+ |
+ |     Only sets a flag, so it is safe to call from a signal handler.
+ |
+ +============================================================================*/
+
+void PolyDaemon::stop()
+{
+    stop_ = true ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyDaemon::serveConnection
+ |
+ | DESCRIPTION
+ |
+ |     Read request lines and run each one on the pool.  Responses from
+ |     requests running at the same time may interleave line by line, so we
+ |     serialize the sends.  When the client hangs up or we're stopped, wait
+ |     for the requests in flight before closing the connection.
+ |
+ +============================================================================*/
+
+void PolyDaemon::serveConnection( int fd )
+{
+    PP_TRACE_THREAD_NAME( "connection", fd ) ;
+    shared_ptr< mutex > sendMutex = make_shared< mutex >() ;
+    auto reply = [fd, sendMutex]( const string & line )
+    {
+        lock_guard< mutex > lock( *sendMutex ) ;
+        sendLine( fd, line ) ;
+    } ;
+
+    vector< future<void> > inFlight ;
+    string buffer ;
+    char   input[ 4096 ] ;
+
+    while (!stop_)
+    {
+        pollfd connection = { fd, POLLIN, 0 } ;
+        if (poll( &connection, 1, 100 ) <= 0)
+            continue ;
+
+        ssize_t n = recv( fd, input, sizeof( input ), 0 ) ;
+        if (n < 0 && errno == EINTR)
+            continue ;
+        if (n <= 0)
+            break ;
+
+        buffer.append( input, static_cast<size_t>( n ) ) ;
+
+        size_t endOfLine ;
+        while ((endOfLine = buffer.find( '\n' )) != string::npos)
+        {
+            string request = buffer.substr( 0, endOfLine ) ;
+            buffer.erase( 0, endOfLine + 1 ) ;
+
+            inFlight.push_back( pool_.submit( [this, request, reply]() { answer( request, reply ) ; } ) ) ;
+        }
+
+        // Forget the requests which are done.
+        inFlight.erase( remove_if( inFlight.begin(), inFlight.end(),
+                                   []( future<void> & f ) { return f.wait_for( chrono::seconds( 0 ) ) == future_status::ready ; } ),
+                        inFlight.end() ) ;
+    }
+
+    for (auto & request : inFlight)
+        request.wait() ;
+
+    close( fd ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyDaemon::answer
+ |
+ | DESCRIPTION
+ |
+ |     Parse and answer one request.  Any exception becomes the error line
+ |     which ends the request.
+ |
+ +============================================================================*/
+
+void PolyDaemon::answer( const string & request, const function< void( const string & ) > & reply )
+{
+    PP_TRACE_SCOPE( "query", "daemon" ) ;
+    typedef chrono::steady_clock Clock ;
+    const Clock::time_point received = Clock::now() ;
+
+    istringstream in( request ) ;
+    string id ;
+    in >> id ;
+
+    try
+    {
+        unsigned long deadlineMs = 0 ;
+        string command ;
+        if (!(in >> deadlineMs >> command))
+            throw DaemonError( "bad request, expecting <id> <deadline ms> <command> <arguments>" ) ;
+
+        // Check the deadline and the stop flag between units of work.
+        auto checkDeadline = [&]()
+        {
+            if (stop_)
+                throw DaemonError( "daemon is stopping" ) ;
+            if (deadlineMs > 0 && Clock::now() > received + chrono::milliseconds( deadlineMs ))
+                throw DaemonError( "deadline exceeded" ) ;
+        } ;
+        checkDeadline() ;
+
+        if (command == "test")
+        {
+            string rest ;
+            getline( in, rest ) ;
+
+            Polynomial f( rest ) ;
+            ppuint p = f.modulus() ;
+            int    n = f.deg() ;
+
+            if (n < static_cast<int>( minDegree ) || p < minModulus || p >= maxModulus || !isAlmostSurelyPrime( p ))
+                throw DaemonError( "p must be a prime and n must be >= 2" ) ;
+
+            PolyOrder order( *cache_.context( p, n ) ) ;
+            order.newPolynomial( f ) ;
+            reply( id + (order.isPrimitive() ? " ok primitive" : " ok not primitive") ) ;
+        }
+        else if (command == "first" || command == "count" || command == "enumerate")
+        {
+            ppuint p = 0 ;
+            int    n = 0 ;
+            if (!(in >> p >> n))
+                throw DaemonError( "bad request, expecting " + command + " <p> <n>" ) ;
+
+            if (n < static_cast<int>( minDegree ) || p < minModulus || p >= maxModulus || !isAlmostSurelyPrime( p ))
+                throw DaemonError( "p must be a prime and n must be >= 2" ) ;
+
+            shared_ptr< const PolyOrder > context = cache_.context( p, n ) ;
+
+            if (command == "count")
+            {
+                ostringstream os ;
+                os << id << " ok " << context->getNumPrimPoly() ;
+                reply( os.str() ) ;
+            }
+            else if (command == "first")
+            {
+                const pair< ppuint, int > key( p, n ) ;
+                string first ;
+                {
+                    lock_guard< mutex > lock( firstPrimitiveMutex_ ) ;
+                    auto found = firstPrimitive_.find( key ) ;
+                    if (found != firstPrimitive_.end())
+                        first = found->second ;
+                }
+
+                if (first.empty())
+                {
+                    PrimitivePolynomialSearch search( p, n, *context ) ;
+                    Polynomial f ;
+                    if (!search.next( f ))
+                        throw PolynomialError( "failed to find a primitive polynomial" ) ;
+                    first = f ;
+
+                    lock_guard< mutex > lock( firstPrimitiveMutex_ ) ;
+                    firstPrimitive_[ key ] = first ;
+                }
+
+                reply( id + " ok " + first ) ;
+            }
+            else
+            {
+                BigInt start ;
+                BigInt count ;
+                if (!(in >> start >> count))
+                    throw DaemonError( "bad request, expecting enumerate <p> <n> <k> <count>" ) ;
+
+                PrimitivePolynomialSearch search( p, n, *context ) ;
+                Polynomial f ;
+                BigInt k( 0u ) ;
+                BigInt end = start + count ;
+
+                while (k < end)
+                {
+                    checkDeadline() ;
+                    if (!search.next( f ))
+                        break ;
+                    if (k >= start)
+                        reply( id + " ok " + string( f ) ) ;
+                    ++k ;
+                }
+            }
+        }
+        else
+            throw DaemonError( "unknown command " + command ) ;
+
+        reply( id + " end" ) ;
+    }
+    catch( exception & e )
+    {
+        string what( e.what() ) ;
+        replace( what.begin(), what.end(), '\n', ' ' ) ;
+        reply( id + " error " + what ) ;
+    }
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyDaemonClient
+ |
+ | DESCRIPTION
+ |
+ |     Connect to the daemon.
+ |
+ +============================================================================*/
+
+PolyDaemonClient::PolyDaemonClient( const string & socketPath )
+    : fd_( -1 )
+    , nextId_( 0u )
+    , buffer_()
+{
+    sockaddr_un address = socketAddress( socketPath ) ;
+
+    fd_ = socket( AF_UNIX, SOCK_STREAM, 0 ) ;
+    if (fd_ < 0)
+        socketError( "Cannot create socket", socketPath, __FILE__, __LINE__ ) ;
+
+    if (connect( fd_, reinterpret_cast<sockaddr *>( &address ), sizeof( address ) ) < 0)
+    {
+        int error = errno ;
+        close( fd_ ) ;
+        errno = error ;
+        socketError( "Cannot connect to daemon at", socketPath, __FILE__, __LINE__ ) ;
+    }
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     ~PolyDaemonClient
+ |
+ | DESCRIPTION
+ |
+ |     Hang up.
+ |
+ +============================================================================*/
+
+PolyDaemonClient::~PolyDaemonClient()
+{
+    close( fd_ ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyDaemonClient::request
+ |
+ | DESCRIPTION
+ |
+ |     Send one request under a new id and collect its response lines up to
+ |     and including the end or error line.
+ |
+ +============================================================================*/
+
+vector<string> PolyDaemonClient::request( const string & request )
+{
+    ostringstream os ;
+    os << nextId_++ ;
+    const string id = os.str() + " " ;
+
+    if (!sendLine( fd_, id + request ))
+        throw DaemonError( "Lost the connection to the daemon" ) ;
+
+    vector<string> response ;
+    char input[ 4096 ] ;
+
+    for (;;)
+    {
+        size_t endOfLine ;
+        while ((endOfLine = buffer_.find( '\n' )) != string::npos)
+        {
+            string line = buffer_.substr( 0, endOfLine ) ;
+            buffer_.erase( 0, endOfLine + 1 ) ;
+
+            if (line.compare( 0, id.size(), id ) != 0)
+                continue ;
+
+            line.erase( 0, id.size() ) ;
+            response.push_back( line ) ;
+
+            if (line == "end" || line.compare( 0, 6, "error " ) == 0)
+                return response ;
+        }
+
+        ssize_t n = recv( fd_, input, sizeof( input ), 0 ) ;
+        if (n < 0 && errno == EINTR)
+            continue ;
+        if (n <= 0)
+            throw DaemonError( "Lost the connection to the daemon" ) ;
+
+        buffer_.append( input, static_cast<size_t>( n ) ) ;
+    }
+}
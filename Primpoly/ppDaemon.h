@@ -0,0 +1,201 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppDaemon.h
+|
+|  DESCRIPTION
+|
+|     Header file for the primitive polynomial query daemon, which answers
+|     requests over a Unix domain socket, and for a simple client.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with the !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+// Wrap this header file to prevent duplication if it is included
+// accidentally more than once.
+#ifndef __PP_DAEMON_H__
+#define __PP_DAEMON_H__
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     DaemonError
+|
+| DESCRIPTION
+|
+|     Exception class for socket errors in the daemon and its client,
+|     derived from the STL exception class runtime_error.
+|
++============================================================================*/
+
+class DaemonError : public runtime_error
+{
+    public:
+        // Throw with an error message.
+        DaemonError( const string & description )
+            : runtime_error( description )
+        {
+        } ;
+
+        // Throw with default error message.
+        DaemonError()
+            : runtime_error( "Daemon error:  " )
+        {
+        } ;
+
+} ; // end class DaemonError
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PolyDaemon
+|
+| DESCRIPTION
+|
+|     Serve primitive polynomial queries on a Unix domain socket.  Each
+|     request is one line of text,
+|
+|         <id> <deadline ms> <command> <arguments>
+|
+|     where id is any word the client picks and a deadline of 0 means none.
+|     Commands are
+|
+|         test <polynomial>               Is the polynomial primitive?
+|         first <p> <n>                   First primitive polynomial of degree n modulo p.
+|         count <p> <n>                   Number of primitive polynomials of degree n modulo p.
+|         enumerate <p> <n> <k> <count>   Primitive polynomials number k through k + count - 1,
+|                                         numbered from 0 in search order.
+|
+|     Every response line starts with the request id, so a client can have
+|     several requests in flight on one connection.  Results stream back as
+|
+|         <id> ok <result>
+|
+|     one line per result, then the request ends with either
+|
+|         <id> end
+|         <id> error <message>
+|
+|     Requests run on a shared thread pool.  The factorization of r for
+|     each (p, n) stays in a PolyOrderCache and first primitive polynomials
+|     are remembered, so repeated queries don't redo the work.  A request
+|     still running or waiting when its deadline passes ends with an error.
+|
+|     Each connection has its own thread, which we join as soon as the
+|     client hangs up.  While maxConnections clients are connected, we close
+|     any more right away.
+|
+| EXAMPLE
+|
+|     PolyDaemon daemon( "/tmp/primpoly.socket" ) ;
+|     daemon.run() ;   // Until another thread calls daemon.stop().
+|
++============================================================================*/
+
+class PolyDaemon
+{
+    public:
+        // Zero threads means one per hardware thread.
+        PolyDaemon( const string & socketPath, unsigned int numThreads = 0, size_t cacheSize = 16,
+                    size_t maxConnections = 64 ) ;
+
+        ~PolyDaemon() ;
+
+        // Accept connections and answer requests until stop() is called.
+        void run() ;
+
+        // Tell run() to return once the connections in progress are done.
+        void stop() ;
+
+        // Answer one request line, calling reply() with each response line.
+        void answer( const string & request, const function< void( const string & ) > & reply ) ;
+
+        // Clients connected now.
+        inline size_t numConnections() const { return numConnections_ ; } ;
+
+    private:
+        PolyDaemon( const PolyDaemon & ) = delete ;
+        PolyDaemon & operator=( const PolyDaemon & ) = delete ;
+
+        void serveConnection( int fd ) ;
+
+        string                          socketPath_ ;
+        int                             listenFd_ ;
+        atomic<bool>                    stop_ ;
+        size_t                          maxConnections_ ;
+        atomic<size_t>                  numConnections_ ;
+        ThreadPool                      pool_ ;
+        PolyOrderCache                  cache_ ;
+        map< pair< ppuint, int >, string > firstPrimitive_ ;   // Result store for first.
+        mutex                           firstPrimitiveMutex_ ;
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PolyDaemonClient
+|
+| DESCRIPTION
+|
+|     Connect to a PolyDaemon and send it one request at a time.
+|
+| EXAMPLE
+|
+|     PolyDaemonClient client( "/tmp/primpoly.socket" ) ;
+|     vector<string> response = client.request( "0 count 2 4" ) ;
+|     // response[ 0 ] == "ok 2", response[ 1 ] == "end"
+|
++============================================================================*/
+
+class PolyDaemonClient
+{
+    public:
+        explicit PolyDaemonClient( const string & socketPath ) ;
+
+        ~PolyDaemonClient() ;
+
+        // Send "<deadline ms> <command> <arguments>" and return the response lines without the id.
+        vector<string> request( const string & request ) ;
+
+    private:
+        PolyDaemonClient( const PolyDaemonClient & ) = delete ;
+        PolyDaemonClient & operator=( const PolyDaemonClient & ) = delete ;
+
+        int    fd_ ;
+        ppuint nextId_ ;
+        string buffer_ ;    // Received but not yet returned.
+} ;
+
+#endif // __PP_DAEMON_H__ -- End of wrapper for header file.
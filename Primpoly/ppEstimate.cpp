@@ -0,0 +1,706 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppEstimate.cpp
+|
+|  DESCRIPTION
+|
+|     Cost model for a search for primitive polynomials:  expected time to
+|     the first one, time for all of them and memory, calibrated by timing a
+|     few operations at degree n.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+
+
+/*------------------------------------------------------------------------------
+|                                Includes                                      |
+------------------------------------------------------------------------------*/
+
+#include <cstdlib>      // abort()
+#include <iostream>     // Basic stream I/O.
+#include <iomanip>      // setw()
+#include <new>          // set_new_handler()
+#include <cmath>        // Basic math functions e.g. sqrt()
+#include <limits>       // Numeric limits.
+#include <complex>      // Complex data type and operations.
+#include <fstream>      // File stream I/O.
+#include <sstream>      // String stream I/O.
+#include <vector>       // STL vector class.
+#include <string>       // STL string class.
+#include <algorithm>    // Iterators.
+#include <stdexcept>    // Exceptions.
+#include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <functional>   // function
+#include <iterator>     // input_iterator_tag
+#include <cstddef>      // ptrdiff_t
+#include <thread>       // hardware_concurrency()
+#include <mutex>        // Needed by ppBatch.h.
+#include <condition_variable>  // Needed by ppBatch.h.
+#include <future>       // Needed by ppBatch.h.
+#include <queue>        // Needed by ppBatch.h.
+#include <list>         // Needed by ppBatch.h.
+#include <map>          // Needed by ppBatch.h.
+#include <atomic>       // Needed by ppBatch.h.
+#include <random>       // Sample candidates.
+#include <chrono>       // steady_clock
+
+using namespace std ;   // So we don't need to say std::vector everywhere.
+
+
+
+/*------------------------------------------------------------------------------
+|                                PP Include Files                              |
+------------------------------------------------------------------------------*/
+
+#include "Primpoly.h"       // Global functions.
+#include "ppArith.h"        // Basic arithmetic functions.
+#include "ppBigInt.h"       // Arbitrary precision integer arithmetic.
+#include "ppOperationCount.h"   // OperationCount collection for factoring and poly finding.
+#include "ppFactor.h"       // Prime factorization and Euler Phi.
+#include "ppPolynomial.h"   // Polynomial operations and mod polynomial operations.
+#include "ppBatch.h"        // Thread pool and PolyOrder cache.
+#include "ppEstimate.h"     // Cost model.
+
+
+// Fewer sampled candidates than this reaching a stage is too few to count on.
+static const ppuint minSampled = 8u ;
+
+// Candidates we time the Q-I matrix and its nullity on, when n is too large to test whole ones.
+static const int numStageSamples = 2 ;
+
+// Primes below this are the ones we divide out of p ^ n - 1 when we couldn't factor it.
+static const ppuint smallPrimeLimit = 1000u ;
+
+// Buffers of the PolynomialWriter the Primpoly program lists polynomials with.
+static const double writerBytes = 2.0 * (1 << 20) ;
+
+
+// A count as a double, or tooLarge.
+static double approximately( const BigInt & count )
+{
+    ostringstream os ;
+    os << count ;
+    string digits = os.str() ;
+
+    return digits.size() > 300 ? tooLarge : strtod( digits.c_str(), nullptr ) ;
+}
+
+// Base 10 logarithm of a count which may be too big for a double.
+static double log10Approximately( const BigInt & count )
+{
+    ostringstream os ;
+    os << count ;
+    string digits = os.str() ;
+
+    return static_cast<double>( digits.size() - 1 ) + log10( strtod( ("0." + digits.substr( 0, 17 )).c_str(), nullptr ) * 10.0 ) ;
+}
+
+// Products and quotients which don't overflow.  With -ffast-math we can't count on infinity.
+static double product( double a, double b )
+{
+    if (a >= tooLarge || b >= tooLarge || (b > 1.0 && a > tooLarge / b))
+        return tooLarge ;
+
+    return a * b ;
+}
+
+static double sum( double a, double b )
+{
+    return (a >= tooLarge || b >= tooLarge) ? tooLarge : a + b ;
+}
+
+static double quotient( double a, double b )
+{
+    return a >= tooLarge ? tooLarge : a / b ;
+}
+
+// Mean time of the stage, in seconds.
+static double meanSeconds( const LatencyHistogram & time )
+{
+    return time.count() == 0u ? 0.0 : time.totalNanoseconds() / 1.0e9 / time.count() ;
+}
+
+static double seconds( chrono::steady_clock::time_point start )
+{
+    return chrono::duration< double >( chrono::steady_clock::now() - start ).count() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     randomPolynomial
+ |
+ | DESCRIPTION
+ |
+ |     Monic polynomial of degree n modulo p with random coefficients.
+ |
+ +============================================================================*/
+
+static Polynomial randomPolynomial( ppuint p, int n, mt19937_64 & random )
+{
+    uniform_int_distribution< ppuint > coeff( 0u, p - 1u ) ;
+
+    Polynomial f ;
+    f.initial_trial_poly( n, p ) ;
+    for (int i = 0 ;  i < n ;  ++i)
+        f[ i ] = coeff( random ) ;
+
+    return f ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     smallPrimeFactors
+ |
+ | DESCRIPTION
+ |
+ |     Divide the primes below limit out of m.  Return them, and leave m with
+ |     only the larger primes.
+ |
+ +============================================================================*/
+
+static vector< ppuint > smallPrimeFactors( BigInt & m, ppuint limit )
+{
+    vector< ppuint > primes ;
+
+    // A composite d never divides, since we've divided its primes out already.
+    for (ppuint d = 2u ;  d < limit && m > static_cast<BigInt>( 1u ) ;  ++d)
+    {
+        if (m % d != 0u)
+            continue ;
+
+        primes.push_back( d ) ;
+        while (m % d == 0u)
+            m /= d ;
+    }
+
+    return primes ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     estimateJob
+ |
+ | DESCRIPTION
+ |
+ |     Get the context, then calibrate:  square a dense polynomial modulo a
+ |     random f( x ) for a while, then test random candidates until we have
+ |     seen some Q-I matrices.  Put the time of each stage together with the
+ |     fraction of candidates which reach it.
+ |
+ +============================================================================*/
+
+JobEstimate estimateJob( ppuint p, int n, double calibrationSeconds, unsigned int numThreads, PolyOrderCache * cache,
+                         double factoringSeconds )
+{
+    if (n < 2 || p < 2 || !isAlmostSurelyPrime( p ))
+    {
+        ostringstream os ;
+        os << "estimateJob:  p = " << p << " must be a prime and n = " << n << " must be at least 2"
+           << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw PolynomialRangeError( os.str() ) ;
+    }
+
+    if (numThreads == 0)
+        numThreads = max( thread::hardware_concurrency(), 1u ) ;
+
+    JobEstimate estimate ;
+    estimate.p = p ;
+    estimate.n = n ;
+
+    // Factor r, unless the cache has done it already.  The factor tables make it quick for small p,
+    // but otherwise it can take hours, so give up after factoringSeconds and do without the factors.
+    chrono::steady_clock::time_point start = chrono::steady_clock::now() ;
+    shared_ptr< const PolyOrder > context ;
+    Polynomial f ;
+    f.initial_trial_poly( n, p ) ;
+    try
+    {
+        FactoringDeadline deadline( factoringSeconds ) ;
+        context = cache != nullptr ? cache->context( p, n ) : make_shared< const PolyOrder >( f ) ;
+        estimate.factored = true ;
+    }
+    catch( FactorTimeout & e )
+    {
+        context = make_shared< const PolyOrder >( f, Factorization<BigInt>() ) ;
+        estimate.factored = false ;
+    }
+    estimate.setupSeconds = seconds( start ) ;
+
+    estimate.maxNumPoly       = context->getMaxNumPoly() ;
+    estimate.numPrimitivePoly = context->getNumPrimPoly() ;
+    estimate.r                = context->getR() ;
+    estimate.numPossible      = approximately( estimate.maxNumPoly ) ;
+    estimate.numOrderMTests   = 0 ;
+
+    if (estimate.factored)
+    {
+        const Factorization<BigInt> & factors = context->getFactorsOfR() ;
+        for (int i = 0 ;  i < static_cast<int>( factors.num_distinct_factors() ) ;  ++i)
+        {
+            // Primes of p - 1 divided out of r are left with multiplicity 0.
+            if (factors.multiplicity( i ) == 0)
+                continue ;
+
+            estimate.factorsOfR.push_back( make_pair( factors.prime_factor( i ), factors.multiplicity( i ) ) ) ;
+            if (!factors.skip_test( p, i ))
+                ++estimate.numOrderMTests ;
+        }
+
+        if (estimate.numPossible < tooLarge)
+            estimate.density = approximately( estimate.numPrimitivePoly ) / estimate.numPossible ;
+        else
+            estimate.density = pow( 10.0, log10Approximately( estimate.numPrimitivePoly ) - log10Approximately( estimate.maxNumPoly ) ) ;
+    }
+    else
+    {
+        //                 n             n                                      n
+        // density = Phi( p  - 1 ) / (n p ), about the product of 1 - 1 / q over primes q of p  - 1, over n.
+        BigInt pToNMinus1 = estimate.maxNumPoly - static_cast<BigInt>( 1u ) ;
+        estimate.density = 1.0 / n ;
+        for (ppuint q : smallPrimeFactors( pToNMinus1, smallPrimeLimit ))
+            estimate.density *= 1.0 - 1.0 / static_cast<double>( q ) ;
+
+        // Primes of r which divide p - 1 don't need an order m test.  What's left of r has at least one prime.
+        BigInt rest = estimate.r ;
+        for (ppuint q : smallPrimeFactors( rest, smallPrimeLimit ))
+            if ((p - 1u) % q != 0u)
+                ++estimate.numOrderMTests ;
+        if (rest > static_cast<BigInt>( 1u ))
+            ++estimate.numOrderMTests ;
+    }
+    estimate.numToFirst  = min( quotient( 1.0, estimate.density ), estimate.numPossible ) ;
+
+    // Always the same candidates, so estimates can be compared from run to run.
+    mt19937_64 random( 20181123u ) ;
+
+    //                        2
+    // Time g( x ) := g( x )  (mod f( x ), p) for a dense g( x ), a few at a time between clock reads.
+    {
+        Polynomial f = randomPolynomial( p, n, random ) ;
+        PolyMod g( randomPolynomial( p, n - 1, random ), f ) ;
+
+        ppuint numSquarings = 0 ;
+        start = chrono::steady_clock::now() ;
+        do
+        {
+            for (int i = 0 ;  i < 8 ;  ++i)
+                g.square() ;
+            numSquarings += 8 ;
+        }
+        while (seconds( start ) < calibrationSeconds) ;
+
+        estimate.squareSeconds = seconds( start ) / numSquarings ;
+    }
+
+    //      r                                                        r
+    // Each x  is about log2( r ) squarings;  multiplying by x is cheap.  x  / p  takes about as many.
+    //                                                                          i
+    double squaringsPerPower = max( log10Approximately( estimate.r ) / log10( 2.0 ), 1.0 ) ;
+    double bitsOfP           = max( log10( static_cast<double>( p ) ) / log10( 2.0 ), 1.0 ) ;
+
+    // A row of the Q-I matrix is one multiplication, and a pivot row of its nullity about as much work
+    // as one squaring.  Bound the time to test one candidate which reaches every stage.
+    double wholeCandidateSeconds = (2.0 * n + bitsOfP + (1.0 + estimate.numOrderMTests) * squaringsPerPower)
+                                 * estimate.squareSeconds ;
+
+    PolyOrder order( *context ) ;
+    OperationCount & sample = order.statistics_ ;
+    double earlySeconds = 0.0 ;
+
+    if (minSampled * wholeCandidateSeconds <= calibrationSeconds)
+    {
+        // Test a sample of random candidates, but start no more once the time is up.
+        estimate.qMatrixRows = n ;
+        start = chrono::steady_clock::now() ;
+        do
+        {
+            order.newPolynomial( randomPolynomial( p, n, random ) ) ;
+            order.isPrimitive() ;
+        }
+        while (seconds( start ) < calibrationSeconds) ;
+
+        // Time per candidate of the stages most of them go through.
+        for (PolyOrderStage stage : { PolyOrderStage::ConstantCoeff, PolyOrderStage::LinearFactor,
+                                      PolyOrderStage::QMatrix, PolyOrderStage::Nullity })
+            earlySeconds += sample.stageTime( stage ).totalNanoseconds() / 1.0e9 ;
+
+        estimate.qMatrixSeconds = meanSeconds( sample.stageTime( PolyOrderStage::QMatrix ) ) ;
+        estimate.nullitySeconds = meanSeconds( sample.stageTime( PolyOrderStage::Nullity ) ) ;
+    }
+    else
+    {
+        // One candidate would take too long, and whether the few we could test are irreducible would
+        // decide the estimate.  Time each stage on its own instead.  The first two cost next to nothing,
+        // so run them on a sample of random candidates as isPrimitive() does.
+        ArithModP modp( p ) ;
+        start = chrono::steady_clock::now() ;
+        do
+        {
+            Polynomial f = randomPolynomial( p, n, random ) ;
+            ++sample.numPolyTested ;
+
+            bool primitiveRoot ;
+            {
+                StageTimer timer( sample.stageTime( PolyOrderStage::ConstantCoeff ) ) ;
+                primitiveRoot = modp.const_coeff_is_primitive_root( f[ 0 ], n ) ;
+            }
+            if (!primitiveRoot)
+                continue ;
+            ++sample.numConstantCoeffIsPrimitiveRoot ;
+
+            bool linearFactor ;
+            {
+                StageTimer timer( sample.stageTime( PolyOrderStage::LinearFactor ) ) ;
+                linearFactor = f.hasLinearFactor() ;
+            }
+            if (!linearFactor)
+                ++sample.numFreeOfLinearFactors ;
+        }
+        while (seconds( start ) < calibrationSeconds) ;
+
+        for (PolyOrderStage stage : { PolyOrderStage::ConstantCoeff, PolyOrderStage::LinearFactor })
+            earlySeconds += sample.stageTime( stage ).totalNanoseconds() / 1.0e9 ;
+
+        // Then build and reduce the first few rows of Q-I for a fixed number of candidates, as many rows
+        // as fit into the time limit, and scale up to n rows.
+        estimate.qMatrixRows = static_cast<int>( min( max( calibrationSeconds / (2.0 * numStageSamples * estimate.squareSeconds), 3.0 ),
+                                                      static_cast<double>( n ) ) ) ;
+        PolyOrder rows( *context ) ;
+        for (int i = 0 ;  i < numStageSamples ;  ++i)
+        {
+            rows.newPolynomial( randomPolynomial( p, n, random ) ) ;
+            rows.hasMultipleDistinctFactors( false, estimate.qMatrixRows ) ;
+        }
+
+        //                p                                                                  p
+        // Q-I starts with x , about log2( p ) squarings, then takes one multiplication by x  for each row
+        // after the second.  Its nullity takes one pivot per row;  count all n, as for an irreducible f( x ).
+        double xToPSeconds = bitsOfP * estimate.squareSeconds ;
+        double rowSeconds  = (meanSeconds( rows.statistics_.stageTime( PolyOrderStage::QMatrix ) ) - xToPSeconds)
+                           / max( estimate.qMatrixRows - 2, 1 ) ;
+        if (!(rowSeconds > 0.0))
+            rowSeconds = estimate.squareSeconds ;
+
+        estimate.qMatrixSeconds = xToPSeconds + (n - 2) * rowSeconds ;
+        estimate.nullitySeconds = meanSeconds( rows.statistics_.stageTime( PolyOrderStage::Nullity ) ) / estimate.qMatrixRows * n ;
+        earlySeconds += static_cast<double>( static_cast<ppuint>( static_cast<BigInt>( sample.numFreeOfLinearFactors ) ) )
+                      * (estimate.qMatrixSeconds + estimate.nullitySeconds) ;
+    }
+
+    double numSampled = static_cast<double>( static_cast<ppuint>( static_cast<BigInt>( sample.numPolyTested ) ) ) ;
+    estimate.numSampled = static_cast<ppuint>( numSampled ) ;
+    earlySeconds /= numSampled ;
+
+    // We time the order r and m tests on the sample if enough candidates reach them.  Otherwise we take
+    // them from the time of a squaring, which is how we time them in isolation.
+    const LatencyHistogram & orderR = sample.stageTime( PolyOrderStage::OrderR ) ;
+    const LatencyHistogram & orderM = sample.stageTime( PolyOrderStage::OrderM ) ;
+    estimate.orderRSeconds = orderR.count() != 0u ? meanSeconds( orderR )
+                                                  : squaringsPerPower * estimate.squareSeconds ;
+
+    // Without the factors of r, the order m tests of the sample don't count.
+    estimate.orderMSeconds = orderM.count() != 0u && estimate.factored ? meanSeconds( orderM )
+                                                  : estimate.numOrderMTests * squaringsPerPower * estimate.squareSeconds ;
+
+    // Fraction of candidates reaching the order tests.  About 1 in n of those with a primitive root
+    // constant are irreducible, and nearly all which reach the order m test are primitive.
+    auto fraction = [numSampled]( const OperationCounter & count, double otherwise )
+    {
+        double num = static_cast<double>( static_cast<ppuint>( static_cast<BigInt>( count ) ) ) ;
+        return num >= minSampled ? num / numSampled : otherwise ;
+    } ;
+
+    double reachOrderR = fraction( sample.numIrreducibleToPower,
+                                   fraction( sample.numConstantCoeffIsPrimitiveRoot, 0.5 ) / n ) ;
+    double reachOrderM = fraction( sample.numPassingConstantCoeffTest, estimate.density ) ;
+
+    estimate.candidateSeconds = earlySeconds + reachOrderR * estimate.orderRSeconds + reachOrderM * estimate.orderMSeconds ;
+
+    // Working memory of one search:  the Q-I matrix, a few polynomials, r, its factors and the exponents m.
+    double bytesOfR    = sizeof( BigInt ) + log10Approximately( estimate.r ) / log10( 2.0 ) / 8.0 ;
+    double searchBytes = sizeof( PolyOrder ) + static_cast<double>( n ) * (n * sizeof( ppsint ) + sizeof( vector< ppsint > ))
+                       + 8.0 * (n + 1) * sizeof( ppuint ) + 2.0 * estimate.factorsOfR.size() * bytesOfR ;
+
+    //                                                                                         b
+    // Archive:  about one difference of 1 / density per polynomial, in 7 bit bytes, plus per block a record of n
+    // bit coefficients and an index entry.
+    double numPrimitivePoly = min( product( estimate.density, estimate.numPossible ), estimate.numPossible ) ;
+    double bytesPerDiff     = max( ceil( log10( max( quotient( 1.0, estimate.density ), 2.0 ) ) / log10( 2.0 ) / 7.0 ), 1.0 ) ;
+    double bitsPerCoeff     = ceil( log10( static_cast<double>( p ) ) / log10( 2.0 ) ) ;
+    double numBlocks        = ceil( quotient( numPrimitivePoly, 256.0 ) ) ;
+    double archiveBytes     = sum( 40.0, sum( product( numPrimitivePoly, bytesPerDiff ),
+                                       product( numBlocks, ceil( n * bitsPerCoeff / 8.0 ) + 8.0 ) ) ) ;
+
+    double c         = estimate.candidateSeconds ;
+    double toFirst   = sum( estimate.setupSeconds, product( estimate.numToFirst, c ) ) ;
+    double forAll    = sum( estimate.setupSeconds, product( estimate.numPossible, c ) ) ;
+    double threads   = static_cast<double>( numThreads ) ;
+    double shardAggregatorBytes = 3.0 * (n + 1) * sizeof( ppuint ) ;
+
+    // The shards start at once, so the first of them finds one about numThreads times as soon.
+    estimate.strategies.push_back( { "search", 1, toFirst, forAll, searchBytes + writerBytes, 0.0 } ) ;
+    estimate.strategies.push_back( { "parallel", static_cast<int>( numThreads ),
+                                     sum( estimate.setupSeconds, product( quotient( estimate.numToFirst, threads ), c ) ),
+                                     sum( estimate.setupSeconds, product( quotient( estimate.numPossible, threads ), c ) ),
+                                     threads * (searchBytes + shardAggregatorBytes), 0.0 } ) ;
+    estimate.strategies.push_back( { "archive", 1, toFirst, forAll,
+                                     sum( searchBytes, product( numBlocks, 8.0 ) ), archiveBytes } ) ;
+
+    return estimate ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     JobEstimate::strategy
+ |
+ | DESCRIPTION
+ |
+ |     Look up a strategy by name.
+ |
+ +============================================================================*/
+
+const StrategyEstimate & JobEstimate::strategy( const string & name ) const
+{
+    for (const StrategyEstimate & estimate : strategies)
+        if (estimate.name == name)
+            return estimate ;
+
+    ostringstream os ;
+    os << "JobEstimate:  no strategy named " << name << " at " << __FILE__ << ": line " << __LINE__ ;
+    throw PolynomialRangeError( os.str() ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     operator<< for JobEstimate
+ |
+ | DESCRIPTION
+ |
+ |     Print the estimate as a table, with times and sizes in handy units.
+ |
+ +============================================================================*/
+
+static string duration( double seconds )
+{
+    static const struct { const char * unit ; double seconds ; } units[] =
+    {
+        { "years", 365.25 * 86400.0 }, { "days", 86400.0 }, { "h", 3600.0 }, { "min", 60.0 },
+        { "s", 1.0 }, { "ms", 1.0e-3 }, { "us", 1.0e-6 }, { "ns", 1.0e-9 }
+    } ;
+
+    if (seconds >= tooLarge)
+        return "forever" ;
+
+    ostringstream os ;
+    os << setprecision( 3 ) ;
+    for (const auto & unit : units)
+        if (seconds >= unit.seconds || unit.seconds == 1.0e-9)
+        {
+            os << seconds / unit.seconds << " " << unit.unit ;
+            break ;
+        }
+
+    return os.str() ;
+}
+
+static string size( double bytes )
+{
+    static const char * const units[] = { "B", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB" } ;
+
+    if (bytes >= tooLarge)
+        return "too large" ;
+
+    int k = 0 ;
+    while (bytes >= 1024.0 && k < 6)
+    {
+        bytes /= 1024.0 ;
+        ++k ;
+    }
+
+    ostringstream os ;
+    os << setprecision( 3 ) << bytes << " " << units[ k ] ;
+    return os.str() ;
+}
+
+ostream & operator<<( ostream & out, const JobEstimate & estimate )
+{
+    ostringstream os ;
+    os << setprecision( 6 ) ;
+
+    os << "+--------- Estimate --------------------------------------\n" ;
+    os << "|\n" ;
+    os << "| Total num. degree " << estimate.n << " poly mod " << estimate.p << " :      " << estimate.maxNumPoly << "\n" ;
+    if (estimate.factored)
+    {
+        os << "| Number of possible primitive poly:    " << estimate.numPrimitivePoly << "\n" ;
+        os << "| Density of primitive poly :           " << estimate.density << "\n" ;
+    }
+    else
+    {
+        os << "| Number of possible primitive poly:    unknown\n" ;
+        os << "| Density of primitive poly :           about " << estimate.density << "\n" ;
+    }
+    os << "| r = (p^n - 1) / (p - 1) :             " << estimate.r << (estimate.factored ? " =" : " = unknown factors") ;
+    for (size_t i = 0 ;  i < estimate.factorsOfR.size() ;  ++i)
+    {
+        os << (i == 0 ? " " : " * ") << estimate.factorsOfR[ i ].first ;
+        if (estimate.factorsOfR[ i ].second > 1)
+            os << " ^ " << estimate.factorsOfR[ i ].second ;
+    }
+    os << "\n" ;
+    os << "| Order m tests per poly :              " << (estimate.factored ? "" : "at least ") << estimate.numOrderMTests << "\n" ;
+    os << "|\n" ;
+    os << "| Calibration with " << estimate.numSampled << " random candidates\n" ;
+    if (estimate.qMatrixRows < estimate.n)
+        os << "| Q-I matrix and nullity scaled from " << estimate.qMatrixRows << " of " << estimate.n << " rows\n" ;
+    os << "|\n" ;
+    os << "| Factoring r :                         " << (estimate.factored ? "" : "gave up after ") << duration( estimate.setupSeconds ) << "\n" ;
+    os << "| Squaring mod f(x) :                   " << duration( estimate.squareSeconds ) << "\n" ;
+    os << "| Q-I matrix :                          " << duration( estimate.qMatrixSeconds ) << "\n" ;
+    os << "| Nullity of Q-I :                      " << duration( estimate.nullitySeconds ) << "\n" ;
+    os << "| Order r :                             " << duration( estimate.orderRSeconds ) << "\n" ;
+    os << "| Order m :                             " << duration( estimate.orderMSeconds ) << "\n" ;
+    os << "| Per candidate, on average :           " << duration( estimate.candidateSeconds ) << "\n" ;
+    os << "|\n" ;
+
+    for (const StrategyEstimate & strategy : estimate.strategies)
+    {
+        os << "| Strategy " << strategy.name << ", " << strategy.numThreads << " thread" << (strategy.numThreads == 1 ? "" : "s") << "\n" ;
+        os << "|     First primitive poly :            " << duration( strategy.secondsToFirst ) << "\n" ;
+        os << "|     All primitive poly :              " << duration( strategy.secondsForAll ) << "\n" ;
+        os << "|     Memory :                          " << size( strategy.memoryBytes ) << "\n" ;
+        if (strategy.diskBytes > 0.0)
+            os << "|     Disk :                            " << size( strategy.diskBytes ) << "\n" ;
+    }
+
+    os << "|\n" ;
+    os << "+-----------------------------------------------------\n" ;
+
+    out << os.str() ;
+    return out ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     writeEstimateJson
+ |
+ | DESCRIPTION
+ |
+ |     Write the estimate as one JSON object on one line, for a scheduler.
+ |     Counts can go past 2 ^ 64, so we write them as exact integers.  If we
+|     couldn't factor r, the number of primitive polynomials is null, and
+|     setup_seconds is only a lower bound.
+ |
+ | EXAMPLE
+ |
+ |     {"p":2,"n":4,"possible":16,"factored":true,"primitive":2,"density":0.125,"r":15,"factors_of_r":[[3,1],[5,1]],
+ |      "order_m_tests":2,"calibration":{"sampled":1000,"q_matrix_rows":4,"setup_seconds":1.2e-05,...},
+ |      "strategies":[{"name":"search","threads":1,"seconds_to_first":2.1e-06,...},...]}
+ |
+ +============================================================================*/
+
+void writeEstimateJson( ostream & out, const JobEstimate & estimate )
+{
+    ostringstream os ;
+    os << setprecision( 6 ) ;
+
+    auto value = [&os]( double x ) -> ostream &
+    {
+        if (x >= tooLarge)
+            os << "null" ;
+        else
+            os << x ;
+        return os ;
+    } ;
+
+    os << "{\"p\":" << estimate.p << ",\"n\":" << estimate.n
+       << ",\"possible\":" << estimate.maxNumPoly
+       << ",\"factored\":" << (estimate.factored ? "true" : "false")
+       << ",\"primitive\":" ;
+    if (estimate.factored)
+        os << estimate.numPrimitivePoly ;
+    else
+        os << "null" ;
+    os << ",\"density\":" << estimate.density
+       << ",\"r\":" << estimate.r
+       << ",\"factors_of_r\":[" ;
+    for (size_t i = 0 ;  i < estimate.factorsOfR.size() ;  ++i)
+        os << (i == 0 ? "" : ",") << "[" << estimate.factorsOfR[ i ].first << "," << estimate.factorsOfR[ i ].second << "]" ;
+
+    os << "],\"order_m_tests\":" << estimate.numOrderMTests
+       << ",\"calibration\":{\"sampled\":" << estimate.numSampled
+       << ",\"q_matrix_rows\":" << estimate.qMatrixRows
+       << ",\"setup_seconds\":" << estimate.setupSeconds
+       << ",\"square_seconds\":" << estimate.squareSeconds
+       << ",\"q_matrix_seconds\":" << estimate.qMatrixSeconds
+       << ",\"nullity_seconds\":" << estimate.nullitySeconds
+       << ",\"order_r_seconds\":" << estimate.orderRSeconds
+       << ",\"order_m_seconds\":" << estimate.orderMSeconds
+       << ",\"candidate_seconds\":" << estimate.candidateSeconds
+       << "},\"strategies\":[" ;
+
+    for (size_t i = 0 ;  i < estimate.strategies.size() ;  ++i)
+    {
+        const StrategyEstimate & strategy = estimate.strategies[ i ] ;
+        os << (i == 0 ? "" : ",") << "{\"name\":\"" << strategy.name << "\",\"threads\":" << strategy.numThreads
+           << ",\"seconds_to_first\":" ;
+        value( strategy.secondsToFirst ) << ",\"seconds_for_all\":" ;
+        value( strategy.secondsForAll ) << ",\"memory_bytes\":" ;
+        value( strategy.memoryBytes ) << ",\"disk_bytes\":" ;
+        value( strategy.diskBytes ) << "}" ;
+    }
+    os << "]}\n" ;
+
+    out << os.str() ;
+}
@@ -0,0 +1,182 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppEstimate.h
+|
+|  DESCRIPTION
+|
+|     Header file for estimating how long a search for primitive polynomials
+|     of degree n modulo p will take, and how much memory it needs, before
+|     we run it.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with the !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+// Wrap this header file to prevent duplication if it is included
+// accidentally more than once.
+#ifndef __PP_ESTIMATE_H__
+#define __PP_ESTIMATE_H__
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     StrategyEstimate
+|
+| DESCRIPTION
+|
+|     Predicted cost of one way of running a job:
+|
+|         name             search    PrimitivePolynomialSearch in one thread,
+|                                    as for Primpoly p n and Primpoly -a p n.
+|                          parallel  One shard per thread, as for Primpoly -g.
+|                          archive   One thread, writing an archive, as for -w.
+|
+|         numThreads       Threads the strategy uses.
+|         secondsToFirst   Until the first primitive polynomial turns up.
+|         secondsForAll    Until we have all of them.
+|         memoryBytes      Working memory of the search, not counting the program.
+|         diskBytes        Size of the file we write, if any.
+|
+|     Times and sizes too large for a double are tooLarge.
+|
++============================================================================*/
+
+static const double tooLarge = numeric_limits< double >::max() ;
+
+struct StrategyEstimate
+{
+    string name ;
+    int    numThreads ;
+    double secondsToFirst ;
+    double secondsForAll ;
+    double memoryBytes ;
+    double diskBytes ;
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     JobEstimate
+|
+| DESCRIPTION
+|
+|     Cost model of a search for primitive polynomials of degree n modulo p.
+|
+|     The density of primitive polynomials among the p ^ n monic candidates
+|                  n
+|     is  Phi( p  - 1 ) / (n p ^ n).  They are spread evenly enough that we
+|     test about 1 / density candidates before we find one, and all of them
+|     before we find the last one.
+|
+|     We take r and its factorization from the PolyOrder context.  Without a
+|     factor table, factoring r can take hours, so we give up after a time
+|     budget.  Then we don't know the number of primitive polynomials or the
+|     factors of r;  we approximate the density from the small primes of
+|     p ^ n - 1, since the large ones hardly change it, and count one order m
+|     test for each small prime of r and one for what is left of it.
+|
+|     Then we time a run of PolyMod::square() at degree n, and test a sample
+|     of random candidates until the calibration time is up.  The sample
+|     gives us how many candidates pass each stage of
+|     PolyOrder::isPrimitive() and the time of the early stages, including
+|     the Q-I matrix and its nullity.  Few candidates reach the order r and m
+|     tests, so if the sample has too few of them, or we have no factors of
+|     r, we estimate those tests from the number of squarings they take.
+|
+|     For large n, one candidate can take seconds, and whether the few we
+|     could test happen to be irreducible would decide the estimate.  So if
+|     a candidate might take more than an eighth of the calibration time, we
+|     only run the cheap first stages on the sample.  We time the Q-I matrix
+|     and its nullity on a few rows of a fixed number of candidates, and
+|     scale up to n rows.  Then the estimate takes about three times the
+|     calibration time, plus factoring r and a few squarings.
+|
+|     Nothing here does console I/O;  print the estimate with operator<<
+|     or writeEstimateJson().
+|
+| EXAMPLE
+|
+|     JobEstimate estimate = estimateJob( 2, 64 ) ;
+|     if (estimate.strategy( "search" ).secondsToFirst > 60.0)
+|         reject() ;
+|
++============================================================================*/
+
+struct JobEstimate
+{
+    ppuint p ;
+    int    n ;
+
+    BigInt maxNumPoly ;             // p ^ n
+    bool   factored ;               // False if factoring r ran out of time.
+    BigInt numPrimitivePoly ;       // Phi( p ^ n - 1 ) / n, or 0 if not factored.
+    double density ;                // numPrimitivePoly / maxNumPoly
+    double numToFirst ;             // Candidates we expect to test to find the first one.
+    double numPossible ;            // maxNumPoly, or tooLarge if it doesn't fit in a double.
+
+    BigInt r ;                      // (p ^ n - 1) / (p - 1)
+    vector< pair< BigInt, int > > factorsOfR ;  // Distinct primes of r and their multiplicities, if factored.
+    int    numOrderMTests ;         // Prime factors of r we need an order m test for.
+
+    ppuint numSampled ;             // Random candidates we tested to calibrate.
+    int    qMatrixRows ;            // Rows of Q-I we built and reduced to time it:  n, unless n is large.
+    double setupSeconds ;           // Factoring r, or 0 if the context was cached.  If not factored, the time we gave up after.
+    double squareSeconds ;          // One PolyMod::square() at degree n.
+    double qMatrixSeconds ;         // One Q-I matrix.
+    double nullitySeconds ;         // One findNullity().
+    double orderRSeconds ;          // One order r test.
+    double orderMSeconds ;          // All the order m tests of one polynomial.
+    double candidateSeconds ;       // Expected time to test one candidate.
+
+    vector< StrategyEstimate > strategies ;
+
+    // The strategy of that name.  Throws PolynomialRangeError if there's no such strategy.
+    const StrategyEstimate & strategy( const string & name ) const ;
+
+    // A table like the OperationCount one.
+    friend ostream & operator<<( ostream & out, const JobEstimate & estimate ) ;
+} ;
+
+
+class PolyOrderCache ;
+
+// Estimate a search for primitive polynomials of degree n modulo p.  Spend about calibrationSeconds
+// each timing squarings and testing sample candidates.  Zero threads means one per hardware thread.
+// If cache is not null, get the PolyOrder context from it.  Give up factoring r after factoringSeconds.
+// Throws PolynomialRangeError if p isn't a prime or n < 2.
+JobEstimate estimateJob( ppuint p, int n, double calibrationSeconds = 0.05, unsigned int numThreads = 0,
+                         PolyOrderCache * cache = nullptr, double factoringSeconds = 1.0 ) ;
+
+// Write the estimate as one JSON object on one line.  Times and sizes which are tooLarge are null.
+void writeEstimateJson( ostream & out, const JobEstimate & estimate ) ;
+
+#endif // __PP_ESTIMATE_H__ -- End of wrapper for header file.
@@ -51,6 +51,9 @@
 #include <stdexcept>    // Exceptions.
 #include <cassert>      // assert()
 #include <regex>        // Regular expressions.
+#include <random>       // Random number generators.
+#include <memory>       // shared_ptr
+#include <chrono>       // steady_clock
 
 using namespace std ;
 
@@ -67,6 +70,77 @@ using namespace std ;
 #include "ppParser.h"         // Parsing of polynomials and I/O services.
 #include "ppUnitTest.h"       // Complete unit test.
 
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     FactoringDeadline
+ |
+ | DESCRIPTION
+ |
+ |     Each thread has its own deadline, in steady clock nanoseconds, or 0
+ |     if it has none.  One step of factoring a small number takes less time
+ |     than reading the clock, but on numbers of thousands of bits a step can
+ |     take milliseconds.  So we read the clock every stride checks, and
+ |     adjust the stride to read it about every 100 microseconds.
+ |
+ +============================================================================*/
+
+static thread_local ppuint       factoringDeadline  = 0u ;
+static thread_local ppuint       factoringLastRead  = 0u ;
+static thread_local unsigned int factoringStride    = 1u ;
+static thread_local unsigned int factoringCountdown = 1u ;
+
+static const ppuint       factoringReadInterval = 100000u ;   // Nanoseconds.
+static const unsigned int factoringMaxStride    = 4096u ;
+
+static ppuint steadyNanoseconds()
+{
+    return static_cast<ppuint>( chrono::duration_cast< chrono::nanoseconds >(
+                                    chrono::steady_clock::now().time_since_epoch() ).count() ) ;
+}
+
+FactoringDeadline::FactoringDeadline( double seconds )
+    : previous_( factoringDeadline )
+{
+    ppuint now = steadyNanoseconds() ;
+    ppuint deadline = now + static_cast<ppuint>( max( seconds, 0.0 ) * 1.0e9 ) ;
+    factoringDeadline = previous_ != 0u ? min( previous_, deadline ) : deadline ;
+
+    factoringLastRead  = now ;
+    factoringStride    = 1u ;
+    factoringCountdown = 1u ;
+}
+
+FactoringDeadline::~FactoringDeadline()
+{
+    factoringDeadline = previous_ ;
+}
+
+void FactoringDeadline::check()
+{
+    if (factoringDeadline == 0u || --factoringCountdown != 0u)
+        return ;
+
+    ppuint now = steadyNanoseconds() ;
+    if (now > factoringDeadline)
+    {
+        ostringstream os ;
+        os << "Factoring ran out of time at " << __FILE__ << ": line " << __LINE__ ;
+        throw FactorTimeout( os.str() ) ;
+    }
+
+    if (now - factoringLastRead < factoringReadInterval)
+        factoringStride = min( 2u * factoringStride, factoringMaxStride ) ;
+    else if (factoringStride > 1u)
+        factoringStride /= 2u ;
+
+    factoringLastRead  = now ;
+    factoringCountdown = factoringStride ;
+}
+
 /*=============================================================================
  |
  | NAME
@@ -107,8 +181,6 @@ bool Factorization<IntType>::factorTable( ppuint p, ppuint n )
     if (p > factorTableName.size() - 1 || factorTableName[ p ].length() == 0)
         return false ;
     
-    string factorizationTableDir = PolyParser<PolySymbol, PolyValue>::factorizationTableLocation_ ;
-    
     // Open an input stream from the file.
     ifstream fin( factorTableName[ p ] ) ;
     
@@ -598,6 +670,7 @@ void Factorization<IntType>::trialDivision()
         IntType q = n_ / d ;
         IntType r = n_ % d ;
         ++statistics_.numTrialDivides ;
+        FactoringDeadline::check() ;
 
         #ifdef DEBUG_PP_FACTOR
         cout << "n = " << n_ << endl ;
@@ -735,6 +808,44 @@ Factorization<IntType> & Factorization<IntType>::operator=( const Factorization<
 }
 
 
+/*=============================================================================
+ |
+ | NAME
+ |
+ |    Factor move constructor and move assignment operator
+ |
+ | DESCRIPTION
+ |
+ |    Take over the vectors of factors instead of copying them.
+ |
+ +============================================================================*/
+
+template <typename IntType>
+Factorization<IntType>::Factorization( Factorization<IntType> && f ) noexcept
+        : statistics_( f.statistics_ )
+        , n_( std::move( f.n_ ) )
+		, numFactors_( f.numFactors_ )
+		, factor_( std::move( f.factor_ ) )
+		, distinctPrimeFactors_( std::move( f.distinctPrimeFactors_ ) )
+{
+}
+
+template <typename IntType>
+Factorization<IntType> & Factorization<IntType>::operator=( Factorization<IntType> && g ) noexcept
+{
+    if (this == &g)
+        return *this ;
+
+    n_          = std::move( g.n_ ) ;
+	factor_     = std::move( g.factor_ ) ;
+	distinctPrimeFactors_ = std::move( g.distinctPrimeFactors_ ) ;
+	numFactors_ = g.numFactors_ ;
+    statistics_ = g.statistics_ ;
+
+    return *this ;
+}
+
+
 /*=============================================================================
  |
  | NAME
@@ -989,20 +1100,20 @@ vector<IntType>Factorization<IntType>::getDistinctPrimeFactors()
      //
      
      //                           n
-     // Copy over the factors of p  - 1
-     factorsOfR = factors_of_p_to_n_minus_1 ;
+     // Move over the factors of p  - 1;  we don't need them after this.
+     factorsOfR = std::move( factors_of_p_to_n_minus_1 ) ;
      
      // We're done if p - 1 = 1.
      if (p > 2)
      {
          //                                             n                   n
          // p-1 cannot have more distinct factors than p - 1 since p - 1 | p  - 1
-         if (factors_of_p_minus_1.num_distinct_factors() > factors_of_p_to_n_minus_1.num_distinct_factors())
+         if (factors_of_p_minus_1.num_distinct_factors() > factorsOfR.num_distinct_factors())
          {
              ostringstream os ;
              os << "factorRAndFindNumberOfPrimitivePolynomials "
                 << " number of distinct prime factors for p-1   = " << factors_of_p_minus_1.num_distinct_factors() << " > "
-                << " number of distinct prime factors for p^n-1 = " << factors_of_p_to_n_minus_1.num_distinct_factors()
+                << " number of distinct prime factors for p^n-1 = " << factorsOfR.num_distinct_factors()
                 << " which is not possible since (p-1) | (p^n - 1)"
                 << " at " << __FILE__ << ": line " << __LINE__ ;
              throw BigIntUnderflow( os.str() ) ;
@@ -1286,10 +1397,10 @@ Primality isProbablyPrime( const IntType & n, const IntType & x )
  |        Addison-Wesley, 1981, pgs. 250-265.
  |
  |        Errata for Volume 2: http://www-cs-faculty.stanford.edu/~knuth/taocp.html
- | TODO:
+ | NOTES
  | 
- |     The system pseudorandom number generator needs to be a good one
- |     (i.e. passes the spectral test and other statistical tests).
+ |     We use the minimal standard generator of Park and Miller, which passes the
+ |     spectral test, and keep its state local to the call.
  |
  +============================================================================*/
 
@@ -1302,13 +1413,14 @@ bool isAlmostSurelyPrime( const IntType & n )
 
 	constexpr ppuint NUM_PRIME_TEST_TRIALS = 14u ;
 
-	// Seed the random-number generator.
-	srand( 314159u );
+	// Our own random-number generator, always with the same seed, so results are
+	// repeatable and threads testing primality don't share the state of rand().
+	minstd_rand random( 314159u ) ;
 
 	for (trial = static_cast<IntType>( 1u ) ;  trial <= static_cast<IntType>( NUM_PRIME_TEST_TRIALS ) ;  ++trial)
 	{
 		//  Generate a new random integer such that 1 < x < n.
-		x = static_cast<IntType>( rand() ) % n ;
+		x = static_cast<IntType>( static_cast<ppuint>( random() ) ) % n ;
 		
 		// Clip away from 1.
 		if (x <= static_cast<IntType>( 1u )) 
@@ -1452,6 +1564,7 @@ bool Factorization<IntType>::PollardRho( const IntType & c )
             IntType absDiff = (xp > x) ? (xp - x) : (x - xp) ;
             g = gcd( absDiff, n_ ) ;
             ++statistics_.numGCDs ;
+            FactoringDeadline::check() ;
 
             #ifdef DEBUG_PP_FACTOR
             cout << "    inner while loop, gcd = g = " << g << " |x -xp| = " << absDiff << " n_ = " << n_
@@ -1540,6 +1653,12 @@ template Factorization<BigInt>::Factorization( const Factorization<BigInt> & ) ;
 template Factorization<ppuint> & Factorization<ppuint>::operator=( const Factorization<ppuint> & ) ;
 template Factorization<BigInt> & Factorization<BigInt>::operator=( const Factorization<BigInt> & ) ;
 
+template Factorization<ppuint>::Factorization( Factorization<ppuint> && ) noexcept ;
+template Factorization<BigInt>::Factorization( Factorization<BigInt> && ) noexcept ;
+
+template Factorization<ppuint> & Factorization<ppuint>::operator=( Factorization<ppuint> && ) noexcept ;
+template Factorization<BigInt> & Factorization<BigInt>::operator=( Factorization<BigInt> && ) noexcept ;
+
 // TODO factorTable only uses BigInt type:
 template bool Factorization<ppuint>::factorTable( ppuint, ppuint ) ;
 template bool Factorization<BigInt>::factorTable( ppuint, ppuint ) ;
@@ -92,6 +92,26 @@ class FactorRangeError : public FactorError
 
 
 
+// Factoring went past the FactoringDeadline of its thread.
+class FactorTimeout : public FactorError
+{
+    public:
+        // Throw with an error message.
+        FactorTimeout( const string & description )
+			: FactorError( description )
+        {
+        } ;
+
+        // Default throw with no error message.
+        FactorTimeout()
+			: FactorError( "Factor timeout:  " )
+        {
+        } ;
+
+} ; // end class FactorTimeout
+
+
+
 /*=============================================================================
  |
  | NAME
@@ -124,6 +144,13 @@ class PrimeFactor
         {
         }
 
+        // Vectors of factors move rather than copy their elements when they grow.
+        PrimeFactor( PrimeFactor && factor ) noexcept
+            : prime_( std::move( factor.prime_ ) )
+            , count_( factor.count_ )
+        {
+        }
+
         PrimeFactor & operator=( const PrimeFactor & factor )
         {
             // Check for assigning to oneself:  just pass back a reference to the unchanged object.
@@ -135,6 +162,14 @@ class PrimeFactor
 			
 			return *this ;
         } ;
+
+        PrimeFactor & operator=( PrimeFactor && factor ) noexcept
+        {
+            prime_ = std::move( factor.prime_ ) ;
+            count_ = factor.count_ ;
+
+            return *this ;
+        } ;
     
         // Print function for a factor.
         friend ostream & operator<<( ostream & out, const PrimeFactor & factor )
@@ -243,10 +278,16 @@ class Factorization
 	   
         // Copy constructor.
         Factorization( const Factorization<IntType> & f ) ;
+
+        // Move constructor.
+        Factorization( Factorization<IntType> && f ) noexcept ;
 		
         // Assignment operator.
         Factorization<IntType> & operator=( const Factorization<IntType> & g ) ;
 
+        // Move assignment operator.
+        Factorization<IntType> & operator=( Factorization<IntType> && g ) noexcept ;
+
 	    // Return the number of distinct factors.
 		ppuint num_distinct_factors() const ;
 
@@ -321,6 +362,52 @@ class Factorization
 void factorRAndFindNumberOfPrimitivePolynomials( ppuint p, int n, 
          BigInt & maxNumPossiblePoly, BigInt & r, Factorization<BigInt> & factorsOfR, BigInt & numPrimitivePoly ) ;
 
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     FactoringDeadline
+|
+| DESCRIPTION
+|
+|     Without a factor table, factoring a large r by Pollard rho or trial
+|     division has no time bound.  While one of these is in scope, factoring
+|     on the same thread throws FactorTimeout once the time is up.  An inner
+|     deadline never extends an outer one.
+|
+| EXAMPLE
+|
+|     try
+|     {
+|         FactoringDeadline deadline( 1.0 ) ;
+|         PolyOrder order( f ) ;
+|     }
+|     catch( FactorTimeout & e )
+|     {
+|         ...  // Do without the factors of r.
+|     }
+|
++============================================================================*/
+
+class FactoringDeadline
+{
+    public:
+        explicit FactoringDeadline( double seconds ) ;
+
+        ~FactoringDeadline() ;
+
+        // Throw FactorTimeout if this thread is past its deadline.  Cheap enough for inner loops.
+        static void check() ;
+
+    private:
+        FactoringDeadline( const FactoringDeadline & ) = delete ;
+        FactoringDeadline & operator=( const FactoringDeadline & ) = delete ;
+
+        ppuint previous_ ;      // The deadline we replaced, in steady clock nanoseconds, or 0 for none.
+} ;
+
 /*=============================================================================
 |
 | NAME
@@ -0,0 +1,499 @@
+/*==============================================================================
+| 
+|  NAME
+|
+|     ppMonitor.cpp
+|
+|  DESCRIPTION
+|
+|     Search statistics as JSON and Prometheus text, and a statistics file
+|     rewritten every few seconds during a long search.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|     
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+
+
+/*------------------------------------------------------------------------------
+|                                Includes                                      |
+------------------------------------------------------------------------------*/
+
+#include <cstdlib>      // abort()
+#include <iostream>     // Basic stream I/O.
+#include <iomanip>      // setw()
+#include <new>          // set_new_handler()
+#include <cmath>        // Basic math functions e.g. sqrt()
+#include <limits>       // Numeric limits.
+#include <complex>      // Complex data type and operations.
+#include <fstream>      // File stream I/O.
+#include <sstream>      // String stream I/O.
+#include <vector>       // STL vector class.
+#include <string>       // STL string class.
+#include <algorithm>    // Iterators.
+#include <stdexcept>    // Exceptions.
+#include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <functional>   // function
+#include <iterator>     // input_iterator_tag
+#include <cstddef>      // ptrdiff_t
+#include <thread>       // Writer thread.
+#include <mutex>        // mutex, lock_guard, unique_lock
+#include <condition_variable>  // Wake up the writer thread.
+#include <atomic>       // Snapshot due flag.
+#include <chrono>       // steady_clock
+#include <cstdio>       // rename(), remove()
+
+using namespace std ;   // So we don't need to say std::vector everywhere.
+
+
+
+/*------------------------------------------------------------------------------
+|                                PP Include Files                              |
+------------------------------------------------------------------------------*/
+
+#include "Primpoly.h"       // Global functions.
+#include "ppArith.h"        // Basic arithmetic functions.
+#include "ppBigInt.h"       // Arbitrary precision integer arithmetic.
+#include "ppOperationCount.h"   // OperationCount collection for factoring and poly finding.
+#include "ppFactor.h"       // Prime factorization and Euler Phi.
+#include "ppPolynomial.h"   // Polynomial operations and mod polynomial operations.
+#include "ppParser.h"       // Parsing of polynomials and I/O services.
+#include "ppMonitor.h"      // Statistics export.
+#include "ppPerfCounters.h" // Hardware performance counters.
+
+
+// Decimal digits of a count, for counts too big for ppuint.
+template< typename Count >
+static string digits( const Count & count )
+{
+    ostringstream os ;
+    os << count ;
+    return os.str() ;
+}
+
+// Only needs to be good enough for rates and fractions.
+template< typename Count >
+static double approximately( const Count & count )
+{
+    return strtod( digits( count ).c_str(), nullptr ) ;
+}
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     Progress
+ |
+ | DESCRIPTION
+ |
+ |     Polynomials tested per second, the fraction of all p ^ n candidates
+ |     tested, and the estimated seconds to go, negative if we can't tell yet.
+ |
+ +============================================================================*/
+
+struct Progress
+{
+    Progress( const OperationCount & statistics, double elapsedSeconds, bool finished )
+        : rate( 0.0 )
+        , fraction( 0.0 )
+        , secondsToGo( -1.0 )
+    {
+        double numTested   = approximately( statistics.numPolyTested ) ;
+        double numPossible = approximately( statistics.maxNumPossiblePoly ) ;
+
+        if (elapsedSeconds > 0.0)
+            rate = numTested / elapsedSeconds ;
+
+        if (numPossible > 0.0)
+            fraction = min( numTested / numPossible, 1.0 ) ;
+
+        if (finished)
+            secondsToGo = 0.0 ;
+        else if (rate > 0.0)
+            secondsToGo = max( numPossible - numTested, 0.0 ) / rate ;
+    }
+
+    double rate ;
+    double fraction ;
+    double secondsToGo ;
+} ;
+
+
+// Survivors of each stage of PolyOrder::isPrimitive(), in the order we test them.
+static const struct { const char * name ; OperationCounter OperationCount::* count ; } survivors[] =
+{
+    { "tested",                     &OperationCount::numPolyTested },
+    { "const_coeff_primitive_root", &OperationCount::numConstantCoeffIsPrimitiveRoot },
+    { "free_of_linear_factors",     &OperationCount::numFreeOfLinearFactors },
+    { "irreducible_to_power",       &OperationCount::numIrreducibleToPower },
+    { "order_r",                    &OperationCount::numOrderR },
+    { "const_coeff_test",           &OperationCount::numPassingConstantCoeffTest },
+    { "order_m",                    &OperationCount::numOrderM }
+} ;
+
+static const struct { const char * name ; OperationCounter OperationCount::* count ; } factoring[] =
+{
+    { "trial_divides",    &OperationCount::numTrialDivides },
+    { "gcds",             &OperationCount::numGCDs },
+    { "primality_tests",  &OperationCount::numPrimalityTests },
+    { "squarings",        &OperationCount::numSquarings }
+} ;
+
+static const char * const stageName[ static_cast<int>( PolyOrderStage::NumStages ) ] =
+{
+    "const_coeff", "linear_factor", "q_matrix", "nullity", "order_r", "order_m"
+} ;
+
+static const char * const hardwareEventName[ static_cast<int>( HardwareEvent::NumEvents ) ] =
+{
+    "cycles", "instructions", "cache_misses", "branch_misses"
+} ;
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     writeStatisticsJson
+ |
+ | DESCRIPTION
+ |
+ |     Write the operation counts as one JSON object on one line.  Counts can
+ |     go past 2 ^ 64, so we write them as exact integers and leave it to the
+ |     reader how to hold them.  An unknown estimate is null.
+ |
+ | EXAMPLE
+ |
+ |     {"p":2,"n":4,"possible":16,"primitive":2,"finished":true,"elapsed_seconds":0.001, ...
+ |      "survivors":{"tested":3,...},"factoring":{"gcds":0,...},
+ |      "stage_time":{"const_coeff":{"calls":3,"nanoseconds":450,"buckets":[0,...]},...}}
+ |
+ +============================================================================*/
+
+void writeStatisticsJson( ostream & out, const OperationCount & statistics, double elapsedSeconds, bool finished )
+{
+    Progress progress( statistics, elapsedSeconds, finished ) ;
+
+    ostringstream os ;
+    os << setprecision( 6 ) ;
+    os << "{\"p\":" << statistics.p << ",\"n\":" << statistics.n
+       << ",\"possible\":" << digits( statistics.maxNumPossiblePoly )
+       << ",\"primitive\":" << digits( statistics.numPrimitivePoly )
+       << ",\"finished\":" << (finished ? "true" : "false")
+       << ",\"elapsed_seconds\":" << elapsedSeconds
+       << ",\"tested_per_second\":" << progress.rate
+       << ",\"progress\":" << progress.fraction
+       << ",\"eta_seconds\":" ;
+    if (progress.secondsToGo < 0.0)
+        os << "null" ;
+    else
+        os << progress.secondsToGo ;
+
+    os << ",\"survivors\":{" ;
+    for (size_t i = 0 ;  i < sizeof( survivors ) / sizeof( survivors[ 0 ] ) ;  ++i)
+        os << (i == 0 ? "" : ",") << "\"" << survivors[ i ].name << "\":" << statistics.*survivors[ i ].count ;
+
+    os << "},\"factoring\":{" ;
+    for (size_t i = 0 ;  i < sizeof( factoring ) / sizeof( factoring[ 0 ] ) ;  ++i)
+        os << (i == 0 ? "" : ",") << "\"" << factoring[ i ].name << "\":" << statistics.*factoring[ i ].count ;
+
+    os << "},\"stage_time\":{" ;
+    for (int stage = 0 ;  stage < static_cast<int>( PolyOrderStage::NumStages ) ;  ++stage)
+    {
+        const LatencyHistogram & time = statistics.stageTime( static_cast<PolyOrderStage>( stage ) ) ;
+        os << (stage == 0 ? "" : ",") << "\"" << stageName[ stage ] << "\":{\"calls\":" << time.count()
+           << ",\"nanoseconds\":" << time.totalNanoseconds() << ",\"buckets\":[" ;
+
+        for (int k = 0 ;  k < LatencyHistogram::numBuckets ;  ++k)
+            os << (k == 0 ? "" : ",") << time.bucket( k ) ;
+
+        os << "]}" ;
+    }
+
+    // Hardware events in each stage and factoring r, null where we didn't count them.
+    auto events = [&os]( const char * name, const HardwareCounts & counts )
+    {
+        os << "\"" << name << "\":{" ;
+        for (int event = 0 ;  event < static_cast<int>( HardwareEvent::NumEvents ) ;  ++event)
+        {
+            os << (event == 0 ? "" : ",") << "\"" << hardwareEventName[ event ] << "\":" ;
+            if (counts.has( static_cast<HardwareEvent>( event ) ))
+                os << counts.count( static_cast<HardwareEvent>( event ) ) ;
+            else
+                os << "null" ;
+        }
+        os << "}" ;
+    } ;
+
+    os << "},\"hardware\":{" ;
+    for (int stage = 0 ;  stage < static_cast<int>( PolyOrderStage::NumStages ) ;  ++stage)
+    {
+        events( stageName[ stage ], statistics.stageEvents( static_cast<PolyOrderStage>( stage ) ) ) ;
+        os << "," ;
+    }
+    events( "factoring", statistics.factoringEvents ) ;
+    os << "}}\n" ;
+
+    out << os.str() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     writeStatisticsPrometheus
+ |
+ | DESCRIPTION
+ |
+ |     Write the operation counts in the Prometheus text exposition format.
+ |     Every sample is labelled with p and n.  An unknown estimate is NaN.
+ |
+ | EXAMPLE
+ |
+ |     # HELP primpoly_survivors_total Polynomials passing each stage of the primitivity test.
+ |     # TYPE primpoly_survivors_total counter
+ |     primpoly_survivors_total{p="2",n="4",stage="tested"} 3
+ |
+ +============================================================================*/
+
+void writeStatisticsPrometheus( ostream & out, const OperationCount & statistics, double elapsedSeconds, bool finished )
+{
+    Progress progress( statistics, elapsedSeconds, finished ) ;
+
+    ostringstream labels ;
+    labels << "p=\"" << statistics.p << "\",n=\"" << statistics.n << "\"" ;
+    string pn = labels.str() ;
+
+    ostringstream os ;
+    os << setprecision( 6 ) ;
+
+    auto metric = [&os]( const char * name, const char * type, const char * help )
+    {
+        os << "# HELP " << name << " " << help << "\n" << "# TYPE " << name << " " << type << "\n" ;
+    } ;
+
+    metric( "primpoly_possible_polynomials", "gauge", "Monic polynomials of degree n modulo p, p ^ n." ) ;
+    os << "primpoly_possible_polynomials{" << pn << "} " << digits( statistics.maxNumPossiblePoly ) << "\n" ;
+
+    metric( "primpoly_primitive_polynomials", "gauge", "Primitive polynomials of degree n modulo p." ) ;
+    os << "primpoly_primitive_polynomials{" << pn << "} " << digits( statistics.numPrimitivePoly ) << "\n" ;
+
+    metric( "primpoly_finished", "gauge", "1 once the search is done." ) ;
+    os << "primpoly_finished{" << pn << "} " << (finished ? 1 : 0) << "\n" ;
+
+    metric( "primpoly_elapsed_seconds", "gauge", "Seconds since the search started." ) ;
+    os << "primpoly_elapsed_seconds{" << pn << "} " << elapsedSeconds << "\n" ;
+
+    metric( "primpoly_tested_per_second", "gauge", "Polynomials tested per second, on average." ) ;
+    os << "primpoly_tested_per_second{" << pn << "} " << progress.rate << "\n" ;
+
+    metric( "primpoly_progress_ratio", "gauge", "Fraction of the possible polynomials tested." ) ;
+    os << "primpoly_progress_ratio{" << pn << "} " << progress.fraction << "\n" ;
+
+    metric( "primpoly_eta_seconds", "gauge", "Estimated seconds until we have tested every possible polynomial." ) ;
+    os << "primpoly_eta_seconds{" << pn << "} " ;
+    if (progress.secondsToGo < 0.0)
+        os << "NaN" ;
+    else
+        os << progress.secondsToGo ;
+    os << "\n" ;
+
+    metric( "primpoly_survivors_total", "counter", "Polynomials passing each stage of the primitivity test." ) ;
+    for (const auto & survivor : survivors)
+        os << "primpoly_survivors_total{" << pn << ",stage=\"" << survivor.name << "\"} " << statistics.*survivor.count << "\n" ;
+
+    metric( "primpoly_factoring_operations_total", "counter", "Operations factoring r and testing orders." ) ;
+    for (const auto & operation : factoring)
+        os << "primpoly_factoring_operations_total{" << pn << ",op=\"" << operation.name << "\"} " << statistics.*operation.count << "\n" ;
+
+    metric( "primpoly_stage_calls_total", "counter", "Calls of each timed stage of the primitivity test." ) ;
+    for (int stage = 0 ;  stage < static_cast<int>( PolyOrderStage::NumStages ) ;  ++stage)
+        os << "primpoly_stage_calls_total{" << pn << ",stage=\"" << stageName[ stage ] << "\"} "
+           << statistics.stageTime( static_cast<PolyOrderStage>( stage ) ).count() << "\n" ;
+
+    metric( "primpoly_stage_seconds_total", "counter", "Seconds spent in each timed stage of the primitivity test." ) ;
+    for (int stage = 0 ;  stage < static_cast<int>( PolyOrderStage::NumStages ) ;  ++stage)
+        os << "primpoly_stage_seconds_total{" << pn << ",stage=\"" << stageName[ stage ] << "\"} "
+           << statistics.stageTime( static_cast<PolyOrderStage>( stage ) ).totalNanoseconds() / 1.0e9 << "\n" ;
+
+    out << os.str() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     StatisticsMonitor
+ |
+ | DESCRIPTION
+ |
+ |     Check now that we can write the file, then start the writer thread.
+ |
+ +============================================================================*/
+
+StatisticsMonitor::StatisticsMonitor( const string & fileName, double intervalSeconds )
+    : fileName_( fileName )
+    , json_( fileName.size() >= 5 && fileName.compare( fileName.size() - 5, 5, ".json" ) == 0 )
+    , interval_( intervalSeconds )
+    , start_( chrono::steady_clock::now() )
+    , due_( false )
+    , snapshot_()
+    , snapshotTime_( 0.0 )
+    , haveSnapshot_( false )
+    , stop_( false )
+    , mutex_()
+    , wake_()
+    , thread_()
+{
+    string temporary = fileName_ + ".tmp" ;
+    if (!ofstream( temporary.c_str(), ios::out | ios::trunc ))
+    {
+        ostringstream os ;
+        os << "Error:  can't write the statistics file " << fileName_ << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw ParserError( os.str() ) ;
+    }
+    remove( temporary.c_str() ) ;
+
+    thread_ = thread( &StatisticsMonitor::writer, this ) ;
+}
+
+StatisticsMonitor::~StatisticsMonitor()
+{
+    stop() ;
+}
+
+double StatisticsMonitor::elapsedSeconds() const
+{
+    return chrono::duration< double >( chrono::steady_clock::now() - start_ ).count() ;
+}
+
+void StatisticsMonitor::finish( const OperationCount & statistics )
+{
+    stop() ;
+    writeFile( statistics, elapsedSeconds(), true ) ;
+}
+
+void StatisticsMonitor::stop()
+{
+    {
+        lock_guard< mutex > lock( mutex_ ) ;
+        stop_ = true ;
+    }
+    wake_.notify_all() ;
+
+    if (thread_.joinable())
+        thread_.join() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     StatisticsMonitor::publish
+ |
+ | DESCRIPTION
+ |
+ |     Called from the searching thread when the writer wants a snapshot.
+ |
+ +============================================================================*/
+
+void StatisticsMonitor::publish( const OperationCount & statistics )
+{
+    {
+        lock_guard< mutex > lock( mutex_ ) ;
+        snapshot_     = statistics ;
+        snapshotTime_ = elapsedSeconds() ;
+        haveSnapshot_ = true ;
+        due_.store( false, memory_order_relaxed ) ;
+    }
+    wake_.notify_all() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     StatisticsMonitor::writer
+ |
+ | DESCRIPTION
+ |
+ |     Every interval, ask the search for a snapshot and write it out.  If the
+ |     search is slow to answer, we wait;  its counts only change when it calls
+ |     update() anyway.  A snapshot we can't write is skipped.
+ |
+ +============================================================================*/
+
+void StatisticsMonitor::writer()
+{
+    unique_lock< mutex > lock( mutex_ ) ;
+
+    while (!wake_.wait_for( lock, interval_, [this]() { return stop_ ; } ))
+    {
+        due_.store( true, memory_order_relaxed ) ;
+        wake_.wait( lock, [this]() { return stop_ || haveSnapshot_ ; } ) ;
+
+        if (haveSnapshot_)
+        {
+            OperationCount statistics( snapshot_ ) ;
+            double         time = snapshotTime_ ;
+            haveSnapshot_ = false ;
+
+            lock.unlock() ;
+            writeFile( statistics, time, false ) ;
+            lock.lock() ;
+        }
+    }
+}
+
+bool StatisticsMonitor::writeFile( const OperationCount & statistics, double elapsedSeconds, bool finished ) const
+{
+    string temporary = fileName_ + ".tmp" ;
+    {
+        ofstream fout( temporary.c_str(), ios::out | ios::trunc ) ;
+        if (!fout)
+            return false ;
+
+        if (json_)
+            writeStatisticsJson( fout, statistics, elapsedSeconds, finished ) ;
+        else
+            writeStatisticsPrometheus( fout, statistics, elapsedSeconds, finished ) ;
+
+        if (!fout)
+            return false ;
+    }
+
+    return rename( temporary.c_str(), fileName_.c_str() ) == 0 ;
+}
@@ -0,0 +1,127 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppMonitor.h
+|
+|  DESCRIPTION
+|
+|     Header file for exporting search statistics for other programs to read:
+|     a JSON document, Prometheus text, and a snapshot file we rewrite every
+|     few seconds during a long search.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with the !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+// Wrap this header file to prevent duplication if it is included
+// accidentally more than once.
+#ifndef __PP_MONITOR_H__
+#define __PP_MONITOR_H__
+
+
+// Write the operation counts as one JSON document, or as Prometheus text.  Besides the
+// counts we give the polynomials tested per second and the fraction of the p ^ n
+// candidates tested after elapsedSeconds, and from those the estimated seconds to go.
+// When finished, the estimate is 0.
+void writeStatisticsJson( ostream & out, const OperationCount & statistics, double elapsedSeconds,
+                          bool finished = false ) ;
+
+void writeStatisticsPrometheus( ostream & out, const OperationCount & statistics, double elapsedSeconds,
+                                bool finished = false ) ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     StatisticsMonitor
+|
+| DESCRIPTION
+|
+|     Rewrite a statistics file every few seconds while we search, so a long
+|     run can be watched without reading its standard output.  The file is
+|     JSON if its name ends in .json and Prometheus text otherwise.  We write
+|     a temporary file and rename it, so readers never see half a snapshot.
+|
+|     Give the monitor to a search in its SearchOptions.  The search calls
+|     update() after each polynomial it tests.  That's one atomic load unless
+|     a snapshot is due, when we copy the counts for the writer thread.
+|
+| EXAMPLE
+|
+|     StatisticsMonitor monitor( "primpoly.prom" ) ;
+|     SearchOptions options ;
+|     options.monitor = &monitor ;
+|     PrimitivePolynomialSearch search( 2, 32, options ) ;
+|     search.enumerate( print ) ;
+|     monitor.finish( search.statistics() ) ;
+|
++============================================================================*/
+
+class StatisticsMonitor
+{
+    public:
+        // Throws ParserError if we can't write the file.
+        explicit StatisticsMonitor( const string & fileName, double intervalSeconds = 10.0 ) ;
+
+        ~StatisticsMonitor() ;
+
+        inline void update( const OperationCount & statistics )
+        {
+            if (due_.load( memory_order_relaxed ))
+                publish( statistics ) ;
+        } ;
+
+        // Stop the writer thread and write the final counts.
+        void finish( const OperationCount & statistics ) ;
+
+        double elapsedSeconds() const ;
+
+    private:
+        StatisticsMonitor( const StatisticsMonitor & ) = delete ;
+        StatisticsMonitor & operator=( const StatisticsMonitor & ) = delete ;
+
+        void publish( const OperationCount & statistics ) ;
+        void writer() ;
+        bool writeFile( const OperationCount & statistics, double elapsedSeconds, bool finished ) const ;
+        void stop() ;
+
+        string                          fileName_ ;
+        bool                            json_ ;
+        chrono::duration< double >      interval_ ;
+        chrono::steady_clock::time_point start_ ;
+        atomic< bool >                  due_ ;          // The writer wants a snapshot.
+        OperationCount                  snapshot_ ;
+        double                          snapshotTime_ ;
+        bool                            haveSnapshot_ ;
+        bool                            stop_ ;
+        mutex                           mutex_ ;
+        condition_variable              wake_ ;
+        thread                          thread_ ;
+} ;
+
+#endif // __PP_MONITOR_H__ -- End of wrapper for header file.
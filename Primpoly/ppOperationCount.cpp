@@ -55,6 +55,10 @@
 #include <algorithm>    // Iterators.
 #include <stdexcept>    // Exceptions.
 #include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <iomanip>      // setprecision()
+#include <chrono>       // steady_clock
+#include <atomic>       // Hardware counters enabled flag.
 
 using namespace std ;   // So we don't need to say std::vector everywhere.
 
@@ -68,12 +72,237 @@ using namespace std ;   // So we don't need to say std::vector everywhere.
 #include "ppArith.h"        // Basic arithmetic functions.
 #include "ppBigInt.h"       // Arbitrary precision integer arithmetic.
 #include "ppOperationCount.h"   // OperationCount collection for factoring and poly finding.
+#include "ppPerfCounters.h" // Hardware performance counters.
 #include "ppFactor.h"       // Prime factorization and Euler Phi.
 #include "ppPolynomial.h"   // Polynomial operations and mod polynomial operations.
 #include "ppParser.h"       // Parsing of polynomials and I/O services.
 #include "ppUnitTest.h"     // Complete unit test.
 
 
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     OperationCounter::operator+=
+ |
+ | DESCRIPTION
+ |
+ |     Add in another count as a double word add with carry.
+ |
+ +============================================================================*/
+
+OperationCounter & OperationCounter::operator+=( const OperationCounter & count )
+{
+    ppuint low = low_ + count.low_ ;
+
+    // Carry out of the low word.
+    high_ += count.high_ + (low < low_ ? 1u : 0u) ;
+    low_   = low ;
+
+    return *this ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     OperationCounter::operator BigInt
+ |
+ | DESCRIPTION
+ |
+ |                                                         64
+ |     Promote the count to a BigInt, count = high word * 2   + low word.
+ |
+ +============================================================================*/
+
+OperationCounter::operator BigInt() const
+{
+    BigInt count( high_ ) ;
+
+    //     64     32   32
+    // Do 2   as 2  * 2   since neither fits into a ppuint.
+    BigInt halfWord( static_cast<ppuint>( 1u ) << (4 * sizeof( ppuint )) ) ;
+    count *= halfWord ;
+    count *= halfWord ;
+    count += BigInt( low_ ) ;
+
+    return count ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     operator<< for OperationCounter
+ |
+ | DESCRIPTION
+ |
+ |     Print the count, only going to multiple precision if the count overflowed a word.
+ |
+ +============================================================================*/
+
+ostream & operator<<( ostream & out, const OperationCounter & count )
+{
+    if (count.high_ == 0u)
+        out << count.low_ ;
+    else
+        out << static_cast<BigInt>( count ) ;
+
+    return out ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     LatencyHistogram
+ |
+ | DESCRIPTION
+ |
+ |     Count durations by powers of 2 nanoseconds.
+ |
+ +============================================================================*/
+
+LatencyHistogram::LatencyHistogram()
+    : count_( 0u )
+    , total_( 0u )
+{
+    fill( bucket_, bucket_ + numBuckets, 0u ) ;
+}
+
+void LatencyHistogram::add( ppuint nanoseconds )
+{
+    // Bucket number is the position of the highest bit.
+    int k = 0 ;
+    for (ppuint t = nanoseconds >> 1 ;  t != 0u && k < numBuckets - 1 ;  t >>= 1)
+        ++k ;
+
+    ++bucket_[ k ] ;
+    ++count_ ;
+    total_ += nanoseconds ;
+}
+
+LatencyHistogram & LatencyHistogram::operator+=( const LatencyHistogram & histogram )
+{
+    for (int k = 0 ;  k < numBuckets ;  ++k)
+        bucket_[ k ] += histogram.bucket_[ k ] ;
+
+    count_ += histogram.count_ ;
+    total_ += histogram.total_ ;
+
+    return *this ;
+}
+
+ostream & operator<<( ostream & out, const LatencyHistogram & histogram )
+{
+    ostringstream os ;
+    os << histogram.count_ << " calls, " << fixed << setprecision( 3 ) << histogram.total_ / 1.0e6 << " ms, mean "
+       << (histogram.count_ == 0u ? 0u : histogram.total_ / histogram.count_) << " ns, calls by 2^k ns " ;
+
+    for (int k = 0 ;  k < LatencyHistogram::numBuckets ;  ++k)
+        if (histogram.bucket_[ k ] != 0u)
+            os << " " << k << ":" << histogram.bucket_[ k ] ;
+
+    out << os.str() ;
+
+    return out ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     HardwareCounts
+ |
+ | DESCRIPTION
+ |
+ |     Add and subtract counts event by event.
+ |
+ +============================================================================*/
+
+HardwareCounts::HardwareCounts()
+    : counted_( 0u )
+{
+    fill( count_, count_ + static_cast<int>( HardwareEvent::NumEvents ), 0u ) ;
+}
+
+void HardwareCounts::set( HardwareEvent event, ppuint count )
+{
+    count_[ static_cast<int>( event ) ] = count ;
+    counted_ |= 1u << static_cast<int>( event ) ;
+}
+
+HardwareCounts & HardwareCounts::operator+=( const HardwareCounts & counts )
+{
+    for (int event = 0 ;  event < static_cast<int>( HardwareEvent::NumEvents ) ;  ++event)
+        count_[ event ] += counts.count_[ event ] ;
+
+    counted_ |= counts.counted_ ;
+
+    return *this ;
+}
+
+HardwareCounts operator-( const HardwareCounts & end, const HardwareCounts & start )
+{
+    HardwareCounts counts ;
+    for (int event = 0 ;  event < static_cast<int>( HardwareEvent::NumEvents ) ;  ++event)
+        if (end.has( static_cast<HardwareEvent>( event ) ) && start.has( static_cast<HardwareEvent>( event ) ))
+            counts.set( static_cast<HardwareEvent>( event ), end.count_[ event ] - start.count_[ event ] ) ;
+
+    return counts ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     StageTimer
+ |
+ | DESCRIPTION
+ |
+ |     Read the steady clock now and when we go out of scope.  Read the
+ |     hardware counters outside the clock readings, so their system calls
+ |     don't count in the time.
+ |
+ +============================================================================*/
+
+static ppuint nowNanoseconds()
+{
+    return static_cast<ppuint>( chrono::duration_cast< chrono::nanoseconds >(
+                                    chrono::steady_clock::now().time_since_epoch() ).count() ) ;
+}
+
+StageTimer::StageTimer( LatencyHistogram & histogram, HardwareCounts * events )
+    : histogram_( histogram )
+    , start_( 0u )
+    , events_( events != nullptr && PerfCounters::enabled() ? events : nullptr )
+{
+    if (events_ != nullptr)
+        startEvents_ = PerfCounters::read() ;
+
+    start_ = nowNanoseconds() ;
+}
+
+StageTimer::~StageTimer()
+{
+    histogram_.add( nowNanoseconds() - start_ ) ;
+
+    if (events_ != nullptr)
+        *events_ += PerfCounters::read() - startEvents_ ;
+}
+
+
+
 /*=============================================================================
  |
  | NAME
@@ -153,8 +382,12 @@ OperationCount::OperationCount( const OperationCount & statistics )
            ,numIrreducibleToPower( statistics.numIrreducibleToPower )
            ,numOrderM( statistics.numOrderM )
            ,numOrderR( statistics.numOrderR )
+           ,factoringTime( statistics.factoringTime )
+           ,factoringEvents( statistics.factoringEvents )
 
 {
+    copy( statistics.stageTime_, statistics.stageTime_ + static_cast<int>( PolyOrderStage::NumStages ), stageTime_ ) ;
+    copy( statistics.stageEvents_, statistics.stageEvents_ + static_cast<int>( PolyOrderStage::NumStages ), stageEvents_ ) ;
 }
 
 
@@ -195,6 +428,76 @@ OperationCount & OperationCount::operator=( const OperationCount & statistics )
     numOrderM                    = statistics.numOrderM ;
     numOrderR                    = statistics.numOrderR ;
 
+    factoringTime                = statistics.factoringTime ;
+    factoringEvents              = statistics.factoringEvents ;
+
+    copy( statistics.stageTime_, statistics.stageTime_ + static_cast<int>( PolyOrderStage::NumStages ), stageTime_ ) ;
+    copy( statistics.stageEvents_, statistics.stageEvents_ + static_cast<int>( PolyOrderStage::NumStages ), stageEvents_ ) ;
+
+    return *this ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     OperationCount::operator+=
+ |
+ | DESCRIPTION
+ |
+ |     Merge the operation counts from another search of the same polynomials
+ |     into this one.  The degree, modulus and the polynomial totals describe
+ |     the problem, not the work, so we keep our own unless we haven't any yet.
+ |     The searches all start from the same factorization of r, so the same
+ |     goes for the cost of factoring.
+ |
+ | EXAMPLE
+ |
+ |     OperationCount total ;
+ |     for (auto & shard : shards)
+ |         total += shard.statistics_ ;
+ |
+ +============================================================================*/
+
+OperationCount & OperationCount::operator+=( const OperationCount & statistics )
+{
+    if (n == 0u && p == 0u)
+    {
+        n                  = statistics.n ;
+        p                  = statistics.p ;
+        maxNumPossiblePoly = statistics.maxNumPossiblePoly ;
+        numPrimitivePoly   = statistics.numPrimitivePoly ;
+    }
+
+    // Every copy of the PolyOrder context carries the counts of factoring r once.
+    bool haveFactoring = factoringTime.count() != 0u || !numGCDs.isZero() || !numPrimalityTests.isZero() ||
+                         !numSquarings.isZero() || !numTrialDivides.isZero() ;
+    if (!haveFactoring)
+    {
+        numGCDs           = statistics.numGCDs ;
+        numPrimalityTests = statistics.numPrimalityTests ;
+        numSquarings      = statistics.numSquarings ;
+        numTrialDivides   = statistics.numTrialDivides ;
+        factoringTime     = statistics.factoringTime ;
+        factoringEvents   = statistics.factoringEvents ;
+    }
+
+    numPolyTested                   += statistics.numPolyTested ;
+    numFreeOfLinearFactors          += statistics.numFreeOfLinearFactors ;
+    numConstantCoeffIsPrimitiveRoot += statistics.numConstantCoeffIsPrimitiveRoot ;
+    numPassingConstantCoeffTest     += statistics.numPassingConstantCoeffTest ;
+    numIrreducibleToPower           += statistics.numIrreducibleToPower ;
+    numOrderM                       += statistics.numOrderM ;
+    numOrderR                       += statistics.numOrderR ;
+
+    for (int stage = 0 ;  stage < static_cast<int>( PolyOrderStage::NumStages ) ;  ++stage)
+    {
+        stageTime_[ stage ]   += statistics.stageTime_[ stage ] ;
+        stageEvents_[ stage ] += statistics.stageEvents_[ stage ] ;
+    }
+
     return *this ;
 }
 
@@ -212,6 +515,37 @@ OperationCount & OperationCount::operator=( const OperationCount & statistics )
  |
  +============================================================================*/
 
+// One line of hardware counts divided by num, with the instructions per cycle.  Events we didn't count are n/a.
+static string hardwareCountsLine( const HardwareCounts & events, double num )
+{
+    ostringstream os ;
+    os << fixed << setprecision( 1 ) ;
+
+    auto column = [&os, &events, num]( HardwareEvent event )
+    {
+        os << setw( 15 ) ;
+        if (events.has( event ))
+            os << events.count( event ) / num ;
+        else
+            os << "n/a" ;
+    } ;
+
+    column( HardwareEvent::Cycles ) ;
+    column( HardwareEvent::Instructions ) ;
+
+    os << setw( 8 ) ;
+    if (events.has( HardwareEvent::Cycles ) && events.has( HardwareEvent::Instructions ) && events.count( HardwareEvent::Cycles ) != 0u)
+        os << setprecision( 2 ) << static_cast<double>( events.count( HardwareEvent::Instructions ) ) / events.count( HardwareEvent::Cycles )
+           << setprecision( 1 ) ;
+    else
+        os << "n/a" ;
+
+    column( HardwareEvent::CacheMisses ) ;
+    column( HardwareEvent::BranchMisses ) ;
+
+    return os.str() ;
+}
+
 ostream & operator<<( ostream & out, const OperationCount & op )
 {
     out << "+--------- OperationCount --------------------------------\n" ;
@@ -235,6 +569,49 @@ ostream & operator<<( ostream & out, const OperationCount & op )
     out << "| Passed const. coeff. test :           " << op.numPassingConstantCoeffTest << endl ;
     out << "| Had order m (x^m != integer) :        " << op.numOrderM << endl ;
     out << "|\n" ;
+
+    // Time per stage, if we tested any polynomials.
+    if (op.stageTime( PolyOrderStage::ConstantCoeff ).count() != 0u)
+    {
+        out << "| Time per stage\n" ;
+        out << "|\n" ;
+        out << "| Const. coeff. primitive root :  " << op.stageTime( PolyOrderStage::ConstantCoeff ) << endl ;
+        out << "| Linear factors :                " << op.stageTime( PolyOrderStage::LinearFactor )  << endl ;
+        out << "| Q-I matrix :                    " << op.stageTime( PolyOrderStage::QMatrix )       << endl ;
+        out << "| Nullity of Q-I :                " << op.stageTime( PolyOrderStage::Nullity )       << endl ;
+        out << "| Order r :                       " << op.stageTime( PolyOrderStage::OrderR )        << endl ;
+        out << "| Order m :                       " << op.stageTime( PolyOrderStage::OrderM )        << endl ;
+        if (op.factoringTime.count() != 0u)
+            out << "| Factoring r :                   " << op.factoringTime << endl ;
+        out << "|\n" ;
+    }
+
+    // Hardware events per stage, if we counted them.
+    bool counted = !op.factoringEvents.empty() ;
+    for (int stage = 0 ;  stage < static_cast<int>( PolyOrderStage::NumStages ) ;  ++stage)
+        counted = counted || !op.stageEvents( static_cast<PolyOrderStage>( stage ) ).empty() ;
+
+    if (counted)
+    {
+        out << "| Hardware counters per polynomial tested\n" ;
+        out << "|\n" ;
+        out << "| " << string( 32, ' ' ) << setw( 15 ) << "cycles" << setw( 15 ) << "instructions" << setw( 8 ) << "IPC"
+            << setw( 15 ) << "cache misses" << setw( 15 ) << "branch misses" << endl ;
+
+        double numTested = max( static_cast<double>( static_cast<ppuint>( static_cast<BigInt>( op.numPolyTested ) ) ), 1.0 ) ;
+        static const char * const stageName[ static_cast<int>( PolyOrderStage::NumStages ) ] =
+        {
+            "Const. coeff. primitive root :  ", "Linear factors :                ", "Q-I matrix :                    ",
+            "Nullity of Q-I :                ", "Order r :                       ", "Order m :                       "
+        } ;
+
+        for (int stage = 0 ;  stage < static_cast<int>( PolyOrderStage::NumStages ) ;  ++stage)
+            out << "| " << stageName[ stage ] << hardwareCountsLine( op.stageEvents( static_cast<PolyOrderStage>( stage ) ), numTested ) << endl ;
+
+        if (!op.factoringEvents.empty())
+            out << "| Factoring r, in total :         " << hardwareCountsLine( op.factoringEvents, 1.0 ) << endl ;
+        out << "|\n" ;
+    }
     out << "+-----------------------------------------------------\n" ;
     
     return out ;
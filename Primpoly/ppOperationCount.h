@@ -41,6 +41,190 @@
 #define __PP_STATISTICS_H__
 
 
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     OperationCounter
+ |
+ | DESCRIPTION
+ |
+ |     One operation count.  Counting is a native word increment in the hot
+ |     loops;  if the word ever wraps around, we carry into a second word.
+ |     We only promote the count to a BigInt when we report it.
+ |
+ +============================================================================*/
+
+class OperationCounter
+{
+    public:
+        OperationCounter( const ppuint count = 0u )
+            : low_( count )
+            , high_( 0u )
+        {
+        }
+
+        OperationCounter & operator++()
+        {
+            if (++low_ == 0u)
+                ++high_ ;
+            return *this ;
+        }
+
+        // Add in another count, e.g. from another thread's search.
+        OperationCounter & operator+=( const OperationCounter & count ) ;
+
+        // Promote to a BigInt for reporting.
+        operator BigInt() const ;
+
+        inline bool isZero() const { return low_ == 0u && high_ == 0u ; } ;
+
+        friend ostream & operator<<( ostream & out, const OperationCounter & count ) ;
+
+    private:
+        ppuint low_ ;   // count = high_ * 2^64 + low_
+        ppuint high_ ;
+} ;
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     LatencyHistogram
+ |
+ | DESCRIPTION
+ |
+ |     How long something took each time, counted in buckets by powers of 2
+ |                              k        k+1
+ |     nanoseconds:  bucket k is 2  up to 2    ns, and bucket 0 includes 0.
+ |     Also the number of times and the total time.  Like the counters, each
+ |     search keeps its own and we add them up at the end.
+ |
+ +============================================================================*/
+
+class LatencyHistogram
+{
+    public:
+        LatencyHistogram() ;
+
+        // Count one duration.
+        void add( ppuint nanoseconds ) ;
+
+        // Add in another histogram, e.g. from another thread's search.
+        LatencyHistogram & operator+=( const LatencyHistogram & histogram ) ;
+
+        inline ppuint count()            const { return count_ ; } ;
+        inline ppuint totalNanoseconds() const { return total_ ; } ;
+        inline ppuint bucket( int k )    const { return bucket_[ k ] ; } ;
+
+        // One line:  calls, total and mean time, then the nonzero buckets by their lower bounds.
+        friend ostream & operator<<( ostream & out, const LatencyHistogram & histogram ) ;
+
+        static const int numBuckets = 48 ;
+
+    private:
+        ppuint bucket_[ numBuckets ] ;
+        ppuint count_ ;
+        ppuint total_ ;     // In nanoseconds.
+} ;
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     HardwareCounts
+ |
+ | DESCRIPTION
+ |
+ |     Totals of hardware events, e.g. in one stage of testing:  CPU cycles,
+ |     instructions, cache misses and branch mispredictions.  The hardware
+ |     can't always count every event;  has() tells which ones we counted.
+ |     See PerfCounters.
+ |
+ +============================================================================*/
+
+enum class HardwareEvent
+{
+    Cycles = 0, Instructions, CacheMisses, BranchMisses,
+    NumEvents
+} ;
+
+class HardwareCounts
+{
+    public:
+        HardwareCounts() ;
+
+        inline bool   has( HardwareEvent event )   const { return (counted_ >> static_cast<int>( event )) & 1u ; } ;
+        inline ppuint count( HardwareEvent event ) const { return count_[ static_cast<int>( event ) ] ; } ;
+        inline bool   empty() const { return counted_ == 0u ; } ;
+
+        void set( HardwareEvent event, ppuint count ) ;
+
+        // Add in counts, e.g. of another stage or another thread's search.
+        HardwareCounts & operator+=( const HardwareCounts & counts ) ;
+
+        // The events between two readings, of the events counted in both.
+        friend HardwareCounts operator-( const HardwareCounts & end, const HardwareCounts & start ) ;
+
+    private:
+        ppuint   count_[ static_cast<int>( HardwareEvent::NumEvents ) ] ;
+        unsigned counted_ ;     // Bit k is set if we counted event k.
+} ;
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     StageTimer
+ |
+ | DESCRIPTION
+ |
+ |     Time the rest of a block on the steady clock and add it to a histogram.
+ |     If we're given hardware counts and PerfCounters are enabled, add the
+ |     hardware events of the block to them too.
+ |
+ | EXAMPLE
+ |
+ |     {
+ |         StageTimer timer( statistics_.stageTime( PolyOrderStage::OrderM ) ) ;
+ |         order_m() ;
+ |     }
+ |
+ +============================================================================*/
+
+class StageTimer
+{
+    public:
+        explicit StageTimer( LatencyHistogram & histogram, HardwareCounts * events = nullptr ) ;
+
+        ~StageTimer() ;
+
+    private:
+        StageTimer( const StageTimer & ) = delete ;
+        StageTimer & operator=( const StageTimer & ) = delete ;
+
+        LatencyHistogram & histogram_ ;
+        ppuint             start_ ;     // Nanoseconds on the steady clock.
+        HardwareCounts *   events_ ;    // Null if we aren't counting.
+        HardwareCounts     startEvents_ ;
+} ;
+
+
+// The stages of PolyOrder::isPrimitive() we time.
+enum class PolyOrderStage
+{
+    ConstantCoeff = 0, LinearFactor, QMatrix, Nullity, OrderR, OrderM,
+    NumStages
+} ;
+
+
+
 /*=============================================================================
  |
  | NAME
@@ -65,28 +249,47 @@ class OperationCount
 
         OperationCount & operator=( const OperationCount & statistics ) ;
 
+        // Merge the operation counts of another search of the same p and n into this one.
+        // Every object counts on its own, so threads or shards searching in parallel
+        // need no locking;  add up their statistics when they are done.
+        OperationCount & operator+=( const OperationCount & statistics ) ;
+
         friend ostream & operator<<( ostream & , const OperationCount & ) ;
 
+        inline LatencyHistogram & stageTime( PolyOrderStage stage ) { return stageTime_[ static_cast<int>( stage ) ] ; } ;
+        inline const LatencyHistogram & stageTime( PolyOrderStage stage ) const { return stageTime_[ static_cast<int>( stage ) ] ; } ;
+
+        inline HardwareCounts & stageEvents( PolyOrderStage stage ) { return stageEvents_[ static_cast<int>( stage ) ] ; } ;
+        inline const HardwareCounts & stageEvents( PolyOrderStage stage ) const { return stageEvents_[ static_cast<int>( stage ) ] ; } ;
+
     // Allow direct access to this simple data type for convenience.
     public:
-        ppuint n ;                            // Degree of the polynomial.
-        ppuint p ;                            // Modulus of the polynomial.
+        ppuint n ;                                      // Degree of the polynomial.
+        ppuint p ;                                      // Modulus of the polynomial.
 
-        BigInt maxNumPossiblePoly ;           // Number of possible degree n modulo p polynomials.
-        BigInt numPrimitivePoly ;             // Number of primitive degree n modulo p polynomials.
-        BigInt numPolyTested ;                // Number of polynomials tested.
+        BigInt maxNumPossiblePoly ;                     // Number of possible degree n modulo p polynomials.
+        BigInt numPrimitivePoly ;                       // Number of primitive degree n modulo p polynomials.
+        OperationCounter numPolyTested ;                // Number of polynomials tested.
         
-        BigInt numGCDs ;                      // Number of gcd computations.
-        BigInt numPrimalityTests ;            // Number primality tests.
-        BigInt numSquarings ;                 // Number of squarings.
-        BigInt numTrialDivides ;              // Number of trial divisions.
-
-        BigInt numFreeOfLinearFactors ;       // Number of polynomials which have no linear factors.
-        BigInt numConstantCoeffIsPrimitiveRoot ;  // Number of polynomials whose constant is a primitive root of p.
-        BigInt numPassingConstantCoeffTest ; // Number of polynomials whose constant term passes a consistency check.
-        BigInt numIrreducibleToPower ;       // Number of polynomials which are of the form irreducible poly to a power >= 1.
-        BigInt numOrderM ;                   // The number of polynomials which pass the x^m not an integer test.
-        BigInt numOrderR ;                   // The number of polynomials which pass the x^r = integer test.
+        OperationCounter numGCDs ;                      // Number of gcd computations.
+        OperationCounter numPrimalityTests ;            // Number primality tests.
+        OperationCounter numSquarings ;                 // Number of squarings.
+        OperationCounter numTrialDivides ;              // Number of trial divisions.
+
+        OperationCounter numFreeOfLinearFactors ;       // Number of polynomials which have no linear factors.
+        OperationCounter numConstantCoeffIsPrimitiveRoot ;  // Number of polynomials whose constant is a primitive root of p.
+        OperationCounter numPassingConstantCoeffTest ;  // Number of polynomials whose constant term passes a consistency check.
+        OperationCounter numIrreducibleToPower ;        // Number of polynomials which are of the form irreducible poly to a power >= 1.
+        OperationCounter numOrderM ;                    // The number of polynomials which pass the x^m not an integer test.
+        OperationCounter numOrderR ;                    // The number of polynomials which pass the x^r = integer test.
+
+        // Factoring r is done once for all the searches of the same p and n, so merging keeps just one.
+        LatencyHistogram factoringTime ;                // Time to factor r.
+        HardwareCounts   factoringEvents ;              // Hardware events factoring r, if we counted them.
+
+    private:
+        LatencyHistogram stageTime_[ static_cast<int>( PolyOrderStage::NumStages ) ] ;  // Time spent in each stage of testing.
+        HardwareCounts   stageEvents_[ static_cast<int>( PolyOrderStage::NumStages ) ] ; // Hardware events in each stage.
 } ;
 
 #endif // __PP_STATISTICS_H__
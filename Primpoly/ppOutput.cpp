@@ -0,0 +1,442 @@
+/*==============================================================================
+| 
+|  NAME
+|
+|     ppOutput.cpp
+|
+|  DESCRIPTION
+|
+|     Write lists of polynomials quickly in several formats, formatting them
+|     by hand and writing them to the stream on another thread.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|     
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+
+
+/*------------------------------------------------------------------------------
+|                                Includes                                      |
+------------------------------------------------------------------------------*/
+
+#include <cstdlib>      // abort()
+#include <iostream>     // Basic stream I/O.
+#include <new>          // set_new_handler()
+#include <cmath>        // Basic math functions e.g. sqrt()
+#include <limits>       // Numeric limits.
+#include <complex>      // Complex data type and operations.
+#include <fstream>      // File stream I/O.
+#include <sstream>      // String stream I/O.
+#include <vector>       // STL vector class.
+#include <string>       // STL string class.
+#include <algorithm>    // Iterators.
+#include <stdexcept>    // Exceptions.
+#include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <functional>   // function
+#include <iterator>     // input_iterator_tag
+#include <cstddef>      // ptrdiff_t
+#include <thread>       // Writer thread.
+#include <mutex>        // mutex, lock_guard, unique_lock
+#include <condition_variable>  // Hand buffers between threads.
+#include <atomic>       // Trace enabled flag.
+
+using namespace std ;   // So we don't need to say std::vector everywhere.
+
+
+
+/*------------------------------------------------------------------------------
+|                                PP Include Files                              |
+------------------------------------------------------------------------------*/
+
+#include "Primpoly.h"       // Global functions.
+#include "ppArith.h"        // Basic arithmetic functions.
+#include "ppBigInt.h"       // Arbitrary precision integer arithmetic.
+#include "ppOperationCount.h"   // OperationCount collection for factoring and poly finding.
+#include "ppFactor.h"       // Prime factorization and Euler Phi.
+#include "ppPolynomial.h"   // Polynomial operations and mod polynomial operations.
+#include "ppParser.h"       // Parsing of polynomials and I/O services.
+#include "ppOutput.h"       // Fast output of polynomials.
+#include "ppTrace.h"        // Timeline tracing.
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialWriter
+ |
+ | DESCRIPTION
+ |
+ |     Reserve both buffers and start the writer thread.
+ |
+ +============================================================================*/
+
+PolynomialWriter::PolynomialWriter( ostream & out, OutputFormat format, size_t bufferSize )
+    : out_( out )
+    , format_( format )
+    , bufferSize_( max( bufferSize, static_cast<size_t>( 1 ) ) )
+    , buffer_()
+    , pending_()
+    , mutex_()
+    , ready_()
+    , written_()
+    , stop_( false )
+    , writer_()
+{
+    buffer_.reserve( bufferSize_ ) ;
+    pending_.reserve( bufferSize_ ) ;
+
+    // Start the thread last, after everything it uses is constructed.
+    writer_ = thread( &PolynomialWriter::writer, this ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     ~PolynomialWriter
+ |
+ | DESCRIPTION
+ |
+ |     Hand off what's left, and wait for the writer thread to write it and exit.
+ |
+ +============================================================================*/
+
+PolynomialWriter::~PolynomialWriter()
+{
+    handOff() ;
+
+    {
+        lock_guard< mutex > lock( mutex_ ) ;
+        stop_ = true ;
+    }
+    ready_.notify_one() ;
+
+    writer_.join() ;
+    out_.flush() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialWriter::write
+ |
+ | DESCRIPTION
+ |
+ |     Format f into the buffer.  The human format is the same as
+ |     Polynomial::operator string() and the Primpoly listing always was.
+ |
+ +============================================================================*/
+
+void PolynomialWriter::write( const Polynomial & f )
+{
+    switch( format_ )
+    {
+        case OutputFormat::Human:
+            append( "\n\nPrimitive polynomial modulo " ) ;
+            append( f.modulus() ) ;
+            append( " of degree " ) ;
+            append( static_cast<ppuint>( f.deg() ) ) ;
+            append( "\n\n" ) ;
+            appendTerms( f, " ^ " ) ;
+            append( "\n\n" ) ;
+        break ;
+
+        case OutputFormat::Compact:
+            appendTerms( f, "^" ) ;
+            append( "\n" ) ;
+        break ;
+
+        case OutputFormat::JsonLines:
+            append( "{\"p\":" ) ;
+            append( f.modulus() ) ;
+            append( ",\"n\":" ) ;
+            append( static_cast<ppuint>( f.deg() ) ) ;
+            append( ",\"coefficients\":[" ) ;
+            for (int i = 0 ;  i <= f.deg() ;  ++i)
+            {
+                if (i > 0)
+                    append( "," ) ;
+                append( f[ i ] ) ;
+            }
+            append( "]}\n" ) ;
+        break ;
+
+        case OutputFormat::HexMask:
+            appendHexMask( f ) ;
+            append( "\n" ) ;
+        break ;
+    }
+
+    if (buffer_.size() >= bufferSize_)
+        handOff() ;
+}
+
+void PolynomialWriter::write( const string & text )
+{
+    buffer_.append( text ) ;
+
+    if (buffer_.size() >= bufferSize_)
+        handOff() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialWriter::flush
+ |
+ | DESCRIPTION
+ |
+ |     Hand off the buffer and wait for the writer thread to finish writing it.
+ |
+ +============================================================================*/
+
+void PolynomialWriter::flush()
+{
+    handOff() ;
+
+    {
+        unique_lock< mutex > lock( mutex_ ) ;
+        written_.wait( lock, [this]() { return pending_.empty() ; } ) ;
+    }
+
+    out_.flush() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialWriter::append
+ |
+ | DESCRIPTION
+ |
+ |     Append a string, or an unsigned number in decimal, to the buffer.
+ |
+ +============================================================================*/
+
+void PolynomialWriter::append( const char * s )
+{
+    buffer_.append( s ) ;
+}
+
+void PolynomialWriter::append( ppuint number )
+{
+    // Digits from lowest to highest, at the end of the array.
+    char digits[ numeric_limits< ppuint >::digits10 + 1 ] ;
+    char * first = digits + sizeof( digits ) ;
+
+    do
+    {
+        *--first = static_cast<char>( '0' + number % 10 ) ;
+        number /= 10 ;
+    } while (number != 0) ;
+
+    buffer_.append( first, digits + sizeof( digits ) - first ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialWriter::appendTerms
+ |
+ | DESCRIPTION
+ |
+ |     Append the nonzero terms of f from high to low degree, then the modulus,
+ |     writing x to a power as x, power, then the exponent.
+ |
+ | EXAMPLE
+ |
+ |     appendTerms( f, " ^ " ) ;   //  x ^ 19 + 9 x + 2, 13
+ |
+ +============================================================================*/
+
+void PolynomialWriter::appendTerms( const Polynomial & f, const char * power )
+{
+    int n = f.deg() ;
+
+    // Special case of f(x) = const.
+    if (n == 0)
+        append( f[ 0 ] ) ;
+    else
+    {
+        int lowestDegreeTerm = -1 ;
+        for (int deg = n ;  deg >= 0 ;  --deg)
+            if (f[ deg ] != 0)
+                lowestDegreeTerm = deg ;
+
+        for (int deg = n ;  deg >= 0 ;  --deg)
+        {
+            ppuint coeff = f[ deg ] ;
+            if (coeff == 0)
+                continue ;
+
+            // Print coeff of x^n unless it is 1, but print the constant term regardless.
+            if (coeff != 1 || deg == 0)
+            {
+                append( coeff ) ;
+                if (deg != 0)
+                    append( " " ) ;
+            }
+
+            if (deg == 1)
+                append( "x" ) ;
+            else if (deg != 0)
+            {
+                append( "x" ) ;
+                append( power ) ;
+                append( static_cast<ppuint>( deg ) ) ;
+            }
+
+            // Print +, but only when followed by a lower degree term.
+            if (deg > lowestDegreeTerm)
+                append( " + " ) ;
+        }
+    }
+
+    append( ", " ) ;
+    append( f.modulus() ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialWriter::appendHexMask
+ |
+ | DESCRIPTION
+ |
+ |     Append a polynomial modulo 2 as a hex tap mask where bit k is the
+ |     coefficient of x^k, highest digit first.
+ |
+ | EXAMPLE
+ |
+ |     x^4 + x + 1 => 0x13
+ |
+ +============================================================================*/
+
+void PolynomialWriter::appendHexMask( const Polynomial & f )
+{
+    static const char hexDigit[] = "0123456789abcdef" ;
+
+    append( "0x" ) ;
+
+    for (int digit = f.deg() / 4 ;  digit >= 0 ;  --digit)
+    {
+        int value = 0 ;
+        for (int bit = 3 ;  bit >= 0 ;  --bit)
+        {
+            int deg = 4 * digit + bit ;
+            value = 2 * value + (deg <= f.deg() && f[ deg ] != 0 ? 1 : 0) ;
+        }
+
+        buffer_.push_back( hexDigit[ value ] ) ;
+    }
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialWriter::handOff
+ |
+ | DESCRIPTION
+ |
+ |     Wait until the writer thread is done with the last buffer, then give it
+ |     ours and take its empty one.
+ |
+ +============================================================================*/
+
+void PolynomialWriter::handOff()
+{
+    if (buffer_.empty())
+        return ;
+
+    {
+        PP_TRACE_SCOPE( "wait for writer", "output" ) ;
+        unique_lock< mutex > lock( mutex_ ) ;
+        written_.wait( lock, [this]() { return pending_.empty() ; } ) ;
+        swap( buffer_, pending_ ) ;
+    }
+    ready_.notify_one() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolynomialWriter::writer
+ |
+ | DESCRIPTION
+ |
+ |     Write each buffer we're handed to the stream, until we're told to
+ |     stop and there's nothing left.  Only this thread touches pending_
+ |     while it is full, so we write it without holding the lock.
+ |
+ +============================================================================*/
+
+void PolynomialWriter::writer()
+{
+    PP_TRACE_THREAD_NAME( "writer", -1 ) ;
+    unique_lock< mutex > lock( mutex_ ) ;
+
+    for (;;)
+    {
+        ready_.wait( lock, [this]() { return stop_ || !pending_.empty() ; } ) ;
+
+        if (pending_.empty())
+            return ;
+
+        lock.unlock() ;
+        {
+            PP_TRACE_SCOPE( "write", "output" ) ;
+            out_.write( pending_.data(), pending_.size() ) ;
+        }
+        lock.lock() ;
+
+        pending_.clear() ;
+        written_.notify_all() ;
+    }
+}
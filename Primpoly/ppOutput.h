@@ -0,0 +1,113 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppOutput.h
+|
+|  DESCRIPTION
+|
+|     Header file for writing lists of polynomials quickly in several formats.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with the !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+// Wrap this header file to prevent duplication if it is included
+// accidentally more than once.
+#ifndef __PP_OUTPUT_H__
+#define __PP_OUTPUT_H__
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PolynomialWriter
+|
+| DESCRIPTION
+|
+|     Write polynomials to a stream in one of the OutputFormats.  We format
+|     them by hand into a large buffer;  when it fills, a writer thread
+|     takes it and writes it to the stream while we fill the other buffer.
+|     So there is no stream formatting and no flush per polynomial, and
+|     listing thousands of primitive polynomials isn't bound by output.
+|
+|     Nothing is guaranteed to be in the stream until flush() or the
+|     destructor.  Call them from the thread which calls write().
+|
+| EXAMPLE
+|
+|     PolynomialWriter writer( cout, OutputFormat::JsonLines ) ;
+|     writer.write( Polynomial( "x^4 + x + 1, 2" ) ) ;
+|     writer.flush() ;  // {"p":2,"n":4,"coefficients":[1,1,0,0,1]}
+|
++============================================================================*/
+
+class PolynomialWriter
+{
+    public:
+        PolynomialWriter( ostream & out, OutputFormat format = OutputFormat::Human, size_t bufferSize = 1 << 20 ) ;
+
+        // Write what's left and stop the writer thread.
+        ~PolynomialWriter() ;
+
+        // Write f in our format.
+        void write( const Polynomial & f ) ;
+
+        // Write text as is.
+        void write( const string & text ) ;
+
+        // Wait until everything is in the stream, then flush the stream.
+        void flush() ;
+
+        inline OutputFormat format() const { return format_ ; } ;
+
+    private:
+        PolynomialWriter( const PolynomialWriter & ) = delete ;
+        PolynomialWriter & operator=( const PolynomialWriter & ) = delete ;
+
+        void append( const char * s ) ;
+        void append( ppuint number ) ;
+        void appendTerms( const Polynomial & f, const char * power ) ;
+        void appendHexMask( const Polynomial & f ) ;
+
+        // Hand the full buffer to the writer thread.
+        void handOff() ;
+
+        void writer() ;
+
+        ostream &          out_ ;
+        OutputFormat       format_ ;
+        size_t             bufferSize_ ;
+        string             buffer_ ;    // We fill this one.
+        string             pending_ ;   // The writer thread writes this one, unless it is empty.
+        mutex              mutex_ ;
+        condition_variable ready_ ;     // Signals pending_ is full, or we are stopping.
+        condition_variable written_ ;   // Signals pending_ is empty again.
+        bool               stop_ ;
+        thread             writer_ ;
+} ;
+
+#endif // __PP_OUTPUT_H__ -- End of wrapper for header file.
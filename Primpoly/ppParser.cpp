@@ -51,6 +51,7 @@
 #include <algorithm>    // Iterators.
 #include <stdexcept>    // Exceptions.
 #include <cassert>      // assert()
+#include <memory>       // shared_ptr
 
 using namespace std ;
 
@@ -186,19 +187,30 @@ Symbol< SymbolType, ValueType > & Symbol< SymbolType, ValueType >::operator=( co
  |
  | NAME
  |
- |     ActionState
+ |     Operator << for ActionState
  |
  | DESCRIPTION
  |
- |     Default constructor for an action/state pair.  Action is shift, reduce, 
- |     etc. and state is a number.
+ |     Debug print to an output stream for an action state.
  |
  +============================================================================*/
 
-ActionState::ActionState()
-    : action_( Action::Error )
-    , state_( 0 )
+ostream & operator<<( ostream & out, const ActionState & as )
 {
+    string s ;
+    
+    out << "Action/State: " ;
+    switch( as.action_ )
+    {
+        case Action::Shift:  s = "Shift" ;   break ;
+        case Action::Reduce: s = "Reduce" ;  break ;
+        case Action::Accept: s = "Accept" ;  break ;
+        case Action::Error:  s = "Error" ;   break ;
+    }
+    out << s ;
+    out << " " << as.state_ ;
+    
+    return out ;
 }
 
 
@@ -206,94 +218,65 @@ ActionState::ActionState()
  |
  | NAME
  |
- |     ActionState
+ |     makeParseTableArrays
  |
  | DESCRIPTION
  |
- |     Constructor for an action/state pair.
+ |     Build the flat ACTION and GOTO tables for a grammar from the list of
+ |     its nonerror entries, at compile time.  Missing ACTION entries are
+ |     errors and missing GOTO entries are state 0.  An entry out of range
+ |     fails to compile.
  |
  +============================================================================*/
 
-ActionState::ActionState( Action type, int state )
-    : action_( type )
-    , state_( state )
+template< typename SymbolType >
+struct ActionEntry
 {
-}
-
-
-/*=============================================================================
- |
- | NAME
- |
- |     ActionState
- |
- | DESCRIPTION
- |
- |     Copy constructor for an action/state pair.
- |
- +============================================================================*/
+    int        state_ ;
+    SymbolType terminal_ ;
+    Action     action_ ;
+    int        newState_ ;  // If Shift, the new state to push on the stack, if Reduce, the production number.
+} ;
 
-ActionState::ActionState( const ActionState & as )
-    : action_(  as.action_ )
-    , state_( as.state_ )
+template< typename SymbolType >
+struct GotoEntry
 {
-}
+    int        state_ ;
+    SymbolType nonTerminal_ ;
+    int        newState_ ;
+} ;
 
-
-/*=============================================================================
- |
- | NAME
- |
- |     ActionState
- |
- | DESCRIPTION
- |
- |     Assignment operator for an action/state pair.
- |
- +============================================================================*/
-
-ActionState & ActionState::operator=( const ActionState & as )
+template< typename SymbolType, int NumStates >
+struct ParseTableArrays
 {
-    // Check for assigning to oneself:  just pass back a reference to the unchanged object.
-    if (this == &as)
-        return *this ;
-    
-    action_  = as.action_ ;
-    state_ = as.state_ ;
-    
-    // Pass back the object so we can concatenate assignments.
-    return *this ;
-}
+    ActionState action_[ NumStates * static_cast<int>( SymbolType::NumTerminals ) ] ;
+    int         goto_  [ NumStates * static_cast<int>( SymbolType::NumSymbols ) ] ;
+} ;
 
+template< typename SymbolType, int NumStates, size_t NumActions, size_t NumGotos >
+constexpr ParseTableArrays< SymbolType, NumStates > makeParseTableArrays( const ActionEntry< SymbolType > (& actions)[ NumActions ],
+                                                                         const GotoEntry< SymbolType >   (& gotos)[ NumGotos ] )
+{
+    ParseTableArrays< SymbolType, NumStates > tables {} ;
 
-/*=============================================================================
- |
- | NAME
- |
- |     Operator << for ActionState
- |
- | DESCRIPTION
- |
- |     Debug print to an output stream for an action state.
- |
- +============================================================================*/
+    for (size_t i = 0 ;  i < NumActions ;  ++i)
+    {
+        const ActionEntry< SymbolType > & a = actions[ i ] ;
+        if (a.state_ < 0 || a.state_ >= NumStates)
+            throw ParserError( "Error:  ACTION table state out of range" ) ;
+        tables.action_[ a.state_ * static_cast<int>( SymbolType::NumTerminals ) + static_cast<int>( a.terminal_ ) ] =
+            ActionState( a.action_, a.newState_ ) ;
+    }
 
-ostream & operator<<( ostream & out, const ActionState & as )
-{
-    string s ;
-    
-    out << "Action/State: " ;
-    switch( as.action_ )
+    for (size_t i = 0 ;  i < NumGotos ;  ++i)
     {
-        case Action::Shift:  s = "Shift" ;   break ;
-        case Action::Reduce: s = "Reduce" ;  break ;
-        case Action::Accept: s = "Accept" ;  break ;
-        case Action::Error:  s = "Error" ;   break ;
+        const GotoEntry< SymbolType > & g = gotos[ i ] ;
+        if (g.state_ < 0 || g.state_ >= NumStates)
+            throw ParserError( "Error:  GOTO table state out of range" ) ;
+        tables.goto_[ g.state_ * static_cast<int>( SymbolType::NumSymbols ) + static_cast<int>( g.nonTerminal_ ) ] = g.newState_ ;
     }
-    out << s ;
-    out << " " << as.state_ ;
-    
-    return out ;
+
+    return tables ;
 }
 
 
@@ -308,18 +291,16 @@ ostream & operator<<( ostream & out, const ActionState & as )
  |
  | DESCRIPTION
  |
- |     Default constructor for the class.
+ |     Constructor for the class.  The parse tables are static, so this
+ |     is cheap.
  |
  +============================================================================*/
 
 template < typename SymbolType, typename ValueType >
-Parser< SymbolType, ValueType >::Parser()
+Parser< SymbolType, ValueType >::Parser( const ParseTables< SymbolType > & tables )
     : inputStack_()
     , parseStack_()
-    , NumStates_       ( 0 ) // Includes the 0 state.
-    , NumProductions_  ( 0 ) // Number of productions.
-    , NumTerminals_    ( 0 ) // Number of terminal symbols.
-    , NumNonTerminals_ ( 0 ) // Number of nonterminal symbols.
+    , tables_( &tables )
 {
 }
 
@@ -358,6 +339,7 @@ template < typename SymbolType, typename ValueType >
 Parser< SymbolType, ValueType >::Parser( const Parser & Parser )
 : inputStack_( Parser.inputStack_ )
 , parseStack_( Parser.parseStack_ )
+, tables_( Parser.tables_ )
 {
 }
 
@@ -383,117 +365,12 @@ Parser< SymbolType, ValueType > & Parser< SymbolType, ValueType >::operator=( co
     
     inputStack_ = Parser.inputStack_ ;
     parseStack_ = Parser.parseStack_ ;
+    tables_     = Parser.tables_ ;
     
     // Return reference to this object.
     return *this ;
 }
 
-/*=============================================================================
- |
- | NAME
- |
- |     insertAction
- |
- | DESCRIPTION
- |
- |     Add a new entry to the Action Table.
- |
- +============================================================================*/
-
-template < typename SymbolType, typename ValueType >
-void Parser< SymbolType, ValueType >::insertAction( int    state,      SymbolType terminal,
-             Action actionType, int      actionState )
-{
-    try
-    {
-        // Create a new action.
-        ActionState as( actionType, actionState ) ;
-        
-        // Get space for actionTable[ state ] which is an vector<ActionState> indexed by terminal.
-        actionTable_[ static_cast<int>( state ) ].resize( NumTerminals_ ) ;
-        
-        // Insert it into the ACTION table.
-        actionTable_[ static_cast<int>( state ) ][ static_cast<int>( terminal ) ] = as ;
-    }
-    catch( length_error & e )
-    {
-        ostringstream os ;
-        os << "Error:  Cannot initialize PolyParser action tables "
-        << " at " << __FILE__ << ": line " << __LINE__  ;
-        throw ParserError( os.str() ) ;
-    }
-    
-}
-
-/*=============================================================================
- |
- | NAME
- |
- |    insertGoto
- |
- | DESCRIPTION
- |
- |     Add a new entry to the Goto Table.
- |
- +============================================================================*/
-
-template < typename SymbolType, typename ValueType >
-void Parser< SymbolType, ValueType >::insertGoto( int state, SymbolType nonterm, int newState )
-{
-    try
-    {
-        // Insert into the GOTO table.
-        gotoTable_[ static_cast<int>( state ) ].resize( static_cast<int>( PolySymbol::NumSymbols ) ) ;
-        gotoTable_[ static_cast<int>( state ) ][ static_cast<int>( nonterm ) ] = newState ;
-    }
-    catch( length_error & e )
-    {
-        ostringstream os ;
-        os << "Error:  Cannot initialize Parser goto tables "
-        << " at " << __FILE__ << ": line " << __LINE__  ;
-        throw ParserError( os.str() ) ;
-    }
-    
-}
-
-/*=============================================================================
- |
- | NAME
- |
- |    insertProduction
- |
- | DESCRIPTION
- |
- |    Add a new entry to the list of productions.
- |
- +============================================================================*/
-
-template < typename SymbolType, typename ValueType >
-void Parser< SymbolType, ValueType >::insertProduction( int prodNum, SymbolType nonTerm, int rhsLength )
-{
-    // Insert into the production table.
-    production_[ prodNum ].type_  = nonTerm ;
-    production_[ prodNum ].state_ = rhsLength ;
-}
-
-/*=============================================================================
- |
- | NAME
- |
- |     insertErrorMessage
- |
- | DESCRIPTION
- |
- |     Insert an error message into the list.
- |
- +============================================================================*/
-
-template < typename SymbolType, typename ValueType >
-void Parser< SymbolType, ValueType >::insertErrorMessage( int state, string errorMessage )
-{
-    errorMessage_[ state ] = errorMessage ;
-}
-
 /*=============================================================================
  | 
  | NAME
@@ -550,7 +427,7 @@ void Parser< SymbolType, ValueType >::insertErrorMessage( int state, string erro
  +============================================================================*/
 
 template< typename SymbolType, typename ValueType >
-ValueType Parser< SymbolType, ValueType >::parse( string sentence )
+ValueType Parser< SymbolType, ValueType >::parse( const string & sentence )
 {
     ValueType retVal ; // Default to f(x) = 0, mod 0.
 
@@ -600,7 +477,7 @@ ValueType Parser< SymbolType, ValueType >::parse( string sentence )
         #endif
 
         // Look up the action (shift 3), (reduce 2), etc.
-        ActionState actionState = actionTable_[ currentState ][ static_cast<int>( lookahead.type_ ) ] ;
+        const ActionState & actionState = tables_->action( currentState, lookahead.type_ ) ;
 
         // Debug dump the action.
         #ifdef DEBUG_PP_PARSER
@@ -635,10 +512,10 @@ ValueType Parser< SymbolType, ValueType >::parse( string sentence )
 					int productionNum = actionState.state_ ;
 
 					// Get the left hand side non-terminal A.
-					SymbolType prodNonTerm = production_[ productionNum ].type_ ;
+					SymbolType prodNonTerm = tables_->production_[ productionNum ].nonTerminal_ ;
 
 					// Get r, the length of beta.  If the production is A -> EPSILON, beta = EPSILON, r = 0.
-					int rhsProductionLength = production_[ productionNum ].state_ ;
+					int rhsProductionLength = tables_->production_[ productionNum ].rhsLength_ ;
 
 					// Carry out the syntax directed translation using
 					// the symbols of beta and its states
@@ -666,7 +543,7 @@ ValueType Parser< SymbolType, ValueType >::parse( string sentence )
 
 					// Get the GOTO state s.
 					currentState = parseStack_.back().state_ ;
-					int gotoState = gotoTable_[ static_cast<int>( currentState ) ][ static_cast<int>( prodNonTerm ) ] ;
+					int gotoState = tables_->goTo( currentState, prodNonTerm ) ;
 
 					// Push nonterminal A and goto state s.
 					A.state_ = gotoState ;
@@ -691,7 +568,7 @@ ValueType Parser< SymbolType, ValueType >::parse( string sentence )
 
 					// Throw a parser error with an error message based on the current state.
                     ostringstream os ;
-                    os << errorMessage_[ currentState ] << " in sentence " << sentence ;
+                    os << tables_->errorMessage_[ currentState ] << " in sentence " << sentence ;
                     throw ParserError( os.str() ) ;
                     
 					return retVal ;
@@ -813,6 +690,152 @@ PolyValue::PolyValue( const PolyValue & v )
 }
 
 
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyParser parse tables
+ |
+ | DESCRIPTION
+ |
+ |     LALR(1) ACTION, GOTO and error message tables and the productions
+ |     for the polynomial grammar, generated at compile time and shared by
+ |     all PolyParser objects.
+ |
+ +============================================================================*/
+
+constexpr int polyNumStates = 15 ;  // Including the 0 state.
+
+// For each state and each terminal, the action, and for Shift the new state to push
+// on the stack, for Reduce the production number.
+constexpr ActionEntry< PolySymbol > polyActions[] =
+{
+    {  0,  PolySymbol::Integer, Action::Shift,   3 },
+    {  0,  PolySymbol::Ecks,    Action::Reduce,  8 },
+    {  0,  PolySymbol::Comma,   Action::Reduce,  8 },
+    {  0,  PolySymbol::Dollar,  Action::Reduce,  8 },
+    {  0,  PolySymbol::Plus,    Action::Reduce,  8 },
+
+    {  1,  PolySymbol::Dollar,  Action::Accept,  0 },
+
+    {  2,  PolySymbol::Comma,   Action::Shift,   7 },
+    {  2,  PolySymbol::Plus,    Action::Shift,   8 },
+    {  2,  PolySymbol::Dollar,  Action::Reduce,  3 },
+
+    {  3,  PolySymbol::Ecks,    Action::Reduce,  7 },
+    {  3,  PolySymbol::Comma,   Action::Reduce,  7 },
+    {  3,  PolySymbol::Dollar,  Action::Reduce,  7 },
+    {  3,  PolySymbol::Plus,    Action::Reduce,  7 },
+
+    {  4,  PolySymbol::Comma,   Action::Reduce,  5 },
+    {  4,  PolySymbol::Dollar,  Action::Reduce,  5 },
+    {  4,  PolySymbol::Plus,    Action::Reduce,  5 },
+
+    {  5,  PolySymbol::Ecks,    Action::Shift,  10 },
+    {  5,  PolySymbol::Comma,   Action::Reduce, 11 },
+    {  5,  PolySymbol::Dollar,  Action::Reduce, 11 },
+    {  5,  PolySymbol::Plus,    Action::Reduce, 11 },
+
+    {  6,  PolySymbol::Dollar,  Action::Reduce,  1 },
+
+    {  7,  PolySymbol::Integer, Action::Shift,  11 },
+
+    {  8,  PolySymbol::Integer, Action::Shift,   3 },
+    {  8,  PolySymbol::Ecks,    Action::Reduce,  8 },
+    {  8,  PolySymbol::Comma,   Action::Reduce,  8 },
+    {  8,  PolySymbol::Dollar,  Action::Reduce,  8 },
+    {  8,  PolySymbol::Plus,    Action::Reduce,  8 },
+
+    {  9,  PolySymbol::Comma,   Action::Reduce,  6 },
+    {  9,  PolySymbol::Dollar,  Action::Reduce,  6 },
+    {  9,  PolySymbol::Plus,    Action::Reduce,  6 },
+
+    { 10,  PolySymbol::Comma,   Action::Reduce,  9 },
+    { 10,  PolySymbol::Exp,     Action::Shift,  13 },
+    { 10,  PolySymbol::Dollar,  Action::Reduce,  9 },
+    { 10,  PolySymbol::Plus,    Action::Reduce,  9 },
+
+    { 11,  PolySymbol::Dollar,  Action::Reduce,  2 },
+
+    { 12,  PolySymbol::Comma,   Action::Reduce,  4 },
+    { 12,  PolySymbol::Dollar,  Action::Reduce,  4 },
+    { 12,  PolySymbol::Plus,    Action::Reduce,  4 },
+
+    { 13,  PolySymbol::Integer, Action::Shift,  14 },
+
+    { 14,  PolySymbol::Comma,   Action::Reduce, 10 },
+    { 14,  PolySymbol::Dollar,  Action::Reduce, 10 },
+    { 14,  PolySymbol::Plus,    Action::Reduce, 10 },
+} ;
+
+// For each state and nonterminal, the new state.
+constexpr GotoEntry< PolySymbol > polyGotos[] =
+{
+    {  0,  PolySymbol::S,           1 },
+    {  0,  PolySymbol::Poly,        2 },
+    {  0,  PolySymbol::Term,        4 },
+    {  0,  PolySymbol::Multiplier,  5 },
+
+    {  2,  PolySymbol::Mod,         6 },
+
+    {  5,  PolySymbol::Power,       9 },
+
+    {  8,  PolySymbol::Term,       12 },
+    {  8,  PolySymbol::Multiplier,  5 },
+} ;
+
+// For each production (given by a unique number), the single nonterminal which starts
+// the production, and the length in symbols of the right hand side.  Production 0 is unused.
+constexpr Production< PolySymbol > polyProductions[] =
+{
+    { PolySymbol::S,          0 },
+    { PolySymbol::S,          2 },  // S          -> Poly Mod
+    { PolySymbol::Mod,        2 },  // Mod        -> , integer
+    { PolySymbol::Mod,        0 },  // Mod        -> EPSILON
+    { PolySymbol::Poly,       3 },  // Poly       -> Poly + Term
+    { PolySymbol::Poly,       1 },  // Poly       -> Term
+    { PolySymbol::Term,       2 },  // Term       -> Multiplier Power
+    { PolySymbol::Multiplier, 1 },  // Multiplier -> integer
+    { PolySymbol::Multiplier, 0 },  // Multiplier -> EPSILON
+    { PolySymbol::Power,      1 },  // Power      -> x
+    { PolySymbol::Power,      3 },  // Power      -> x ^ integer
+    { PolySymbol::Power,      0 },  // Power      -> EPSILON
+} ;
+
+// For each state, an error message.
+constexpr const char * polyErrorMessages[] =
+{
+    /*  0 */ "Expecting to see the start of the polynomial or next term or coefficient",
+    /*  1 */ "Expecting to see end of the polynomial",
+    /*  2 */ "Expecting to see mod or + term or , integer or end of polynomial",
+    /*  3 */ "Expecting to see x or , or end of the polynomial",
+    /*  4 */ "Expecting to see + or end of the polynomial",
+    /*  5 */ "Expecting to see a power after a coefficient or x or ,",
+    /*  6 */ "Expecting to see ,",
+    /*  7 */ "Expecting to see mod after ,",
+    /*  8 */ "Expecting to see a term after a + or a term or coefficient",
+    /*  9 */ "Expecting to see , or end of polynomial after a term",
+    /* 10 */ "Expecting to see x^ or x or x ^ integer",
+    /* 11 */ "Expecting to see end of the polynomial after , integer",
+    /* 12 */ "Expecting to see , end of polynomial or + after a term",
+    /* 13 */ "Expecting to see an exponent after x ^",
+    /* 14 */ "Expecting to see , or + end of polynomial after x ^ integer"
+} ;
+
+static_assert( sizeof( polyErrorMessages ) / sizeof( polyErrorMessages[ 0 ] ) == polyNumStates,
+               "Need one error message per state" ) ;
+
+constexpr ParseTableArrays< PolySymbol, polyNumStates > polyTableArrays =
+    makeParseTableArrays< PolySymbol, polyNumStates >( polyActions, polyGotos ) ;
+
+constexpr ParseTables< PolySymbol > polyParseTables =
+{
+    polyNumStates, 11,
+    polyTableArrays.action_, polyTableArrays.goto_,
+    polyProductions, polyErrorMessages
+} ;
+
+
 /*=============================================================================
 |
 | NAME
@@ -827,18 +850,34 @@ PolyValue::PolyValue( const PolyValue & v )
 
 template < typename SymbolType, typename ValueType >
 PolyParser< SymbolType, ValueType >::PolyParser()
-    : Parser< SymbolType, ValueType >()
+    : Parser< SymbolType, ValueType >( polyParseTables )
     , testPolynomial_()
     , testPolynomialForPrimitivity_( false )
     , listAllPrimitivePolynomials_( false )
+    , aggregate_( false )
+    , estimate_( false )
     , printOperationCount_( false )
+    , statisticsJson_( false )
+    , monitorFile_()
+    , traceFile_()
     , printHelp_( false )
     , slowConfirm_( false )
+    , batchTest_( false )
+    , batchFile_()
+    , daemon_( false )
+    , daemonSocket_()
+    , outputFormat_( OutputFormat::Human )
+    , writeArchive_( false )
+    , readArchive_( false )
+    , verifyArchive_( false )
+    , archiveFile_()
+    , archiveFirst_( 0 )
+    , archiveCount_( 0 )
+    , fullUnitTest_( false )
+    , unitTestOnly_( false )
     , p( 0 )
     , n( 0 )
 {
-    // Initialize all the parse tables.
-    initializeTables() ;
 }
 
 /*=============================================================================
@@ -908,160 +947,6 @@ PolyParser< SymbolType, ValueType > & PolyParser< SymbolType, ValueType >::opera
 }
 
 
-/*=============================================================================
- | 
- | NAME
- | 
- |     initializeTables
- | 
- | DESCRIPTION
- | 
- |     Initialize ACTION, GOTO, and ERROR_MESSAGE tables for an LALR(1) parser.
- |     And also information about the productions.
- |
- +============================================================================*/
-
-template < typename SymbolType, typename ValueType >
-    void PolyParser< SymbolType, ValueType >::
-        initializeTables()
-{
-    // Need these so we can preallocate the vector lengths.  Vector's operator[] is unchecked!
-    NumStates_       = 15 ; // Including the 0 state.
-    NumProductions_  = 11 ;
-    NumTerminals_    = static_cast<int>(PolySymbol::NumTerminals) ;
-    NumNonTerminals_ = static_cast<int>(PolySymbol::NumSymbols) - static_cast<int>(PolySymbol::NumTerminals) - 1 ;  // Don't count NumTerminals enum itself.
-
-    // Expand the rows of the ACTION table to hold all the states.
-    actionTable_.resize( NumStates_ ) ;
-    
-    // Expand the rows of the GOTO table to hold all the states.
-    gotoTable_.resize( NumStates_ ) ;
-    
-    // Expand the rows of the ACTION table to hold all the states.
-    // Allow space in 0th slot (unused).
-    production_.resize( NumProductions_ + 1 ) ;
-    
-    errorMessage_.resize( NumStates_ ) ;
-    
-    // TODO:  does resize or operator[] throw any exceptions?  use vector.at( i ) for checked access?
-    try
-	{
-		// For each state and each terminal, insert
-        //    if Shift, the new state to push on the stack,
-        //    if Reduce, the production number.
-		insertAction( 0,    PolySymbol::Integer,    Action::Shift,       3 ) ;
-		insertAction( 0,    PolySymbol::Ecks,       Action::Reduce,      8 ) ;
-		insertAction( 0,    PolySymbol::Comma,      Action::Reduce,      8 ) ;
-		insertAction( 0,    PolySymbol::Dollar,     Action::Reduce,      8 ) ;
-		insertAction( 0,    PolySymbol::Plus,       Action::Reduce,      8 ) ;
-
-		insertAction( 1,    PolySymbol::Dollar,     Action::Accept,      0 ) ;
-
-		insertAction( 2,    PolySymbol::Comma,      Action::Shift,       7 ) ;
-		insertAction( 2,    PolySymbol::Plus,       Action::Shift,       8 ) ;
-		insertAction( 2,    PolySymbol::Dollar,     Action::Reduce,      3 ) ;
-
-		insertAction( 3,    PolySymbol::Ecks,       Action::Reduce,      7 ) ;
-		insertAction( 3,    PolySymbol::Comma,      Action::Reduce,      7 ) ;
-		insertAction( 3,    PolySymbol::Dollar,     Action::Reduce,      7 ) ;
-		insertAction( 3,    PolySymbol::Plus,       Action::Reduce,      7 ) ;
-
-		insertAction( 4,    PolySymbol::Comma,      Action::Reduce,      5 ) ;
-		insertAction( 4,    PolySymbol::Dollar,     Action::Reduce,      5 ) ;
-		insertAction( 4,    PolySymbol::Plus,       Action::Reduce,      5 ) ;
-
-		insertAction( 5,    PolySymbol::Ecks,       Action::Shift,      10 ) ;
-		insertAction( 5,    PolySymbol::Comma,      Action::Reduce,     11 ) ;
-		insertAction( 5,    PolySymbol::Dollar,     Action::Reduce,     11 ) ;
-		insertAction( 5,    PolySymbol::Plus,       Action::Reduce,     11 ) ;
-
-		insertAction( 6,    PolySymbol::Dollar,     Action::Reduce,      1 ) ;
-
-		insertAction( 7,    PolySymbol::Integer,    Action::Shift,      11 ) ;
-
-		insertAction( 8,    PolySymbol::Integer,    Action::Shift,       3 ) ;
-		insertAction( 8,    PolySymbol::Ecks,       Action::Reduce,      8 ) ;
-		insertAction( 8,    PolySymbol::Comma,      Action::Reduce,      8 ) ;
-		insertAction( 8,    PolySymbol::Dollar,     Action::Reduce,      8 ) ;
-		insertAction( 8,    PolySymbol::Plus,       Action::Reduce,      8 ) ;
-
-		insertAction( 9,    PolySymbol::Comma,      Action::Reduce,      6 ) ;
-		insertAction( 9,    PolySymbol::Dollar,     Action::Reduce,      6 ) ;
-		insertAction( 9,    PolySymbol::Plus,       Action::Reduce,      6 ) ;
-
-		insertAction( 10,   PolySymbol::Comma,      Action::Reduce,      9 ) ;
-		insertAction( 10,   PolySymbol::Exp,        Action::Shift,      13 ) ;
-		insertAction( 10,   PolySymbol::Dollar,     Action::Reduce,      9 ) ;
-		insertAction( 10,   PolySymbol::Plus,       Action::Reduce,      9 ) ;
-
-		insertAction( 11,   PolySymbol::Dollar,     Action::Reduce,      2 ) ;
-
-		insertAction( 12,   PolySymbol::Comma,      Action::Reduce,      4 ) ;
-		insertAction( 12,   PolySymbol::Dollar,     Action::Reduce,      4 ) ;
-		insertAction( 12,   PolySymbol::Plus,       Action::Reduce,      4 ) ;
-
-		insertAction( 13,   PolySymbol::Integer,    Action::Shift,      14 ) ;
-
-		insertAction( 14,   PolySymbol::Comma,      Action::Reduce,     10 ) ;
-		insertAction( 14,   PolySymbol::Dollar,     Action::Reduce,     10 ) ;
-		insertAction( 14,   PolySymbol::Plus,       Action::Reduce,     10 ) ;
-
-
-		// For each state and symbol insert a new state.
-		insertGoto( 0,  PolySymbol::S,               1 ) ;
-		insertGoto( 0,  PolySymbol::Poly,            2 ) ;
-		insertGoto( 0,  PolySymbol::Term,            4 ) ;
-		insertGoto( 0,  PolySymbol::Multiplier,      5 ) ;
-
-		insertGoto( 2,  PolySymbol::Mod,             6 ) ;
-
-		insertGoto( 5,  PolySymbol::Power,           9 ) ;
-
-		insertGoto( 8,  PolySymbol::Term,           12 ) ;
-		insertGoto( 8,  PolySymbol::Multiplier,      5 ) ;
-
-
-		// For each production (given by a unique number), insert the single nonterminal
-        // which starts the production, and the length in symbols of the right hand side.
-        // We'll need to know which production is being reduced so we can apply the syntax
-        // directed translation, and pop the production off the stack.
-		insertProduction(  1,      PolySymbol::S,           2 ) ; // S          -> Poly Mod
-		insertProduction(  2,      PolySymbol::Mod,         2 ) ; // Mod        -> , integer
-		insertProduction(  3,      PolySymbol::Mod,         0 ) ; // Mod        -> EPSILON
-		insertProduction(  4,      PolySymbol::Poly,        3 ) ; // Poly       -> Poly + Term
-		insertProduction(  5,      PolySymbol::Poly,        1 ) ; // Poly       -> Term
-		insertProduction(  6,      PolySymbol::Term,        2 ) ; // Term       -> Multiplier Power
-		insertProduction(  7,      PolySymbol::Multiplier,  1 ) ; // Multiplier -> integer
-		insertProduction(  8,      PolySymbol::Multiplier,  0 ) ; // Multiplier -> EPSILON
-		insertProduction(  9,      PolySymbol::Power,       1 ) ; // Power      -> x
-		insertProduction( 10,      PolySymbol::Power,       3 ) ; // Power      -> x ^ integer
-		insertProduction( 11,      PolySymbol::Power,       0 ) ; // Power      -> EPSILON
-
-        // For each state, provide an error message.
-		insertErrorMessage(  0, "Expecting to see the start of the polynomial or next term or coefficient" ) ;
-		insertErrorMessage(  1, "Expecting to see end of the polynomial" ) ;
-		insertErrorMessage(  2, "Expecting to see mod or + term or , integer or end of polynomial" ) ;
-		insertErrorMessage(  3, "Expecting to see x or , or end of the polynomial" ) ;
-		insertErrorMessage(  4, "Expecting to see + or end of the polynomial" ) ;
-		insertErrorMessage(  5, "Expecting to see a power after a coefficient or x or ," ) ;
-		insertErrorMessage(  6, "Expecting to see ," ) ;
-		insertErrorMessage(  7, "Expecting to see mod after ," ) ;
-		insertErrorMessage(  8, "Expecting to see a term after a + or a term or coefficient" ) ;
-		insertErrorMessage(  9, "Expecting to see , or end of polynomial after a term" ) ;
-		insertErrorMessage( 10, "Expecting to see x^ or x or x ^ integer" ) ;
-		insertErrorMessage( 11, "Expecting to see end of the polynomial after , integer" ) ;
-		insertErrorMessage( 12, "Expecting to see , end of polynomial or + after a term" ) ;
-		insertErrorMessage( 13, "Expecting to see an exponent after x ^" ) ;
-		insertErrorMessage( 14, "Expecting to see , or + end of polynomial after x ^ integer" ) ;
-	}
-	catch( length_error & e)
-	{
-		ostringstream os ;
-		os << "Error:  Cannot initialize PolyParser tables "
-		<< " at " << __FILE__ << ": line " << __LINE__  ;
-		throw ParserError( os.str() ) ;
-    }  
-}
 
 
 /*=============================================================================
@@ -1082,7 +967,7 @@ template < typename SymbolType, typename ValueType >
  +============================================================================*/
 
 template < typename SymbolType, typename ValueType >
-void PolyParser< SymbolType, ValueType >::tokenize( string sentence )
+void PolyParser< SymbolType, ValueType >::tokenize( const string & sentence )
 {
 	Symbol< SymbolType, ValueType > tok( PolySymbol::NumSymbols, 0 ) ;
 
@@ -1115,7 +1000,7 @@ void PolyParser< SymbolType, ValueType >::tokenize( string sentence )
                 int digit = atoi( asciiDigit ) ;
 
                 // Stop reading the next decimal digit if we're about to overflow.
-                if (num > (BigInt::getBase() - digit) / 10)
+                if (num > (maxModulus - digit) / 10)
                 {
                     ostringstream os ;
                     os << "Error:  number about to overflow in tokenizer "
@@ -1445,65 +1330,477 @@ void PolyParser<SymbolType, ValueType>::syntaxDirectedTranslation( int productio
 
 
 
-/*------------------------------- Parser Child Classes ------------------------*/
-
-
-
 /*=============================================================================
  |
  | NAME
  |
- |     operator=( const FactorizationValue & v )
- |
+ |     nextPolyToken
  |
  | DESCRIPTION
  |
- |     Assignment operator for FactorizationValue.
+ |     Lexical analyzer for parsePolynomial.  Read the token at pos exactly
+ |     as PolyParser::tokenize does and advance pos past it.  Return false
+ |     for anything tokenize would reject.
  |
  +============================================================================*/
 
-template<typename IntType>
-FactorizationValue<IntType> & FactorizationValue<IntType>::operator=( const FactorizationValue<IntType> & v )
+static bool nextPolyToken( const char * & pos, const char * last, bool & minusSignDetected,
+                           PolySymbol & type, ppuint & value )
 {
-    // Check for assigning to oneself:  just pass back a reference to the unchanged object.
-    if (this == &v)
-        return *this ;
-    
-    numberString_ = v.numberString_ ;
-    factor_ = v.factor_ ;
+    // At end of input, the $ terminator symbol.
+    if (pos == last)
+    {
+        type = PolySymbol::Dollar ;
+        return true ;
+    }
 
-    // Pass back the object so we can concatenate assignments.
-    return *this ;
-}
+    // Skip whitespace.
+    while (pos != last && iswspace( *pos ))
+        ++pos ;
+
+    // Read an integer.
+    if (pos != last && isdigit( *pos ))
+    {
+        ppuint num = 0 ;
+        while (pos != last && isdigit( *pos ))
+        {
+            ppuint digit = static_cast<ppuint>( *pos - '0' ) ;
+
+            // Number about to overflow.
+            if (num > (maxModulus - digit) / 10)
+                return false ;
+
+            num = 10 * num + digit ;
+            ++pos ;
+        }
+
+        // Once we've seen a minus sign, no more numbers are allowed.
+        if (minusSignDetected)
+            return false ;
 
+        type  = PolySymbol::Integer ;
+        value = num ;
+        return true ;
+    }
+
+    // tokenize doesn't allow whitespace at the end.
+    if (pos == last)
+        return false ;
+
+    switch( *pos++ )
+    {
+        case '+' : type = PolySymbol::Plus ;  break ;
+        case '-' : type = PolySymbol::Plus ;  minusSignDetected = true ;  break ;
+        case '^' : type = PolySymbol::Exp ;   break ;
+        case 'x' :
+        case 'X' : type = PolySymbol::Ecks ;  break ;
+        case ',' : type = PolySymbol::Comma ; break ;
+        default  : return false ;
+    }
+
+    return true ;
+}
 
 
 /*=============================================================================
  |
  | NAME
  |
- |     numberStringToInteger
- |
+ |     scanPolynomial
  |
  | DESCRIPTION
  |
- |     Convert a number string (sequence of decimal digits) to an integer.
+ |     Recursive descent recognizer for the polynomial grammar,
+ |
+ |         S    -> Term { + Term } [ , integer ] $
+ |         Term -> [ integer ] [ x [ ^ integer ] ]
+ |
+ |     which is the PolyParser grammar with the left recursion and epsilon
+ |     productions written out.  Add each term into f as we go.  Return
+ |     false on any error.
  |
  +============================================================================*/
 
-template<typename IntType>
-IntType FactorizationValue<IntType>::numberStringToInteger( const string & numberString )
+static bool scanPolynomial( const char * first, const char * last, vector< ppuint > & f, ppuint & p )
 {
-    // First define a generic integer type.
-    IntType u ;
-    
-    // Create a string stream and load it with the number string.
-    istringstream is ;
-    is.clear() ;
-    is.str( numberString ) ;
-    
-    // Read the generic integer from the stream.
-    // We have two IntType's:
+    const char * pos = first ;
+    bool minusSignDetected = false ;
+    PolySymbol type = PolySymbol::Dollar ;
+    ppuint value = 0 ;
+
+    auto next = [&]() { return nextPolyToken( pos, last, minusSignDetected, type, value ) ; } ;
+
+    if (!next())
+        return false ;
+
+    for (;;)
+    {
+        // Multiplier -> integer | EPSILON
+        ppuint multiplier = 1 ;
+        if (type == PolySymbol::Integer)
+        {
+            multiplier = value ;
+            if (!next())
+                return false ;
+        }
+
+        // Power -> x | x ^ integer | EPSILON
+        ppuint power = 0 ;
+        if (type == PolySymbol::Ecks)
+        {
+            power = 1 ;
+            if (!next())
+                return false ;
+
+            if (type == PolySymbol::Exp)
+            {
+                if (!next() || type != PolySymbol::Integer)
+                    return false ;
+                power = value ;
+                if (!next())
+                    return false ;
+            }
+        }
+
+        // f += multiplier x ^ power
+        if (power >= f.size())
+            f.resize( power + 1, 0 ) ;
+        f[ power ] += multiplier ;
+
+        if (type != PolySymbol::Plus)
+            break ;
+
+        if (!next())
+            return false ;
+    }
+
+    // Mod -> , integer | EPSILON, with a default modulus of 2.
+    p = 2 ;
+    if (type == PolySymbol::Comma)
+    {
+        if (!next() || type != PolySymbol::Integer)
+            return false ;
+        p = value ;
+        if (!next())
+            return false ;
+    }
+
+    return type == PolySymbol::Dollar ;
+}
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     parsePolynomial
+ |
+ | DESCRIPTION
+ |
+ |     Parse a polynomial straight into its coefficients and modulus.
+ |     See the header file.
+ |
+ +============================================================================*/
+
+void parsePolynomial( const char * first, const char * last, vector< ppuint > & f, ppuint & p )
+{
+    // As in Parser::parse, the empty string is f( x ) = 0 with modulus 0.
+    f.assign( 1, 0 ) ;
+    p = 0 ;
+    if (first == last)
+        return ;
+
+    if (scanPolynomial( first, last, f, p ))
+        return ;
+
+    // Let the reference parser find the error and throw its ParserError.
+    PolyParser< PolySymbol, PolyValue > parser ;
+    PolyValue v = parser.parse( string( first, last ) ) ;
+
+    // We shouldn't get here, but if the reference parser accepts, its value is the right one.
+    f = v.f_ ;
+    p = v.scalar_ ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     readTapMask
+ |
+ | DESCRIPTION
+ |
+ |     Read the digits of a hex tap mask (bitsPerDigit = 4) or bit string
+ |     (bitsPerDigit = 1) in [first, last), most significant digit first,
+ |     into the coefficients of a polynomial modulo 2.
+ |
+ +============================================================================*/
+
+static void readTapMask( const char * first, const char * last, int bitsPerDigit, vector< ppuint > & f )
+{
+    const char * end = first ;
+    while (end != last && !iswspace( *end ))
+        ++end ;
+
+    const char * pos = end ;
+    while (pos != last && iswspace( *pos ))
+        ++pos ;
+
+    const char * prefix = bitsPerDigit == 4 ? "0x" : "0b" ;
+    if (first == end || pos != last)
+    {
+        ostringstream os ;
+        os << "Error:  expecting only " << (bitsPerDigit == 4 ? "hex" : "binary") << " digits after the " << prefix
+           << " in the tap mask " << prefix << string( first, last )
+           << " at " << __FILE__ << ": line " << __LINE__  ;
+        throw ParserError( os.str() ) ;
+    }
+
+    // The last digit holds the lowest powers of x.
+    f.assign( static_cast<size_t>( end - first ) * bitsPerDigit, 0 ) ;
+    size_t power = 0 ;
+    for (const char * digit = end ;  digit != first ;  power += bitsPerDigit)
+    {
+        char c = *--digit ;
+
+        int value = 16 ;
+        if (c >= '0' && c <= '9')
+            value = c - '0' ;
+        else if (c >= 'a' && c <= 'f')
+            value = c - 'a' + 10 ;
+        else if (c >= 'A' && c <= 'F')
+            value = c - 'A' + 10 ;
+
+        if (value >= (1 << bitsPerDigit))
+        {
+            ostringstream os ;
+            os << "Error:  bad digit " << c << " in the tap mask " << prefix << string( first, last )
+               << " at " << __FILE__ << ": line " << __LINE__  ;
+            throw ParserError( os.str() ) ;
+        }
+
+        for (int bit = 0 ;  bit < bitsPerDigit ;  ++bit)
+            f[ power + bit ] = (value >> bit) & 1 ;
+    }
+
+    // Drop the leading zeros, but leave the constant term.
+    size_t size = f.size() ;
+    while (size > 1 && f[ size - 1 ] == 0)
+        --size ;
+    f.resize( size ) ;
+}
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     readDecimal
+ |
+ | DESCRIPTION
+ |
+ |     Read a decimal integer at pos, less than maxModulus as in the
+ |     tokenizer, and advance pos past it.  Return false if there isn't one.
+ |
+ +============================================================================*/
+
+static bool readDecimal( const char * & pos, const char * last, ppuint & num )
+{
+    if (pos == last || !isdigit( *pos ))
+        return false ;
+
+    num = 0 ;
+    while (pos != last && isdigit( *pos ))
+    {
+        ppuint digit = static_cast<ppuint>( *pos - '0' ) ;
+        if (num > (maxModulus - digit) / 10)
+            return false ;
+
+        num = 10 * num + digit ;
+        ++pos ;
+    }
+
+    return true ;
+}
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     readExponentList
+ |
+ | DESCRIPTION
+ |
+ |     Read a sparse list of exponents with optional coefficients and an
+ |     optional modulus, ( e1[:c1] e2[:c2] ... ) [, p], starting just after
+ |     the opening parenthesis.
+ |
+ +============================================================================*/
+
+static void readExponentList( const char * first, const char * pos, const char * last, vector< ppuint > & f, ppuint & p )
+{
+    auto skipBlanks = [&]() { while (pos != last && iswspace( *pos )) ++pos ; } ;
+
+    auto error = [&]( const char * expecting )
+    {
+        ostringstream os ;
+        os << "Error:  expecting " << expecting << " in the exponent list " << string( first, last )
+           << " at " << __FILE__ << ": line " << __LINE__  ;
+        throw ParserError( os.str() ) ;
+    } ;
+
+    f.assign( 1, 0 ) ;
+    bool empty = true ;
+    for (;;)
+    {
+        skipBlanks() ;
+        if (pos != last && *pos == ')')
+            break ;
+
+        // Terms may be separated by blanks or commas.
+        if (!empty && pos != last && *pos == ',')
+        {
+            ++pos ;
+            skipBlanks() ;
+        }
+
+        ppuint power = 0, coeff = 1 ;
+        if (!readDecimal( pos, last, power ))
+            error( "an exponent or )" ) ;
+
+        if (pos != last && *pos == ':')
+        {
+            ++pos ;
+            if (!readDecimal( pos, last, coeff ))
+                error( "a coefficient after :" ) ;
+        }
+
+        if (power >= f.size())
+            f.resize( power + 1, 0 ) ;
+        f[ power ] += coeff ;
+        empty = false ;
+    }
+    ++pos ;
+
+    if (empty)
+        error( "at least one exponent" ) ;
+
+    // Modulus -> , integer | EPSILON, with a default modulus of 2.
+    p = 2 ;
+    skipBlanks() ;
+    if (pos != last && *pos == ',')
+    {
+        ++pos ;
+        skipBlanks() ;
+        if (!readDecimal( pos, last, p ))
+            error( "the modulus after ," ) ;
+        skipBlanks() ;
+    }
+
+    if (pos != last)
+        error( "the end of input after the list and modulus" ) ;
+}
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     readPolynomial
+ |
+ | DESCRIPTION
+ |
+ |     Read a polynomial in any of our text formats.  See the header file.
+ |
+ +============================================================================*/
+
+void readPolynomial( const char * first, const char * last, vector< ppuint > & f, ppuint & p )
+{
+    const char * pos = first ;
+    while (pos != last && iswspace( *pos ))
+        ++pos ;
+
+    // x can't be followed by a digit in the usual format, so 0x13 is never 0 x 13.
+    if (last - pos > 2 && pos[ 0 ] == '0' && (pos[ 1 ] == 'x' || pos[ 1 ] == 'X') && isxdigit( pos[ 2 ] ))
+    {
+        readTapMask( pos + 2, last, 4, f ) ;
+        p = 2 ;
+    }
+    else if (last - pos > 2 && pos[ 0 ] == '0' && (pos[ 1 ] == 'b' || pos[ 1 ] == 'B') && (pos[ 2 ] == '0' || pos[ 2 ] == '1'))
+    {
+        readTapMask( pos + 2, last, 1, f ) ;
+        p = 2 ;
+    }
+    else if (pos != last && *pos == '(')
+        readExponentList( first, pos + 1, last, f, p ) ;
+    else
+        parsePolynomial( first, last, f, p ) ;
+}
+
+
+
+/*------------------------------- Parser Child Classes ------------------------*/
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     operator=( const FactorizationValue & v )
+ |
+ |
+ | DESCRIPTION
+ |
+ |     Assignment operator for FactorizationValue.
+ |
+ +============================================================================*/
+
+template<typename IntType>
+FactorizationValue<IntType> & FactorizationValue<IntType>::operator=( const FactorizationValue<IntType> & v )
+{
+    // Check for assigning to oneself:  just pass back a reference to the unchanged object.
+    if (this == &v)
+        return *this ;
+    
+    numberString_ = v.numberString_ ;
+    factor_ = v.factor_ ;
+
+    // Pass back the object so we can concatenate assignments.
+    return *this ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     numberStringToInteger
+ |
+ |
+ | DESCRIPTION
+ |
+ |     Convert a number string (sequence of decimal digits) to an integer.
+ |
+ +============================================================================*/
+
+template<typename IntType>
+IntType FactorizationValue<IntType>::numberStringToInteger( const string & numberString )
+{
+    // First define a generic integer type.
+    IntType u ;
+    
+    // Create a string stream and load it with the number string.
+    istringstream is ;
+    is.clear() ;
+    is.str( numberString ) ;
+    
+    // Read the generic integer from the stream.
+    // We have two IntType's:
     //     BigInt class has a definition of operator>>
     //     ppunint built-in type uses the C++ language operator>>
     is >> u ;
@@ -1511,6 +1808,15 @@ IntType FactorizationValue<IntType>::numberStringToInteger( const string & numbe
     return u ;
 }
 
+// Skip the string stream for BigInt and convert the digits directly.  For
+// factor table entries with thousands of digits, the string constructor
+// does subquadratic radix conversion.
+template<>
+BigInt FactorizationValue<BigInt>::numberStringToInteger( const string & numberString )
+{
+    return BigInt( numberString ) ;
+}
+
 
 /*=============================================================================
  |
@@ -1574,6 +1880,130 @@ FactorizationValue<IntType>::FactorizationValue( const FactorizationValue<IntTyp
 
 
 
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     FactorizationParser parse tables
+ |
+ | DESCRIPTION
+ |
+ |     LALR(1) ACTION, GOTO and error message tables and the productions
+ |     for the factorization grammar, generated at compile time and shared by
+ |     all FactorizationParser objects.
+ |
+ +============================================================================*/
+
+constexpr int factorizationNumStates = 16 ;  // Including the 0 state.
+
+// For each state and each terminal, the action, and for Shift the new state to push
+// on the stack, for Reduce the production number.
+constexpr ActionEntry< FactorizationSymbol > factorizationActions[] =
+{
+    {  0,  FactorizationSymbol::Integer,   Action::Shift,   2 },
+    {  1,  FactorizationSymbol::Dollar,    Action::Accept,  0 },
+    {  2,  FactorizationSymbol::Integer,   Action::Shift,   3 },
+    {  3,  FactorizationSymbol::Integer,   Action::Shift,   4 },
+
+    {  4,  FactorizationSymbol::Caret,     Action::Reduce,  7 },
+    {  4,  FactorizationSymbol::Dollar,    Action::Reduce,  7 },
+    {  4,  FactorizationSymbol::Period,    Action::Reduce,  7 },
+    {  4,  FactorizationSymbol::Backslash, Action::Reduce,  7 },
+
+    {  5,  FactorizationSymbol::Dollar,    Action::Reduce,  1 },
+    {  5,  FactorizationSymbol::Period,    Action::Shift,   8 },
+
+    {  6,  FactorizationSymbol::Dollar,    Action::Reduce,  3 },
+    {  6,  FactorizationSymbol::Period,    Action::Reduce,  3 },
+
+    {  7,  FactorizationSymbol::Caret,     Action::Shift,   9 },
+    {  7,  FactorizationSymbol::Dollar,    Action::Reduce,  5 },
+    {  7,  FactorizationSymbol::Period,    Action::Reduce,  5 },
+    {  7,  FactorizationSymbol::Backslash, Action::Shift,  10 },
+
+    {  8,  FactorizationSymbol::Integer,   Action::Shift,   4 },
+
+    {  9,  FactorizationSymbol::Integer,   Action::Shift,   4 },
+
+    { 10,  FactorizationSymbol::Integer,   Action::Shift,  14 },
+
+    { 11,  FactorizationSymbol::Dollar,    Action::Reduce,  2 },
+    { 11,  FactorizationSymbol::Period,    Action::Reduce,  2 },
+
+    { 13,  FactorizationSymbol::Dollar,    Action::Reduce,  4 },
+    { 13,  FactorizationSymbol::Period,    Action::Reduce,  4 },
+    { 13,  FactorizationSymbol::Backslash, Action::Shift,  10 },
+
+    { 14,  FactorizationSymbol::Caret,     Action::Reduce,  6 },
+    { 14,  FactorizationSymbol::Dollar,    Action::Reduce,  6 },
+    { 14,  FactorizationSymbol::Period,    Action::Reduce,  6 },
+    { 14,  FactorizationSymbol::Backslash, Action::Reduce,  6 },
+} ;
+
+// For each state and nonterminal, the new state.
+constexpr GotoEntry< FactorizationSymbol > factorizationGotos[] =
+{
+    {  0,  FactorizationSymbol::S,              1 },
+
+    {  3,  FactorizationSymbol::Factorization,  5 },
+    {  3,  FactorizationSymbol::Factor,         6 },
+    {  3,  FactorizationSymbol::BigInteger,     7 },
+
+    {  8,  FactorizationSymbol::Factor,        11 },
+    {  8,  FactorizationSymbol::BigInteger,     7 },
+
+    {  9,  FactorizationSymbol::BigInteger,    13 },
+} ;
+
+// For each production (given by a unique number), the single nonterminal which starts
+// the production, and the length in symbols of the right hand side.  Production 0 is unused.
+constexpr Production< FactorizationSymbol > factorizationProductions[] =
+{
+    { FactorizationSymbol::S,             0 },
+    { FactorizationSymbol::S,             3 },  // S -> INTEGER INTEGER FACTORIZATION
+    { FactorizationSymbol::Factorization, 3 },  // FACTORIZATION -> FACTORIZATION PERIOD FACTOR
+    { FactorizationSymbol::Factorization, 1 },  // FACTORIZATION -> FACTOR
+    { FactorizationSymbol::Factor,        3 },  // FACTOR -> BIGINTEGER ^ BIGINTEGER
+    { FactorizationSymbol::Factor,        1 },  // FACTOR -> BIGINTEGER
+    { FactorizationSymbol::BigInteger,    3 },  // BIGINTEGER -> BIGINTEGER \ INTEGER
+    { FactorizationSymbol::BigInteger,    1 },  // BIGINTEGER -> INTEGER
+} ;
+
+// For each state, an error message.
+constexpr const char * factorizationErrorMessages[] =
+{
+    /*  0 */ "Expecting to see the power n.",
+    /*  1 */ "Expecting end of input.",
+    /*  2 */ "Expecting to see the number of prime factors.",
+    /*  3 */ "Expecting an integer.",
+    /*  4 */ "Expecting integer continuation \\ or . followed by a factor or ^ followed by a power or end of input.",
+    /*  5 */ "Expecting another factor after the . or the end of the factorization.",
+    /*  6 */ "Expecting a .",
+    /*  7 */ "Expecting integer continuation \\ or . followed by a factor or a ^ follwed by a power or end of input.",
+    /*  8 */ "Expecting factor or an integer.",
+    /*  9 */ "Expecting an integer.",
+    /* 10 */ "Expecting an integer after the continuation \\.",
+    /* 11 */ "Expecting . and another factor or end of input.",
+    /* 12 */ "",
+    /* 13 */ "Expecting integer continuation \\ or . and next factor or end of input.",
+    /* 14 */ "Expecting . and next factor or ^ and power or end of input after integer continuation \\.",
+    /* 15 */ ""
+} ;
+
+static_assert( sizeof( factorizationErrorMessages ) / sizeof( factorizationErrorMessages[ 0 ] ) == factorizationNumStates,
+               "Need one error message per state" ) ;
+
+constexpr ParseTableArrays< FactorizationSymbol, factorizationNumStates > factorizationTableArrays =
+    makeParseTableArrays< FactorizationSymbol, factorizationNumStates >( factorizationActions, factorizationGotos ) ;
+
+constexpr ParseTables< FactorizationSymbol > factorizationParseTables =
+{
+    factorizationNumStates, 7,
+    factorizationTableArrays.action_, factorizationTableArrays.goto_,
+    factorizationProductions, factorizationErrorMessages
+} ;
+
+
 /*=============================================================================
 |
 | NAME
@@ -1588,10 +2018,8 @@ FactorizationValue<IntType>::FactorizationValue( const FactorizationValue<IntTyp
 
 template < typename SymbolType, typename ValueType >
 FactorizationParser< SymbolType, ValueType >::FactorizationParser()
-    : Parser<SymbolType,ValueType>()
+    : Parser<SymbolType,ValueType>( factorizationParseTables )
 {
-    // Initialize all the parse tables.
-    initializeTables() ;
 }
 
 
@@ -1662,136 +2090,6 @@ FactorizationParser< SymbolType, ValueType > & FactorizationParser< SymbolType,
 }
 
 
-/*=============================================================================
- | 
- | NAME
- | 
- |     initializeTables
- | 
- | DESCRIPTION
- | 
- |     Initialize ACTION, GOTO, and ERROR_MESSAGE tables for an LALR(1) parser.
- |     And also information about the productions.
- |
- +============================================================================*/
-
-template < typename SymbolType, typename ValueType >
-void FactorizationParser<SymbolType,ValueType>::initializeTables()
-{
-    // Need these so we can preallocate the vector lengths.  Vector's operator[] is unchecked!
-    NumStates_       = 16 ; // Including the 0 state.
-    NumProductions_  =  7 ;
-    NumTerminals_    = static_cast<int>(FactorizationSymbol::NumTerminals) ;
-    NumNonTerminals_ = static_cast<int>(FactorizationSymbol::NumSymbols) - static_cast<int>(FactorizationSymbol::NumTerminals) - 1 ;  // Don't count the NumTerminals enum itself.
-
-    // Expand the rows of the ACTION table to hold all the states.
-    actionTable_.resize( NumStates_ ) ;
-    
-    // Expand the rows of the GOTO table to hold all the states.
-    gotoTable_.resize( NumStates_ ) ;
-    
-    // Expand the rows of the ACTION table to hold all the states.
-    // Allow space in 0th slot (unused).
-    production_.resize( NumProductions_ + 1 ) ;
-    
-    errorMessage_.resize( NumStates_ ) ;
-    
-    // TODO:  does resize or operator[] throw any exceptions?  use vector.at( i ) for checked access?
-    try
-	{
-		// For each state and each terminal, insert
-        //    if Shift, the new state to push on the stack,
-        //    if Reduce, the production number.
-		insertAction(  0,  FactorizationSymbol::Integer,   Action::Shift,   2 ) ;
-		insertAction(  1,  FactorizationSymbol::Dollar,    Action::Accept,  0 ) ;
-		insertAction(  2,  FactorizationSymbol::Integer,   Action::Shift,   3 ) ;
-		insertAction(  3,  FactorizationSymbol::Integer,   Action::Shift,   4 ) ;
-
-		insertAction(  4,  FactorizationSymbol::Caret,     Action::Reduce,  7 ) ;
-		insertAction(  4,  FactorizationSymbol::Dollar,    Action::Reduce,  7 ) ;
-        insertAction(  4,  FactorizationSymbol::Period,    Action::Reduce,  7 ) ;
-        insertAction(  4,  FactorizationSymbol::Backslash, Action::Reduce,  7 ) ;
-
-		insertAction(  5,  FactorizationSymbol::Dollar,    Action::Reduce,  1 ) ;
-		insertAction(  5,  FactorizationSymbol::Period,    Action::Shift,   8 ) ;
-
-		insertAction(  6,  FactorizationSymbol::Dollar,    Action::Reduce,  3 ) ;
-		insertAction(  6,  FactorizationSymbol::Period,    Action::Reduce,  3 ) ;
-
-		insertAction(  7,  FactorizationSymbol::Caret,     Action::Shift,   9 ) ;
-        insertAction(  7,  FactorizationSymbol::Dollar,    Action::Reduce,  5 ) ;
-        insertAction(  7,  FactorizationSymbol::Period,    Action::Reduce,  5 ) ;
-		insertAction(  7,  FactorizationSymbol::Backslash, Action::Shift,  10 ) ;
-
-		insertAction(  8,  FactorizationSymbol::Integer,   Action::Shift,   4 ) ;
- 
-		insertAction(  9,  FactorizationSymbol::Integer,   Action::Shift,   4 ) ;
-
-		insertAction( 10,  FactorizationSymbol::Integer,   Action::Shift,  14 ) ;
-
-		insertAction( 11,  FactorizationSymbol::Dollar,    Action::Reduce,  2 ) ;
-		insertAction( 11,  FactorizationSymbol::Period,    Action::Reduce,  2 ) ;
-
-		insertAction( 13,  FactorizationSymbol::Dollar,    Action::Reduce,  4 ) ;
-		insertAction( 13,  FactorizationSymbol::Period,    Action::Reduce,  4 ) ;
-		insertAction( 13,  FactorizationSymbol::Backslash, Action::Shift,  10 ) ;
-
-		insertAction( 14,  FactorizationSymbol::Caret,     Action::Reduce,  6 ) ;
-		insertAction( 14,  FactorizationSymbol::Dollar,    Action::Reduce,  6 ) ;
-        insertAction( 14,  FactorizationSymbol::Period,    Action::Reduce,  6 ) ;
-        insertAction( 14,  FactorizationSymbol::Backslash, Action::Reduce,  6 ) ;
-
-
-		// For each state and symbol insert a new state.
-		insertGoto( 0,  FactorizationSymbol::S,               1 ) ;
-
-		insertGoto( 3,  FactorizationSymbol::Factorization,   5 ) ;
-		insertGoto( 3,  FactorizationSymbol::Factor,          6 ) ;
-		insertGoto( 3,  FactorizationSymbol::BigInteger,      7 ) ;
-
-		insertGoto( 8,  FactorizationSymbol::Factor,         11 ) ;
-		insertGoto( 8,  FactorizationSymbol::BigInteger,      7 ) ;
-
-		insertGoto( 9,  FactorizationSymbol::BigInteger,     13 ) ;
-
-
-		// For each production (given by a unique number), insert the single nonterminal
-        // which starts the production, and the length in symbols of the right hand side.
-        // We'll need to know which production is being reduced so we can apply the syntax
-        // directed translation, and pop the production off the stack.
-		insertProduction(  1,      FactorizationSymbol::S,               3 ) ; // S -> INTEGER INTEGER FACTORIZATION
-		insertProduction(  2,      FactorizationSymbol::Factorization,   3 ) ; // FACTORIZATION -> FACTORIZATION PERIOD FACTOR
-		insertProduction(  3,      FactorizationSymbol::Factorization,   1 ) ; // FACTORIZATION -> FACTOR
-		insertProduction(  4,      FactorizationSymbol::Factor,          3 ) ; // FACTOR -> BIGINTEGER ^ BIGINTEGER
-		insertProduction(  5,      FactorizationSymbol::Factor,          1 ) ; // FACTOR -> BIGINTEGER
-		insertProduction(  6,      FactorizationSymbol::BigInteger,      3 ) ; // BIGINTEGER -> BIGINTEGER \ INTEGER
-		insertProduction(  7,      FactorizationSymbol::BigInteger,      1 ) ; // BIGINTEGER -> INTEGER
-
-        // For each state, provide an error message.
-        insertErrorMessage(  0, "Expecting to see the power n." ) ;
-        insertErrorMessage(  1, "Expecting end of input." ) ;
-        insertErrorMessage(  2, "Expecting to see the number of prime factors." ) ;
-        insertErrorMessage(  3, "Expecting an integer." ) ;
-        insertErrorMessage(  4, "Expecting integer continuation \\ or . followed by a factor or ^ followed by a power or end of input." ) ;
-        insertErrorMessage(  5, "Expecting another factor after the . or the end of the factorization." ) ;
-        insertErrorMessage(  6, "Expecting a ." ) ;
-        insertErrorMessage(  7, "Expecting integer continuation \\ or . followed by a factor or a ^ follwed by a power or end of input." ) ;
-        insertErrorMessage(  8, "Expecting factor or an integer." ) ;
-        insertErrorMessage(  9, "Expecting an integer." ) ;
-        insertErrorMessage( 10, "Expecting an integer after the continuation \\." ) ;
-        insertErrorMessage( 11, "Expecting . and another factor or end of input." ) ;
-        insertErrorMessage( 13, "Expecting integer continuation \\ or . and next factor or end of input." ) ;
-        insertErrorMessage( 14, "Expecting . and next factor or ^ and power or end of input after integer continuation \\." ) ;
-
-	}
-	catch( length_error & e)
-	{
-		ostringstream os ;
-		os << "Error:  Cannot initialize FactorizationParser tables "
-		<< " at " << __FILE__ << ": line " << __LINE__  ;
-		throw ParserError( os.str() ) ;
-    }  
-}
 
 
 /*=============================================================================
@@ -1812,7 +2110,7 @@ void FactorizationParser<SymbolType,ValueType>::initializeTables()
  +============================================================================*/
 
 template <typename SymbolType, typename ValueType> 
-void FactorizationParser<SymbolType, ValueType>::tokenize( string sentence )
+void FactorizationParser<SymbolType, ValueType>::tokenize( const string & sentence )
 {
 	Symbol<SymbolType, ValueType> tok( FactorizationSymbol::NumSymbols, 0 ) ;
 
@@ -2065,9 +2363,23 @@ void FactorizationParser<SymbolType,ValueType>::
  | 
  |    pp -h
  |    pp -s 2 4
+ |    pp -S 2 4                           // Statistics as JSON.
+ |    pp -a -m stats.prom 2 32            // Prometheus statistics every 10 seconds.
  |    pp -t 2 4 x^3+x^2+1                 // No blanks, please!  Looks like
  |                                        // several command line arguments.
  |    pp -t 2 4 "x^  3  +  x ^ 2  +  1"   // Blanks OK now.
+ |    pp -a -j 2 10                       // List all as JSON Lines.
+ |    pp -g 2 20                          // Weights and taps of all of them.
+ |    pp -g -T trace.json 2 24            // Same, with a timeline of the threads.
+ |    pp -e 2 64                          // How long would it take?
+ |    pp --estimate -S 2 64               // Same, as JSON.
+ |    pp -w degree20.ppa 2 20             // Archive all primitive polynomials.
+ |    pp -r degree20.ppa 1000 10          // List 10 of them starting with number 1000.
+ |    pp -v degree20.ppa                  // Check the archive.
+ |    pp -b polys.txt                     // Test one polynomial per line.
+ |    pp -b < polys.txt                   // Same, but from the standard input.
+ |    pp -d /tmp/primpoly.socket          // Answer queries on a Unix domain socket.
+ |    pp -u                               // Run the complete unit test.
  | 
  +============================================================================*/
 
@@ -2078,20 +2390,37 @@ void PolyParser< SymbolType, PolyValueType >::parseCommandLine( int argc, const
     const char * input_arg_string ;
     const char * option_ptr ;
 
+    // Room for the archive file name before p and n.
     int          num_arg ;
-    const char * arg_string[ MAX_NUM_COMMAND_LINE_ARGS ] ;
+    const char * arg_string[ MAX_NUM_COMMAND_LINE_ARGS + 1 ] ;
 
     /*  Initialize to defaults. */
     testPolynomialForPrimitivity_ = false ;
     listAllPrimitivePolynomials_  = false ;
+    aggregate_                    = false ;
+    estimate_                     = false ;
     printOperationCount_          = false ;
+    statisticsJson_               = false ;
+    monitorFile_                  = "" ;
+    traceFile_                    = "" ;
     printHelp_                    = false ;
     slowConfirm_                  = false ;
+    batchTest_                    = false ;
+    batchFile_                    = "" ;
+    daemon_                       = false ;
+    daemonSocket_                 = "" ;
+    outputFormat_                 = OutputFormat::Human ;
+    writeArchive_                 = false ;
+    readArchive_                  = false ;
+    verifyArchive_                = false ;
+    archiveFile_                  = "" ;
+    archiveFirst_                 = 0 ;
+    archiveCount_                 = 0 ;
+    fullUnitTest_                 = false ;
+    unitTestOnly_                 = false ;
     p                             = 0 ;
     n                             = 0 ;
 
-    factorizationTableLocation_ = argv[ 0 ] ;
-    
     //  Parse the command line to get the options and their inputs.
     for (input_arg_index = 0, num_arg = 0 ;  input_arg_index < argc ;
          ++input_arg_index)
@@ -2099,6 +2428,13 @@ void PolyParser< SymbolType, PolyValueType >::parseCommandLine( int argc, const
         /*  Get next argument string. */
         input_arg_string = argv[ input_arg_index ] ;
 
+        /* The one long option, the same as -e. */
+        if (string( input_arg_string ) == "--estimate")
+        {
+            estimate_ = true ;
+            continue ;
+        }
+
         /* We have an option:  a hyphen followed by a non-null string. */
         if (input_arg_string[ 0 ] == '-' && input_arg_string[ 1 ] != '\0')
         {
@@ -2118,11 +2454,47 @@ void PolyParser< SymbolType, PolyValueType >::parseCommandLine( int argc, const
                        listAllPrimitivePolynomials_ = true ;
                     break ;
 
+                    /* Gather statistics of all primitive polynomials instead of listing them. */
+                    case 'g':
+                       aggregate_ = true ;
+                    break ;
+
+                    /* Estimate the time and memory of the search instead of doing it. */
+                    case 'e':
+                       estimate_ = true ;
+                    break ;
+
                     /* Print statistics on program operation. */
                     case 's':
                        printOperationCount_ = true ;
                     break ;
 
+                    /* Print statistics as JSON. */
+                    case 'S':
+                       printOperationCount_ = true ;
+                       statisticsJson_      = true ;
+                    break ;
+
+                    /* Rewrite a statistics file every few seconds.  The file name is the next argument. */
+                    case 'm':
+                        if (input_arg_index + 1 >= argc)
+                        {
+                            printHelp_ = true ;
+                            throw ParserError( "ERROR:  Expecting the statistics file after -m.\n\n" ) ;
+                        }
+                        monitorFile_ = argv[ ++input_arg_index ] ;
+                    break ;
+
+                    /* Write a timeline of the run.  The file name is the next argument. */
+                    case 'T':
+                        if (input_arg_index + 1 >= argc)
+                        {
+                            printHelp_ = true ;
+                            throw ParserError( "ERROR:  Expecting the trace file after -T.\n\n" ) ;
+                        }
+                        traceFile_ = argv[ ++input_arg_index ] ;
+                    break ;
+
                     /* Print help. */
                     case 'h':
                     case 'H':
@@ -2134,6 +2506,47 @@ void PolyParser< SymbolType, PolyValueType >::parseCommandLine( int argc, const
                         slowConfirm_ = true ;
                     break ;
 
+                    /* Test a batch of polynomials from a file or the standard input. */
+                    case 'b':
+                        batchTest_ = true ;
+                    break ;
+
+                    /* Run as a daemon answering queries on a socket. */
+                    case 'd':
+                        daemon_ = true ;
+                    break ;
+
+                    /* Write the primitive polynomials one per line, as JSON Lines or as hex tap masks. */
+                    case 'l':
+                        outputFormat_ = OutputFormat::Compact ;
+                    break ;
+
+                    case 'j':
+                        outputFormat_ = OutputFormat::JsonLines ;
+                    break ;
+
+                    case 'x':
+                        outputFormat_ = OutputFormat::HexMask ;
+                    break ;
+
+                    /* Write, read or verify an archive of primitive polynomials. */
+                    case 'w':
+                        writeArchive_ = true ;
+                    break ;
+
+                    case 'r':
+                        readArchive_ = true ;
+                    break ;
+
+                    case 'v':
+                        verifyArchive_ = true ;
+                    break ;
+
+                    /* Run the complete unit test, not just the smoke test. */
+                    case 'u':
+                        fullUnitTest_ = true ;
+                    break ;
+
                     default:
                        ostringstream os ;
                        os << "Cannot recognize the option" << *option_ptr ;
@@ -2144,10 +2557,107 @@ void PolyParser< SymbolType, PolyValueType >::parseCommandLine( int argc, const
         }
         else  /* Not an option, but an argument. */
         {
+            if (num_arg > MAX_NUM_COMMAND_LINE_ARGS)
+            {
+                printHelp_ = true ;
+                throw ParserError( "ERROR:  Too many arguments.\n\n" ) ;
+            }
+
             arg_string[ num_arg++ ] = input_arg_string ;
         }
     }
 
+    // Nothing to do but the unit test.
+    if (fullUnitTest_ && num_arg == 1 && !testPolynomialForPrimitivity_ && !batchTest_ && !daemon_)
+    {
+        unitTestOnly_ = true ;
+        return ;
+    }
+
+    // Run as a daemon.  The one argument is the path of the socket.
+    if (daemon_)
+    {
+        if (num_arg != 2)
+        {
+            ostringstream os ;
+            os << "ERROR:  Expecting one argument, the path of the daemon's socket.\n\n" ;
+            printHelp_ = true ;
+            throw ParserError( os.str() ) ;
+        }
+
+        daemonSocket_ = arg_string[ 1 ] ;
+        return ;
+    }
+
+    // Read or verify an archive.  The arguments are the file name, and for reading,
+    // optionally the first polynomial to list and how many.
+    if (readArchive_ || verifyArchive_)
+    {
+        if (num_arg < 2 || num_arg > (readArchive_ ? 4 : 2))
+        {
+            ostringstream os ;
+            os << "ERROR:  Expecting the archive file" << (readArchive_ ? ", then optionally the first polynomial and the count" : "") << ".\n\n" ;
+            printHelp_ = true ;
+            throw ParserError( os.str() ) ;
+        }
+
+        archiveFile_  = arg_string[ 1 ] ;
+        archiveFirst_ = 0 ;
+        archiveCount_ = numeric_limits< ppuint >::max() ;
+
+        for (int i = 2 ;  i < num_arg ;  ++i)
+        {
+            char * end = nullptr ;
+            ppuint value = strtoul( arg_string[ i ], &end, 10 ) ;
+            if (end == arg_string[ i ] || *end != '\0')
+            {
+                ostringstream os ;
+                os << "ERROR:  Expecting a number but got " << arg_string[ i ] << ".\n\n" ;
+                printHelp_ = true ;
+                throw ParserError( os.str() ) ;
+            }
+
+            (i == 2 ? archiveFirst_ : archiveCount_) = value ;
+        }
+
+        return ;
+    }
+
+    // Write an archive.  The file name comes before p and n.
+    if (writeArchive_)
+    {
+        if (num_arg != MAX_NUM_COMMAND_LINE_ARGS + 1)
+        {
+            ostringstream os ;
+            os << "ERROR:  Expecting three arguments, the archive file, p and n.\n\n" ;
+            printHelp_ = true ;
+            throw ParserError( os.str() ) ;
+        }
+
+        archiveFile_ = arg_string[ 1 ] ;
+        arg_string[ 1 ] = arg_string[ 2 ] ;
+        arg_string[ 2 ] = arg_string[ 3 ] ;
+        --num_arg ;
+    }
+
+    // User specified a batch of polynomials to test.  Each one has its own p and n, and the
+    // optional argument is the file name.  Without it, we read the standard input.
+    if (batchTest_)
+    {
+        if (num_arg > 2)
+        {
+            ostringstream os ;
+            os << "ERROR:  Expecting at most one argument, the file of polynomials to test.\n\n" ;
+            printHelp_ = true ;
+            throw ParserError( os.str() ) ;
+        }
+
+        if (num_arg == 2 && string( arg_string[ 1 ] ) != "-")
+            batchFile_ = arg_string[ 1 ] ;
+
+        return ;
+    }
+
     // User specified a polynomial to test.  First argument is program name, next is
     // the polynomial.
     if (testPolynomialForPrimitivity_)
@@ -2183,10 +2693,10 @@ void PolyParser< SymbolType, PolyValueType >::parseCommandLine( int argc, const
         throw ParserError( os.str() ) ;
     }
 
-    if (p >= BigInt::getBase())
+    if (p >= maxModulus)
     {
         ostringstream os ;
-        os << "Error.  Polynomial modulus p must be < " << BigInt::getBase() << endl ;
+        os << "Error.  Polynomial modulus p must be < " << maxModulus << endl ;
         printHelp_ = true ;
         throw ParserError( os.str() ) ;
     }
@@ -2202,6 +2712,15 @@ void PolyParser< SymbolType, PolyValueType >::parseCommandLine( int argc, const
     //  Check to see if p is a prime.
     if (!isAlmostSurelyPrime( static_cast<ppuint>( p )))
         throw ParserError( "ERROR:  p must be a prime number.\n\n" ) ;
+
+    // Tap masks have one bit per coefficient.
+    if (outputFormat_ == OutputFormat::HexMask && p != 2)
+    {
+        ostringstream os ;
+        os << "Error.  Hex tap masks are only for p = 2 but p = " << p << endl ;
+        printHelp_ = true ;
+        throw ParserError( os.str() ) ;
+    }
 }
 
 
@@ -2254,9 +2773,9 @@ string enumToString<FactorizationSymbol>( const FactorizationSymbol & st )
 // the templated functions are undefined.  Best to explicitly instantiate the templates here.
 
 // General purpose LALR(1) parser.  Template versions for both the polynomial grammar and factorization grammar.
-template PolyValue                                                    Parser<PolySymbol, PolyValue>::parse( string s ) ;
-template FactorizationValue<BigInt>         Parser<FactorizationSymbol, FactorizationValue<BigInt>>::parse( string s ) ;
-template FactorizationValue<ppuint>         Parser<FactorizationSymbol, FactorizationValue<ppuint>>::parse( string s ) ;
+template PolyValue                                                    Parser<PolySymbol, PolyValue>::parse( const string & s ) ;
+template FactorizationValue<BigInt>         Parser<FactorizationSymbol, FactorizationValue<BigInt>>::parse( const string & s ) ;
+template FactorizationValue<ppuint>         Parser<FactorizationSymbol, FactorizationValue<ppuint>>::parse( const string & s ) ;
 
 // Generate all symbols for the polynomial grammar.
 template                                    Symbol<PolySymbol, PolyValue>::Symbol( PolySymbol, int ) ;
@@ -44,6 +44,10 @@
 const ppuint minModulus = 2 ;
 const ppuint minDegree  = 2 ;
 
+// Largest modulus p and largest integer in a polynomial.  Products of two numbers below this
+// bound fit into a ppuint with a bit to spare, which modulo p arithmetic on polynomials needs.
+const ppuint maxModulus = static_cast<ppuint>( 1u ) << (8 * sizeof( ppuint ) / 2 - 1) ;
+
 
 /*=============================================================================
  |
@@ -151,20 +155,18 @@ class Symbol
 class ActionState
 {
     public:
-        ActionState() ;
-        
-        ActionState( Action type, int state ) ;
-    
-        // Destructor.  Virtual so derived class destructor
-        // automatically calls its base class destructor.
-        virtual ~ActionState()
+        constexpr ActionState()
+            : action_( Action::Error )
+            , state_( 0 )
+        {
+        }
+
+        constexpr ActionState( Action type, int state )
+            : action_( type )
+            , state_( state )
         {
         }
 
-        ActionState( const ActionState & as ) ;
-        
-        ActionState & operator=( const ActionState & as ) ;
-    
         friend ostream & operator<<( ostream & out, const ActionState & as ) ;
     
     // Allow direct access to this simple data type for convenience.
@@ -173,6 +175,52 @@ class ActionState
         int    state_ ;
 } ;
 
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     ParseTables
+ |
+ | DESCRIPTION
+ |
+ |     Read-only LALR(1) tables for one grammar:  the ACTION and GOTO tables
+ |     stored row by row, the productions and an error message for each state.
+ |     Each grammar has a single copy generated at compile time, which all of
+ |     its parsers share.
+ |
+ +============================================================================*/
+
+template< typename SymbolType >
+struct Production
+{
+    SymbolType nonTerminal_ ;   // Left side A of the production A -> beta.
+    int        rhsLength_ ;     // Number of symbols in beta.
+} ;
+
+template< typename SymbolType >
+struct ParseTables
+{
+    //     action = ACTION[ <state at top of parse stack> ][ <lookahead input token> ]
+    inline const ActionState & action( int state, SymbolType terminal ) const
+    {
+        return action_[ state * static_cast<int>( SymbolType::NumTerminals ) + static_cast<int>( terminal ) ] ;
+    }
+
+    // For reduce actions,
+    //    new goto state to push = GOTO[ current state ][ nonterminal production symbol ]
+    inline int goTo( int state, SymbolType nonTerminal ) const
+    {
+        return goto_[ state * static_cast<int>( SymbolType::NumSymbols ) + static_cast<int>( nonTerminal ) ] ;
+    }
+
+    int                              numStates_ ;       // Includes the 0 state.
+    int                              numProductions_ ;  // Productions are numbered from 1.
+    const ActionState *              action_ ;
+    const int *                      goto_ ;
+    const Production< SymbolType > * production_ ;      // Indexed by production number.
+    const char * const *             errorMessage_ ;    // Indexed by state.
+} ;
+
 /*=============================================================================
  |
  | NAME
@@ -218,7 +266,7 @@ class ParserError : public runtime_error
 |
 |     Example of how to use the PolyParser child class for polynomials,
 |
-|        // Create a parser and load the parse tables.
+|        // Create a parser.  Its parse tables are built at compile time and shared.
 |        PolyParser<PolySymbol, PolyValue> parser() ;
 |
 |        // Sample polynomial.
@@ -254,8 +302,8 @@ class Parser
     // The basic member functions to create and initialize the parser,
     // make copies and do a syntax-directed translation of a string.
     public:
-        // Default construct the parser.
-        Parser() ;
+        // Construct the parser for the grammar with these parse tables.
+        explicit Parser( const ParseTables< SymbolType > & tables ) ;
         
         // Destructor.  Virtual so derived class destructor
         // automatically calls its base class destructor.
@@ -268,36 +316,21 @@ class Parser
         virtual Parser & operator=( const Parser & parser ) ;
 
         // Parse an input string, doing a syntax-directed translation, returning the value.
-        ValueType parse( string s ) ;
+        ValueType parse( const string & s ) ;
 
-    // Pure virtual functions to be redefined in the child classes, since the lexical analyzer, parse tables and
-    // syntax-directed translation depend uniquely on the grammar.
+    // Pure virtual functions to be redefined in the child classes, since the lexical analyzer
+    // and syntax-directed translation depend uniquely on the grammar.
     //
 	// Defined within the scope of the Parser class or its derived classes only,
     // so not visible from outside the parser.
     protected:
         // Parse string into tokens.
-        virtual void tokenize( string sentence ) = 0 ;
+        virtual void tokenize( const string & sentence ) = 0 ;
     
-        // NOTE:  call this in the child class constructor.  It fills in the ACTION, GOTO, and ERROR_MESSAGE tables.
-        virtual void initializeTables() = 0 ;
-
         // Reduce using production A -> beta, computing A's value from values of the tokens in beta.
         virtual void syntaxDirectedTranslation( int productionNum, int topIndex, Symbol<SymbolType,ValueType> & as ) = 0 ;
     
-    // These member values and functions are called directly in the child classes.
-    protected:
-        // Number of states, productions, etc.
-        int NumStates_ ;        // Includes the 0 state.
-        int NumProductions_ ;   // Number of productions.
-        int NumTerminals_ ;     // Number of terminal symbols.
-        int NumNonTerminals_ ;  // Number of nonterminal symbols.
-    
-        void insertAction(       int state,   SymbolType terminal, Action actionType, int actionState ) ;
-        void insertGoto(         int state,   SymbolType nonterm,  int    newState ) ;
-        void insertProduction(   int prodNum, SymbolType nonTerm,  int    rhsLength ) ;
-        void insertErrorMessage( int state,   string errorMessage ) ;
-
+    // These member values are used directly in the child classes.
     protected:
         // Parser stack containing symbols tokenized by lexical analyzer.
         vector< Symbol<SymbolType, ValueType> > inputStack_ ;
@@ -305,20 +338,8 @@ class Parser
         // Parse stack containing symbols and states.
         vector< Symbol<SymbolType, ValueType> > parseStack_ ;
 
-        // Action table.  
-        //     action = ACTION_TABLE[ <state at top of parse stack> ][ <lookahead input token> ]
-        vector< vector<ActionState> > actionTable_ ;
-
-        // GOTO table.
-        // For reduce actions,
-        //    new goto state to push = GOTO[ current state ][ nonterminal production symbol ]
-        vector< vector<int> > gotoTable_ ;
-
-        // Error messages.
-        vector< string > errorMessage_ ;
-        
-        // Productions:  Left side non-terminal symbol + production number.
-        vector< Symbol<SymbolType, ValueType> > production_ ;
+        // ACTION, GOTO and error message tables and the productions, shared by all parsers for the grammar.
+        const ParseTables< SymbolType > * tables_ ;
 } ;
 
 
@@ -385,6 +406,30 @@ enum class PolySymbol
     NumSymbols
 } ;
 
+/*=============================================================================
+|
+| NAME
+|
+|     OutputFormat
+|
+| DESCRIPTION
+|
+|     How to write the primitive polynomials we find.
+|
+|         Human       Primitive polynomial modulo 2 of degree 4, then x ^ 4 + x + 1, 2
+|         Compact     One per line:  x^4 + x + 1, 2
+|         JsonLines   One JSON object per line:  {"p":2,"n":4,"coefficients":[1,1,0,0,1]}
+|         HexMask     One tap mask per line, modulo 2 only:  0x13
+|
+|     Compact lines and hex masks can be read back with Primpoly -b.
+|
++============================================================================*/
+
+enum class OutputFormat
+{
+    Human, Compact, JsonLines, HexMask
+} ;
+
 /*=============================================================================
 |
 | NAME
@@ -437,23 +482,35 @@ class PolyParser : public Parser< SymbolType, ValueType >
         // Allow direct access to these command line parameters for convenience.
         bool   testPolynomialForPrimitivity_ ;
         bool   listAllPrimitivePolynomials_ ;
+        bool   aggregate_ ;     // Statistics of all primitive polynomials instead of a list.
+        bool   estimate_ ;      // Cost of the search instead of the search.
         bool   printOperationCount_ ;
+        bool   statisticsJson_ ;  // Print them as JSON.
+        string monitorFile_ ;     // Statistics snapshots during the search, if not empty.
+        string traceFile_ ;       // Timeline of the run, if not empty.
         bool   printHelp_ ;
         bool   slowConfirm_ ;
+        bool   batchTest_ ;
+        string batchFile_ ;    // Empty for the standard input.
+        bool   daemon_ ;
+        string daemonSocket_ ;
+        OutputFormat outputFormat_ ;
+        bool   writeArchive_ ;
+        bool   readArchive_ ;
+        bool   verifyArchive_ ;
+        string archiveFile_ ;
+        ppuint archiveFirst_ ;  // First polynomial to list, and how many.
+        ppuint archiveCount_ ;
+        bool   fullUnitTest_ ;
+        bool   unitTestOnly_ ;
         ppuint p ;
         int    n ;
         Polynomial testPolynomial_ ;
     
-        // Location of the factorization tables.
-        static string factorizationTableLocation_ ;
-    
     private:
         // Parse string into tokens.
-        void tokenize( string sentence ) ;
+        void tokenize( const string & sentence ) ;
         
-        // Fill in the ACTION, GOTO, and ERROR_MESSAGE tables.
-        void initializeTables() ;
-
         // Syntax directed translation.  Reduce using production A -> beta, computing A's value from values of 
         // the tokens in beta.
         void syntaxDirectedTranslation( int productionNum, int topIndex, Symbol<SymbolType,ValueType> & as ) ;
@@ -461,27 +518,70 @@ class PolyParser : public Parser< SymbolType, ValueType >
         // Even though these member variables are declared in the base class as protected, they are not visible in this
         // child class.  Because we have a templated class, we must tell the C++ compiler explicitly that these symbols
         // are from the base class.
-        using Parser<SymbolType, ValueType>::NumStates_ ;
-        using Parser<SymbolType, ValueType>::NumProductions_ ;
-        using Parser<SymbolType, ValueType>::NumTerminals_ ;
-        using Parser<SymbolType, ValueType>::NumNonTerminals_ ;
-
-        using Parser<SymbolType, ValueType>::insertAction ;
-        using Parser<SymbolType, ValueType>::insertGoto ;
-        using Parser<SymbolType, ValueType>::insertProduction ;
-        using Parser<SymbolType, ValueType>::insertErrorMessage ;
-
         using Parser< SymbolType, ValueType >::inputStack_ ;
         using Parser< SymbolType, ValueType >::parseStack_ ;
-        using Parser< SymbolType, ValueType >::actionTable_ ;
-        using Parser< SymbolType, ValueType >::gotoTable_ ;
-        using Parser< SymbolType, ValueType >::errorMessage_ ;
-        using Parser< SymbolType, ValueType >::production_ ;
+        using Parser< SymbolType, ValueType >::tables_ ;
 } ;
 
-// Static member variable needs to be initialized outside of the class declaration.
-template< typename SymbolType, typename ValueType >
-string PolyParser<SymbolType, ValueType>::factorizationTableLocation_  = "" ;
+
+/*=============================================================================
+|
+| NAME
+|
+|     parsePolynomial
+|
+| DESCRIPTION
+|
+|     Fast path for the polynomial grammar.  Scan the characters in
+|     [first, last) once, adding each term straight into the coefficients f
+|     and setting the modulus p, with no tokens, parse stacks or copies of
+|     partial polynomials.  Accepts exactly the sentences PolyParser does
+|     and gives the same value, including p = 0 for the empty string.
+|
+|     Throws the same ParserError as PolyParser:  on any error we hand the
+|     string to PolyParser, which stays the reference implementation.
+|
+| EXAMPLE
+|
+|     string s = "x ^ 1000000 + x ^ 3 + 1, 2" ;
+|     vector<ppuint> f ;
+|     ppuint p ;
+|     parsePolynomial( s.data(), s.data() + s.size(), f, p ) ;
+|     // f.size() == 1000001, f[ 0 ] == f[ 3 ] == f[ 1000000 ] == 1, p == 2
+|
++============================================================================*/
+
+void parsePolynomial( const char * first, const char * last, vector< ppuint > & f, ppuint & p ) ;
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     readPolynomial
+|
+| DESCRIPTION
+|
+|     Read a polynomial in any of our text formats into its coefficients f
+|     and modulus p.  The first characters pick the format:
+|
+|         0x13              Hex tap mask modulo 2.  Bit k is the coefficient
+|                           of x^k, including the bit for x^n, so
+|                           0x13 = x^4 + x + 1, 2.
+|         0b10011           Bit string modulo 2, highest power first, so
+|                           0b10011 = x^4 + x + 1, 2.
+|         (5 1:2 0), 3      Sparse list of exponents, each with an optional
+|                           :coefficient, then an optional modulus which
+|                           defaults to 2, so (5 1:2 0), 3 = x^5 + 2 x + 1, 3.
+|         x^4 + x + 1, 2    Anything else goes to parsePolynomial.
+|
+|     The compact formats allow blanks before and after.  Throws ParserError
+|     if the string is in none of these formats.
+|
++============================================================================*/
+
+void readPolynomial( const char * first, const char * last, vector< ppuint > & f, ppuint & p ) ;
+
 
 
 // --------------- Derived class parsers and their symbols and values ---------
@@ -538,6 +638,10 @@ class FactorizationValue
 		vector< PrimeFactor<IntType> > factor_ ;        // Vector of distinct prime factors to powers.
 } ;
 
+// BigInt numbers convert directly from the string by the subquadratic method.
+template<>
+BigInt FactorizationValue<BigInt>::numberStringToInteger( const string & numberString ) ;
+
 
 /*=============================================================================
  |
@@ -624,11 +728,8 @@ class FactorizationParser : public Parser< SymbolType, ValueType >
         
     private:
         // Parse string into tokens.
-        void tokenize( string sentence ) ;
+        void tokenize( const string & sentence ) ;
         
-        // Fill in the ACTION, GOTO, and ERROR_MESSAGE tables.
-        void initializeTables() ;
-
         // Syntax directed translation.  Reduce using production A -> beta, computing A's value from values of 
         // the tokens in beta.
         void syntaxDirectedTranslation( int productionNum, int topIndex, Symbol<SymbolType,ValueType> & as ) ;
@@ -636,22 +737,9 @@ class FactorizationParser : public Parser< SymbolType, ValueType >
         // Even though these member variables are declared in the base class as protected, they are not visible in this
         // child class.  Because we have a templated class, we must tell the C++ compiler explicitly that these symbols
         // are from the base class.
-        using Parser<SymbolType, ValueType>::NumStates_ ;
-        using Parser<SymbolType, ValueType>::NumProductions_ ;
-        using Parser<SymbolType, ValueType>::NumTerminals_ ;
-        using Parser<SymbolType, ValueType>::NumNonTerminals_ ;
-
-        using Parser<SymbolType, ValueType>::insertAction ;
-        using Parser<SymbolType, ValueType>::insertGoto ;
-        using Parser<SymbolType, ValueType>::insertProduction ;
-        using Parser<SymbolType, ValueType>::insertErrorMessage ;
-
         using Parser< SymbolType, ValueType >::inputStack_ ;
         using Parser< SymbolType, ValueType >::parseStack_ ;
-        using Parser< SymbolType, ValueType >::actionTable_ ;
-        using Parser< SymbolType, ValueType >::gotoTable_ ;
-        using Parser< SymbolType, ValueType >::errorMessage_ ;
-        using Parser< SymbolType, ValueType >::production_ ;
+        using Parser< SymbolType, ValueType >::tables_ ;
 } ;
 
 #endif // __PPPARSER_H__
@@ -0,0 +1,231 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppPerfCounters.cpp
+|
+|  DESCRIPTION
+|
+|     Hardware performance counters of a thread from perf_event_open(),
+|     with a fallback to no counts where we can't open them.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+
+
+/*------------------------------------------------------------------------------
+|                                Includes                                      |
+------------------------------------------------------------------------------*/
+
+#include <cstdlib>      // abort()
+#include <iostream>     // Basic stream I/O.
+#include <new>          // set_new_handler()
+#include <cmath>        // Basic math functions e.g. sqrt()
+#include <limits>       // Numeric limits.
+#include <complex>      // Complex data type and operations.
+#include <fstream>      // File stream I/O.
+#include <sstream>      // String stream I/O.
+#include <vector>       // STL vector class.
+#include <string>       // STL string class.
+#include <algorithm>    // Iterators.
+#include <stdexcept>    // Exceptions.
+#include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <atomic>       // Enabled flag.
+#include <cstring>      // memset(), strerror()
+#include <cerrno>       // errno
+
+#ifdef __linux__
+#include <linux/perf_event.h>   // perf_event_attr
+#include <sys/syscall.h>        // syscall()
+#include <unistd.h>             // read(), close()
+#endif
+
+using namespace std ;   // So we don't need to say std::vector everywhere.
+
+
+
+/*------------------------------------------------------------------------------
+|                                PP Include Files                              |
+------------------------------------------------------------------------------*/
+
+#include "Primpoly.h"       // Global functions.
+#include "ppArith.h"        // Basic arithmetic functions.
+#include "ppBigInt.h"       // Arbitrary precision integer arithmetic.
+#include "ppOperationCount.h"   // OperationCount collection for factoring and poly finding.
+#include "ppPerfCounters.h" // Hardware performance counters.
+
+
+atomic< bool > PerfCounters::enabled_( false ) ;
+
+static const char * const eventName[ static_cast<int>( HardwareEvent::NumEvents ) ] =
+{
+    "cycles", "instructions", "cache misses", "branch misses"
+} ;
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PerfCounters
+ |
+ | DESCRIPTION
+ |
+ |     Open a counter for each event we can count, all in one group so we
+ |     read them together with one system call.  The first one we open leads
+ |     the group.
+ |
+ +============================================================================*/
+
+PerfCounters::PerfCounters()
+    : leader_( -1 )
+    , numCounted_( 0 )
+{
+    fill( fd_, fd_ + numEvents, -1 ) ;
+
+#ifdef __linux__
+    static const ppuint config[ numEvents ] =
+    {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    } ;
+
+    for (int event = 0 ;  event < numEvents ;  ++event)
+    {
+        perf_event_attr attr ;
+        memset( &attr, 0, sizeof( attr ) ) ;
+        attr.size           = sizeof( attr ) ;
+        attr.type           = PERF_TYPE_HARDWARE ;
+        attr.config         = config[ event ] ;
+        attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING ;
+        attr.exclude_kernel = 1 ;
+        attr.exclude_hv     = 1 ;
+
+        // This thread, on any CPU.
+        int fd = static_cast<int>( syscall( SYS_perf_event_open, &attr, 0, -1, leader_, 0 ) ) ;
+        if (fd < 0)
+        {
+            reason_ += (reason_.empty() ? "" : ", ") + string( eventName[ event ] ) + ":  " + strerror( errno ) ;
+            continue ;
+        }
+
+        if (leader_ < 0)
+            leader_ = fd ;
+
+        fd_[ event ] = fd ;
+        order_[ numCounted_++ ] = static_cast<HardwareEvent>( event ) ;
+    }
+#else
+    reason_ = "hardware counters need Linux perf events" ;
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for (int event = 0 ;  event < numEvents ;  ++event)
+        if (fd_[ event ] >= 0)
+            close( fd_[ event ] ) ;
+#endif
+}
+
+PerfCounters & PerfCounters::thisThread()
+{
+    static thread_local PerfCounters counters ;
+    return counters ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PerfCounters::enable
+ |
+ | DESCRIPTION
+ |
+ |     Turn on counting, and open our own thread's counters now so we can
+ |     tell the caller whether they work.
+ |
+ +============================================================================*/
+
+bool PerfCounters::enable()
+{
+    enabled_.store( true, memory_order_relaxed ) ;
+    return thisThread().numCounted_ != 0 ;
+}
+
+void PerfCounters::disable()
+{
+    enabled_.store( false, memory_order_relaxed ) ;
+}
+
+string PerfCounters::unavailableReason()
+{
+    return thisThread().reason_ ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PerfCounters::read
+ |
+ | DESCRIPTION
+ |
+ |     Read the whole group.  With PERF_FORMAT_GROUP we get the number of
+ |     counters, the times the group was enabled and running, then the
+ |     counts in the order we opened them.  If the group never got on the
+ |     hardware, e.g. because other programs use all the counters, the counts
+ |     mean nothing and we leave them out.
+ |
+ +============================================================================*/
+
+HardwareCounts PerfCounters::read()
+{
+    HardwareCounts counts ;
+
+#ifdef __linux__
+    PerfCounters & counters = thisThread() ;
+    if (counters.leader_ < 0)
+        return counts ;
+
+    uint64_t value[ 3 + numEvents ] ;
+    ssize_t numBytes = ::read( counters.leader_, value, sizeof( value ) ) ;
+    if (numBytes < static_cast<ssize_t>( 3 * sizeof( uint64_t ) ) || value[ 2 ] == 0u)
+        return counts ;
+
+    for (int k = 0 ;  k < counters.numCounted_ && k < static_cast<int>( value[ 0 ] ) ;  ++k)
+        counts.set( counters.order_[ k ], value[ 3 + k ] ) ;
+#endif
+
+    return counts ;
+}
@@ -0,0 +1,114 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppPerfCounters.h
+|
+|  DESCRIPTION
+|
+|     Header file for reading the hardware performance counters of a thread,
+|     so we can count cycles, instructions and misses in each stage of
+|     testing a polynomial.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with the !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+// Wrap this header file to prevent duplication if it is included
+// accidentally more than once.
+#ifndef __PP_PERF_COUNTERS_H__
+#define __PP_PERF_COUNTERS_H__
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PerfCounters
+|
+| DESCRIPTION
+|
+|     The hardware performance counters of the calling thread, from the Linux
+|     perf_event_open() system call:  one group counting CPU cycles,
+|     instructions, cache misses and branch mispredictions in user space.
+|
+|     Counting is off until enable() is called, because every reading is a
+|     system call.  Then StageTimer reads the counters at the start and end
+|     of each stage it times.  Each thread opens its own counters the first
+|     time it reads them, and closes them when it exits.
+|
+|     Where we can't count an event, e.g. on other systems, in a virtual
+|     machine without performance counters, or with perf_event_paranoid set
+|     to 3, we leave it out of the HardwareCounts we read.  If we can't count
+|     any, the counts are empty and the program runs as usual.
+|
+| EXAMPLE
+|
+|     if (!PerfCounters::enable())
+|         cout << "No hardware counters:  " << PerfCounters::unavailableReason() << endl ;
+|
+|     HardwareCounts start = PerfCounters::read() ;
+|     f.hasLinearFactor() ;
+|     HardwareCounts used = PerfCounters::read() - start ;
+|
++============================================================================*/
+
+class PerfCounters
+{
+    public:
+        // Turn on counting for all threads.  Return false if the calling thread can't count any event.
+        static bool enable() ;
+
+        static void disable() ;
+
+        static inline bool enabled() { return enabled_.load( memory_order_relaxed ) ; } ;
+
+        // Why the calling thread can't count some events, or empty if it can count them all.
+        static string unavailableReason() ;
+
+        // The counts of the calling thread so far.
+        static HardwareCounts read() ;
+
+        ~PerfCounters() ;
+
+    private:
+        PerfCounters() ;
+        PerfCounters( const PerfCounters & ) = delete ;
+        PerfCounters & operator=( const PerfCounters & ) = delete ;
+
+        static PerfCounters & thisThread() ;
+
+        static const int numEvents = static_cast<int>( HardwareEvent::NumEvents ) ;
+
+        int           leader_ ;                 // File descriptor of the group, or -1.
+        int           fd_[ numEvents ] ;        // For each event, or -1 if we can't count it.
+        HardwareEvent order_[ numEvents ] ;     // The events we count, in the order we read them.
+        int           numCounted_ ;
+        string        reason_ ;
+
+        static atomic< bool > enabled_ ;
+} ;
+
+#endif // __PP_PERF_COUNTERS_H__ -- End of wrapper for header file.
@@ -51,6 +51,9 @@
 #include <algorithm>    // Iterators.
 #include <stdexcept>    // Exceptions.
 #include <cassert>      // assert()
+#include <limits>       // numeric_limits
+#include <memory>       // shared_ptr
+#include <atomic>       // Trace enabled flag.
 
 using namespace std ;
 
@@ -67,6 +70,7 @@ using namespace std ;
 #include "ppFactor.h"         // Prime factorization and Euler Phi.
 #include "ppPolynomial.h"     // Polynomial operations and mod polynomial operations.
 #include "ppParser.h"         // Parsing of polynomials and I/O services.
+#include "ppTrace.h"          // Timeline tracing.
 #include "ppUnitTest.h"       // Complete unit test.
 
 
@@ -192,6 +196,32 @@ Polynomial::Polynomial( const Polynomial & g )
 
 
 
+/*=============================================================================
+|
+| NAME
+|
+|     Polynomial
+|
+| DESCRIPTION
+|
+|     Move constructor.  Takes over the coefficients of g, leaving g empty.
+|
+| EXAMPLE
+|
+|     Polynomial f( g + h ) ;
+|
++============================================================================*/
+
+Polynomial::Polynomial( Polynomial && g ) noexcept
+                : f_( std::move( g.f_ ) )
+                , n_( g.n_ )
+                , p_( g.p_ )
+                , mod( p_ )
+{
+}
+
+
+
 /*=============================================================================
 |
 | NAME
@@ -230,7 +260,7 @@ Polynomial & Polynomial::operator=( const Polynomial & g )
     p_ = g.p_ ;
 
     // And the modulus functionoid.
-    mod( g.p_ ) ;
+    mod.set( g.p_ ) ;
 
     // Overwrite the old polynomial coefficients in f_ with the new coefficients in g.f_:
     //   1) Delete the old polynomial coefficients, i.e. destruct the vector valued member variable f_.
@@ -263,6 +293,34 @@ Polynomial & Polynomial::operator=( const Polynomial & g )
 
 
 
+/*=============================================================================
+|
+| NAME
+|
+|     Polynomial::operator=( Polynomial && )
+|
+| DESCRIPTION
+|
+|     Move assigment operator for polynomials, f( x ) = g( x ) + h( x ).
+|     Takes over the coefficients of g;  nothing is allocated so nothing can throw.
+|
++============================================================================*/
+
+Polynomial & Polynomial::operator=( Polynomial && g ) noexcept
+{
+    if (this == &g)
+        return *this ;
+
+    n_ = g.n_ ;
+    p_ = g.p_ ;
+    mod.set( g.p_ ) ;
+    f_ = std::move( g.f_ ) ;
+
+    return *this ;
+}
+
+
+
 /*=============================================================================
 |
 | NAME
@@ -341,7 +399,7 @@ Polynomial & Polynomial::operator=( string s )
  , p_( 2 )
 +============================================================================*/
 
-Polynomial::Polynomial( string s, ppuint p )
+Polynomial::Polynomial( const string & s, ppuint p )
                 : f_()
                 , mod( 0 )
                 , n_( 0 )
@@ -353,13 +411,13 @@ Polynomial::Polynomial( string s, ppuint p )
 
     try
     {
-        // Initialize an LALR(1) parser for polynomials.
-        PolyParser< PolySymbol, PolyValue > pp ;
-
-        PolyValue v = pp.parse( s ) ;
+        // Parse straight into our coefficients.  Besides the usual x^4 + x + 1, 2 we
+        // accept the compact formats, e.g. 0x13 and (4 1 0).
+        ppuint modulus = 0 ;
+        readPolynomial( s.data(), s.data() + s.size(), f_, modulus ) ;
 
         // Get the modulus specified by the polynomial.
-        p_ = v.scalar_ ;
+        p_ = modulus ;
 
         // If the modulus is explicitly input, use that instead of the polynomial's modulus.
         if (p > 0)
@@ -377,7 +435,7 @@ Polynomial::Polynomial( string s, ppuint p )
         mod.set( p_ ) ;
 
         // Sanity check the degree of the polynomial.
-        n_ = static_cast<int>( v.f_.size() ) - 1 ;
+        n_ = static_cast<int>( f_.size() ) - 1 ;
         if (n_ < 0)
         {
             ostringstream os ;
@@ -386,12 +444,8 @@ Polynomial::Polynomial( string s, ppuint p )
         }
 
         // Reduce all the (positive) polynomial coefficients modulo p.
-        vector< ppuint >::iterator i ;
-        for (i = v.f_.begin() ;  i != v.f_.end() ;  ++i)
-            *i = mod( *i ) ;
-
-        // Copy over the polynomial coefficients.
-        f_ = v.f_ ;
+        for (auto & coeff : f_)
+            coeff = mod( coeff ) ;
     }
     catch( ParserError & e )
     {
@@ -877,13 +931,12 @@ Polynomial & Polynomial::operator+=( const Polynomial & g )
 |
 +============================================================================*/
 
-const Polynomial operator+( const Polynomial & f, const Polynomial &g )
+Polynomial operator+( Polynomial f, const Polynomial &g )
 {
     // Do + in terms of += to maintain consistency.
-    // Copy construct temporary copy, then add to it.
-    // Return value optimization compiles away the copy constructor.
-    // const on return type disallows doing (u+v) = w ;
-    return Polynomial( f ) += g ;
+    // f is already our own copy, or a moved in temporary, so add to it and return it.
+    f += g ;
+    return f ;
 }
 
 /*=============================================================================
@@ -921,13 +974,12 @@ Polynomial & Polynomial::operator*=( const ppuint k )
 |
 +============================================================================*/
 
-const Polynomial operator*( const Polynomial & f, const ppuint k )
+Polynomial operator*( Polynomial f, const ppuint k )
 {
     // Do * in terms of *= to maintain consistency.
-    // Copy construct temporary copy, then add to it.
-    // Return value optimization compiles away the copy constructor.
-    // const on return type disallows doing (u*k) = w ;
-    return Polynomial( f ) *= k ;
+    // f is already our own copy, or a moved in temporary, so multiply it and return it.
+    f *= k ;
+    return f ;
 }
 
 
@@ -1385,6 +1437,28 @@ PolyMod::PolyMod( const PolyMod & g2 )
 
 
 
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyMod move constructor
+ |
+ | DESCRIPTION
+ |
+ |     Move g2 to g( x ) mod (f( x ), p)
+ |
+ +============================================================================*/
+
+PolyMod::PolyMod( PolyMod && g2 ) noexcept
+         : g_( std::move( g2.g_ ) )
+         , f_( std::move( g2.f_ ) )
+         , powerTable_( std::move( g2.powerTable_ ) )
+         , mod( f_.modulus() )
+{
+}
+
+
+
 /*=============================================================================
  |
  | NAME
@@ -1404,7 +1478,7 @@ PolyMod & PolyMod::operator=( const PolyMod & g2 )
         return *this ;
 
     g_ = g2.g_ ;
-    g_ = g2.f_ ;
+    f_ = g2.f_ ;
 
     powerTable_ = g2.powerTable_ ;
     mod = g2.mod ;
@@ -1414,6 +1488,34 @@ PolyMod & PolyMod::operator=( const PolyMod & g2 )
 }
 
 
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     operator=( PolyMod && )
+ |
+ | DESCRIPTION
+ |
+ |     PolyMod move assignment operator.
+ |
+ +============================================================================*/
+
+PolyMod & PolyMod::operator=( PolyMod && g2 ) noexcept
+{
+    if (this == &g2)
+        return *this ;
+
+    g_ = std::move( g2.g_ ) ;
+    f_ = std::move( g2.f_ ) ;
+
+    powerTable_ = std::move( g2.powerTable_ ) ;
+    mod = g2.mod ;
+
+    return *this ;
+}
+
+
 /*=============================================================================
  |
  | NAME
@@ -1503,8 +1605,8 @@ PolyMod::constructPowerTable()
     // Get hold of the degree of f(x).
     int n = f_.deg() ;
 
-    // Empty the power table.
-    powerTable_.clear() ;
+    // Build a new power table.
+    vector< Polynomial > powerTable ;
 
     //
     //  t(x) is temporary storage for x ^ k (mod f(x),p)
@@ -1564,7 +1666,7 @@ PolyMod::constructPowerTable()
 			}  // end if
 
 			//  Copy t(x) into row i of power_table.
-			powerTable_.push_back( t ) ;
+			powerTable.push_back( t ) ;
 
 		} // end for
 
@@ -1572,8 +1674,10 @@ PolyMod::constructPowerTable()
 			cout << "PowerTable of polynomials x^n ... x^2n-2 mod f(x), p" << endl ;
 			cout << "f(x) = " << getf() << " n = " << n << " p = " << getModulus() << endl ;
 			for  (int i = n ;  i <= 2*n-2 ;  ++i)
-				cout << "powerTable[ x^" << i << " ] = " << powerTable_[ offset(i) ] << endl ;
+				cout << "powerTable[ x^" << i << " ] = " << powerTable[ offset(i) ] << endl ;
 		#endif
+
+        powerTable_ = make_shared< const vector< Polynomial > >( std::move( powerTable ) ) ;
     }
     catch( bad_alloc & e )
     {
@@ -1643,7 +1747,7 @@ PolyMod::modf()
 
             //          i       i
             // Replace x  with x  (mod f(x), p) from the power table * coeff.
-            g_ += (powerTable_[ offset(i) ] * coeff) ;
+            g_ += ((*powerTable_)[ offset(i) ] * coeff) ;
          }
 
          #ifdef DEBUG_PP_POLYNOMIAL
@@ -2118,13 +2222,13 @@ ppuint coeffOfProduct( const Polynomial & s, const Polynomial & t, const int k,
  |
  +============================================================================*/
 
-const PolyMod operator*( const PolyMod & s,
-                         const PolyMod & t )
+PolyMod operator*( PolyMod s,
+                   const PolyMod & t )
 {
     // Do * in terms of *= to maintain consistency.
-    // Return value optimization compiles away the copy constructor.
-    // const on return type disallows doing (u*v) = w ;
-    return PolyMod( s ) *= t ;
+    // s is already our own copy, or a moved in temporary, so multiply it and return it.
+    s *= t ;
+    return s ;
 }
 
 /*=============================================================================
@@ -2144,12 +2248,13 @@ PolyMod::operator*=( const PolyMod & t )
     int i, j ;   //                 k             2
     ppuint coeff;  // Coefficient of x  term of t(x)
 
-    // Temporary storage for the new t(x).  Can have degree up to n.
-    Polynomial temp ;
-
     // Get hold of the degree of f(x).
     int n = f_.deg() ;
 
+    // Temporary storage for the new t(x).  Can have degree up to n.
+    // Size it once rather than growing a Polynomial a coefficient at a time.
+    vector<ppuint> temp( n + 1 ) ;
+
     //                               0        n-1
     //  Compute the coefficients of x , ..., x.   These terms do not require
     //  reduction mod f(x) because their degree is less than n.
@@ -2167,7 +2272,7 @@ PolyMod::operator*=( const PolyMod & t )
         if ( (coeff = coeffOfProduct( g_, t.g_, i, n)) != 0 )
             for (j = 0 ;  j <= n - 1 ;  ++j)
                 temp[ j ] = mod( temp[ j ] +
-                                 mod( coeff * powerTable_[ offset(i) ] [ j ])) ;
+                                 mod( coeff * (*powerTable_)[ offset(i) ] [ j ])) ;
 
     for (i = 0 ;  i <= n - 1 ;  ++i)
         g_[ i ] = temp[ i ] ;
@@ -2253,7 +2358,7 @@ void PolyMod::timesX()
     {
         for (int i = 0 ;  i <= n - 1 ;  ++i)
             g_[ i ] = mod( g_[ i ] +
-                           mod( g_coeff * powerTable_[ offset(n) ] [ i ] )) ;
+                           mod( g_coeff * (*powerTable_)[ offset(n) ] [ i ] )) ;
     }
 
     #ifdef DEBUG_PP_POLYNOMIAL
@@ -2332,7 +2437,8 @@ PolyMod::square()
     #endif
 
     // Temporary storage for the new g(x).  Can have degree up to n.
-    Polynomial t ;
+    // Size it once rather than growing a Polynomial a coefficient at a time.
+    vector<ppuint> t( n + 1 ) ;
 
     //                               0        n-1
     //  Compute the coefficients of x , ..., x.   These terms do not require
@@ -2355,7 +2461,7 @@ PolyMod::square()
 
             for (int j = 0 ;  j <= n- 1 ;  ++j)
 
-                t[ j ] = mod( t[ j ] + mod( coeff * powerTable_[ offset(i) ] [ j ])) ;
+                t[ j ] = mod( t[ j ] + mod( coeff * (*powerTable_)[ offset(i) ] [ j ])) ;
     }
 
     for (int i = 0 ;  i <= n - 1 ;  ++i)
@@ -2488,14 +2594,37 @@ PolyMod::square()
  |
  +============================================================================*/
 
-const PolyMod power( const PolyMod & g1, const BigInt & m )
+// Bit access for BigInt and single precision exponents, so one exponentiation loop serves both.
+static inline int exponentMaxBitNumber( const BigInt & m )
+{
+    return m.maxBitNumber() ;
+}
+
+static inline int exponentMaxBitNumber( const ppuint m )
+{
+    return 8 * sizeof( ppuint ) - 1 ;
+}
+
+static inline bool exponentTestBit( const BigInt & m, const int bitNum )
+{
+    return m.testBit( bitNum ) ;
+}
+
+static inline bool exponentTestBit( const ppuint m, const int bitNum )
+{
+    return testBit( m, bitNum ) ;
+}
+
+template <typename IntType>
+static PolyMod powerBySquaring( const PolyMod & g1, const IntType & m )
 {
     // Return if g(x) != x
-    if (g1.f_.deg() == 1 && g1[ 0 ] == 0 && g1[ 1 ] == 1)
+    int degF = g1.getf().deg() ;
+    if (degF == 1 && g1[ 0 ] == 0 && g1[ 1 ] == 1)
     {
         ostringstream os ;
         os << "Error in PolyMod::power():  g( x ) != x "
-           << "with deg g = " << g1.f_.deg() << " m = " << m
+           << "with deg g = " << degF << " m = " << m
            << " at " << __FILE__ << ": line " << __LINE__ ;
         throw PolynomialRangeError( os.str() ) ;
     }
@@ -2503,18 +2632,18 @@ const PolyMod power( const PolyMod & g1, const BigInt & m )
     // Exit right away if m = 1 and return a copy of g(x).
     PolyMod g( g1 ) ;
 
-    if (m == static_cast<BigInt>( 1u ))
+    if (m == static_cast<IntType>( 1u ))
         return g ;
 
     // Find the number of the leading bit.
-    int bitNum = m.maxBitNumber() ; // Number of highest possible bit.
+    int bitNum = exponentMaxBitNumber( m ) ; // Number of highest possible bit.
 
     #ifdef DEBUG_PP_POLYNOMIAL
     cout << "initial max bitNum = " << bitNum << endl ;
     cout << "g( x ) = " << g << endl ;
     #endif
 
-    while (!m.testBit( bitNum ))
+    while (bitNum >= 0 && !exponentTestBit( m, bitNum ))
         --bitNum ;
 
     #ifdef DEBUG_PP_POLYNOMIAL
@@ -2540,12 +2669,12 @@ const PolyMod power( const PolyMod & g1, const BigInt & m )
     {
         g.square() ;
 
-        if (m.testBit( bitNum ))
+        if (exponentTestBit( m, bitNum ))
            g.timesX() ;
 
         #ifdef DEBUG_PP_POLYNOMIAL
         cout << "S " ;
-        if (m.testBit( bitNum ))
+        if (exponentTestBit( m, bitNum ))
             cout << "X " ;
         cout << "Bit num = " << bitNum << " g( x ) = " << g << endl ;
         #endif
@@ -2558,6 +2687,16 @@ const PolyMod power( const PolyMod & g1, const BigInt & m )
     return g ;
 }
 
+PolyMod power( const PolyMod & g1, const BigInt & m )
+{
+    return powerBySquaring( g1, m ) ;
+}
+
+PolyMod power( const PolyMod & g1, const ppuint m )
+{
+    return powerBySquaring( g1, m ) ;
+}
+
 
 
 /*=============================================================================
@@ -2623,6 +2762,8 @@ PolyOrder::PolyOrder( const Polynomial & f )
              , r_( 0 )
              , a_( 0 )
              , factorsOfR_( 1 )
+             , nativeExponents_( false )
+             , rNative_( 0 )
              , Q_( 0 )
              , p_( f.modulus() )
              , n_( f.deg() )
@@ -2638,8 +2779,12 @@ PolyOrder::PolyOrder( const Polynomial & f )
     //              p - 1
     //                                             n
     // the number of primitive polynomials = Phi( p - 1 ) / n
+    LatencyHistogram factoringTime ;
+    HardwareCounts   factoringEvents ;
     try
     {
+        PP_TRACE_SCOPE( "factor r", "setup" ) ;
+        StageTimer timer( factoringTime, &factoringEvents ) ;
         factorRAndFindNumberOfPrimitivePolynomials( p_, n_, maxNumPoly_, r_, factorsOfR_, numPrimPoly_ ) ;
     }
     catch( BigIntMathError & e )
@@ -2652,6 +2797,91 @@ PolyOrder::PolyOrder( const Polynomial & f )
        throw PolynomialRangeError( os.str() ) ;
     }
 
+    precompute() ;
+    statistics_.factoringTime   = factoringTime ;
+    statistics_.factoringEvents = factoringEvents ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PolyOrder()
+ |
+ | DESCRIPTION
+ |
+ |     Initialize with the factors of r we were given.
+ |
+ +============================================================================*/
+
+PolyOrder::PolyOrder( const Polynomial & f, const Factorization<BigInt> & factorsOfR )
+             : f_( f )
+             , r_( 0 )
+             , a_( 0 )
+             , factorsOfR_( factorsOfR )
+             , nativeExponents_( false )
+             , rNative_( 0 )
+             , Q_( 0 )
+             , p_( f.modulus() )
+             , n_( f.deg() )
+             , mod( f.modulus() )
+             , statistics_()
+             , numPrimPoly_( 0 )
+             , maxNumPoly_( 0 )
+{
+    try
+    {
+        maxNumPoly_ = power( p_, n_ ) ;
+        r_ = (maxNumPoly_ - static_cast<BigInt>( 1u )) / (p_ - 1u) ;
+    }
+    catch( BigIntMathError & e )
+    {
+        ostringstream os ;
+        os << "PolyOrder: problem computing p^n or r = (p^n - 1 )/ (p - 1) "
+           << " p = " << p_ << " n = " << n_
+           << " at " << __FILE__ << ": line " << __LINE__
+           << e.what() ;
+       throw PolynomialRangeError( os.str() ) ;
+    }
+
+    precompute() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     precompute
+ |
+ | DESCRIPTION
+ |
+ |     Once we have r and its factors, work out what testing each polynomial
+ |     needs, and copy the statistics of factoring.
+ |
+ +============================================================================*/
+
+void PolyOrder::precompute()
+{
+    // Precompute the exponents for the order m test once, instead of dividing r
+    // by its prime factors for every polynomial we test.  Keep single precision
+    // copies if r fits:  most of the time p^n - 1 has no more than 64 bits.
+    for (int i = 0 ;  i < static_cast<int>( factorsOfR_.num_distinct_factors() ) ;  ++i)
+        if (!factorsOfR_.skip_test( p_, i ))
+            m_.push_back( r_ / factorsOfR_.prime_factor( i ) ) ;
+
+    if (r_ <= static_cast<BigInt>( numeric_limits<ppuint>::max() ))
+    {
+        nativeExponents_ = true ;
+        rNative_ = static_cast<ppuint>( r_ ) ;
+
+        for (auto & m : m_)
+            mNative_.push_back( static_cast<ppuint>( m ) ) ;
+    }
+
     // Copy the factoring statistics, and others.
     statistics_ = factorsOfR_.statistics_ ;
     statistics_.p = p_ ;
@@ -2726,31 +2956,22 @@ PolyOrder::PolyOrder( const Polynomial & f )
 
 bool PolyOrder::order_m()
 {
-    ppuint p = f_.modulus() ;
+    Polynomial x1( "x" ) ;
+    x1.setModulus( p_ ) ;
+    PolyMod x( x1, f_ ) ;
 
-    for (int i = 0 ;  i < factorsOfR_.num_distinct_factors() ;  ++i)
+    for (size_t i = 0 ;  i < m_.size() ;  ++i)
     {
-        // Can we skip this order m test?
-        if (!factorsOfR_.skip_test( p, i ))
-        {
-            BigInt m = r_ / factorsOfR_.prime_factor( i ) ;
-
-            Polynomial x1( "x" ) ;
-            x1.setModulus( p ) ;
-            PolyMod x( x1, f_ ) ;
+        PolyMod x_to_m = nativeExponents_ ? power( x, mNative_[ i ] ) : power( x, m_[ i ] ) ;
 
-            PolyMod x_to_m = power( x, m ) ;
-
-            #ifdef DEBUG_PP_POLYNOMIAL
-            cout << "Prime factor p[ " << i << " ] = " << factorsOfR_.prime_factor( i ) << endl ;
-            cout << "m = " << m << endl ;
-            cout << "x^m = " << x_to_m << endl ;
-            #endif
+        #ifdef DEBUG_PP_POLYNOMIAL
+        cout << "m = " << m_[ i ] << endl ;
+        cout << "x^m = " << x_to_m << endl ;
+        #endif
 
-            // Early out.
-            if (x_to_m.isInteger())
-                return( false ) ;
-        }
+        // Early out.
+        if (x_to_m.isInteger())
+            return( false ) ;
     }
 
     return( true ) ;
@@ -2798,7 +3019,7 @@ ppuint PolyOrder::order_r()
     Polynomial x1( "x", p_ ) ;
     PolyMod x( x1, f_ ) ;
 
-    PolyMod x_to_r = power( x, r_ ) ;
+    PolyMod x_to_r = nativeExponents_ ? power( x, rNative_ ) : power( x, r_ ) ;
 
     #ifdef DEBUG_PP_POLYNOMIAL
     cout << "r = " << r_ << endl ;
@@ -2934,15 +3155,23 @@ bool PolyOrder::maximal_order()
  |
  +============================================================================*/
 
-bool PolyOrder::hasMultipleDistinctFactors( bool earlyOut )
+bool PolyOrder::hasMultipleDistinctFactors( bool earlyOut, int numRows )
 
 {
     // Generate the Q-I matrix.
-    generate_Q_matrix() ;
+    {
+        PP_TRACE_SCOPE( "q_matrix", "stage" ) ;
+        StageTimer timer( statistics_.stageTime( PolyOrderStage::QMatrix ), &statistics_.stageEvents( PolyOrderStage::QMatrix ) ) ;
+        generate_Q_matrix( numRows ) ;
+    }
 
 
     // Find nullity of Q-I
-    findNullity( earlyOut ) ;
+    {
+        PP_TRACE_SCOPE( "nullity", "stage" ) ;
+        StageTimer timer( statistics_.stageTime( PolyOrderStage::Nullity ), &statistics_.stageEvents( PolyOrderStage::Nullity ) ) ;
+        findNullity( earlyOut, numRows ) ;
+    }
 
 
     // If nullity_ >= 2, f( x ) is a reducible polynomial modulo p since it has
@@ -2960,102 +3189,19 @@ bool PolyOrder::hasMultipleDistinctFactors( bool earlyOut )
 
 
 
-/*=============================================================================
- |
- | NAME
- |
- |    findPrimitivePolynomial
- |
- | DESCRIPTION
- |
- |     Find a "random" primitive polynomial.
- |
- +============================================================================*/
-
-Polynomial
-findPrimitivePolynomial( ppuint p, int n,
-                         bool printOperationCount, bool listAllPrimitivePolynomials, bool slowConfirm )
+// Names of the stages on the trace timeline.
+static const char * const traceStageName[ static_cast<int>( PolyOrderStage::NumStages ) ] =
 {
-    //
-    //   Generate and test all possible n th degree, monic, modulo p polynomials
-    //   f(x).  A polynomial is primitive if passes all the tests successfully.
-    //
-
-    //                       n
-    //   Initialize f(x) to x  + (-1).  Then, when f(x) passes through function
-    //                                                                        n
-    //   next_trial_poly for the first time, it will have the correct value, x
-    Polynomial f ;
-    f.initial_trial_poly( n, p ) ;
-
-    bool is_primitive_poly = false ;
-    bool tried_all_poly    = false ;
-    bool stopTesting       = false ;
-
-    BigInt num_poly( 0u ) ;
-    BigInt numPrimitivePoly( 0u ) ;
-    PolyOrder order( f ) ;
+    "const_coeff", "linear_factor", "q_matrix", "nullity", "order_r", "order_m"
+} ;
 
-    if (listAllPrimitivePolynomials)
-        cout << "\n\nThere are " << order.getNumPrimPoly() << " primitive polynomials modulo " << f.modulus() << " of degree " << f.deg() << "\n\n" ;
-
-    do {
-        f.next_trial_poly() ;      // Try next polynomal in sequence.
-        ++num_poly ;
-        
-        #ifdef DEBUG_PP_POLYNOMIAL
-        cout << "Testing polynomial # " << num_poly << ") p(x) = modulo " << f.modulus() << " for primitivity" << endl ;
-        #endif // DEBUG_PP_POLYNOMIAL
-
-        order.newPolynomial( f ) ;
-        is_primitive_poly = order.isPrimitive() ;
-
-        if (is_primitive_poly)
-        {
-            ++numPrimitivePoly ;
-            cout << "\n\nPrimitive polynomial modulo " << f.modulus() << " of degree " << f.deg() << "\n\n" ;
-            cout << f ;
-            cout << endl << endl ;
-
-            // Do a very slow maximal order test for primitivity.
-            if (slowConfirm)
-            {
-                cout << confirmWarning ;
-                if (order.maximal_order())
-                    cout << f << " confirmed primitive!" << endl ;
-                else
-                {
-                    ostringstream os ;
-                    os << "Fast test says " << f << " is a primitive polynomial but slow test disagrees.\n"
-                       << " at " << __FILE__ << ": line " << __LINE__ ;
-                    throw PolynomialError( os.str() ) ;
-                }
-            }
-
-            // Early out if we've found all the primitive polynomials.
-            if (numPrimitivePoly >= order.getNumPrimPoly())
-                break ;
-        }
-
-        tried_all_poly = (num_poly >= order.getMaxNumPoly()) ;
-        stopTesting = tried_all_poly || (!listAllPrimitivePolynomials && is_primitive_poly) ;
-
-    } while( !stopTesting ) ;
-
-    if (printOperationCount)
-        cout << order.statistics_ << endl ;
-
-    // Didn't find a primitive polynomial in the find-only-one-primitive-polynomial case, which is an error.
-    if (!listAllPrimitivePolynomials && !is_primitive_poly)
-    {
-        ostringstream os ;
-        os << "Tested all " << order.getMaxNumPoly() << " possible polynomials, but\n"
-           << "failed to find a primitive polynomial.\n"
-           << " at " << __FILE__ << ": line " << __LINE__ ;
-        throw PolynomialError( os.str() ) ;
-    }
-
-    return f ;
+// Run test(), adding the time it takes and its hardware events to the stage's statistics.
+template< typename Test >
+static auto timeStage( OperationCount & statistics, PolyOrderStage stage, Test test ) -> decltype( test() )
+{
+    PP_TRACE_SCOPE( traceStageName[ static_cast<int>( stage ) ], "stage" ) ;
+    StageTimer timer( statistics.stageTime( stage ), &statistics.stageEvents( stage ) ) ;
+    return test() ;
 }
 
 
@@ -3079,11 +3225,11 @@ bool PolyOrder::isPrimitive()
 
     try
     {
-        BigInt maxNumPossiblePoly = power( p_, n_ ) ;
         ArithModP modp( p_ ) ;
 
         // Constant coefficient of f(x) * (-1)^n must be a primitive root of p.
-        if (modp.const_coeff_is_primitive_root( f_[0], f_.deg() ))
+        if (timeStage( statistics_, PolyOrderStage::ConstantCoeff,
+                       [&]() { return modp.const_coeff_is_primitive_root( f_[0], f_.deg() ) ; } ))
         {
             ++statistics_.numConstantCoeffIsPrimitiveRoot ;
 
@@ -3092,7 +3238,7 @@ bool PolyOrder::isPrimitive()
             #endif
 
             // f(x) can't have any linear factors.
-            if (!f_.hasLinearFactor())
+            if (!timeStage( statistics_, PolyOrderStage::LinearFactor, [this]() { return f_.hasLinearFactor() ; } ))
             {
                 ++statistics_.numFreeOfLinearFactors ;
 
@@ -3113,7 +3259,7 @@ bool PolyOrder::isPrimitive()
 
                     //  r
                     // x  (mod f(x), p) = a_ must be an integer.
-                    ppuint a = order_r() ;
+                    ppuint a = timeStage( statistics_, PolyOrderStage::OrderR, [this]() { return order_r() ; } ) ;
                     if (a != 0)
                     {
                         ++statistics_.numOrderR ;
@@ -3134,7 +3280,7 @@ bool PolyOrder::isPrimitive()
                              #endif
 
                              //  x^m != integer for all m = r / q, q a prime divisor of r.
-                             if (order_m())
+                             if (timeStage( statistics_, PolyOrderStage::OrderM, [this]() { return order_m() ; } ))
                              {
                                  ++statistics_.numOrderM ;
 
@@ -3211,12 +3357,14 @@ bool PolyOrder::isPrimitive()
  |
  +============================================================================*/
 
-void PolyOrder::generate_Q_matrix()
+void PolyOrder::generate_Q_matrix( int numRows )
 {
     // Check for invalid inputs.
     if (n_ < 2 || p_ < 2)
         throw PolynomialRangeError( "generate Q matrix has n < 2 or p < 2" ) ;
 
+    int lastRow = (numRows > 0 && numRows < n_) ? numRows : n_ ;
+
 
     // Row 0 of Q = (1 0 ... 0).
     Q_[ 0 ][ 0 ] = 1 ;
@@ -3229,7 +3377,7 @@ void PolyOrder::generate_Q_matrix()
     // and Q[ 1 ] = coefficients of q(x).
     Polynomial x1( "x", p_ ) ;
     PolyMod x( x1, f_ ) ;
-    PolyMod xp = power( x, static_cast< BigInt >( p_ ) ) ;
+    PolyMod xp = power( x, p_ ) ;
 
     #ifdef DEBUG_PP_POLYNOMIAL
         cout << "x ^ p (mod f(x),p) = " << xp << endl ;
@@ -3246,7 +3394,7 @@ void PolyOrder::generate_Q_matrix()
     // Row k of Q = x   (mod f(x), p) 2 <= k <= n-1, computed by
     //                                   p
     // multiplying each previous row by x (mod f(x),p).
-    for (int k = 2 ;  k <= n_- 1 ;  ++k)
+    for (int k = 2 ;  k <= lastRow - 1 ;  ++k)
     {
         q *= xp ;
 
@@ -3263,7 +3411,7 @@ void PolyOrder::generate_Q_matrix()
     #endif
 
     //  Subtract Q - I
-    for (int row = 0 ;  row < n_ ;  ++row)
+    for (int row = 0 ;  row < lastRow ;  ++row)
     {
         Q_[ row ][ row ] = mod( Q_[ row ][ row ] - 1 ) ;
     }
@@ -3402,7 +3550,7 @@ string PolyOrder::printQMatrix() const
  |
  +============================================================================*/
 
-void PolyOrder::findNullity( bool earlyOut )
+void PolyOrder::findNullity( bool earlyOut, int numRows )
 {
     try
     {
@@ -3418,7 +3566,8 @@ void PolyOrder::findNullity( bool earlyOut )
         int pivotCol = -1 ; // No pivots yet.
 
         // Sweep through each row.
-        for (int row = 0 ;  row < n_ ;  ++row)
+        int lastRow = (numRows > 0 && numRows < n_) ? numRows : n_ ;
+        for (int row = 0 ;  row < lastRow ;  ++row)
         {
             // Search for a pivot in this row:  a non-zero element
             // in a column which had no previous pivot.
@@ -154,8 +154,14 @@ class Polynomial
         // Copy constructor.
         Polynomial( const Polynomial & g ) ;
 
+        // Move constructor.
+        Polynomial( Polynomial && g ) noexcept ;
+
         // Assignment.
         virtual Polynomial & operator=( const Polynomial & g ) ;
+
+        // Move assignment.
+        virtual Polynomial & operator=( Polynomial && g ) noexcept ;
                                   
         // String to polynomial assignment.
         virtual Polynomial & operator=( string s ) ;
@@ -164,7 +170,7 @@ class Polynomial
         // Polynomial p( "x^2 + 2 x + 1, 3" ) ;
 		// If modulus isn't specified, use the one in specified in the
 		// polynomial string.
-        Polynomial( string s, ppuint p = 0 ) ;
+        Polynomial( const string & s, ppuint p = 0 ) ;
 		
         // Operator casting to string type.
         operator string() const ;
@@ -195,14 +201,15 @@ class Polynomial
         void setModulus( const ppuint p ) ;
 
         // Addition modulo p:  f(x) + g(x) mod p
-        friend const Polynomial operator+( const Polynomial & f, const Polynomial & g ) ;
+        // f is taken by value so a temporary left operand is moved in, not copied.
+        friend Polynomial operator+( Polynomial f, const Polynomial & g ) ;
 
         // Addition.
         Polynomial & operator+=( const Polynomial & g ) ;
 					  
         // Scalar multiple.
-		friend const Polynomial
-		   operator*( const Polynomial & f, const ppuint k ) ;
+		friend Polynomial
+		   operator*( Polynomial f, const ppuint k ) ;
 			   
         Polynomial & operator*=( const ppuint k ) ;
 
@@ -309,12 +316,18 @@ class PolyMod
          // cout << p prints g(x) to output stream
         friend ostream & operator<<( ostream & out, const PolyMod & p ) ;
 
-        // Copy g( x ) = g2( x ).
+        // Copy g( x ) = g2( x ).  The copy shares the power table of g2.
         PolyMod( const PolyMod & g2 ) ;
 
+        // Move g( x ) = g2( x ).
+        PolyMod( PolyMod && g2 ) noexcept ;
+
         // Assign g( x ) = g2( x ) 
         virtual PolyMod & operator=( const PolyMod & g2 ) ;
 
+        // Move assign g( x ) = g2( x ) 
+        virtual PolyMod & operator=( PolyMod && g2 ) noexcept ;
+
         // Bounds checked indexing operator for read only access:
         // coeff = p[ i ] ;
         const ppuint operator[]( int i ) const ;
@@ -330,11 +343,14 @@ class PolyMod
         PolyMod & operator*=( const PolyMod & g2 ) ;
 
         // Multiplication:  g(x) := s(x) t(x) (mod f( x ), p)
-        friend const PolyMod operator*( const PolyMod & s, const PolyMod & t ) ;
+        friend PolyMod operator*( PolyMod s, const PolyMod & t ) ;
 
         // Special exponentiation:  g(x) ^ m (mod f(x), p)
 		// for g(x) = x only for now!
-        friend const PolyMod power( const PolyMod & g, const BigInt & m ) ;
+        friend PolyMod power( const PolyMod & g, const BigInt & m ) ;
+
+        // Same, but for an exponent which fits into a single precision integer.
+        friend PolyMod power( const PolyMod & g, const ppuint m ) ;
 
         bool isInteger() const ;
 		
@@ -361,7 +377,9 @@ class PolyMod
         //                          n+i
         //      powerTable_[ i ] = x   (mod f(x), p)
         //
-        vector< Polynomial > powerTable_ ;
+        // It depends only on f(x) and never changes after construction, so copies
+        // of g(x), e.g. in power(), share it instead of duplicating n-1 polynomials.
+        shared_ptr< const vector< Polynomial > > powerTable_ ;
 
         ModP<ppuint,ppsint>  mod ; //  modulo p functionoid.
 
@@ -420,18 +438,16 @@ class PolyMod
 |
 +============================================================================*/
 
-// Stand alone.
-Polynomial 
-findPrimitivePolynomial( ppuint p, int n, 
-                         bool printOperationCount = false, 
-                         bool listAllPrimitivePolynomials = false, 
-                         bool slowConfirm = false ) ;
-
 class PolyOrder
 {
     public:
         // Do tests on the nth degree polynomial f(x) modulo p.
         PolyOrder( const Polynomial & f ) ;
+
+        // Same, but skip factoring r and use the given factors of r instead, e.g. none at all when
+        // factoring would take too long.  The order m test only tries those factors, and the number
+        // of primitive polynomials is unknown, i.e. 0.
+        PolyOrder( const Polynomial & f, const Factorization<BigInt> & factorsOfR ) ;
          
         void newPolynomial( const Polynomial &f ) ;
 
@@ -454,13 +470,22 @@ class PolyOrder
         bool maximal_order() ;
 				  
         // Check if the monic polynomial f( x ) has 2 or more distinct factors.
-        // Uses x_to_power().
-        bool hasMultipleDistinctFactors( bool earlyOut = true ) ;
+        // Uses x_to_power().  For estimates, numRows > 0 builds and reduces only the first numRows
+        // rows of Q-I:  the answer means nothing then, but the stage times tell what the rows cost.
+        bool hasMultipleDistinctFactors( bool earlyOut = true, int numRows = 0 ) ;
            
         inline BigInt getNumPrimPoly() const { return numPrimPoly_ ; } ;
 
         inline BigInt getMaxNumPoly() const { return maxNumPoly_ ; } ;
 
+        //           n
+        //          p  - 1
+        // r =     -------  and its factorization.
+        //          p  - 1
+        inline const BigInt & getR() const { return r_ ; } ;
+
+        inline const Factorization<BigInt> & getFactorsOfR() const { return factorsOfR_ ; } ;
+
         // --- Stand alone functions, here for neatness.
 
         // Test if a given polynomial f(x) is primitive.
@@ -493,6 +518,16 @@ class PolyOrder
         
         // Factorization of r.
         Factorization<BigInt> factorsOfR_ ;
+
+        // Exponents m = r / p  for the order m test, one for each distinct prime p  of r
+        //                    i                                                    i
+        // which doesn't divide p - 1, computed once for all polynomials of degree n modulo p.
+        // When r fits into a ppuint, we test with the native copies instead, so testing
+        // a polynomial never touches multiple precision arithmetic.
+        bool           nativeExponents_ ;
+        ppuint         rNative_ ;
+        vector<ppuint> mNative_ ;
+        vector<BigInt> m_ ;
         
         // Number of possible primitive polynomials.
         BigInt numPrimPoly_ ;
@@ -520,9 +555,13 @@ class PolyOrder
                 
     // Helper functions. 
     protected:
-        void generate_Q_matrix() ;
+        // The rest of construction, once we have r and its factors.
+        void precompute() ;
+
+        // Only the first numRows rows, if numRows > 0.
+        void generate_Q_matrix( int numRows = 0 ) ;
 
-        void findNullity( bool earlyOut = true ) ;
+        void findNullity( bool earlyOut = true, int numRows = 0 ) ;
 
 } ;
 
@@ -0,0 +1,472 @@
+/*==============================================================================
+| 
+|  NAME
+|
+|     ppSearch.cpp
+|
+|  DESCRIPTION
+|
+|     Primitive polynomial search and test library API.  No console I/O here;
+|     the Primpoly program does the printing.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|     
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+
+
+/*------------------------------------------------------------------------------
+|                                Includes                                      |
+------------------------------------------------------------------------------*/
+
+#include <cstdlib>      // abort()
+#include <iostream>     // Basic stream I/O.
+#include <new>          // set_new_handler()
+#include <cmath>        // Basic math functions e.g. sqrt()
+#include <limits>       // Numeric limits.
+#include <complex>      // Complex data type and operations.
+#include <fstream>      // File stream I/O.
+#include <sstream>      // String stream I/O.
+#include <vector>       // STL vector class.
+#include <string>       // STL string class.
+#include <algorithm>    // Iterators.
+#include <stdexcept>    // Exceptions.
+#include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <functional>   // function
+#include <iterator>     // input_iterator_tag
+#include <cstddef>      // ptrdiff_t
+#include <thread>       // Needed by ppMonitor.h.
+#include <mutex>        // Needed by ppMonitor.h.
+#include <condition_variable>  // Needed by ppMonitor.h.
+#include <future>       // Needed by ppBatch.h.
+#include <queue>        // Needed by ppBatch.h.
+#include <list>         // Needed by ppBatch.h.
+#include <map>          // Needed by ppBatch.h.
+#include <atomic>       // Needed by ppMonitor.h and ppTrace.h.
+#include <chrono>       // Needed by ppMonitor.h.
+
+using namespace std ;   // So we don't need to say std::vector everywhere.
+
+
+
+/*------------------------------------------------------------------------------
+|                                PP Include Files                              |
+------------------------------------------------------------------------------*/
+
+#include "Primpoly.h"       // Global functions.
+#include "ppArith.h"        // Basic arithmetic functions.
+#include "ppBigInt.h"       // Arbitrary precision integer arithmetic.
+#include "ppOperationCount.h"   // OperationCount collection for factoring and poly finding.
+#include "ppFactor.h"       // Prime factorization and Euler Phi.
+#include "ppPolynomial.h"   // Polynomial operations and mod polynomial operations.
+#include "ppSearch.h"       // Primitive polynomial search and test API.
+#include "ppParser.h"       // Parsing of polynomials and I/O services.
+#include "ppBatch.h"        // Needed by ppAggregate.h.
+#include "ppAggregate.h"    // Streaming statistics of polynomials.
+#include "ppMonitor.h"      // Statistics export.
+#include "ppTrace.h"        // Timeline tracing.
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     trialPolynomialBefore
+ |
+ | DESCRIPTION
+ |
+ |     The polynomial just before candidate number k in the sequence of
+ |     polynomials next_trial_poly() steps through.  Candidate number k has
+ |     coefficients a    ... a  which are the digits of k in base p.
+ |                   n-1     0
+ |                                                        n
+ |     For k = 0, it's the initial trial polynomial, f(x) = x  - 1.
+ |
+ +============================================================================*/
+
+static Polynomial trialPolynomialBefore( ppuint p, int n, const BigInt & k )
+{
+    Polynomial f ;
+    f.initial_trial_poly( n, p ) ;
+
+    if (k > static_cast<ppuint>( 0u ))
+    {
+        BigInt digits = k - static_cast<ppuint>( 1u ) ;
+        for (int i = 0 ;  i < n ;  ++i)
+        {
+            f[ i ] = digits % p ;
+            digits /= p ;
+        }
+    }
+
+    return f ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     shardIndex
+ |
+ | DESCRIPTION
+ |
+ |     First candidate number of slice shard of numShards slices of
+ |     numPoly candidates.
+ |
+ +============================================================================*/
+
+static BigInt shardIndex( const BigInt & numPoly, int shard, int numShards )
+{
+    return numPoly * static_cast<ppuint>( shard ) / static_cast<ppuint>( numShards ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PrimitivePolynomialSearch
+ |
+ | DESCRIPTION
+ |
+ |     Set up the search:  factor r and count the primitive polynomials, or
+ |     start from a context for degree n modulo p which has done that already.
+ |     Then position ourselves just before the first candidate in our shard.
+ |
+ +============================================================================*/
+
+PrimitivePolynomialSearch::PrimitivePolynomialSearch( ppuint p, int n, const SearchOptions & options )
+    : PrimitivePolynomialSearch( p, n, PolyOrder( trialPolynomialBefore( p, n, static_cast<ppuint>( 0u ) ) ), options )
+{
+}
+
+PrimitivePolynomialSearch::PrimitivePolynomialSearch( ppuint p, int n, const PolyOrder & context,
+                                                      const SearchOptions & options )
+    : options_( options )
+    , f_( trialPolynomialBefore( p, n, static_cast<ppuint>( 0u ) ) )
+    , order_( context )
+    , numPolyTested_( 0u )
+    , endIndex_( 0u )
+    , numPrimitivePoly_( 0u )
+{
+    if (options_.numShards < 1 || options_.shard < 0 || options_.shard >= options_.numShards)
+    {
+        ostringstream os ;
+        os << "Shard " << options_.shard << " of " << options_.numShards << " is out of range"
+           << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw PolynomialRangeError( os.str() ) ;
+    }
+
+    numPolyTested_ = shardIndex( order_.getMaxNumPoly(), options_.shard,     options_.numShards ) ;
+    endIndex_      = shardIndex( order_.getMaxNumPoly(), options_.shard + 1, options_.numShards ) ;
+
+    if (numPolyTested_ > static_cast<ppuint>( 0u ))
+        f_ = trialPolynomialBefore( p, n, numPolyTested_ ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PrimitivePolynomialSearch::next
+ |
+ | DESCRIPTION
+ |
+ |     Generate and test the next n th degree, monic, modulo p polynomials
+ |     in sequence until we find a primitive one or reach the end of our shard.
+ |     Stop early once we've found all the primitive polynomials there are.
+ |
+ +============================================================================*/
+
+bool PrimitivePolynomialSearch::next( Polynomial & f )
+{
+    while (numPrimitivePoly_ < order_.getNumPrimPoly() && numPolyTested_ < endIndex_)
+    {
+        f_.next_trial_poly() ;      // Try next polynomal in sequence.
+        ++numPolyTested_ ;
+
+        order_.newPolynomial( f_ ) ;
+        bool primitive = order_.isPrimitive() ;
+
+        if (options_.monitor != nullptr)
+            options_.monitor->update( order_.statistics_ ) ;
+
+        if (primitive)
+        {
+            ++numPrimitivePoly_ ;
+
+            // Do a very slow maximal order test for primitivity.
+            if (options_.slowConfirm && !order_.maximal_order())
+            {
+                ostringstream os ;
+                os << "Fast test says " << f_ << " is a primitive polynomial but slow test disagrees.\n"
+                   << " at " << __FILE__ << ": line " << __LINE__ ;
+                throw PolynomialError( os.str() ) ;
+            }
+
+            if (options_.aggregator != nullptr)
+                options_.aggregator->add( f_ ) ;
+
+            f = f_ ;
+            return true ;
+        }
+    }
+
+    return false ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PrimitivePolynomialSearch::findFirst
+ |
+ | DESCRIPTION
+ |
+ |     Find the next primitive polynomial.  Not finding one is an error.
+ |
+ +============================================================================*/
+
+Polynomial PrimitivePolynomialSearch::findFirst()
+{
+    PP_TRACE_SCOPE( "find first", "search" ) ;
+    Polynomial f ;
+    if (!next( f ))
+    {
+        ostringstream os ;
+        os << "Tested all " << order_.getMaxNumPoly() << " possible polynomials, but\n"
+           << "failed to find a primitive polynomial.\n"
+           << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw PolynomialError( os.str() ) ;
+    }
+
+    return f ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PrimitivePolynomialSearch::enumerate
+ |
+ | DESCRIPTION
+ |
+ |     Hand each primitive polynomial to the caller until the caller says stop.
+ |
+ +============================================================================*/
+
+BigInt PrimitivePolynomialSearch::enumerate( const function< bool( const Polynomial & ) > & found )
+{
+    PP_TRACE_SCOPE( "enumerate", "search" ) ;
+    BigInt numFound( 0u ) ;
+    Polynomial f ;
+
+    while (next( f ))
+    {
+        ++numFound ;
+        if (!found( f ))
+            break ;
+    }
+
+    return numFound ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PrimitivePolynomialRange
+ |
+ | DESCRIPTION
+ |
+ |     Set up the search, but don't test any polynomials until asked.
+ |
+ +============================================================================*/
+
+PrimitivePolynomialRange::PrimitivePolynomialRange( ppuint p, int n, const SearchOptions & options )
+    : search_( p, n, options )
+    , f_()
+    , started_( false )
+    , done_( false )
+{
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PrimitivePolynomialRange::begin
+ |
+ | DESCRIPTION
+ |
+ |     Pull the first primitive polynomial, or resume at the current one.
+ |
+ +============================================================================*/
+
+PrimitivePolynomialRange::iterator PrimitivePolynomialRange::begin()
+{
+    if (!started_)
+    {
+        started_ = true ;
+        done_    = !search_.next( f_ ) ;
+    }
+
+    return done_ ? end() : iterator( this ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     PrimitivePolynomialRange::iterator::operator++
+ |
+ | DESCRIPTION
+ |
+ |     Pull the next primitive polynomial.
+ |
+ +============================================================================*/
+
+PrimitivePolynomialRange::iterator & PrimitivePolynomialRange::iterator::operator++()
+{
+    if (!range_->search_.next( range_->f_ ))
+    {
+        range_->done_ = true ;
+        range_ = nullptr ;
+    }
+
+    return *this ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     isPrimitive
+ |
+ | DESCRIPTION
+ |
+ |     Test a single polynomial for primitivity.
+ |
+ +============================================================================*/
+
+bool isPrimitive( const Polynomial & f, OperationCount * statistics )
+{
+    PolyOrder order( f ) ;
+    bool primitive = order.isPrimitive() ;
+
+    if (statistics != nullptr)
+        *statistics = order.statistics_ ;
+
+    return primitive ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     confirmPrimitive
+ |
+ | DESCRIPTION
+ |
+ |     Test a single polynomial for primitivity the slow way.
+ |
+ +============================================================================*/
+
+bool confirmPrimitive( const Polynomial & f )
+{
+    PolyOrder order( f ) ;
+    return order.maximal_order() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     findFirst
+ |
+ | DESCRIPTION
+ |
+ |     Find the first primitive polynomial of degree n modulo p.
+ |
+ +============================================================================*/
+
+Polynomial findFirst( ppuint p, int n, const SearchOptions & options, OperationCount * statistics )
+{
+    PrimitivePolynomialSearch search( p, n, options ) ;
+    Polynomial f = search.findFirst() ;
+
+    if (statistics != nullptr)
+        *statistics = search.statistics() ;
+
+    return f ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     enumerate
+ |
+ | DESCRIPTION
+ |
+ |     Enumerate the primitive polynomials of degree n modulo p.
+ |
+ +============================================================================*/
+
+BigInt enumerate( ppuint p, int n, const function< bool( const Polynomial & ) > & found,
+                  const SearchOptions & options, OperationCount * statistics )
+{
+    PrimitivePolynomialSearch search( p, n, options ) ;
+    BigInt numFound = search.enumerate( found ) ;
+
+    if (statistics != nullptr)
+        *statistics = search.statistics() ;
+
+    return numFound ;
+}
@@ -0,0 +1,254 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppSearch.h
+|
+|  DESCRIPTION
+|
+|     Header file for the primitive polynomial search and test library API.
+|     This is what the Primpoly program is built on;  it does no console I/O,
+|     so other programs can link with libprimpoly and call it directly.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with the !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+// Wrap this header file to prevent duplication if it is included
+// accidentally more than once.
+#ifndef __PP_SEARCH_H__
+#define __PP_SEARCH_H__
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     SearchOptions
+|
+| DESCRIPTION
+|
+|     Options for searching for primitive polynomials.
+|
+|         slowConfirm    Confirm each primitive polynomial found with the
+|                        very slow maximal order test.  Throws PolynomialError
+|                        if the fast and slow tests disagree.
+|
+|         shard          Search only slice number shard of numShards equal
+|         numShards      slices of the candidate polynomials.  Each slice can
+|                        be searched independently in its own thread or process;
+|                        listing the slices in order gives the complete list.
+|
+|         aggregator     If not null, add each primitive polynomial to it as
+|                        soon as we find it.  Not owned by the search.
+|
+|         monitor        If not null, update it with our operation counts after
+|                        each polynomial we test.  Not owned by the search.
+|
++============================================================================*/
+
+class PolynomialAggregator ;
+class StatisticsMonitor ;
+
+struct SearchOptions
+{
+    SearchOptions()
+        : slowConfirm( false )
+        , shard( 0 )
+        , numShards( 1 )
+        , aggregator( nullptr )
+        , monitor( nullptr )
+    {
+    }
+
+    bool                   slowConfirm ;
+    int                    shard ;
+    int                    numShards ;
+    PolynomialAggregator * aggregator ;
+    StatisticsMonitor *    monitor ;
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PrimitivePolynomialSearch
+|
+| DESCRIPTION
+|
+|     Search through all monic polynomials of degree n modulo p in order,
+|                  n       n        n
+|     starting at x,  then x  + 1, x  + 2, ..., testing each for primitivity.
+|
+|     The constructor factors r once;  each call to next() picks up where the
+|     last one left off, so callers pay only for the polynomials they ask for.
+|     With options.numShards > 1, we search only the candidates in our shard.
+|
+|     Exceptions:  throws PolynomialError or one of its subclasses,
+|     FactorError or a BigInt exception.
+|
+| EXAMPLE
+|
+|     PrimitivePolynomialSearch search( 2, 4 ) ;
+|     Polynomial f ;
+|     while (search.next( f ))
+|         cout << f << endl ;
+|     cout << search.statistics() ;
+|
++============================================================================*/
+
+class PrimitivePolynomialSearch
+{
+    public:
+        PrimitivePolynomialSearch( ppuint p, int n, const SearchOptions & options = SearchOptions() ) ;
+
+        // Start from a PolyOrder context for degree n modulo p, e.g. from a PolyOrderCache,
+        // instead of factoring r again.
+        PrimitivePolynomialSearch( ppuint p, int n, const PolyOrder & context,
+                                   const SearchOptions & options = SearchOptions() ) ;
+
+        // Find the next primitive polynomial f.  Return false when there are no more.
+        bool next( Polynomial & f ) ;
+
+        // Find the first primitive polynomial after the ones found so far.
+        // Throws PolynomialError if there are none left.
+        Polynomial findFirst() ;
+
+        // Call found( f ) for each remaining primitive polynomial f until found() returns false
+        // or there are no more.  Return the number of primitive polynomials found.
+        BigInt enumerate( const function< bool( const Polynomial & ) > & found ) ;
+
+        // Total number of primitive polynomials of degree n modulo p.
+        inline BigInt getNumPrimPoly() const { return order_.getNumPrimPoly() ; } ;
+
+        // Operation counts of the search so far.
+        inline const OperationCount & statistics() const { return order_.statistics_ ; } ;
+
+    private:
+        SearchOptions options_ ;
+        Polynomial    f_ ;              // Last polynomial tested.
+        PolyOrder     order_ ;
+        BigInt        numPolyTested_ ;  // Candidates numPolyTested_ < endIndex_ remain to be tested.
+        BigInt        endIndex_ ;
+        BigInt        numPrimitivePoly_ ;
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     PrimitivePolynomialRange
+|
+| DESCRIPTION
+|
+|     Lazy range of primitive polynomials.  Its iterators pull the next
+|     primitive polynomial from the search only when incremented, so we can stop
+|     after the first few or on any condition and skip testing the rest.
+|
+|     The search state lives in the range;  it is an input range, so starting
+|     a second loop over it picks up where the first one stopped.
+|
+| EXAMPLE
+|
+|     // The first 3 primitive polynomials of degree 10 modulo 2.
+|     int k = 0 ;
+|     for (const Polynomial & f : PrimitivePolynomialRange( 2, 10 ))
+|     {
+|         cout << f << endl ;
+|         if (++k == 3)
+|             break ;
+|     }
+|
++============================================================================*/
+
+class PrimitivePolynomialRange
+{
+    public:
+        PrimitivePolynomialRange( ppuint p, int n, const SearchOptions & options = SearchOptions() ) ;
+
+        class iterator
+        {
+            public:
+                typedef input_iterator_tag iterator_category ;
+                typedef Polynomial         value_type ;
+                typedef ptrdiff_t          difference_type ;
+                typedef const Polynomial * pointer ;
+                typedef const Polynomial & reference ;
+
+                explicit iterator( PrimitivePolynomialRange * range = nullptr )
+                    : range_( range )
+                {
+                }
+
+                reference operator*()  const { return range_->f_ ; }
+                pointer   operator->() const { return &range_->f_ ; }
+
+                // Find the next primitive polynomial;  become the end iterator if there are no more.
+                iterator & operator++() ;
+
+                bool operator==( const iterator & it ) const { return range_ == it.range_ ; }
+                bool operator!=( const iterator & it ) const { return range_ != it.range_ ; }
+
+            private:
+                PrimitivePolynomialRange * range_ ;
+        } ;
+
+        iterator begin() ;
+
+        iterator end() { return iterator() ; }
+
+        // Operation counts of the polynomials pulled so far.
+        inline const OperationCount & statistics() const { return search_.statistics() ; } ;
+
+    private:
+        PrimitivePolynomialSearch search_ ;
+        Polynomial                f_ ;        // Current primitive polynomial.
+        bool                      started_ ;  // Have we pulled the first one yet?
+        bool                      done_ ;     // No more primitive polynomials.
+} ;
+
+
+// Test if f( x ) is primitive.  If statistics is not null, return the operation counts there.
+bool isPrimitive( const Polynomial & f, OperationCount * statistics = nullptr ) ;
+
+//                                                                    n
+// Confirm f( x ) is primitive with the very slow maximal order test, O( p  ).
+bool confirmPrimitive( const Polynomial & f ) ;
+
+// Find the first primitive polynomial of degree n modulo p.
+Polynomial findFirst( ppuint p, int n, const SearchOptions & options = SearchOptions(),
+                      OperationCount * statistics = nullptr ) ;
+
+// Call found( f ) for each primitive polynomial of degree n modulo p until found() returns false.
+// Return the number of primitive polynomials found.
+BigInt enumerate( ppuint p, int n, const function< bool( const Polynomial & ) > & found,
+                  const SearchOptions & options = SearchOptions(),
+                  OperationCount * statistics = nullptr ) ;
+
+#endif // __PP_SEARCH_H__ -- End of wrapper for header file.
@@ -0,0 +1,447 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppTrace.cpp
+|
+|  DESCRIPTION
+|
+|     Per-thread ring buffers of trace events, written out as a Chrome trace.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+
+
+/*------------------------------------------------------------------------------
+|                                Includes                                      |
+------------------------------------------------------------------------------*/
+
+#include <cstdlib>      // abort()
+#include <iostream>     // Basic stream I/O.
+#include <iomanip>      // setw()
+#include <new>          // set_new_handler()
+#include <cmath>        // Basic math functions e.g. sqrt()
+#include <limits>       // Numeric limits.
+#include <complex>      // Complex data type and operations.
+#include <fstream>      // File stream I/O.
+#include <sstream>      // String stream I/O.
+#include <vector>       // STL vector class.
+#include <string>       // STL string class.
+#include <algorithm>    // Iterators.
+#include <stdexcept>    // Exceptions.
+#include <cassert>      // assert()
+#include <memory>       // shared_ptr
+#include <mutex>        // mutex, lock_guard
+#include <atomic>       // Enabled flag, event counts.
+#include <chrono>       // steady_clock
+
+using namespace std ;   // So we don't need to say std::vector everywhere.
+
+
+
+/*------------------------------------------------------------------------------
+|                                PP Include Files                              |
+------------------------------------------------------------------------------*/
+
+#include "Primpoly.h"       // Global functions.
+#include "ppArith.h"        // Basic arithmetic functions.
+#include "ppBigInt.h"       // Arbitrary precision integer arithmetic.
+#include "ppOperationCount.h"   // OperationCount collection for factoring and poly finding.
+#include "ppFactor.h"       // Prime factorization and Euler Phi.
+#include "ppPolynomial.h"   // Polynomial operations and mod polynomial operations.
+#include "ppParser.h"       // Parsing of polynomials and I/O services.
+#include "ppTrace.h"        // Timeline tracing.
+
+
+atomic< bool > Trace::enabled_( false ) ;
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     TraceBuffer
+ |
+ | DESCRIPTION
+ |
+ |     Ring buffer of one thread's events.  Only its thread writes it;  the
+ |     release store of numWritten_ publishes each event to the thread which
+ |     writes the trace.
+ |
+ +============================================================================*/
+
+struct TraceBuffer
+{
+    TraceBuffer( size_t capacity, int threadId )
+        : events_( max( capacity, static_cast<size_t>( 1u ) ) )
+        , numWritten_( 0u )
+        , threadId_( threadId )
+        , name_( nullptr )
+        , number_( -1 )
+    {
+    }
+
+    inline void record( const TraceEvent & event )
+    {
+        ppuint num = numWritten_.load( memory_order_relaxed ) ;
+        events_[ num % events_.size() ] = event ;
+        numWritten_.store( num + 1u, memory_order_release ) ;
+    }
+
+    inline ppuint numDropped() const
+    {
+        ppuint num = numWritten_.load( memory_order_acquire ) ;
+        return num > events_.size() ? num - events_.size() : 0u ;
+    }
+
+    vector< TraceEvent >   events_ ;
+    atomic< ppuint >       numWritten_ ;
+    int                    threadId_ ;
+    atomic< const char * > name_ ;
+    atomic< int >          number_ ;
+} ;
+
+
+// The buffers of this trace, in the order the threads first recorded an event.
+static mutex                                traceMutex ;
+static vector< shared_ptr< TraceBuffer > >  traceBuffers ;
+static size_t                               traceEventsPerThread = Trace::defaultEventsPerThread ;
+static atomic< unsigned int >               traceGeneration( 0u ) ;    // Counts calls of start().
+static atomic< ppuint >                     traceEpoch( 0u ) ;         // Steady clock nanoseconds at start().
+
+// The calling thread's buffer, and its name, which we may get before tracing starts.
+struct ThreadTrace
+{
+    shared_ptr< TraceBuffer > buffer ;
+    unsigned int              generation ;
+    const char *              name ;
+    int                       number ;
+} ;
+
+static thread_local ThreadTrace thisThread = { nullptr, 0u, nullptr, -1 } ;
+
+static ppuint steadyNanoseconds()
+{
+    return static_cast<ppuint>( chrono::duration_cast< chrono::nanoseconds >(
+                                    chrono::steady_clock::now().time_since_epoch() ).count() ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     threadBuffer
+ |
+ | DESCRIPTION
+ |
+ |     The calling thread's buffer for this trace.  We take the lock only the
+ |     first time a thread records an event after start().
+ |
+ +============================================================================*/
+
+static TraceBuffer & threadBuffer()
+{
+    if (!thisThread.buffer || thisThread.generation != traceGeneration.load( memory_order_acquire ))
+    {
+        lock_guard< mutex > lock( traceMutex ) ;
+
+        thisThread.buffer = make_shared< TraceBuffer >( traceEventsPerThread, static_cast<int>( traceBuffers.size() ) + 1 ) ;
+        thisThread.buffer->name_.store( thisThread.name ) ;
+        thisThread.buffer->number_.store( thisThread.number ) ;
+        thisThread.generation = traceGeneration.load( memory_order_relaxed ) ;
+
+        traceBuffers.push_back( thisThread.buffer ) ;
+    }
+
+    return *thisThread.buffer ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     Trace::start, stop, now
+ |
+ | DESCRIPTION
+ |
+ |     Threads still holding buffers of the last trace see the generation
+ |     change and make new ones.
+ |
+ +============================================================================*/
+
+void Trace::start( size_t eventsPerThread )
+{
+    lock_guard< mutex > lock( traceMutex ) ;
+
+    traceBuffers.clear() ;
+    traceEventsPerThread = eventsPerThread ;
+    traceEpoch.store( steadyNanoseconds(), memory_order_relaxed ) ;
+    traceGeneration.fetch_add( 1u, memory_order_release ) ;
+    enabled_.store( true, memory_order_release ) ;
+}
+
+void Trace::stop()
+{
+    enabled_.store( false, memory_order_release ) ;
+}
+
+ppuint Trace::now()
+{
+    return steadyNanoseconds() - traceEpoch.load( memory_order_relaxed ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     Trace::nameThread
+ |
+ | DESCRIPTION
+ |
+ |     Remember the name for the thread's next buffer, and give it to the
+ |     current one, if it has one.
+ |
+ +============================================================================*/
+
+void Trace::nameThread( const char * name, int number )
+{
+    thisThread.name   = name ;
+    thisThread.number = number ;
+
+    if (thisThread.buffer && thisThread.generation == traceGeneration.load( memory_order_acquire ))
+    {
+        thisThread.buffer->name_.store( name ) ;
+        thisThread.buffer->number_.store( number ) ;
+    }
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     Trace::complete, counter
+ |
+ | DESCRIPTION
+ |
+ |     Record a span or a counter value on the calling thread's timeline.
+ |
+ +============================================================================*/
+
+void Trace::complete( const char * name, const char * category, ppuint start, ppuint duration, ppuint arg )
+{
+    if (enabled())
+        threadBuffer().record( TraceEvent{ name, category, 'X', start, duration, arg } ) ;
+}
+
+void Trace::counter( const char * name, ppuint value )
+{
+    if (enabled())
+        threadBuffer().record( TraceEvent{ name, "counter", 'C', now(), 0u, value } ) ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     Trace::numEvents, numDropped
+ |
+ +============================================================================*/
+
+ppuint Trace::numEvents()
+{
+    lock_guard< mutex > lock( traceMutex ) ;
+
+    ppuint num = 0u ;
+    for (auto & buffer : traceBuffers)
+        num += buffer->numWritten_.load( memory_order_acquire ) ;
+
+    return num ;
+}
+
+ppuint Trace::numDropped()
+{
+    lock_guard< mutex > lock( traceMutex ) ;
+
+    ppuint num = 0u ;
+    for (auto & buffer : traceBuffers)
+        num += buffer->numDropped() ;
+
+    return num ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     Trace::writeJson
+ |
+ | DESCRIPTION
+ |
+ |     Write the Chrome trace event format:  a name for each thread, then
+ |     each thread's events from the oldest we kept.  Chrome wants times in
+ |     microseconds;  we keep the nanoseconds as three decimals.
+ |
+ |     {"displayTimeUnit":"ns","otherData":{"dropped_events":0},"traceEvents":[
+ |     {"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"worker 0"}},
+ |     {"name":"shard","cat":"work","ph":"X","pid":1,"tid":2,"ts":1.250,"dur":812.004,"args":{"unit":0}},
+ |     ...
+ |     ]}
+ |
+ +============================================================================*/
+
+static void writeMicroseconds( ostream & out, ppuint nanoseconds )
+{
+    out << nanoseconds / 1000u << '.' << setw( 3 ) << setfill( '0' ) << nanoseconds % 1000u << setfill( ' ' ) ;
+}
+
+void Trace::writeJson( ostream & out )
+{
+    vector< shared_ptr< TraceBuffer > > buffers ;
+    {
+        lock_guard< mutex > lock( traceMutex ) ;
+        buffers = traceBuffers ;
+    }
+
+    ppuint numDropped = 0u ;
+    for (auto & buffer : buffers)
+        numDropped += buffer->numDropped() ;
+
+    out << "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":" << numDropped << "},\"traceEvents\":[\n" ;
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Primpoly\"}}" ;
+
+    for (auto & buffer : buffers)
+    {
+        int tid = buffer->threadId_ ;
+
+        const char * name = buffer->name_.load() ;
+        if (name != nullptr)
+        {
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":\"" << name ;
+            if (buffer->number_.load() >= 0)
+                out << " " << buffer->number_.load() ;
+            out << "\"}}" ;
+        }
+        out << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"sort_index\":" << tid << "}}" ;
+
+        ppuint numWritten = buffer->numWritten_.load( memory_order_acquire ) ;
+        ppuint capacity   = buffer->events_.size() ;
+        for (ppuint k = numWritten > capacity ? numWritten - capacity : 0u ;  k < numWritten ;  ++k)
+        {
+            const TraceEvent & event = buffer->events_[ k % capacity ] ;
+
+            out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category << "\",\"ph\":\"" << event.phase
+                << "\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" ;
+            writeMicroseconds( out, event.start ) ;
+
+            if (event.phase == 'C')
+                out << ",\"args\":{\"value\":" << event.arg << "}}" ;
+            else
+            {
+                out << ",\"dur\":" ;
+                writeMicroseconds( out, event.duration ) ;
+                if (event.arg != noArg)
+                    out << ",\"args\":{\"unit\":" << event.arg << "}" ;
+                out << "}" ;
+            }
+        }
+    }
+
+    out << "\n]}\n" ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     TraceSession
+ |
+ | DESCRIPTION
+ |
+ |     Check now that we can write the file, then start tracing.
+ |
+ +============================================================================*/
+
+TraceSession::TraceSession( const string & fileName, size_t eventsPerThread )
+    : fileName_( fileName )
+    , finished_( false )
+{
+    if (!ofstream( fileName_.c_str(), ios::out | ios::trunc ))
+    {
+        ostringstream os ;
+        os << "Error:  can't write the trace file " << fileName_ << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw ParserError( os.str() ) ;
+    }
+
+    Trace::start( eventsPerThread ) ;
+}
+
+TraceSession::~TraceSession()
+{
+    try
+    {
+        finish() ;
+    }
+    catch( ParserError & )
+    {
+        // We're unwinding already;  the first error is the one to report.
+    }
+}
+
+void TraceSession::finish()
+{
+    if (finished_)
+        return ;
+
+    finished_ = true ;
+    Trace::stop() ;
+
+    ofstream out( fileName_.c_str(), ios::out | ios::trunc ) ;
+    Trace::writeJson( out ) ;
+    out.close() ;
+
+    if (!out)
+    {
+        ostringstream os ;
+        os << "Error:  can't write the trace file " << fileName_ << " at " << __FILE__ << ": line " << __LINE__ ;
+        throw ParserError( os.str() ) ;
+    }
+}
@@ -0,0 +1,257 @@
+/*==============================================================================
+|
+|  NAME
+|
+|     ppTrace.h
+|
+|  DESCRIPTION
+|
+|     Header file for tracing searches on a timeline:  what each thread was
+|     doing and when, written as a Chrome trace which chrome://tracing and
+|     the Perfetto UI can show.
+|
+|     User manual and technical documentation are described in detail in my web page at
+|     http://seanerikoconnor.freeservers.com/Mathematics/AbstractAlgebra/PrimitivePolynomials/overview.html
+|
+|  LEGAL
+|
+|     Primpoly Version 13.0 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2018 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with the !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+// Wrap this header file to prevent duplication if it is included
+// accidentally more than once.
+#ifndef __PP_TRACE_H__
+#define __PP_TRACE_H__
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     TraceEvent
+|
+| DESCRIPTION
+|
+|     One event on the timeline of a thread:
+|
+|         phase 'X'   A span of time, from start for duration nanoseconds,
+|                     e.g. one stage of testing a polynomial, one task on a
+|                     worker thread, or one shard of a parallel search.
+|         phase 'C'   The value of a counter at start, e.g. the number of
+|                     tasks waiting in the ThreadPool queue.
+|
+|     Times are nanoseconds since tracing started.  The name and category
+|     must be string literals, since we only keep the pointers.
+|
++============================================================================*/
+
+struct TraceEvent
+{
+    const char * name ;
+    const char * category ;
+    char         phase ;
+    ppuint       start ;
+    ppuint       duration ;
+    ppuint       arg ;          // Work unit number or counter value, or Trace::noArg.
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     Trace
+|
+| DESCRIPTION
+|
+|     Tracing for all threads.  Each thread records its events in its own
+|     ring buffer without locking:  only the thread writes its buffer, so
+|     recording an event is a couple of clock readings and a store.  When a
+|     buffer fills, the newest events overwrite the oldest, and we count the
+|     ones we lost.
+|
+|     Tracing is off until start(), so the trace points cost one relaxed
+|     atomic load.  Define PP_NO_TRACE, e.g. with cmake -DPP_TRACE=OFF, to
+|     compile the trace points out altogether.
+|
+|     Write the trace after the threads being traced are done, e.g. after
+|     their ThreadPool is gone, since we read their buffers then without
+|     locking them.
+|
+| EXAMPLE
+|
+|     Trace::start() ;
+|     {
+|         PP_TRACE_SCOPE( "order_m", "stage" ) ;
+|         order_m() ;
+|     }
+|     Trace::stop() ;
+|     Trace::writeJson( file ) ;
+|
++============================================================================*/
+
+class Trace
+{
+    public:
+        static const ppuint noArg = static_cast<ppuint>( -1 ) ;
+        static const size_t defaultEventsPerThread = 1u << 16 ;
+
+        // Throw away the events we had, and start tracing every thread with a fresh buffer.
+        static void start( size_t eventsPerThread = defaultEventsPerThread ) ;
+
+        static void stop() ;
+
+        static inline bool enabled() { return enabled_.load( memory_order_relaxed ) ; } ;
+
+        // Nanoseconds since start().
+        static ppuint now() ;
+
+        // Name the calling thread on the timeline, e.g. worker 3.  The name must be a string literal.
+        static void nameThread( const char * name, int number = -1 ) ;
+
+        // Record an event for the calling thread, if we're tracing.
+        static void complete( const char * name, const char * category, ppuint start, ppuint duration, ppuint arg = noArg ) ;
+        static void counter( const char * name, ppuint value ) ;
+
+        // Events recorded since start(), and those of them we overwrote.
+        static ppuint numEvents() ;
+        static ppuint numDropped() ;
+
+        // Write the events as Chrome trace JSON, with times in microseconds.
+        static void writeJson( ostream & out ) ;
+
+    private:
+        static atomic< bool > enabled_ ;
+} ;
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     TraceScope
+|
+| DESCRIPTION
+|
+|     Record the rest of the block as one span on the calling thread's
+|     timeline.  Use it through PP_TRACE_SCOPE so it compiles out with
+|     PP_NO_TRACE.
+|
++============================================================================*/
+
+class TraceScope
+{
+    public:
+        inline TraceScope( const char * name, const char * category, ppuint arg = Trace::noArg )
+            : name_( name )
+            , category_( category )
+            , arg_( arg )
+            , tracing_( Trace::enabled() )
+            , start_( tracing_ ? Trace::now() : 0u )
+        {
+        }
+
+        inline ~TraceScope()
+        {
+            if (tracing_)
+                Trace::complete( name_, category_, start_, Trace::now() - start_, arg_ ) ;
+        }
+
+    private:
+        TraceScope( const TraceScope & ) = delete ;
+        TraceScope & operator=( const TraceScope & ) = delete ;
+
+        const char * name_ ;
+        const char * category_ ;
+        ppuint       arg_ ;
+        bool         tracing_ ;
+        ppuint       start_ ;
+} ;
+
+
+// Trace points.  Each one costs an atomic load when we aren't tracing, and nothing with PP_NO_TRACE.
+#ifdef PP_NO_TRACE
+    #define PP_TRACE_SCOPE( name, category )            ((void) 0)
+    #define PP_TRACE_SCOPE_ARG( name, category, arg )   ((void) 0)
+    #define PP_TRACE_COUNTER( name, value )             ((void) 0)
+    #define PP_TRACE_THREAD_NAME( name, number )        ((void) 0)
+#else
+    #define PP_TRACE_JOIN_( a, b ) a ## b
+    #define PP_TRACE_JOIN( a, b )  PP_TRACE_JOIN_( a, b )
+
+    #define PP_TRACE_SCOPE( name, category ) \
+        TraceScope PP_TRACE_JOIN( traceScope, __LINE__ )( name, category )
+
+    #define PP_TRACE_SCOPE_ARG( name, category, arg ) \
+        TraceScope PP_TRACE_JOIN( traceScope, __LINE__ )( name, category, static_cast<ppuint>( arg ) )
+
+    #define PP_TRACE_COUNTER( name, value ) \
+        do { if (Trace::enabled()) Trace::counter( name, static_cast<ppuint>( value ) ) ; } while (0)
+
+    #define PP_TRACE_THREAD_NAME( name, number ) \
+        Trace::nameThread( name, number )
+#endif
+
+
+
+/*=============================================================================
+|
+| NAME
+|
+|     TraceSession
+|
+| DESCRIPTION
+|
+|     Trace from construction to finish(), then write the trace to a file.
+|     The destructor writes it too, if we didn't finish, e.g. when a search
+|     throws.
+|
+| EXAMPLE
+|
+|     TraceSession trace( "search.json" ) ;
+|     aggregate( p, n, aggregator, pool, cache ) ;
+|     trace.finish() ;
+|
++============================================================================*/
+
+class TraceSession
+{
+    public:
+        // Throws ParserError if we can't write the file.
+        explicit TraceSession( const string & fileName, size_t eventsPerThread = Trace::defaultEventsPerThread ) ;
+
+        // Writes the trace if we haven't, ignoring errors.
+        ~TraceSession() ;
+
+        // Stop tracing and write the file.  Throws ParserError if we can't.
+        void finish() ;
+
+    private:
+        TraceSession( const TraceSession & ) = delete ;
+        TraceSession & operator=( const TraceSession & ) = delete ;
+
+        string fileName_ ;
+        bool   finished_ ;
+} ;
+
+#endif // __PP_TRACE_H__ -- End of wrapper for header file.
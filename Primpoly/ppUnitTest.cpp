@@ -53,6 +53,22 @@
 #include <stdexcept>    // Exceptions.
 #include <cassert>      // assert()
 #include <array>        // array type.
+#include <thread>       // Threads for the concurrent search test.
+#include <memory>       // shared_ptr
+#include <functional>   // function
+#include <iterator>     // input_iterator_tag
+#include <cstddef>      // ptrdiff_t
+#include <mutex>        // mutex, lock_guard, unique_lock
+#include <condition_variable>  // Wake up idle workers.
+#include <future>       // packaged_task, future
+#include <queue>        // Task queue.
+#include <list>         // LRU order.
+#include <map>          // LRU index.
+#include <atomic>       // Stop flag.
+#include <chrono>       // Deadlines.
+#include <random>       // Random strings for the parser test.
+
+#include <sys/stat.h>   // stat() for the build fingerprint.
 
 using namespace std ;   // So we don't need to say std::vector everywhere.
 
@@ -68,11 +84,150 @@ using namespace std ;   // So we don't need to say std::vector everywhere.
 #include "ppOperationCount.h" // OperationCount collection for factoring and poly finding.
 #include "ppFactor.h"         // Prime factorization and Euler Phi.
 #include "ppPolynomial.h"     // Polynomial operations and mod polynomial operations.
+#include "ppSearch.h"         // Primitive polynomial search and test API.
 #include "ppParser.h"         // Parsing of polynomials and I/O services.
+#include "ppOutput.h"         // Fast output of polynomials.
+#include "ppBatch.h"          // Batch testing of polynomials.
+#include "ppArchive.h"        // Polynomial archives.
+#include "ppAggregate.h"      // Streaming statistics of polynomials.
+#include "ppMonitor.h"        // Statistics export.
+#include "ppEstimate.h"       // Cost model.
+#include "ppPerfCounters.h"   // Hardware performance counters.
+#include "ppTrace.h"          // Timeline tracing.
+#include "ppDaemon.h"         // Query daemon.
 
 #ifdef SELF_CHECK
 #include "ppUnitTest.h"       // Complete unit test.
 
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     selfCheck
+ |
+ | DESCRIPTION
+ |
+ |     Tiered self-check for startup.  The smoke test always runs;  it takes
+ |     a millisecond or so.  The complete unit test runs when asked for, or the
+ |     first time this build of the program runs in the current directory.
+ |     We record that the complete unit test passed in unitTest.fingerprint,
+ |     keyed by the build fingerprint, so later runs of the same build skip it.
+ |
+ |     If the smoke test fails, we run the complete unit test anyway to get
+ |     the details into unitTest.log.
+ |
+ +============================================================================*/
+
+static const char * unitTestFingerprintFileName = "unitTest.fingerprint" ;
+
+bool selfCheck( bool fullUnitTest )
+{
+    if (!smokeTest())
+    {
+        unitTest() ;
+        return false ;
+    }
+
+    const string fingerprint = buildFingerprint() ;
+
+    if (!fullUnitTest)
+    {
+        ifstream fin( unitTestFingerprintFileName ) ;
+        string passedFingerprint ;
+        if (getline( fin, passedFingerprint ) && passedFingerprint == fingerprint)
+            return true ;
+    }
+
+    if (!unitTest())
+    {
+        remove( unitTestFingerprintFileName ) ;
+        return false ;
+    }
+
+    ofstream fout( unitTestFingerprintFileName ) ;
+    fout << fingerprint << endl ;
+
+    return true ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     buildFingerprint
+ |
+ | DESCRIPTION
+ |
+ |     Identify this build of the program:  the size and modification time of
+ |     the executable, which change every time we relink, plus the compiler
+ |     version and compile time of this file.  Where we can't stat the
+ |     executable, fall back on the compile time alone.
+ |
+ +============================================================================*/
+
+string buildFingerprint()
+{
+    ostringstream os ;
+    os << __DATE__ << " " << __TIME__ << " " << __VERSION__ ;
+
+    struct stat executable ;
+    if (stat( "/proc/self/exe", &executable ) == 0)
+        os << " " << executable.st_size << " " << executable.st_mtime ;
+
+    return os.str() ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     smokeTest
+ |
+ | DESCRIPTION
+ |
+ |     A few quick end to end checks of multiple precision arithmetic,
+ |     modulo p arithmetic, parsing, factoring and primitivity testing.
+ |     Logs nothing;  if it fails, the complete unit test will say where.
+ |
+ +============================================================================*/
+
+bool smokeTest()
+{
+    try
+    {
+        // Multiple precision arithmetic and decimal conversion.
+        BigInt u( "1234567890123456789012345678901234567890" ) ;
+        BigInt v( "98765432109876543210" ) ;
+        ostringstream os ;
+        os << u * v / v << " " << u % v ;
+        if (os.str() != "1234567890123456789012345678901234567890 54205246805420524680")
+            return false ;
+
+        // Modulo p arithmetic:  Fermat's little theorem.
+        PowerMod<ppuint> powermod( static_cast<ppuint>( 65003u ) ) ;
+        if (powermod( static_cast<ppuint>( 3u ), static_cast<ppuint>( 65002u ) ) != static_cast<ppuint>( 1u ))
+            return false ;
+
+        // Parsing, factoring r and the primitivity tests.
+        if (!isPrimitive( Polynomial( "x^4 + x + 1, 2" ) ) ||
+             isPrimitive( Polynomial( "x^4 + x^3 + x^2 + x + 1, 2" ) ) ||
+            !isPrimitive( Polynomial( "x^5 + 2 x + 1, 3" ) ))
+            return false ;
+    }
+    catch( exception & e )
+    {
+        return false ;
+    }
+
+    return true ;
+}
+
+
+
 /*=============================================================================
  |
  | NAME
@@ -82,11 +237,14 @@ using namespace std ;   // So we don't need to say std::vector everywhere.
  | DESCRIPTION
  |
  |     In the spirit of EXTREME programming, test each class and its member
- |     functions.  Run the tests every time we run this application.
- |     Place the test results into the current directory in the file
- |     unitTest.txt.  If we can't write the file, log an error message
+ |     functions.  Place the test results into the current directory in the
+ |     file unitTest.log.  If we can't write the file, log an error message
  |     to the console and skip the tests.
  |
+ |     The test groups are independent of each other, so we run them in
+ |     parallel, each logging to its own stream, and copy their logs into the
+ |     file in order.
+ |
  +============================================================================*/
 
 bool unitTest()
@@ -117,27 +275,68 @@ bool unitTest()
 
     fout << legalNotice ;
     fout << "\nBegin unit testing..." ;
+
+    typedef bool (*UnitTestGroup)( ostream & ) ;
+    const array< UnitTestGroup, 8 > unitTestGroup =
+    {
+        unitTestSystemFunctions,
+        unitTestBigIntBase10,
+        unitTestBigIntDefaultBase,
+        unitTestModPArithmetic,
+        unitTestFactoring,
+        unitTestPolynomials,
+        unitTestPolynomialOrder,
+        unitTestParser
+    } ;
+
+    array< ostringstream, 8 > log ;
+    vector< future<bool> > unitTestStatus ;
+
+    for (size_t i = 0 ;  i < unitTestGroup.size() ;  ++i)
+        unitTestStatus.push_back( async( launch::async, runUnitTestGroup, unitTestGroup[ i ], ref( log[ i ] ) ) ) ;
+
+    // True only if everyone passes.
+    for (size_t i = 0 ;  i < unitTestGroup.size() ;  ++i)
+    {
+        status = unitTestStatus[ i ].get() && status ;
+        fout << log[ i ].str() ;
+    }
+
+    fout << "\nEnd unit testing..." ;
+    
+    if (status)
+        fout << "\nCONGRATULATIONS!  All tests passed!" << endl ;
+    else
+        fout << "\nSORRY.  One or more unit tests failed!" << endl ;
     
+    fout.close() ;
+    
+    return status ;
+}
+
+
+
+/*=============================================================================
+ |
+ | NAME
+ |
+ |     runUnitTestGroup
+ |
+ | DESCRIPTION
+ |
+ |     Run one group of unit tests, logging any exception which escapes it
+ |     as a failure.
+ |
+ +============================================================================*/
+
+bool runUnitTestGroup( bool (*unitTestGroup)( ostream & ), ostream & fout )
+{
+    bool status = true ;
+
     try
     {
-        array<bool,8> unitTestStatus ;
-        unitTestStatus.fill( true ) ;
-        int i = 0 ;
+        status = unitTestGroup( fout ) ;
 
-        // Go thorough all the unit tests in order.
-        unitTestStatus[i++] = unitTestSystemFunctions( fout ) ;
-        unitTestStatus[i++] = unitTestBigIntBase10( fout ) ;
-        unitTestStatus[i++] = unitTestBigIntDefaultBase( fout ) ;
-        unitTestStatus[i++] = unitTestModPArithmetic( fout ) ;
-        unitTestStatus[i++] = unitTestFactoring( fout ) ;
-        unitTestStatus[i++] = unitTestPolynomials( fout ) ;
-        unitTestStatus[i++] = unitTestPolynomialOrder( fout ) ;
-        unitTestStatus[i++] = unitTestParser( fout ) ;
-
-        // True only if everyone passes.
-        for (i = 0 ;  i < unitTestStatus.size() ;  ++i)
-            status = status && unitTestStatus[ i ] ;
-        
     // These catch blocks should be in order from more specific to less specific.
     // i.e. up the class hierarchy.
     }
@@ -235,16 +434,7 @@ bool unitTest()
         fout << ".........FAIL!\n    caught exception type  uncaught exception" << endl ;
         status = false ;
     }
-    
-    fout << "\nEnd unit testing..." ;
-    
-    if (status)
-        fout << "\nCONGRATULATIONS!  All tests passed!" << endl ;
-    else
-        fout << "\nSORRY.  One or more unit tests failed!" << endl ;
-    
-    fout.close() ;
-    
+
     return status ;
 }
 
@@ -437,6 +627,25 @@ bool unitTestBigIntBase10( ostream & fout )
             fout << ".........PASS!" ;
     }
 
+    fout << "\nTEST:  Move constructor BigInt v( move( u ) ) and move assignment w = move( v ) from BigInt u = 3 ^ 100" ;
+    {
+        BigInt x = power( 3, 100 ) ;
+        BigInt u( x ) ;
+        BigInt v( std::move( u ) ) ;
+        BigInt w ;
+        w = std::move( v ) ;
+
+        if (w != x)
+        {
+            fout << ".........FAIL!" << endl ;
+            fout << "    w = " ; printNumber( w, fout ) ; fout << endl ;
+            fout << "    x = " ; printNumber( x, fout ) ; fout << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
     fout << "\nTEST:  Implicit casting ppuint d = u from BigInt u( \"01234\" )" ;
     {
         BigInt u( "01234" ) ;
@@ -1316,6 +1525,126 @@ bool unitTestBigIntDefaultBase( ostream & fout )
             fout << ".........PASS!" ;
     }
 
+    fout << "\nTEST:  BigInt full word digit carry and borrow (2^64 - 1) + 1 - 1" ;
+    {
+        ppuint maxDigit = numeric_limits<ppuint>::max() ;
+        BigInt u( maxDigit ) ;
+        BigInt v = u + static_cast<ppuint>( 1u ) ;
+        BigInt w = v - static_cast<ppuint>( 1u ) ;
+
+        if (v.to_string() != "18446744073709551616" || w != u || static_cast<ppuint>( w ) != maxDigit)
+        {
+            fout << "\n\tERROR:  BigInt full word digit carry and borrow failed." << endl ;
+            fout << "v = " ; printNumber( v, fout ) ;
+            fout << "w = " ; printNumber( w, fout ) ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  BigInt arithmetic on numbers up to 256 bits does no heap allocation" ;
+    {
+        ppuint numAllocationsBefore = BigIntDigits::numHeapAllocations() ;
+
+        BigInt r( "340282366920938463463374607431768211455" ) ; // 2^128 - 1
+        BigInt x = power( 3, 50 ) ;
+        BigInt count( static_cast<ppuint>( 0u ) ) ;
+        BigInt y, q ;
+        int numOperations = 0 ;
+
+        for (int i = 0 ;  i < 1000 ;  ++i)
+        {
+            y = x * x + r ;
+            y -= r ;
+            q = r / x ;
+            y = r % x ;
+            ++count ;
+            numOperations += 6 ;
+        }
+
+        ppuint numAllocations = BigIntDigits::numHeapAllocations() - numAllocationsBefore ;
+        if (numAllocations != 0 || count != static_cast<ppuint>( 1000u ))
+        {
+            fout << "\n\tERROR:  " << numAllocations << " heap allocations for " << numOperations << " BigInt operations." << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  BigInt u << 100 = u * 2 ^ 100" ;
+    {
+        BigInt u( "3141592653589793238462643383279" ) ;
+        BigInt w = u << static_cast<ppuint>( 100u ) ;
+
+        if (w != u * power( 2, 100 ))
+        {
+            fout << "\n\tERROR:  BigInt u << 100 = " << w << endl ;
+            fout << "correct answer = " << u * power( 2, 100 ) << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  BigInt Karatsuba, Toom-3, squaring and recursive division on u = 3 ^ 20000 and v = 3 ^ 30000" ;
+    {
+        BigInt u = power( 3, 20000 ) ;
+        BigInt v = power( 3, 30000 ) ;
+        BigInt r = v - static_cast<ppuint>( 1u ) ;
+
+        // Check u v against an independent computation mod a small prime.
+        ppuint p = 1000003 ;
+        PowerMod<ppuint> powermod( p ) ;
+
+        BigInt uv = u * v ;
+        BigInt q, rem ;
+        divMod( uv + r, v, q, rem ) ;
+
+        BigInt uPlus1 = u + static_cast<ppuint>( 1u ) ;
+
+        // The numbers have tens of thousands of digits, so only say which checks fail.
+        ppuint residue  = uv % p ;
+        ppuint expected = powermod( static_cast<ppuint>( 3u ), static_cast<ppuint>( 50000u ) ) ;
+
+        ostringstream failed ;
+        if (residue != expected)
+            failed << " u v mod p" ;
+        if (uv != power( 3, 50000 ))
+            failed << " u v = 3 ^ 50000" ;
+        if (u * u != u * uPlus1 - u)
+            failed << " u u = u (u + 1) - u" ;
+        if (q != u || rem != r)
+            failed << " (u v + r) / v = u remainder r" ;
+
+        if (!failed.str().empty())
+        {
+            fout << "\n\tERROR:  BigInt checks failed:" << failed.str() << endl ;
+            fout << "u v mod " << p << " = " << residue << " but 3 ^ 50000 mod " << p << " = " << expected << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  BigInt decimal string conversion of u = 10 ^ 5000 + 1 and v = 3 ^ 20000" ;
+    {
+        string s = "1" + string( 4999, '0' ) + "1" ;
+        BigInt u( s ) ;
+        BigInt v = power( 3, 20000 ) ;
+
+        if (u != power( 10, 5000 ) + static_cast<ppuint>( 1u ) || u.to_string() != s ||
+            BigInt( v.to_string() ) != v || v % static_cast<ppuint>( 10u ) != 1)
+        {
+            fout << "\n\tERROR:  BigInt( 10 ^ 5000 + 1 ) = " << u << endl ;
+            fout << "3 ^ 20000 = " << v << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
     fout << "\nTEST:  BigInt eval 2 ^ 1198 - 1 = 3 * 366994123 * 16659379034607403556537 * 148296291984475077955727317447564721950969097 * "
             "839804700900123195473468092497901750422530587828620063507554515144683510250490874819119570309824866293030799718783 * "
             "18844604989678054320016126723693071015074748359764319259483333877486701203536294532613478431402128085705057673867712"
@@ -1645,6 +1974,25 @@ bool unitTestModPArithmetic( ostream & fout )
     else
         fout << ".........PASS!" ;
 
+    fout << "\nTEST:  PowerMod BigInt in Montgomery form 3 ^ (p-1) = 1 (mod p) for p = 2 ^ 521 - 1 and 2 ^ 340 = 1 (mod 341)" ;
+    {
+        BigInt p = power( 2, 521 ) - static_cast<ppuint>( 1u ) ;
+        PowerMod<BigInt> powermodp( p ) ;
+        PowerMod<BigInt> powermod341( static_cast<ppuint>( 341u ) ) ;
+        BigInt a( "123456789012345678901234567890123456789" ) ;
+
+        if (powermodp( static_cast<ppuint>( 3u ), p - static_cast<ppuint>( 1u ) ) != static_cast<ppuint>( 1u ) ||
+            powermodp( a, p ) != a ||
+            powermod341( static_cast<ppuint>( 2u ), static_cast<ppuint>( 340u ) ) != static_cast<ppuint>( 1u ))
+        {
+            fout << "\n\tERROR:  PowerMod powermod( 2 ^ 521 - 1 );  powermod( 3, p - 1 ) = "
+                 << powermodp( static_cast<ppuint>( 3u ), p - static_cast<ppuint>( 1u ) ) << " failed." << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
     fout << "\nTEST:  PowerMod with out of range inputs." ;
     try
     {
@@ -2021,6 +2369,22 @@ bool unitTestFactoring( ostream & fout )
 
 
 
+    fout << "\nTEST:  Factor move constructor" ;
+    Factorization<BigInt> factCopy( fact ) ;
+    Factorization<BigInt> factMoved( std::move( factCopy ) ) ;
+    if (!(factMoved.num_distinct_factors() == 3 &&
+          factMoved.multiplicity(0) == 2 && factMoved.prime_factor(0) == static_cast<BigInt>( 2u ) &&
+          factMoved.multiplicity(1) == 3 && factMoved.prime_factor(1) == static_cast<BigInt>( 3u ) &&
+          factMoved.multiplicity(2) == 5 && factMoved.prime_factor(2) == static_cast<BigInt>( 5u ) ))
+    {
+        fout << "\n\tERROR:  Factor move constructor failed on 337500 = 2^2 3^3 5^5." << endl ;
+        status = false ;
+    }
+    else
+        fout << ".........PASS!" ;
+
+
+
     fout << "\nTEST:  Factor assignment operator" ;
     Factorization<BigInt> fact1 ;
     fact1 = f3 ;
@@ -2203,6 +2567,28 @@ bool unitTestPolynomials( ostream & fout )
         status = false ;
     }
 
+    fout << "\nTEST:  Polynomial move assignment operator." ;
+    try
+    {
+        Polynomial p( "2x^2 + 1, 3" ) ;
+        Polynomial q ;
+        q = p + p ;  // Moves the sum into q, which takes on the modulus 3 of p.
+        string sum = q ;
+        q *= 2u ;
+        if (sum != "x ^ 2 + 2, 3" || static_cast<string>(q) != "2 x ^ 2 + 1, 3")
+        {
+            fout << "\n\tERROR: Polynomial move assignment operator q = p + p = " << sum << " then 2 q = " << q << " failed." << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+    catch( PolynomialRangeError & e )
+    {
+        fout << "\n\tERROR:  PolynomialRangeError error:  move assignment operator q = p + p failed." << e.what() << endl ;
+        status = false ;
+    }
+
     fout << "\nTEST:  Polynomial()[] read only operator." ;
     try
     {
@@ -2683,6 +3069,33 @@ bool unitTestPolynomials( ostream & fout )
         status = false ;
     }
 
+    fout << "\nTEST:  PolyMod x_to_power with single precision and BigInt exponents 2 ^ 64 - 1 agree" ;
+    try {
+        Polynomial f( "x^4 + x^2 + 2x + 3, 5" ) ;
+        PolyMod x( "x, 5", f ) ;
+
+        ppuint m = numeric_limits<ppuint>::max() ;
+        PolyMod p = power( x, m ) ;
+        PolyMod q = power( x, static_cast<BigInt>( m ) ) ;
+
+        //  x has order 624 = 156 * 4 since x^156 = 3 has order 4 modulo 5, and 2^64 - 1 = 15 (mod 624).
+        PolyMod t = power( x, 15u ) ;
+
+        if (static_cast<string>(p) == static_cast<string>(q) && static_cast<string>(p) == static_cast<string>(t))
+            fout << ".........PASS!" ;
+        else
+        {
+            fout << "\n\tERROR: PolyMod x_to_power = |" << static_cast<string>(p) << "| and |"
+                 << static_cast<string>(q) << "| differ." << endl ;
+            status = false ;
+        }
+    }
+    catch( PolynomialRangeError & e )
+    {
+        fout << "\n\tERROR:  PolynomialRangeError error:  " << e.what() << endl ;
+        status = false ;
+    }
+
     return status ;
 }
 
@@ -2909,17 +3322,866 @@ bool unitTestPolynomialOrder( ostream & fout )
             status = false ;
         }
     }
-    
-    return status ;
-}
 
+    fout << "\nTEST:  OperationCounter carries past 2 ^ 64 - 1 and merges to 2 ^ 65" ;
+    {
+        OperationCounter count( numeric_limits<ppuint>::max() ) ;
+        ++count ;
+        count += count ;
 
+        ostringstream os ;
+        os << count ;
+        if (os.str() == "36893488147419103232" && static_cast<BigInt>( count ) == BigInt( "36893488147419103232" ))
+            fout << ".........PASS!" ;
+        else
+        {
+            fout << "\n\tERROR: OperationCounter = " << os.str() << " should be 2 ^ 65 = 36893488147419103232" << endl ;
+            status = false ;
+        }
+    }
 
-bool unitTestParser( ostream & fout )
-{
-    bool status = true ;
-    
-    // Create a parser with parse tables.
+    fout << "\nTEST:  OperationCount merge of two searches for x^4 + x^2 + 2x + 3, 5" ;
+    {
+        Polynomial f( "x^4 + x^2 + 2x + 3, 5" ) ;
+        PolyOrder order1( f ) ;
+        PolyOrder order2( f ) ;
+        order1.isPrimitive() ;
+        order2.isPrimitive() ;
+        order2.isPrimitive() ;
+
+        OperationCount total ;
+        total += order1.statistics_ ;
+        total += order2.statistics_ ;
+
+        ostringstream os ;
+        os << total.numPolyTested << " " << total.numOrderM << " " << total.n << " " << total.p << " " << total.maxNumPossiblePoly ;
+        if (os.str() == "3 3 4 5 625")
+            fout << ".........PASS!" ;
+        else
+        {
+            fout << "\n\tERROR: OperationCount merge gave tested, order m, n, p, p ^ n = " << os.str() << " instead of 3 3 4 5 625" << endl ;
+            status = false ;
+        }
+    }
+
+    fout << "\nTEST:  LatencyHistogram buckets 0, 1, 3, 1000 ns and 1 s by powers of 2, then merges" ;
+    {
+        LatencyHistogram histogram ;
+        for (ppuint ns : { 0u, 1u, 3u, 1000u, 1000000000u })
+            histogram.add( ns ) ;
+
+        LatencyHistogram total ;
+        total += histogram ;
+        total += histogram ;
+
+        if (total.count() == 10u && total.totalNanoseconds() == 2u * 1000001004u &&
+            total.bucket( 0 ) == 4u && total.bucket( 1 ) == 2u && total.bucket( 9 ) == 2u && total.bucket( 29 ) == 2u)
+            fout << ".........PASS!" ;
+        else
+        {
+            fout << "\n\tERROR: LatencyHistogram = " << total << endl ;
+            status = false ;
+        }
+    }
+
+    fout << "\nTEST:  PolyOrder times each stage of isPrimitive for x^4 + x^2 + 2x + 3, 5 as often as it counts them" ;
+    {
+        Polynomial f( "x^4 + x^2 + 2x + 3, 5" ) ;
+        PolyOrder order( f ) ;
+        order.isPrimitive() ;
+        order.isPrimitive() ;
+
+        const OperationCount & s = order.statistics_ ;
+        if (BigInt( s.stageTime( PolyOrderStage::ConstantCoeff ).count() ) == static_cast<BigInt>( s.numPolyTested ) &&
+            BigInt( s.stageTime( PolyOrderStage::LinearFactor ).count() )  == static_cast<BigInt>( s.numConstantCoeffIsPrimitiveRoot ) &&
+            BigInt( s.stageTime( PolyOrderStage::QMatrix ).count() )       == static_cast<BigInt>( s.numFreeOfLinearFactors ) &&
+            BigInt( s.stageTime( PolyOrderStage::Nullity ).count() )       == static_cast<BigInt>( s.numFreeOfLinearFactors ) &&
+            s.stageTime( PolyOrderStage::OrderM ).count() == 2u)
+            fout << ".........PASS!" ;
+        else
+        {
+            fout << "\n\tERROR: PolyOrder stage times " << s << endl ;
+            status = false ;
+        }
+    }
+
+    fout << "\nTEST:  HardwareCounts differences and merges keep just the events counted" ;
+    {
+        HardwareCounts start, end, other ;
+        start.set( HardwareEvent::Cycles, 100u ) ;
+        start.set( HardwareEvent::Instructions, 50u ) ;
+        end.set( HardwareEvent::Cycles, 350u ) ;
+        other.set( HardwareEvent::BranchMisses, 7u ) ;
+
+        HardwareCounts total = end - start ;
+        total += other ;
+        total += end - start ;
+
+        if (total.has( HardwareEvent::Cycles ) && total.count( HardwareEvent::Cycles ) == 500u &&
+            !total.has( HardwareEvent::Instructions ) && !total.has( HardwareEvent::CacheMisses ) &&
+            total.has( HardwareEvent::BranchMisses ) && total.count( HardwareEvent::BranchMisses ) == 7u &&
+            HardwareCounts().empty() && !total.empty())
+            fout << ".........PASS!" ;
+        else
+        {
+            fout << "\n\tERROR: HardwareCounts cycles = " << total.count( HardwareEvent::Cycles )
+                 << " branch misses = " << total.count( HardwareEvent::BranchMisses ) << endl ;
+            status = false ;
+        }
+    }
+
+    fout << "\nTEST:  PolyOrder counts cycles in each stage of isPrimitive for x^4 + x^2 + 2x + 3, 5, or none without counters" ;
+    {
+        bool haveCounters = PerfCounters::enable() ;
+
+        Polynomial f( "x^4 + x^2 + 2x + 3, 5" ) ;
+        PolyOrder order( f ) ;
+        order.isPrimitive() ;
+
+        PerfCounters::disable() ;
+
+        // Without counters, every stage is empty;  with them, every stage counted some cycles.
+        const OperationCount & s = order.statistics_ ;
+        bool consistent = true ;
+        for (int stage = 0 ;  stage < static_cast<int>( PolyOrderStage::NumStages ) ;  ++stage)
+        {
+            const HardwareCounts & events = s.stageEvents( static_cast<PolyOrderStage>( stage ) ) ;
+            if (haveCounters ? (events.has( HardwareEvent::Cycles ) && events.count( HardwareEvent::Cycles ) == 0u)
+                             : !events.empty())
+                consistent = false ;
+        }
+
+        if (consistent)
+            fout << ".........PASS!" << (haveCounters ? "" : "  (no hardware counters:  " + PerfCounters::unavailableReason() + ")") ;
+        else
+        {
+            fout << "\n\tERROR: PolyOrder hardware counts " << s << endl ;
+            status = false ;
+        }
+    }
+
+    // Build with cmake -DPP_THREAD_SANITIZER=ON to have ThreadSanitizer check for data races here.
+    fout << "\nTEST:  PolyOrder searches of all degree 5 modulo 3 polynomials and of x^19 + 9x + 2, 13 in 8 concurrent threads" ;
+    {
+        const int numThreads = 8 ;
+        vector<string> result( numThreads ) ;
+        vector<thread> threads ;
+
+        for (int t = 0 ;  t < numThreads ;  ++t)
+        {
+            threads.push_back( thread( [t, &result]()
+            {
+                ostringstream os ;
+                try
+                {
+                    if (t % 2 == 0)
+                    {
+                        // Count the primitive polynomials the slow way.
+                        Polynomial f ;
+                        f.initial_trial_poly( 5, 3 ) ;
+                        PolyOrder order( f ) ;
+
+                        int numPrimitive = 0 ;
+                        for (int i = 0 ;  i < 243 ;  ++i)
+                        {
+                            f.next_trial_poly() ;
+                            order.newPolynomial( f ) ;
+                            if (order.isPrimitive())
+                                ++numPrimitive ;
+                        }
+                        os << numPrimitive << " " << order.getNumPrimPoly() ;
+                    }
+                    else
+                    {
+                        // Factoring r needs Pollard rho and its primality tests.
+                        Polynomial f( "x^19 + 9 x + 2, 13" ) ;
+                        PolyOrder order( f ) ;
+                        os << order.isPrimitive() << " " << order.getNumPrimPoly() ;
+                    }
+                }
+                catch( exception & e )
+                {
+                    os << "exception " << e.what() ;
+                }
+                result[ t ] = os.str() ;
+            } ) ) ;
+        }
+
+        for (auto & thread : threads)
+            thread.join() ;
+
+        bool allAgree = true ;
+        for (int t = 0 ;  t < numThreads ;  ++t)
+        {
+            if (result[ t ] != (t % 2 == 0 ? "22 22" : "1 25647722399087923968"))
+            {
+                fout << "\n\tERROR: thread " << t << " got " << result[ t ] << endl ;
+                allAgree = false ;
+            }
+        }
+
+        if (allAgree)
+            fout << ".........PASS!" ;
+        else
+            status = false ;
+    }
+
+    fout << "\nTEST:  Library API findFirst, enumerate and isPrimitive for degree 4 modulo 2" ;
+    {
+        ostringstream os ;
+        OperationCount statistics ;
+
+        os << findFirst( 2, 4 ) << " | " ;
+
+        vector<Polynomial> found ;
+        BigInt numFound = enumerate( 2, 4, [&found]( const Polynomial & f ) { found.push_back( f ) ; return true ; },
+                                     SearchOptions(), &statistics ) ;
+        os << numFound << " " << statistics.numPolyTested << " " << found[ 1 ] << " | " ;
+
+        numFound = enumerate( 2, 4, []( const Polynomial & ) { return false ; } ) ;
+        os << numFound << " | " ;
+
+        os << isPrimitive( Polynomial( "x^4 + x^3 + x^2 + x + 1, 2" ) ) << " " << isPrimitive( Polynomial( "x^4 + x^3 + 1, 2" ) ) ;
+
+        if (os.str() != "x ^ 4 + x + 1, 2 | 2 10 x ^ 4 + x ^ 3 + 1, 2 | 1 | 0 1")
+        {
+            fout << "\n\tERROR: got " << os.str() << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  PrimitivePolynomialRange stops after the first 3 of degree 5 modulo 2 having tested only 16 polynomials" ;
+    {
+        ostringstream os ;
+        PrimitivePolynomialRange range( 2, 5 ) ;
+
+        int k = 0 ;
+        for (const Polynomial & f : range)
+        {
+            os << f << " | " ;
+            if (++k == 3)
+                break ;
+        }
+        os << range.statistics().numPolyTested ;
+
+        if (os.str() != "x ^ 5 + x ^ 2 + 1, 2 | x ^ 5 + x ^ 3 + 1, 2 | x ^ 5 + x ^ 3 + x ^ 2 + x + 1, 2 | 16")
+        {
+            fout << "\n\tERROR: got " << os.str() << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  PrimitivePolynomialRange in 5 shards and 5 threads lists the same 22 polynomials of degree 5 modulo 3 as one search" ;
+    {
+        const int numShards = 5 ;
+        vector< vector<Polynomial> > found( numShards ) ;
+        vector<OperationCount> statistics( numShards ) ;
+        vector<thread> threads ;
+
+        for (int shard = 0 ;  shard < numShards ;  ++shard)
+        {
+            threads.push_back( thread( [shard, &found, &statistics]()
+            {
+                SearchOptions options ;
+                options.shard     = shard ;
+                options.numShards = numShards ;
+
+                PrimitivePolynomialRange range( 3, 5, options ) ;
+                for (const Polynomial & f : range)
+                    found[ shard ].push_back( f ) ;
+                statistics[ shard ] = range.statistics() ;
+            } ) ) ;
+        }
+
+        for (auto & thread : threads)
+            thread.join() ;
+
+        vector<Polynomial> all ;
+        enumerate( 3, 5, [&all]( const Polynomial & f ) { all.push_back( f ) ; return true ; } ) ;
+
+        vector<Polynomial> merged ;
+        OperationCount total ;
+        for (int shard = 0 ;  shard < numShards ;  ++shard)
+        {
+            merged.insert( merged.end(), found[ shard ].begin(), found[ shard ].end() ) ;
+            total += statistics[ shard ] ;
+        }
+
+        bool same = merged.size() == 22 && all.size() == 22 ;
+        for (size_t i = 0 ;  same && i < all.size() ;  ++i)
+            same = (merged[ i ] == all[ i ]) ;
+
+        if (!same || BigInt( total.numPolyTested ) != static_cast<ppuint>( 243u ))
+        {
+            fout << "\n\tERROR: shards found " << merged.size() << " of " << all.size()
+                 << " primitive polynomials after testing " << total.numPolyTested << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  PolynomialWriter with a 64 byte buffer lists the 22 polynomials of degree 5 modulo 3 as the << operator does, and in compact, JSON Lines and hex formats" ;
+    {
+        ostringstream expected, human ;
+        vector< Polynomial > found ;
+        {
+            PolynomialWriter writer( human, OutputFormat::Human, 64 ) ;
+            enumerate( 3, 5, [&]( const Polynomial & f )
+            {
+                expected << "\n\nPrimitive polynomial modulo " << f.modulus() << " of degree " << f.deg() << "\n\n" << f << "\n\n" ;
+                writer.write( f ) ;
+                found.push_back( f ) ;
+                return true ;
+            } ) ;
+        }
+
+        ostringstream compact, json, hex ;
+        {
+            PolynomialWriter compactWriter( compact, OutputFormat::Compact ) ;
+            PolynomialWriter jsonWriter( json, OutputFormat::JsonLines ) ;
+            PolynomialWriter hexWriter( hex, OutputFormat::HexMask, 1 ) ;
+
+            compactWriter.write( found[ 0 ] ) ;
+            compactWriter.write( Polynomial( "0, 2" ) ) ;
+            jsonWriter.write( Polynomial( "x^4 + x + 1, 2" ) ) ;
+            hexWriter.write( Polynomial( "x^4 + x + 1, 2" ) ) ;
+            hexWriter.write( Polynomial( "x^8 + x^4 + x^3 + x^2 + 1, 2" ) ) ;
+            hexWriter.flush() ;
+            hexWriter.write( Polynomial( "x^3 + x + 1, 2" ) ) ;
+        }
+
+        if (found.size() != 22 || human.str() != expected.str() ||
+            compact.str() != "x^5 + 2 x + 1, 3\n0, 2\n" || Polynomial( "x^5 + 2 x + 1, 3" ) != found[ 0 ] ||
+            json.str() != "{\"p\":2,\"n\":4,\"coefficients\":[1,1,0,0,1]}\n" ||
+            hex.str() != "0x13\n0x11d\n0xb\n")
+        {
+            fout << "\n\tERROR: got " << found.size() << " polynomials\n" << human.str() << compact.str() << json.str() << hex.str() << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  Aggregating the 22 polynomials of degree 5 modulo 3 in 4 shards on 4 threads gives the same statistics as one search" ;
+    {
+        unique_ptr< AggregatorList > serial = AggregatorList::standard() ;
+        ppuint numTrinomials = 0 ;
+        SearchOptions options ;
+        options.aggregator = serial.get() ;
+        enumerate( 3, 5, [&]( const Polynomial & f )
+        {
+            int w = 0 ;
+            for (int i = 0 ;  i <= f.deg() ;  ++i)
+                w += f[ i ] != 0 ? 1 : 0 ;
+            numTrinomials += w == 3 ? 1 : 0 ;
+            return true ;
+        }, options ) ;
+
+        ThreadPool     pool( 4 ) ;
+        PolyOrderCache cache ;
+        WeightHistogram weights ;
+        MinimumWeight   minimum( 1 ) ;
+        unique_ptr< AggregatorList > parallel = AggregatorList::standard() ;
+        ppuint numFound = aggregate( 3, 5, *parallel, pool, cache ) ;
+        aggregate( 3, 5, weights, pool, cache ) ;
+        aggregate( 3, 5, minimum, pool, cache ) ;
+
+        ostringstream serialReport, parallelReport ;
+        serialReport   << *serial ;
+        parallelReport << *parallel ;
+
+        if (numFound != 22 || serialReport.str() != parallelReport.str() || weights.count( 3 ) != numTrinomials ||
+            minimum.weight() != 3 || minimum.numMembers() != numTrinomials || minimum.members().size() != 1 ||
+            minimum.members()[ 0 ] != Polynomial( "x^5 + 2 x + 1, 3" ))
+        {
+            fout << "\n\tERROR: found " << numFound << " with " << numTrinomials << " trinomials\n" << serialReport.str() << parallelReport.str() << minimum << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  Statistics of degree 4 modulo 13 merged from 4 shards count factoring r once, as one search does" ;
+    {
+        PrimitivePolynomialSearch search( 13, 4 ) ;
+        search.enumerate( []( const Polynomial & ) { return true ; } ) ;
+        const OperationCount & single = search.statistics() ;
+
+        ThreadPool      pool( 4 ) ;
+        PolyOrderCache  cache ;
+        WeightHistogram weights ;
+        OperationCount  merged ;
+        aggregate( 13, 4, weights, pool, cache, &merged ) ;
+
+        OperationCount twice ;
+        twice += single ;
+        twice += single ;
+
+        auto factoring = []( const OperationCount & s )
+        {
+            ostringstream os ;
+            os << s.numTrialDivides << " " << s.numGCDs << " " << s.numPrimalityTests << " " << s.numSquarings
+               << " " << s.factoringTime.count() ;
+            return os.str() ;
+        } ;
+
+        if (factoring( merged ) != factoring( single ) || factoring( twice ) != factoring( single ) ||
+            static_cast<BigInt>( twice.numPolyTested ) != static_cast<BigInt>( 2u ) * static_cast<BigInt>( single.numPolyTested ) ||
+            single.numPrimalityTests.isZero())
+        {
+            fout << "\n\tERROR: trial divides, gcds, primality tests, squarings and factorings are " << factoring( single )
+                 << " for one search, " << factoring( merged ) << " merged from shards and " << factoring( twice ) << " merged twice" << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  Trace of aggregating degree 5 modulo 3 on 2 threads keeps the newest 8 events per thread as a Chrome trace" ;
+    {
+        #ifndef PP_NO_TRACE
+        Trace::start( 8 ) ;
+        {
+            ThreadPool     pool( 2 ) ;
+            PolyOrderCache cache ;
+            WeightHistogram weights ;
+            aggregate( 3, 5, weights, pool, cache ) ;
+
+            for (int i = 0 ;  i < 20 ;  ++i)
+                PP_TRACE_SCOPE( "spin", "test" ) ;
+        }
+        Trace::stop() ;
+
+        ppuint numEvents = Trace::numEvents() ;
+        {
+            PP_TRACE_SCOPE( "after stop", "test" ) ;
+        }
+
+        ostringstream os ;
+        Trace::writeJson( os ) ;
+        string json = os.str() ;
+
+        // Count the times a name appears in the trace.
+        auto count = [&json]( const string & text )
+        {
+            int num = 0 ;
+            for (size_t pos = json.find( text ) ;  pos != string::npos ;  pos = json.find( text, pos + 1 ))
+                ++num ;
+            return num ;
+        } ;
+
+        if (json.find( "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":" + to_string( Trace::numDropped() ) + "}," ) != 0 ||
+            json.substr( json.size() - 3 ) != "]}\n" || Trace::numEvents() != numEvents || Trace::numDropped() < 12u ||
+            count( "\"name\":\"spin\"" ) != 8 || count( "\"args\":{\"name\":\"worker " ) != 2 ||
+            count( "\"name\":\"shard\",\"cat\":\"work\",\"ph\":\"X\"" ) < 1 || count( "after stop" ) != 0)
+        {
+            fout << "\n\tERROR: trace of " << numEvents << " events, " << Trace::numDropped() << " dropped, is\n" << json << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+        #else
+        fout << ".........PASS!  (tracing is compiled out)" ;
+        #endif
+    }
+
+    fout << "\nTEST:  Statistics of the search of degree 4 modulo 2 as JSON, as Prometheus text and in a monitor file" ;
+    {
+        ostringstream fileName ;
+        fileName << "/tmp/primpoly_unittest_" << chrono::steady_clock::now().time_since_epoch().count() << ".json" ;
+
+        StatisticsMonitor monitor( fileName.str(), 0.001 ) ;
+        SearchOptions options ;
+        options.monitor = &monitor ;
+        PrimitivePolynomialSearch search( 2, 4, options ) ;
+        search.enumerate( []( const Polynomial & ) { return true ; } ) ;
+        monitor.finish( search.statistics() ) ;
+
+        ifstream fin( fileName.str().c_str() ) ;
+        string json( (istreambuf_iterator<char>( fin )), istreambuf_iterator<char>() ) ;
+        remove( fileName.str().c_str() ) ;
+
+        ostringstream prometheus ;
+        writeStatisticsPrometheus( prometheus, search.statistics(), 2.0 ) ;
+
+        if (json.find( "{\"p\":2,\"n\":4,\"possible\":16,\"primitive\":2,\"finished\":true," ) != 0 ||
+            json.find( "\"eta_seconds\":0,\"survivors\":{\"tested\":10,\"const_coeff_primitive_root\":5," ) == string::npos ||
+            json.find( "\"order_m\":{\"calls\":2," ) == string::npos ||
+            prometheus.str().find( "primpoly_tested_per_second{p=\"2\",n=\"4\"} 5\n" ) == string::npos ||
+            prometheus.str().find( "primpoly_progress_ratio{p=\"2\",n=\"4\"} 0.625\n" ) == string::npos ||
+            prometheus.str().find( "primpoly_eta_seconds{p=\"2\",n=\"4\"} 1.2\n" ) == string::npos ||
+            prometheus.str().find( "primpoly_survivors_total{p=\"2\",n=\"4\",stage=\"order_m\"} 2\n" ) == string::npos)
+        {
+            fout << "\n\tERROR: statistics are\n" << json << prometheus.str() << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  Estimate of the search of degree 4 modulo 2 and of degree 64 modulo 2" ;
+    {
+        JobEstimate small = estimateJob( 2, 4, 0.001, 4 ) ;
+        JobEstimate large = estimateJob( 2, 64, 0.001, 4 ) ;
+
+        ostringstream json ;
+        writeEstimateJson( json, small ) ;
+
+        const StrategyEstimate & search   = small.strategy( "search" ) ;
+        const StrategyEstimate & parallel = small.strategy( "parallel" ) ;
+        const StrategyEstimate & archive  = large.strategy( "archive" ) ;
+
+        if (small.maxNumPoly != static_cast<BigInt>( 16u ) || small.numPrimitivePoly != static_cast<BigInt>( 2u ) ||
+            small.density != 0.125 || small.numToFirst != 8.0 || small.numOrderMTests != 2 ||
+            json.str().find( "{\"p\":2,\"n\":4,\"possible\":16,\"factored\":true,\"primitive\":2,\"density\":0.125,\"r\":15,\"factors_of_r\":[[3,1],[5,1]]," ) != 0 ||
+            !(small.candidateSeconds > 0.0) || !(search.secondsToFirst < search.secondsForAll) ||
+            parallel.numThreads != 4 || !(parallel.secondsForAll < search.secondsForAll) ||
+            !(archive.secondsForAll > 1.0e6) || !(archive.diskBytes > 0.0) ||
+            !(large.squareSeconds > 0.0) || !(large.nullitySeconds > 0.0))
+        {
+            fout << "\n\tERROR: estimates are\n" << small << large << json.str() << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  Estimate of degree 1000 modulo 2 times Q-I on a few rows and returns within its bound" ;
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now() ;
+        JobEstimate estimate = estimateJob( 2, 1000, 0.01, 4 ) ;
+        double elapsed = chrono::duration< double >( chrono::steady_clock::now() - start ).count() ;
+
+        if (!estimate.factored || elapsed > 3.0 || !(estimate.qMatrixRows >= 3 && estimate.qMatrixRows < 1000) ||
+            !(estimate.qMatrixSeconds > estimate.squareSeconds) || !(estimate.nullitySeconds > 0.0) ||
+            !(estimate.candidateSeconds > 0.0) || estimate.numSampled < 100u)
+        {
+            fout << "\n\tERROR: estimate took " << elapsed << " s and is\n" << estimate << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  Estimate of degree 13 modulo 65003, with no factor table, gives up factoring r after its time budget" ;
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now() ;
+        JobEstimate estimate = estimateJob( 65003, 13, 0.001, 4, nullptr, 0.2 ) ;
+        double elapsed = chrono::duration< double >( chrono::steady_clock::now() - start ).count() ;
+
+        ostringstream json ;
+        writeEstimateJson( json, estimate ) ;
+
+        if (estimate.factored || elapsed > 5.0 || !(estimate.setupSeconds >= 0.2) ||
+            estimate.numPrimitivePoly != static_cast<BigInt>( 0u ) || !estimate.factorsOfR.empty() ||
+            !(estimate.density > 0.0 && estimate.density <= 1.0 / 13.0) || estimate.numOrderMTests < 1 ||
+            !(estimate.orderMSeconds > 0.0) || json.str().find( "\"factored\":false,\"primitive\":null," ) == string::npos)
+        {
+            fout << "\n\tERROR: estimate took " << elapsed << " s and is\n" << estimate << json.str() << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  Archive of the 22 polynomials of degree 5 modulo 3 in blocks of 4 selects, ranks, scans and verifies, and a corrupt copy fails" ;
+    {
+        ostringstream fileName ;
+        fileName << "/tmp/primpoly_unittest_" << chrono::steady_clock::now().time_since_epoch().count() << ".ppa" ;
+
+        vector< Polynomial > found ;
+        {
+            PolynomialArchiveWriter writer( fileName.str(), 3, 5, 4 ) ;
+            enumerate( 3, 5, [&]( const Polynomial & f ) { writer.write( f ) ; found.push_back( f ) ; return true ; } ) ;
+            writer.finish() ;
+        }
+
+        ostringstream os ;
+        {
+            ThreadPool pool( 3 ) ;
+            MappedFile file( fileName.str(), false ) ;
+            PolynomialArchive archive( file.begin(), file.end() ) ;
+
+            if (archive.size() != 22 || archive.degree() != 5 || archive.modulus() != 3 || archive.generatorVersion() != primpolyVersion)
+                os << "header has " << archive.size() << " polynomials of degree " << archive.degree() << " modulo " << archive.modulus() << endl ;
+
+            for (ppuint k = 0 ;  k < found.size() ;  ++k)
+                if (archive.select( k ) != found[ k ] || archive.rank( found[ k ] ) != k)
+                    os << "select( " << k << " ) = " << archive.select( k ) << " and its rank is " << archive.rank( found[ k ] ) << endl ;
+
+            if (archive.rank( Polynomial( "x^5, 3" ) ) != 0 || archive.rank( Polynomial( "x^5 + 2 x^4 + 2 x^3 + 2 x^2 + 2 x + 2, 3" ) ) != 22)
+                os << "rank of polynomials outside the archive is wrong" << endl ;
+
+            vector< Polynomial > scanned ;
+            archive.scan( 10, [&]( const Polynomial & f ) { scanned.push_back( f ) ; return scanned.size() < 7 ; } ) ;
+            if (scanned != vector< Polynomial >( found.begin() + 10, found.begin() + 17 ))
+                os << "scan from 10 got " << scanned.size() << " polynomials" << endl ;
+
+            archive.verify( pool ) ;
+
+            // Change the first difference.
+            string bytes( file.begin(), file.end() ) ;
+            bytes[ 40 + 2 ] ^= 1 ;
+            PolynomialArchive corrupt( bytes.data(), bytes.data() + bytes.size() ) ;
+            try
+            {
+                corrupt.verify( pool ) ;
+                os << "verify passes a corrupt archive" << endl ;
+            }
+            catch( ArchiveError & e )
+            {
+            }
+        }
+        remove( fileName.str().c_str() ) ;
+
+        // Polynomials too far apart for a 64 bit difference.
+        fileName << "2" ;
+        {
+            PolynomialArchiveWriter writer( fileName.str(), 2, 70 ) ;
+            writer.write( Polynomial( "x^70 + 1, 2" ) ) ;
+            writer.write( Polynomial( "x^70 + x^69 + 1, 2" ) ) ;
+            writer.write( Polynomial( "x^70 + x^69 + x + 1, 2" ) ) ;
+        }
+        {
+            ThreadPool pool( 1 ) ;
+            MappedFile file( fileName.str() ) ;
+            PolynomialArchive archive( file.begin(), file.end() ) ;
+            archive.verify( pool, false ) ;
+
+            // 40 byte header, 9 byte record, escape and record, 1 byte difference, 8 byte index.
+            if (file.end() - file.begin() != 40 + 9 + 10 + 1 + 8 || archive.select( 1 ) != Polynomial( "x^70 + x^69 + 1, 2" ) ||
+                archive.select( 2 ) != Polynomial( "x^70 + x^69 + x + 1, 2" ))
+                os << "archive of degree 70 has " << (file.end() - file.begin()) << " bytes" << endl ;
+        }
+        remove( fileName.str().c_str() ) ;
+
+        if (found.size() != 22 || !os.str().empty())
+        {
+            fout << "\n\tERROR: " << os.str() << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  Batch test of 7 lines in blocks of 3 on 3 threads with a cache of 1 context gives results in input order" ;
+    {
+        istringstream in( "x^4 + x + 1, 2\n"
+                          "x^4 + x^3 + x^2 + x + 1, 2\n"
+                          "\n"
+                          "x^19 + 9 x + 2, 13\n"
+                          "x^4 + x^3 + 1, 2\n"
+                          "x^4 + x + 1, 4\n"
+                          "x^4 + x + 1 ) , 2\n" ) ;
+        ostringstream out ;
+
+        ThreadPool     pool( 3 ) ;
+        PolyOrderCache cache( 1 ) ;
+        testPolynomials( in, out, pool, cache, 3 ) ;
+
+        string expected( "x ^ 4 + x + 1, 2 is primitive!\n"
+                         "x ^ 4 + x ^ 3 + x ^ 2 + x + 1, 2 is NOT primitive!\n"
+                         "\n"
+                         "x ^ 19 + 9 x + 2, 13 is primitive!\n"
+                         "x ^ 4 + x ^ 3 + 1, 2 is primitive!\n"
+                         "x^4 + x + 1, 4 error: p must be a prime" ) ;
+
+        istringstream results( out.str() ) ;
+        string line ;
+        int numLines = 0 ;
+        while (getline( results, line ))
+            ++numLines ;
+
+        if (out.str().compare( 0, expected.size(), expected ) != 0 || numLines != 7 ||
+            out.str().find( "x^4 + x + 1 ) , 2 error: " ) == string::npos)
+        {
+            fout << "\n\tERROR: got\n" << out.str() << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  Batch test of compact formats from memory, and of packed polynomials from a memory mapped file" ;
+    {
+        string text( "0x13\n(4 3 0)\n0b11111\n(5 1:2 0), 3" ) ;
+        ostringstream out ;
+
+        ThreadPool     pool( 2 ) ;
+        PolyOrderCache cache ;
+        testPolynomials( text.data(), text.data() + text.size(), out, pool, cache, 3 ) ;
+
+        ostringstream packed ;
+        PackedPolynomials::write( packed, 13, 19, { Polynomial( "x^19 + 9 x + 2, 13" ), Polynomial( "x^19 + 12 x^18 + 9 x + 2, 13" ) } ) ;
+        string bytes( packed.str() ) ;
+        PackedPolynomials view( bytes.data(), bytes.data() + bytes.size() ) ;
+
+        ostringstream fileName ;
+        fileName << "/tmp/primpoly_unittest_" << chrono::steady_clock::now().time_since_epoch().count() << ".ppk" ;
+        {
+            ofstream file( fileName.str(), ios::binary ) ;
+            file << bytes ;
+        }
+        ostringstream fileOut ;
+        testPolynomialFile( fileName.str(), fileOut, pool, cache ) ;
+        remove( fileName.str().c_str() ) ;
+
+        // 16 byte header, then 20 coefficients of 4 bits for each polynomial.
+        if (out.str() != "x ^ 4 + x + 1, 2 is primitive!\n"
+                         "x ^ 4 + x ^ 3 + 1, 2 is primitive!\n"
+                         "x ^ 4 + x ^ 3 + x ^ 2 + x + 1, 2 is NOT primitive!\n"
+                         "x ^ 5 + 2 x + 1, 3 is primitive!\n" ||
+            bytes.size() != 16 + 2 * 10 || view.size() != 2 || view[ 1 ] != Polynomial( "x^19 + 12 x^18 + 9 x + 2, 13" ) ||
+            fileOut.str() != "x ^ 19 + 9 x + 2, 13 is primitive!\n"
+                             "x ^ 19 + 12 x ^ 18 + 9 x + 2, 13 is NOT primitive!\n")
+        {
+            fout << "\n\tERROR: got\n" << out.str() << fileOut.str() << " and " << bytes.size() << " packed bytes" << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  Daemon answers test, count, first, enumerate, deadline and bad requests over a Unix domain socket" ;
+    {
+        ostringstream path ;
+        path << "/tmp/primpoly_unittest_" << chrono::steady_clock::now().time_since_epoch().count() << ".socket" ;
+
+        ostringstream os ;
+        try
+        {
+            PolyDaemon daemon( path.str(), 2 ) ;
+            thread server( [&daemon]() { daemon.run() ; } ) ;
+
+            try
+            {
+                PolyDaemonClient client( path.str() ) ;
+                const char * requests[] =
+                {
+                    "0 test x^4 + x + 1, 2",
+                    "0 count 13 19",
+                    "0 first 2 5",
+                    "0 first 2 5",
+                    "0 enumerate 2 5 1 2",
+                    "1 enumerate 2 64 0 1000000",
+                    "0 frobnicate"
+                } ;
+
+                for (const char * request : requests)
+                {
+                    for (const string & line : client.request( request ))
+                        os << line << " | " ;
+                    os << "\n" ;
+                }
+            }
+            catch( exception & e )
+            {
+                os << "exception " << e.what() ;
+            }
+
+            daemon.stop() ;
+            server.join() ;
+        }
+        catch( exception & e )
+        {
+            os << "exception " << e.what() ;
+        }
+
+        if (os.str() != "ok primitive | end | \n"
+                        "ok 25647722399087923968 | end | \n"
+                        "ok x ^ 5 + x ^ 2 + 1, 2 | end | \n"
+                        "ok x ^ 5 + x ^ 2 + 1, 2 | end | \n"
+                        "ok x ^ 5 + x ^ 3 + 1, 2 | ok x ^ 5 + x ^ 3 + x ^ 2 + x + 1, 2 | end | \n"
+                        "error deadline exceeded | \n"
+                        "error unknown command frobnicate | \n")
+        {
+            fout << "\n\tERROR: got\n" << os.str() << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  Daemon with room for 2 connections turns away a third, and takes a new one once a client hangs up" ;
+    {
+        ostringstream path ;
+        path << "/tmp/primpoly_unittest_" << chrono::steady_clock::now().time_since_epoch().count() << ".socket" ;
+
+        ostringstream os ;
+        try
+        {
+            PolyDaemon daemon( path.str(), 2, 16, 2 ) ;
+            thread server( [&daemon]() { daemon.run() ; } ) ;
+
+            // Wait up to 2 s for the daemon to have num clients.
+            auto waitFor = [&daemon]( size_t num )
+            {
+                for (int i = 0 ;  i < 200 && daemon.numConnections() != num ;  ++i)
+                    this_thread::sleep_for( chrono::milliseconds( 10 ) ) ;
+                return daemon.numConnections() ;
+            } ;
+
+            try
+            {
+                PolyDaemonClient first( path.str() ) ;
+                {
+                    PolyDaemonClient second( path.str() ) ;
+                    os << first.request( "0 count 2 4" )[ 0 ] << " " << second.request( "0 count 2 4" )[ 0 ] << " " << waitFor( 2 ) << "\n" ;
+
+                    try
+                    {
+                        PolyDaemonClient third( path.str() ) ;
+                        third.request( "0 count 2 4" ) ;
+                        os << "third answered\n" ;
+                    }
+                    catch( DaemonError & e )
+                    {
+                        os << "third turned away\n" ;
+                    }
+                }
+
+                os << waitFor( 1 ) << "\n" ;
+                PolyDaemonClient fourth( path.str() ) ;
+                os << fourth.request( "0 count 2 4" )[ 0 ] << "\n" ;
+            }
+            catch( exception & e )
+            {
+                os << "exception " << e.what() ;
+            }
+
+            daemon.stop() ;
+            server.join() ;
+            os << daemon.numConnections() << "\n" ;
+        }
+        catch( exception & e )
+        {
+            os << "exception " << e.what() ;
+        }
+
+        if (os.str() != "ok 2 ok 2 2\nthird turned away\n1\nok 2\n0\n")
+        {
+            fout << "\n\tERROR: got\n" << os.str() << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+    
+    return status ;
+}
+
+
+
+bool unitTestParser( ostream & fout )
+{
+    bool status = true ;
+    
+    // Create a parser with parse tables.
     string s ;
     PolyValue  v ;
     PolyParser< PolySymbol, PolyValue > p ;
@@ -3003,6 +4265,118 @@ bool unitTestParser( ostream & fout )
             fout << ".........PASS!" ;
     }
     
+    fout << "\nTEST:  copy of a parser parses with the same shared tables:  x ^ 4 + x + 1, 2" ;
+    {
+        PolyParser< PolySymbol, PolyValue > copy( p ) ;
+        s = "x ^ 4 + x + 1, 2" ;
+        v = copy.parse( s ) ;
+        if (!(v.scalar_ == 2 && (v.f_.size()-1) == 4 && v.f_[0] == 1 && v.f_[1] == 1 && v.f_[4] == 1))
+        {
+            fout << ".........FAIL!" << endl ;
+            fout << "    parsing input " << s << endl << " value = " << v << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+    
+    fout << "\nTEST:  fast path parsePolynomial agrees with the LALR parser on values and errors" ;
+    {
+        // Some tricky sentences, then random strings from the polynomial alphabet.
+        vector<string> sentence { "", "0", "x", "X^12 + 3x + 1, 5", "+ x", "x +", ", 3", "x - 1", "x^4 - x", "x^4+x+1 ",
+                                  " x", "x^", "x 1", "2 3", "x,", "x, 3 + x", "4294967296", "x^3 + x^3 + x^3, 2" } ;
+        mt19937 gen( 12345 ) ;
+        const string alphabet = "0123456789  xX^+-,\t" ;
+        uniform_int_distribution<size_t> pickLength( 0, 12 ), pickChar( 0, alphabet.size() - 1 ) ;
+        for (int i = 0 ;  i < 5000 ;  ++i)
+        {
+            string t( pickLength( gen ), ' ' ) ;
+            for (auto & c : t)
+                c = alphabet[ pickChar( gen ) ] ;
+            sentence.push_back( t ) ;
+        }
+
+        int numBad = 0 ;
+        for (auto & t : sentence)
+        {
+            string reference, fast ;
+            try
+            {
+                PolyValue w = p.parse( t ) ;
+                ostringstream os ;  os << w ;  reference = os.str() ;
+            }
+            catch( ParserError & e ) { reference = e.what() ; }
+
+            try
+            {
+                PolyValue w ;
+                parsePolynomial( t.data(), t.data() + t.size(), w.f_, w.scalar_ ) ;
+                ostringstream os ;  os << w ;  fast = os.str() ;
+            }
+            catch( ParserError & e ) { fast = e.what() ; }
+
+            if (fast != reference && numBad++ < 5)
+                fout << "\n\tERROR:  parsing |" << t << "| fast path gives " << fast << " but reference gives " << reference << endl ;
+        }
+
+        if (numBad > 0)
+            status = false ;
+        else
+            fout << ".........PASS!" ;
+    }
+
+    fout << "\nTEST:  fast path parsing sparse polynomial x ^ 1000000 + x ^ 3 + 1, 2" ;
+    {
+        s = "x ^ 1000000 + x ^ 3 + 1, 2" ;
+        vector<ppuint> f ;
+        ppuint modulus = 0 ;
+        parsePolynomial( s.data(), s.data() + s.size(), f, modulus ) ;
+        if (!(modulus == 2 && f.size() == 1000001 && f[ 0 ] == 1 && f[ 3 ] == 1 && f[ 1000000 ] == 1 &&
+              count( f.begin(), f.end(), static_cast<ppuint>( 0u ) ) == 1000001 - 3))
+        {
+            fout << ".........FAIL!" << endl ;
+            fout << "    parsing input " << s << " gave p = " << modulus << " and degree " << f.size() - 1 << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+    
+    fout << "\nTEST:  reading hex tap mask 0x13, bit string 0b10011 and exponent list (5 1:2 0), 3, and rejecting 0x1g and ()" ;
+    {
+        auto read = []( const string & t )
+        {
+            PolyValue w ;
+            readPolynomial( t.data(), t.data() + t.size(), w.f_, w.scalar_ ) ;
+            ostringstream os ;  os << w ;
+            return os.str() ;
+        } ;
+
+        int rejected = 0 ;
+        for (const string t : { "0x1g", " ( ) " })
+        {
+            try
+            {
+                read( t ) ;
+            }
+            catch( ParserError & e )
+            {
+                ++rejected ;
+            }
+        }
+
+        string x4x1 = read( "x^4 + x + 1" ) ;
+        if (read( "0x13" ) != x4x1 || read( " 0b10011 " ) != x4x1 || read( "(4, 1 0)" ) != x4x1 ||
+            read( "(5 1:2 0), 3" ) != read( "x^5 + 2x + 1, 3" ) || read( "0x" ) != read( "0 x" ) || rejected != 2)
+        {
+            fout << ".........FAIL!" << endl ;
+            fout << "    0x13 gives " << read( "0x13" ) << " and (5 1:2 0), 3 gives " << read( "(5 1:2 0), 3" ) << endl ;
+            status = false ;
+        }
+        else
+            fout << ".........PASS!" ;
+    }
+
     fout << "\nTEST:  parsing bad syntax x 1" ;
     try
     {
@@ -49,11 +49,16 @@
 | DESCRIPTION
 |
 |     In the spirit of extreme programming, test each class and its member
-|     functions.  Run the tests every time we run this application.
+|     functions.  selfCheck() runs a quick smoke test every time we run this
+|     application, and the complete unit test once per build or on demand.
 |
 +============================================================================*/
 
+bool selfCheck( bool fullUnitTest = false ) ;
+bool smokeTest() ;
 bool unitTest() ;
+string buildFingerprint() ;
+bool runUnitTestGroup( bool (*unitTestGroup)( ostream & ), ostream & fout ) ;
 
 // Subtest functions.
 bool unitTestSystemFunctions( ostream & fout ) ;